@@ -18,6 +18,10 @@ struct RuntimeConfiguration: Sendable {
         var healthyPeriodicProbeInterval: TimeInterval = 60
         // Keep periodic probe cadence configurable for tests and reliability tuning.
         var periodicRecoveryPassInterval: TimeInterval = 15
+        // With kernel mount-change events running, healthy remotes are only probed this often as a safety net.
+        var watchedHealthyPeriodicProbeInterval: TimeInterval = 300
+        // One mount or unmount raises a burst of kernel events; they are handled once after this delay.
+        var mountChangeDebounceInterval: TimeInterval = 0.1
         // Queue label is configurable so tests can use predictable queue names.
         var networkMonitorQueueLabel: String = "com.visualweb.macfusegui.network-monitor"
     }
@@ -30,10 +34,20 @@ struct RuntimeConfiguration: Sendable {
     struct Browser: Sendable {
         var breakerThreshold: Int = 8
         var breakerWindow: TimeInterval = 30
+        // Per-remote cap for saved listings used to render the browser before it connects.
+        var listingCacheByteLimit: Int = BrowserListingDiskCache.defaultByteLimit
+        // Background listing of likely-next folders after each navigation.
+        var prefetch = BrowserPrefetchPolicy()
+        // TCP keepalive/user-timeout tuning so half-open sockets fail fast after network changes.
+        var socketOptions = BrowserSocketOptions()
+        // List and keepalive budgets derived from each remote's measured RTT.
+        var timeoutPolicy = BrowserAdaptiveTimeoutPolicy()
     }
 
     struct Mount: Sendable {
         var sshfsConnectCommandTimeout: TimeInterval = 20
+        // Refresh passes within this window share one mount-table read.
+        var mountTableSnapshotMaxAge: TimeInterval = MountTableSnapshotService.defaultMaxAge
     }
 
     var remotes = Remotes()
@@ -57,6 +71,7 @@ final class AppEnvironment {
     let validationService: ValidationService
     let askpassHelper: AskpassHelper
     let mountStateParser: MountStateParser
+    let mountSnapshots: MountTableSnapshotService?
     let mountCommandBuilder: MountCommandBuilder
     let unmountService: UnmountService
     let mountManager: MountManager
@@ -80,11 +95,15 @@ final class AppEnvironment {
         validationService = ValidationService()
         askpassHelper = AskpassHelper(diagnostics: diagnosticsService)
         mountStateParser = MountStateParser()
+        mountSnapshots = MountTableReaders.platformDefault().map {
+            MountTableSnapshotService(reader: $0, maxAge: runtimeConfiguration.mount.mountTableSnapshotMaxAge)
+        }
         mountCommandBuilder = MountCommandBuilder(redactionService: redactionService)
         unmountService = UnmountService(
             runner: processRunner,
             diagnostics: diagnosticsService,
             mountStateParser: mountStateParser,
+            mountSnapshots: mountSnapshots,
             totalUnmountTimeout: runtimeConfiguration.unmount.totalUnmountTimeout,
             perCommandMaxTimeout: runtimeConfiguration.unmount.perCommandMaxTimeout
         )
@@ -94,18 +113,26 @@ final class AppEnvironment {
             askpassHelper: askpassHelper,
             unmountService: unmountService,
             mountStateParser: mountStateParser,
+            mountSnapshots: mountSnapshots,
             diagnostics: diagnosticsService,
             commandBuilder: mountCommandBuilder,
             sshfsConnectCommandTimeout: runtimeConfiguration.mount.sshfsConnectCommandTimeout
         )
         let browserTransport = LibSSH2SFTPTransport(
-            diagnostics: diagnosticsService
+            diagnostics: diagnosticsService,
+            timeoutPolicy: runtimeConfiguration.browser.timeoutPolicy,
+            socketOptions: runtimeConfiguration.browser.socketOptions
         )
         let browserSessionManager = RemoteBrowserSessionManager(
             transport: browserTransport,
             diagnostics: diagnosticsService,
             breakerThreshold: runtimeConfiguration.browser.breakerThreshold,
-            breakerWindow: runtimeConfiguration.browser.breakerWindow
+            breakerWindow: runtimeConfiguration.browser.breakerWindow,
+            listingStore: BrowserListingDiskCache(
+                byteLimit: runtimeConfiguration.browser.listingCacheByteLimit,
+                diagnostics: diagnosticsService
+            ),
+            prefetchPolicy: runtimeConfiguration.browser.prefetch
         )
         remoteDirectoryBrowserService = RemoteDirectoryBrowserService(
             manager: browserSessionManager,
@@ -126,6 +153,7 @@ final class AppEnvironment {
             remoteDirectoryBrowserService: remoteDirectoryBrowserService,
             diagnostics: diagnosticsService,
             launchAtLoginService: launchAtLoginService,
+            mountChangeWatcher: MountChangeWatchers.platformDefault(),
             runtimeConfiguration: runtimeConfiguration
         )
 
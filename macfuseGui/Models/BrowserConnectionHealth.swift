@@ -76,6 +76,8 @@ struct RemoteBrowserSnapshot: Equatable, Sendable {
     let fromCache: Bool
     let requestID: UInt64
     let latencyMs: Int
+    // True while a streamed listing is still running; entries are the rows received so far.
+    let isPartial: Bool
 
     init(
         path: String,
@@ -87,7 +89,8 @@ struct RemoteBrowserSnapshot: Equatable, Sendable {
         generatedAt: Date,
         fromCache: Bool,
         requestID: UInt64,
-        latencyMs: Int
+        latencyMs: Int,
+        isPartial: Bool = false
     ) {
         self.path = path
         self.entries = entries
@@ -99,6 +102,24 @@ struct RemoteBrowserSnapshot: Equatable, Sendable {
         self.fromCache = fromCache
         self.requestID = requestID
         self.latencyMs = latencyMs
+        self.isPartial = isPartial
+    }
+
+    /// Beginner note: Same snapshot delivered to another request (single-flight followers, partial fan-out).
+    func withRequestID(_ requestID: UInt64) -> RemoteBrowserSnapshot {
+        RemoteBrowserSnapshot(
+            path: path,
+            entries: entries,
+            isStale: isStale,
+            isConfirmedEmpty: isConfirmedEmpty,
+            health: health,
+            message: message,
+            generatedAt: generatedAt,
+            fromCache: fromCache,
+            requestID: requestID,
+            latencyMs: latencyMs,
+            isPartial: isPartial
+        )
     }
 
     /// Structural Equatable includes timing/request metadata. Use this helper for UI state comparisons.
@@ -110,5 +131,6 @@ struct RemoteBrowserSnapshot: Equatable, Sendable {
             && health.isSemanticallyEquivalent(to: other.health)
             && message == other.message
             && fromCache == other.fromCache
+            && isPartial == other.isPartial
     }
 }
@@ -0,0 +1,212 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file keeps recently listed directories in memory under a byte budget, evicting least-recently-used listings.
+// Called by: Owned by LibSSH2SessionActor as its sticky listing cache.
+// Calls into: Pure Swift data structures only.
+// Concurrency: Value type with no internal locking; the owning actor provides isolation.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: Path -> listing cache with LRU order and a byte budget.
+/// Sizes are estimates of resident heap bytes (item storage plus out-of-line string bytes),
+/// which is what grows when a user browses thousands of directories.
+/// The most recently stored listing is never evicted, even when it alone exceeds the budget,
+/// so "show the last good listing" fallbacks keep working.
+struct BrowserDirectoryCache {
+    /// Beginner note: Counters for diagnostics; all values are cumulative except entry/byte totals.
+    struct Metrics: Equatable, Sendable {
+        var entryCount = 0
+        var totalBytes = 0
+        var byteBudget = 0
+        var hits = 0
+        var misses = 0
+        var evictions = 0
+        var evictedBytes = 0
+    }
+
+    // Default budget: comfortably holds a few thousand typical listings.
+    static let defaultByteBudget = 16 * 1024 * 1024
+
+    // Swift stores strings of up to 15 UTF-8 bytes inline; longer ones get a heap buffer.
+    private static let inlineStringCapacity = 15
+    private static let heapStringHeaderBytes = 32
+    private static let arrayHeaderBytes = 32
+
+    /// Beginner note: Doubly linked LRU node, addressed by index so the list needs no class references.
+    private struct Node {
+        var path: String
+        var entries: [RemoteDirectoryItem]
+        var validator: BrowserDirectoryValidator?
+        var bytes: Int
+        var newer: Int
+        var older: Int
+    }
+
+    let byteBudget: Int
+    private var nodes: [Node] = []
+    private var freeIndices: [Int] = []
+    private var indexByPath: [String: Int] = [:]
+    // Most and least recently used node indices; -1 when empty.
+    private var newest = -1
+    private var oldest = -1
+    private(set) var metrics: Metrics
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(byteBudget: Int = BrowserDirectoryCache.defaultByteBudget) {
+        self.byteBudget = max(0, byteBudget)
+        self.metrics = Metrics(byteBudget: max(0, byteBudget))
+    }
+
+    var count: Int {
+        indexByPath.count
+    }
+
+    /// Beginner note: Reading a listing marks it most recently used; assigning nil removes it.
+    subscript(path: String) -> [RemoteDirectoryItem]? {
+        mutating get {
+            guard let index = indexByPath[path] else {
+                metrics.misses += 1
+                return nil
+            }
+            metrics.hits += 1
+            moveToNewest(index)
+            return nodes[index].entries
+        }
+        set {
+            if let newValue {
+                store(newValue, validator: nil, for: path)
+            } else {
+                remove(path)
+            }
+        }
+    }
+
+    /// Beginner note: Membership check that does not change LRU order or hit counters.
+    func contains(_ path: String) -> Bool {
+        indexByPath[path] != nil
+    }
+
+    /// Beginner note: Stores a listing together with the directory attributes it was read under.
+    /// Plain subscript assignment drops any validator, so a relist is never skipped on stale data.
+    mutating func store(_ entries: [RemoteDirectoryItem], validator: BrowserDirectoryValidator?, for path: String) {
+        let bytes = Self.estimatedBytes(path: path, entries: entries)
+        if let index = indexByPath[path] {
+            metrics.totalBytes += bytes - nodes[index].bytes
+            nodes[index].entries = entries
+            nodes[index].validator = validator
+            nodes[index].bytes = bytes
+            moveToNewest(index)
+        } else {
+            let node = Node(path: path, entries: entries, validator: validator, bytes: bytes, newer: -1, older: -1)
+            let index: Int
+            if let reused = freeIndices.popLast() {
+                nodes[reused] = node
+                index = reused
+            } else {
+                nodes.append(node)
+                index = nodes.count - 1
+            }
+            indexByPath[path] = index
+            linkAsNewest(index)
+            metrics.totalBytes += bytes
+            metrics.entryCount = indexByPath.count
+        }
+        evictToBudget()
+    }
+
+    /// Beginner note: Validator saved with a path's listing; does not change LRU order or hit counters.
+    func validator(for path: String) -> BrowserDirectoryValidator? {
+        indexByPath[path].flatMap { nodes[$0].validator }
+    }
+
+    /// Beginner note: Rough resident size of one cached listing.
+    static func estimatedBytes(path: String, entries: [RemoteDirectoryItem]) -> Int {
+        var bytes = arrayHeaderBytes + stringHeapBytes(path) + entries.count * MemoryLayout<RemoteDirectoryItem>.stride
+        for entry in entries {
+            bytes += stringHeapBytes(entry.name) + stringHeapBytes(entry.fullPath)
+        }
+        return bytes
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func stringHeapBytes(_ value: String) -> Int {
+        let length = value.utf8.count
+        return length > inlineStringCapacity ? heapStringHeaderBytes + length + 1 : 0
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private mutating func remove(_ path: String) {
+        guard let index = indexByPath.removeValue(forKey: path) else {
+            return
+        }
+        unlink(index)
+        metrics.totalBytes -= nodes[index].bytes
+        metrics.entryCount = indexByPath.count
+        release(index)
+    }
+
+    /// Beginner note: Drops least recently used listings until the budget holds (keeping the newest one).
+    private mutating func evictToBudget() {
+        while metrics.totalBytes > byteBudget, oldest != -1, oldest != newest {
+            let index = oldest
+            let bytes = nodes[index].bytes
+            indexByPath[nodes[index].path] = nil
+            unlink(index)
+            release(index)
+            metrics.totalBytes -= bytes
+            metrics.evictions += 1
+            metrics.evictedBytes += bytes
+        }
+        metrics.entryCount = indexByPath.count
+    }
+
+    /// Beginner note: Frees the slot's payload so evicted listings stop holding memory.
+    private mutating func release(_ index: Int) {
+        nodes[index].path = ""
+        nodes[index].entries = []
+        nodes[index].validator = nil
+        nodes[index].bytes = 0
+        freeIndices.append(index)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private mutating func moveToNewest(_ index: Int) {
+        guard index != newest else {
+            return
+        }
+        unlink(index)
+        linkAsNewest(index)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private mutating func linkAsNewest(_ index: Int) {
+        nodes[index].older = newest
+        nodes[index].newer = -1
+        if newest != -1 {
+            nodes[newest].newer = index
+        }
+        newest = index
+        if oldest == -1 {
+            oldest = index
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private mutating func unlink(_ index: Int) {
+        let newer = nodes[index].newer
+        let older = nodes[index].older
+        if newer != -1 {
+            nodes[newer].older = older
+        } else {
+            newest = older
+        }
+        if older != -1 {
+            nodes[older].newer = newer
+        } else {
+            oldest = newer
+        }
+        nodes[index].newer = -1
+        nodes[index].older = -1
+    }
+}
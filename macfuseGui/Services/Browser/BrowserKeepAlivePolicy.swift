@@ -0,0 +1,131 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file defines keepalive modes, per-mode counters, and the per-server mode memory.
+// Called by: LibSSH2SessionActor (mode choice and stats), RemoteBrowserSessionManager (shared memory), and transports.
+// Calls into: Pure Swift values and Foundation locking only.
+// Concurrency: Values are Sendable; BrowserKeepAliveModeMemory guards its map with a lock.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: How a keepalive tick proves the session is still alive.
+/// sshProtocol sends a no-reply SSH keepalive and proves liveness with an SFTP realpath of ".",
+/// which does not stat the browsed folder; sftpStat stats the current folder each tick.
+enum BrowserKeepAliveMode: String, CaseIterable, Sendable {
+    case sshProtocol = "ssh"
+    case sftpStat = "stat"
+}
+
+/// Beginner note: What one keepalive probe did.
+struct BrowserKeepAliveResult: Sendable, Equatable {
+    var modeUsed: BrowserKeepAliveMode
+    // True when an SFTP stat ran, either by mode or because the server refused the realpath probe.
+    var sftpProbed: Bool
+    // True when the server answered the sshProtocol realpath probe.
+    var replySeen: Bool
+    var latencyMs: Int
+}
+
+/// Beginner note: Cumulative counters for one keepalive mode.
+struct BrowserKeepAliveModeStats: Sendable, Equatable {
+    var attempts = 0
+    var replies = 0
+    var sftpProbes = 0
+    var failures = 0
+    var totalLatencyMs = 0
+
+    var averageLatencyMs: Int {
+        let succeeded = attempts - failures
+        return succeeded <= 0 ? 0 : totalLatencyMs / succeeded
+    }
+
+    var summary: String {
+        "n\(attempts)/reply\(replies)/probe\(sftpProbes)/fail\(failures)/avg\(averageLatencyMs)ms"
+    }
+}
+
+/// Beginner note: Chooses the keepalive mode for one session and records how each mode behaves.
+/// SSH keepalives are preferred. A server that refuses the realpath probe makes every tick pay
+/// that round trip plus a stat, so after demoteAfterProbes such ticks in a row the session
+/// settles on plain stat pings.
+struct BrowserKeepAliveTracker: Sendable, Equatable {
+    static let defaultDemoteAfterProbes = 3
+
+    private(set) var mode: BrowserKeepAliveMode
+    private(set) var stats: [BrowserKeepAliveMode: BrowserKeepAliveModeStats] = [:]
+    private(set) var consecutiveUnansweredKeepAlives = 0
+    let demoteAfterProbes: Int
+
+    init(mode: BrowserKeepAliveMode = .sshProtocol, demoteAfterProbes: Int = BrowserKeepAliveTracker.defaultDemoteAfterProbes) {
+        self.mode = mode
+        self.demoteAfterProbes = demoteAfterProbes
+    }
+
+    /// Beginner note: Records a successful probe; returns true when the mode changed because of it.
+    mutating func recordSuccess(_ result: BrowserKeepAliveResult) -> Bool {
+        var modeStats = stats[result.modeUsed] ?? BrowserKeepAliveModeStats()
+        modeStats.attempts += 1
+        modeStats.totalLatencyMs += result.latencyMs
+        if result.replySeen {
+            modeStats.replies += 1
+        }
+        if result.sftpProbed {
+            modeStats.sftpProbes += 1
+        }
+        stats[result.modeUsed] = modeStats
+
+        guard result.modeUsed == .sshProtocol, mode == .sshProtocol else {
+            return false
+        }
+        consecutiveUnansweredKeepAlives = result.replySeen ? 0 : consecutiveUnansweredKeepAlives + 1
+        guard consecutiveUnansweredKeepAlives >= demoteAfterProbes else {
+            return false
+        }
+        mode = .sftpStat
+        consecutiveUnansweredKeepAlives = 0
+        return true
+    }
+
+    /// Beginner note: Records a failed probe. Failure says the link is down, not that the mode is
+    /// wrong, so it never changes the mode.
+    mutating func recordFailure(mode failedMode: BrowserKeepAliveMode) {
+        var modeStats = stats[failedMode] ?? BrowserKeepAliveModeStats()
+        modeStats.attempts += 1
+        modeStats.failures += 1
+        stats[failedMode] = modeStats
+    }
+
+    var summary: String {
+        let parts = BrowserKeepAliveMode.allCases.compactMap { candidate -> String? in
+            stats[candidate].map { "\(candidate.rawValue):\($0.summary)" }
+        }
+        return ([mode.rawValue] + parts).joined(separator: ",")
+    }
+}
+
+/// Beginner note: Remembers which keepalive mode worked per server (host:port), so reopening a
+/// browser for a server that ignores SSH keepalives starts straight on stat pings.
+// @unchecked Sendable is safe here because the map is only accessed under lock.
+final class BrowserKeepAliveModeMemory: @unchecked Sendable {
+    private let lock = NSLock()
+    private var modes: [String: BrowserKeepAliveMode] = [:]
+
+    /// Beginner note: Mode learned for this server, or nil when none was recorded yet.
+    func mode(for remote: RemoteConfig) -> BrowserKeepAliveMode? {
+        lock.lock()
+        defer { lock.unlock() }
+        return modes[Self.key(for: remote)]
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func remember(_ mode: BrowserKeepAliveMode, for remote: RemoteConfig) {
+        lock.lock()
+        modes[Self.key(for: remote)] = mode
+        lock.unlock()
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func key(for remote: RemoteConfig) -> String {
+        "\(remote.host.lowercased()):\(remote.port)"
+    }
+}
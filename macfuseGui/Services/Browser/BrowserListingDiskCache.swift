@@ -0,0 +1,688 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file persists recent directory listings per remote endpoint so the browser can open with last-known rows instantly.
+// Called by: Owned by RemoteBrowserSessionManager and shared with each LibSSH2SessionActor it creates.
+// Calls into: Calls into FileManager, memory-mapped Data, and DiagnosticsService.
+// Concurrency: In-memory state is guarded by a lock; file writes run on a private serial queue.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: One cached listing as it was last seen on the server.
+struct BrowserCachedListing: Equatable, Sendable {
+    let path: String
+    let entries: [RemoteDirectoryItem]
+    let listedAt: Date
+    // Directory attributes the listing was read under; lets a later session revalidate with one stat.
+    var validator: BrowserDirectoryValidator? = nil
+}
+
+/// Beginner note: Identifies whose listings a cache file holds. The remote's UUID survives edits,
+/// so the endpoint (user, host, port) is part of the key: pointing a saved remote at another
+/// server never serves the old server's rows.
+struct BrowserListingCacheKey: Hashable, Sendable {
+    let remoteID: UUID
+    let endpoint: String
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(remoteID: UUID, host: String, port: Int, username: String) {
+        self.remoteID = remoteID
+        let normalizedHost = host.trimmingCharacters(in: .whitespacesAndNewlines).lowercased()
+        let normalizedUser = username.trimmingCharacters(in: .whitespacesAndNewlines)
+        self.endpoint = "\(normalizedUser)@\(normalizedHost):\(port)"
+    }
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(remote: RemoteConfig) {
+        self.init(remoteID: remote.id, host: remote.host, port: remote.port, username: remote.username)
+    }
+}
+
+/// Beginner note: Small binary file per remote endpoint holding recent listings keyed by canonical path.
+/// Files are opened memory-mapped and only a record index is built at load; entries are decoded
+/// on first lookup. Each record carries a checksum, so a torn or corrupted record is dropped
+/// without losing the rest of the file. Unknown versions or bad headers load as an empty cache.
+// @unchecked Sendable is safe here because all mutable state is accessed under lock.
+final class BrowserListingDiskCache: @unchecked Sendable {
+    // File layout (little-endian):
+    //   header: magic "MFLC", u16 version, u16 reserved, u32 record count
+    //   record: u32 payload length, u32 FNV-1a checksum of payload, payload
+    //   payload: u8 kind, u16 path length, path bytes, then
+    //     listing: i64 listedAt (ms), validator, u32 entry count, entries
+    //     alias:   u16 target length, target bytes (requested path -> canonical path)
+    //   validator: u8 flags, [i64 mtime s, [u64 size], i64 captured s] when flags bit 0 is set
+    //   entry: u8 flags, u16 name length, name, [u16 full path length, full path], [i64 modified ms], [i64 size]
+    // Version 2 added the per-listing validator; version 3 moved its captured time to the server
+    // clock. Older files load as empty and are rewritten.
+    static let formatVersion: UInt16 = 3
+    static let defaultByteLimit = 1024 * 1024
+    static let defaultWriteDelay: TimeInterval = 0.5
+
+    private static let magic: [UInt8] = Array("MFLC".utf8)
+    private static let headerSize = 12
+    private static let frameHeaderSize = 8
+    private static let kindListing: UInt8 = 0
+    private static let kindAlias: UInt8 = 1
+    private static let flagDirectory: UInt8 = 1 << 0
+    private static let flagExplicitFullPath: UInt8 = 1 << 1
+    private static let flagModified: UInt8 = 1 << 2
+    private static let flagSize: UInt8 = 1 << 3
+    private static let validatorPresent: UInt8 = 1 << 0
+    private static let validatorHasSize: UInt8 = 1 << 1
+
+    /// Beginner note: Indexed record; `frame` is the full on-disk record and may point into the mapped file.
+    /// `lastAccess` orders in-memory eviction (0 for records loaded from disk and not read since).
+    private struct Record {
+        let listedAt: Date
+        let frame: Data
+        var lastAccess: UInt64 = 0
+    }
+
+    /// Beginner note: All cached state for one remote endpoint.
+    private struct RemoteListings {
+        var records: [String: Record] = [:]
+        var aliases: [String: String] = [:]
+        var writeScheduled = false
+    }
+
+    let directoryURL: URL
+    let byteLimit: Int
+    private let fileManager: FileManager
+    private let diagnostics: DiagnosticsService?
+    private let writeDelay: TimeInterval
+    private let ioQueue = DispatchQueue(label: "macfuseGui.browser.listing-cache", qos: .utility)
+    private let lock = NSLock()
+    private var remotes: [BrowserListingCacheKey: RemoteListings] = [:]
+    private var accessClock: UInt64 = 0
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(
+        directoryURL: URL? = nil,
+        byteLimit: Int = BrowserListingDiskCache.defaultByteLimit,
+        writeDelay: TimeInterval = BrowserListingDiskCache.defaultWriteDelay,
+        fileManager: FileManager = .default,
+        diagnostics: DiagnosticsService? = nil
+    ) {
+        self.fileManager = fileManager
+        self.byteLimit = max(Self.headerSize, byteLimit)
+        self.writeDelay = writeDelay
+        self.diagnostics = diagnostics
+        if let directoryURL {
+            self.directoryURL = directoryURL
+        } else {
+            // Defensive fallback: FileManager should return a Caches URL, but avoid crashing if it doesn't.
+            let caches = fileManager.urls(for: .cachesDirectory, in: .userDomainMask).first
+                ?? fileManager.homeDirectoryForCurrentUser.appendingPathComponent("Library/Caches", isDirectory: true)
+            self.directoryURL = caches
+                .appendingPathComponent("macfuseGui", isDirectory: true)
+                .appendingPathComponent("browser-listings", isDirectory: true)
+        }
+    }
+
+    /// Beginner note: Maps and indexes a remote's file in the background so the first lookup is cheap.
+    func preload(key: BrowserListingCacheKey) {
+        ioQueue.async { [self] in
+            lock.lock()
+            defer { lock.unlock() }
+            _ = loadedListings(key: key)
+        }
+    }
+
+    /// Beginner note: Last-known listing for a path (or for the canonical path it resolved to), if any.
+    func listing(key cacheKey: BrowserListingCacheKey, path: String) -> BrowserCachedListing? {
+        let normalized = BrowserPathNormalizer.normalize(path: path)
+        lock.lock()
+        var state = loadedListings(key: cacheKey)
+        let key = state.records[normalized] != nil ? normalized : (state.aliases[normalized] ?? normalized)
+        guard var record = state.records[key] else {
+            lock.unlock()
+            return nil
+        }
+        accessClock += 1
+        record.lastAccess = accessClock
+        state.records[key] = record
+        remotes[cacheKey] = state
+        lock.unlock()
+
+        if let listing = Self.decodeListing(frame: record.frame) {
+            return listing
+        }
+
+        diagnostics?.append(
+            level: .warning,
+            category: "remote-browser",
+            message: "Dropped corrupt cached listing remote=\(cacheKey.remoteID.uuidString) path=\(key)"
+        )
+        lock.lock()
+        state = remotes[cacheKey] ?? state
+        if state.records[key]?.frame == record.frame {
+            state.records[key] = nil
+            remotes[cacheKey] = state
+        }
+        lock.unlock()
+        return nil
+    }
+
+    /// Beginner note: Records a fresh listing and schedules a coalesced background write.
+    /// `requestedPath` is remembered as an alias when it resolved to a different canonical path (e.g. "~").
+    func store(
+        key: BrowserListingCacheKey,
+        path: String,
+        requestedPath: String? = nil,
+        entries: [RemoteDirectoryItem],
+        listedAt: Date = Date(),
+        validator: BrowserDirectoryValidator? = nil
+    ) {
+        let canonical = BrowserPathNormalizer.normalize(path: path)
+        let frame = Self.encodeListing(
+            BrowserCachedListing(path: canonical, entries: entries, listedAt: listedAt, validator: validator)
+        )
+        lock.lock()
+        var state = loadedListings(key: key)
+        accessClock += 1
+        state.records[canonical] = Record(listedAt: listedAt, frame: frame, lastAccess: accessClock)
+        if let requestedPath {
+            let alias = BrowserPathNormalizer.normalize(path: requestedPath)
+            if alias != canonical {
+                state.aliases[alias] = canonical
+            }
+        }
+        Self.evictToByteLimit(&state, byteLimit: byteLimit)
+        let shouldSchedule = !state.writeScheduled
+        state.writeScheduled = true
+        remotes[key] = state
+        lock.unlock()
+
+        if shouldSchedule {
+            ioQueue.asyncAfter(deadline: .now() + writeDelay) { [self] in
+                write(key: key)
+            }
+        }
+    }
+
+    /// Beginner note: Starts writing pending changes now without waiting for the coalescing delay.
+    /// Returns immediately so session teardown never blocks on disk I/O.
+    func flush() {
+        ioQueue.async { [self] in
+            writePending()
+        }
+    }
+
+    /// Beginner note: Writes pending changes and returns once they are on disk; used by tests.
+    func flushAndWait() {
+        ioQueue.sync {
+            writePending()
+        }
+    }
+
+    /// Beginner note: Forgets every cached listing for a remote, for all endpoints it has pointed at,
+    /// in memory and on disk. Called when the remote is deleted or its connection details change.
+    func removeAll(remoteID: UUID) {
+        lock.lock()
+        remotes = remotes.filter { $0.key.remoteID != remoteID }
+        lock.unlock()
+        ioQueue.async { [self] in
+            // Prefix match also removes files from before the endpoint was part of the name.
+            let prefix = remoteID.uuidString
+            let names = (try? fileManager.contentsOfDirectory(atPath: directoryURL.path)) ?? []
+            for name in names where name.hasPrefix(prefix) && name.hasSuffix(".cache") {
+                try? fileManager.removeItem(at: directoryURL.appendingPathComponent(name, isDirectory: false))
+            }
+            // A preload queued before this purge may have mapped the old file meanwhile.
+            lock.lock()
+            remotes = remotes.filter { $0.key.remoteID != remoteID }
+            lock.unlock()
+        }
+    }
+
+    /// Beginner note: One file per remote endpoint: "<remote UUID>-<endpoint hash>.cache".
+    func fileURL(key: BrowserListingCacheKey) -> URL {
+        let endpointHash = String(format: "%08x", Self.checksum(key.endpoint.utf8))
+        return directoryURL.appendingPathComponent("\(key.remoteID.uuidString)-\(endpointHash).cache", isDirectory: false)
+    }
+
+    // MARK: - Loading and writing
+
+    /// Beginner note: Returns the endpoint's state, loading its file on first use. Caller holds `lock`.
+    private func loadedListings(key: BrowserListingCacheKey) -> RemoteListings {
+        if let existing = remotes[key] {
+            return existing
+        }
+        var state = RemoteListings()
+        let url = fileURL(key: key)
+        if fileManager.fileExists(atPath: url.path) {
+            do {
+                let data = try Data(contentsOf: url, options: .alwaysMapped)
+                let index = Self.indexFile(data)
+                state.records = index.records
+                state.aliases = index.aliases
+                if index.isDamaged {
+                    diagnostics?.append(
+                        level: .warning,
+                        category: "remote-browser",
+                        message: "Listing cache for remote=\(key.remoteID.uuidString) was damaged; kept \(index.records.count) readable listings"
+                    )
+                }
+            } catch {
+                diagnostics?.append(
+                    level: .warning,
+                    category: "remote-browser",
+                    message: "Failed to read listing cache remote=\(key.remoteID.uuidString) error=\(error.localizedDescription)"
+                )
+            }
+        }
+        remotes[key] = state
+        return state
+    }
+
+    /// Beginner note: Writes every endpoint with unsaved changes. Runs on ioQueue.
+    private func writePending() {
+        lock.lock()
+        let pending = remotes.compactMap { $0.value.writeScheduled ? $0.key : nil }
+        lock.unlock()
+        for key in pending {
+            write(key: key)
+        }
+    }
+
+    /// Beginner note: Serializes one endpoint's records within the byte limit. Runs on ioQueue.
+    /// A key dropped by `removeAll` is skipped, so a delayed write cannot resurrect purged rows.
+    private func write(key: BrowserListingCacheKey) {
+        lock.lock()
+        guard var state = remotes[key], state.writeScheduled else {
+            lock.unlock()
+            return
+        }
+        state.writeScheduled = false
+        remotes[key] = state
+        lock.unlock()
+
+        let data = Self.encodeFile(records: state.records, aliases: state.aliases, byteLimit: byteLimit)
+        do {
+            try fileManager.createDirectory(at: directoryURL, withIntermediateDirectories: true)
+            try data.write(to: fileURL(key: key), options: .atomic)
+        } catch {
+            diagnostics?.append(
+                level: .warning,
+                category: "remote-browser",
+                message: "Failed to write listing cache remote=\(key.remoteID.uuidString) error=\(error.localizedDescription)"
+            )
+        }
+    }
+
+    /// Beginner note: Keeps an endpoint's in-memory records within the same byte limit as its file,
+    /// dropping the least recently used listings first and every alias that pointed at one of them.
+    private static func evictToByteLimit(_ state: inout RemoteListings, byteLimit: Int) {
+        func aliasBytes(_ alias: String, _ target: String) -> Int {
+            frameHeaderSize + 5 + alias.utf8.count + target.utf8.count
+        }
+        var total = headerSize
+        total += state.records.values.reduce(0) { $0 + $1.frame.count }
+        total += state.aliases.reduce(0) { $0 + aliasBytes($1.key, $1.value) }
+        guard total > byteLimit else {
+            return
+        }
+
+        let leastRecentFirst = state.records.sorted {
+            ($0.value.lastAccess, $0.value.listedAt) < ($1.value.lastAccess, $1.value.listedAt)
+        }
+        for (path, record) in leastRecentFirst where total > byteLimit {
+            state.records[path] = nil
+            total -= record.frame.count
+            for (alias, target) in state.aliases where target == path {
+                state.aliases[alias] = nil
+                total -= aliasBytes(alias, target)
+            }
+        }
+        // Aliases alone never outgrow the limit by much, but keep the bound strict.
+        for (alias, target) in state.aliases.sorted(by: { $0.key < $1.key }) where total > byteLimit {
+            state.aliases[alias] = nil
+            total -= aliasBytes(alias, target)
+        }
+    }
+
+    /// Beginner note: Newest listings first until the byte limit; aliases only for kept listings.
+    private static func encodeFile(records: [String: Record], aliases: [String: String], byteLimit: Int) -> Data {
+        var body = Data()
+        var count: UInt32 = 0
+        var kept = Set<String>()
+        let newestFirst = records.sorted { $0.value.listedAt > $1.value.listedAt }
+        for (path, record) in newestFirst {
+            guard headerSize + body.count + record.frame.count <= byteLimit else {
+                continue
+            }
+            body.append(record.frame)
+            kept.insert(path)
+            count += 1
+        }
+        for (alias, target) in aliases.sorted(by: { $0.key < $1.key }) where kept.contains(target) {
+            let frame = encodeAlias(path: alias, target: target)
+            guard headerSize + body.count + frame.count <= byteLimit else {
+                break
+            }
+            body.append(frame)
+            count += 1
+        }
+
+        var data = Data(magic)
+        var writer = ByteWriter()
+        writer.u16(formatVersion)
+        writer.u16(0)
+        writer.u32(count)
+        data.append(contentsOf: writer.bytes)
+        data.append(body)
+        return data
+    }
+
+    /// Beginner note: Reads record headers only; stops at the first torn record and keeps everything before it.
+    private static func indexFile(_ data: Data) -> (records: [String: Record], aliases: [String: String], isDamaged: Bool) {
+        var records: [String: Record] = [:]
+        var aliases: [String: String] = [:]
+        let expected: Int? = data.withUnsafeBytes { raw -> Int? in
+            var reader = ByteReader(raw)
+            guard reader.bytes(magic.count).map({ [UInt8]($0) }) == magic,
+                  reader.u16() == formatVersion,
+                  reader.u16() != nil,
+                  let count = reader.u32() else {
+                return nil
+            }
+            return Int(count)
+        }
+        guard let expected else {
+            return ([:], [:], !data.isEmpty)
+        }
+
+        var offset = headerSize
+        var seen = 0
+        while seen < expected {
+            guard let frame = frameSlice(data, at: offset) else {
+                break
+            }
+            offset += frame.count
+            seen += 1
+            let header: (kind: UInt8, path: String, listedAt: Date?, target: String?)? = frame.withUnsafeBytes { raw in
+                var reader = ByteReader(raw)
+                _ = reader.bytes(frameHeaderSize)
+                guard let kind = reader.u8(), let path = reader.string16() else {
+                    return nil
+                }
+                if kind == kindListing, let millis = reader.i64() {
+                    return (kind, path, Date(timeIntervalSince1970: Double(millis) / 1000), nil)
+                }
+                if kind == kindAlias, let target = reader.string16() {
+                    return (kind, path, nil, target)
+                }
+                return nil
+            }
+            guard let header else {
+                continue
+            }
+            if let listedAt = header.listedAt {
+                records[header.path] = Record(listedAt: listedAt, frame: frame)
+            } else if let target = header.target {
+                // Alias frames are tiny, so they are checksummed eagerly.
+                if verify(frame: frame) {
+                    aliases[header.path] = target
+                }
+            }
+        }
+        return (records, aliases, seen < expected || offset != data.count)
+    }
+
+    /// Beginner note: Bounds-checked slice of one framed record, or nil when the file is truncated.
+    private static func frameSlice(_ data: Data, at offset: Int) -> Data? {
+        guard offset + frameHeaderSize <= data.count else {
+            return nil
+        }
+        let length = data.withUnsafeBytes { raw -> Int in
+            var reader = ByteReader(raw)
+            _ = reader.bytes(offset)
+            return Int(reader.u32() ?? UInt32.max)
+        }
+        let end = offset + frameHeaderSize + length
+        guard length <= data.count, end <= data.count else {
+            return nil
+        }
+        return data[(data.startIndex + offset)..<(data.startIndex + end)]
+    }
+
+    // MARK: - Record encoding
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    static func encodeListing(_ listing: BrowserCachedListing) -> Data {
+        var payload = ByteWriter()
+        payload.u8(kindListing)
+        payload.string16(listing.path)
+        payload.i64(Int64((listing.listedAt.timeIntervalSince1970 * 1000).rounded()))
+        if let validator = listing.validator {
+            payload.u8(validatorPresent | (validator.sizeBytes == nil ? 0 : validatorHasSize))
+            payload.i64(validator.modifiedAtUnix)
+            if let sizeBytes = validator.sizeBytes {
+                payload.i64(Int64(bitPattern: sizeBytes))
+            }
+            payload.i64(validator.capturedAtUnix)
+        } else {
+            payload.u8(0)
+        }
+        payload.u32(UInt32(clamping: listing.entries.count))
+        for entry in listing.entries {
+            var flags: UInt8 = entry.isDirectory ? flagDirectory : 0
+            let needsFullPath = entry.fullPath != impliedFullPath(base: listing.path, name: entry.name)
+            if needsFullPath { flags |= flagExplicitFullPath }
+            if entry.modifiedAt != nil { flags |= flagModified }
+            if entry.sizeBytes != nil { flags |= flagSize }
+            payload.u8(flags)
+            payload.string16(entry.name)
+            if needsFullPath {
+                payload.string16(entry.fullPath)
+            }
+            if let modifiedAt = entry.modifiedAt {
+                payload.i64(Int64((modifiedAt.timeIntervalSince1970 * 1000).rounded()))
+            }
+            if let sizeBytes = entry.sizeBytes {
+                payload.i64(sizeBytes)
+            }
+        }
+        return frame(payload: payload.bytes)
+    }
+
+    /// Beginner note: Decodes a listing frame; nil when the checksum or structure is wrong.
+    static func decodeListing(frame: Data) -> BrowserCachedListing? {
+        guard verify(frame: frame) else {
+            return nil
+        }
+        return frame.withUnsafeBytes { raw -> BrowserCachedListing? in
+            var reader = ByteReader(raw)
+            _ = reader.bytes(frameHeaderSize)
+            guard reader.u8() == kindListing,
+                  let path = reader.string16(),
+                  let millis = reader.i64(),
+                  let validatorFlags = reader.u8() else {
+                return nil
+            }
+            var validator: BrowserDirectoryValidator?
+            if validatorFlags & validatorPresent != 0 {
+                guard let modified = reader.i64() else {
+                    return nil
+                }
+                var sizeBytes: UInt64?
+                if validatorFlags & validatorHasSize != 0 {
+                    guard let value = reader.i64() else {
+                        return nil
+                    }
+                    sizeBytes = UInt64(bitPattern: value)
+                }
+                guard let captured = reader.i64() else {
+                    return nil
+                }
+                validator = BrowserDirectoryValidator(modifiedAtUnix: modified, sizeBytes: sizeBytes, capturedAtUnix: captured)
+            }
+            guard let count = reader.u32(),
+                  Int(count) <= reader.remaining else {
+                return nil
+            }
+            var entries: [RemoteDirectoryItem] = []
+            entries.reserveCapacity(Int(count))
+            for _ in 0..<count {
+                guard let flags = reader.u8(), let name = reader.string16() else {
+                    return nil
+                }
+                var fullPath = impliedFullPath(base: path, name: name)
+                if flags & flagExplicitFullPath != 0 {
+                    guard let explicit = reader.string16() else {
+                        return nil
+                    }
+                    fullPath = explicit
+                }
+                var modifiedAt: Date?
+                if flags & flagModified != 0 {
+                    guard let value = reader.i64() else {
+                        return nil
+                    }
+                    modifiedAt = Date(timeIntervalSince1970: Double(value) / 1000)
+                }
+                var sizeBytes: Int64?
+                if flags & flagSize != 0 {
+                    guard let value = reader.i64() else {
+                        return nil
+                    }
+                    sizeBytes = value
+                }
+                entries.append(
+                    RemoteDirectoryItem(
+                        name: name,
+                        fullPath: fullPath,
+                        isDirectory: flags & flagDirectory != 0,
+                        modifiedAt: modifiedAt,
+                        sizeBytes: sizeBytes
+                    )
+                )
+            }
+            return BrowserCachedListing(
+                path: path,
+                entries: entries,
+                listedAt: Date(timeIntervalSince1970: Double(millis) / 1000),
+                validator: validator
+            )
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func encodeAlias(path: String, target: String) -> Data {
+        var payload = ByteWriter()
+        payload.u8(kindAlias)
+        payload.string16(path)
+        payload.string16(target)
+        return frame(payload: payload.bytes)
+    }
+
+    /// Beginner note: Most listings store child names only; the full path is rebuilt from the parent.
+    private static func impliedFullPath(base: String, name: String) -> String {
+        base.hasSuffix("/") ? base + name : base + "/" + name
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func frame(payload: [UInt8]) -> Data {
+        var header = ByteWriter()
+        header.u32(UInt32(payload.count))
+        header.u32(checksum(payload[...]))
+        var data = Data(header.bytes)
+        data.append(contentsOf: payload)
+        return data
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func verify(frame: Data) -> Bool {
+        frame.withUnsafeBytes { raw -> Bool in
+            var reader = ByteReader(raw)
+            guard let length = reader.u32(), let stored = reader.u32(), Int(length) == reader.remaining,
+                  let payload = reader.bytes(Int(length)) else {
+                return false
+            }
+            return checksum(payload) == stored
+        }
+    }
+
+    /// Beginner note: FNV-1a; catches torn writes and bit rot, not tampering.
+    private static func checksum<Bytes: Collection>(_ bytes: Bytes) -> UInt32 where Bytes.Element == UInt8 {
+        var hash: UInt32 = 2_166_136_261
+        for byte in bytes {
+            hash ^= UInt32(byte)
+            hash = hash &* 16_777_619
+        }
+        return hash
+    }
+}
+
+/// Beginner note: Little-endian append-only encoder for the listing cache format.
+private struct ByteWriter {
+    var bytes: [UInt8] = []
+
+    mutating func u8(_ value: UInt8) {
+        bytes.append(value)
+    }
+
+    mutating func u16(_ value: UInt16) {
+        withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+    }
+
+    mutating func u32(_ value: UInt32) {
+        withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+    }
+
+    mutating func i64(_ value: Int64) {
+        withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+    }
+
+    /// Beginner note: Strings longer than 64 KiB of UTF-8 are truncated; decoding repairs a split character.
+    mutating func string16(_ value: String) {
+        let utf8 = value.utf8.prefix(Int(UInt16.max))
+        u16(UInt16(utf8.count))
+        bytes.append(contentsOf: utf8)
+    }
+}
+
+/// Beginner note: Bounds-checked little-endian decoder; every read returns nil instead of trapping.
+private struct ByteReader {
+    private let raw: UnsafeRawBufferPointer
+    private var offset = 0
+
+    init(_ raw: UnsafeRawBufferPointer) {
+        self.raw = raw
+    }
+
+    var remaining: Int {
+        raw.count - offset
+    }
+
+    mutating func bytes(_ count: Int) -> UnsafeRawBufferPointer? {
+        guard count >= 0, count <= remaining else {
+            return nil
+        }
+        defer { offset += count }
+        return UnsafeRawBufferPointer(rebasing: raw[offset..<(offset + count)])
+    }
+
+    mutating func u8() -> UInt8? {
+        bytes(1).map { $0[0] }
+    }
+
+    mutating func u16() -> UInt16? {
+        bytes(2).map { UInt16(littleEndian: $0.loadUnaligned(as: UInt16.self)) }
+    }
+
+    mutating func u32() -> UInt32? {
+        bytes(4).map { UInt32(littleEndian: $0.loadUnaligned(as: UInt32.self)) }
+    }
+
+    mutating func i64() -> Int64? {
+        bytes(8).map { Int64(littleEndian: $0.loadUnaligned(as: Int64.self)) }
+    }
+
+    mutating func string16() -> String? {
+        guard let length = u16(), let utf8 = bytes(Int(length)) else {
+            return nil
+        }
+        return String(decoding: utf8, as: UTF8.self)
+    }
+}
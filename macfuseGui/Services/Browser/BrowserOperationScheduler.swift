@@ -0,0 +1,221 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file orders queued native browser operations for each remote by priority class.
+// Called by: Called by LibSSH2SFTPTransport instead of submitting straight to a remote's executor.
+// Calls into: Calls into BrowserRemoteExecutorPool and Dispatch only.
+// Concurrency: Pending work is guarded by a lock; at most one operation per remote is on its executor at a time.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: Why a browser operation is running; lower raw values run first.
+/// Callers set the class with BrowserOperationPriority.$current.withValue(...) around a transport
+/// call; anything not tagged counts as interactive, which is what a user click is.
+enum BrowserOperationPriority: Int, CaseIterable, Comparable, Sendable {
+    case interactive
+    case recovery
+    case keepalive
+    case background
+
+    @TaskLocal static var current: BrowserOperationPriority = .interactive
+
+    var label: String {
+        switch self {
+        case .interactive:
+            return "interactive"
+        case .recovery:
+            return "recovery"
+        case .keepalive:
+            return "keepalive"
+        case .background:
+            return "background"
+        }
+    }
+
+    static func < (lhs: BrowserOperationPriority, rhs: BrowserOperationPriority) -> Bool {
+        lhs.rawValue < rhs.rawValue
+    }
+}
+
+/// Beginner note: Per-remote priority queues in front of BrowserRemoteExecutorPool.
+/// Each remote's serial executor is fed one operation at a time, so work that is still queued can
+/// be reordered: a click submitted behind a keepalive ping runs before it. A running operation is
+/// never interrupted (the native call owns the session until it returns or is cancelled).
+/// Starvation protection: once the oldest operation of a class has waited longer than that
+/// class's limit it is treated as aged, and aged operations run oldest-first ahead of newer work.
+// @unchecked Sendable is safe here because all mutable state is accessed under lock.
+final class BrowserOperationScheduler: @unchecked Sendable {
+    /// Beginner note: Counters for one priority class, summed over all remotes.
+    struct ClassMetrics: Equatable, Sendable {
+        var queued = 0
+        var maxQueued = 0
+        var dispatched = 0
+        // Operations that ran ahead of higher-priority work because they had aged.
+        var promoted = 0
+        var totalWaitMicros: Int64 = 0
+        var maxWaitMicros: Int64 = 0
+
+        var averageWaitMicros: Int64 {
+            dispatched == 0 ? 0 : totalWaitMicros / Int64(dispatched)
+        }
+    }
+
+    // Defaults keep interactive work first while bounding how long background work can be deferred.
+    static let defaultStarvationLimits: [BrowserOperationPriority: TimeInterval] = [
+        .recovery: 1,
+        .keepalive: 2,
+        .background: 4
+    ]
+
+    /// Beginner note: This type groups related state and behavior for one part of the app.
+    private struct PendingOperation {
+        let enqueuedAt: UInt64
+        let work: () -> Void
+    }
+
+    /// Beginner note: Queues for one remote, indexed by priority raw value.
+    private struct RemoteQueues {
+        var pending: [[PendingOperation]] = Array(repeating: [], count: BrowserOperationPriority.allCases.count)
+        var running = false
+    }
+
+    let executors: BrowserRemoteExecutorPool
+    private let starvationLimitNanos: [UInt64?]
+    private let lock = NSLock()
+    private var remotes: [UUID: RemoteQueues] = [:]
+    private var classMetrics = Array(repeating: ClassMetrics(), count: BrowserOperationPriority.allCases.count)
+
+    /// Beginner note: Classes missing from starvationLimits are never promoted.
+    init(
+        executors: BrowserRemoteExecutorPool,
+        starvationLimits: [BrowserOperationPriority: TimeInterval] = BrowserOperationScheduler.defaultStarvationLimits
+    ) {
+        self.executors = executors
+        self.starvationLimitNanos = BrowserOperationPriority.allCases.map { priority in
+            starvationLimits[priority].map { UInt64(max(0, $0) * 1_000_000_000) }
+        }
+    }
+
+    /// Beginner note: Queues work for a remote; it runs on that remote's executor when its turn comes.
+    func enqueue(remoteID: UUID, priority: BrowserOperationPriority, _ work: @escaping () -> Void) {
+        lock.lock()
+        var queues = remotes[remoteID] ?? RemoteQueues()
+        queues.pending[priority.rawValue].append(PendingOperation(enqueuedAt: DispatchTime.now().uptimeNanoseconds, work: work))
+        classMetrics[priority.rawValue].queued += 1
+        classMetrics[priority.rawValue].maxQueued = max(
+            classMetrics[priority.rawValue].maxQueued,
+            classMetrics[priority.rawValue].queued
+        )
+        let shouldStart = !queues.running
+        queues.running = true
+        remotes[remoteID] = queues
+        lock.unlock()
+
+        if shouldStart {
+            dispatchNext(remoteID: remoteID)
+        }
+    }
+
+    /// Beginner note: Async wrapper: queues blocking work and resumes the caller with its result.
+    /// This is async and throwing: callers must await it and handle failures.
+    func run<T: Sendable>(
+        remoteID: UUID,
+        priority: BrowserOperationPriority = BrowserOperationPriority.current,
+        _ body: @escaping () throws -> T
+    ) async throws -> T {
+        try await withCheckedThrowingContinuation { continuation in
+            enqueue(remoteID: remoteID, priority: priority) {
+                do {
+                    continuation.resume(returning: try body())
+                } catch {
+                    continuation.resume(throwing: error)
+                }
+            }
+        }
+    }
+
+    /// Beginner note: Snapshot of per-class counters, for diagnostics and tests.
+    func metrics() -> [BrowserOperationPriority: ClassMetrics] {
+        lock.lock()
+        defer { lock.unlock() }
+        var snapshot: [BrowserOperationPriority: ClassMetrics] = [:]
+        for priority in BrowserOperationPriority.allCases {
+            snapshot[priority] = classMetrics[priority.rawValue]
+        }
+        return snapshot
+    }
+
+    /// Beginner note: One diagnostics line with queue depth and wait times per class.
+    func summaryLine() -> String {
+        let snapshot = metrics()
+        let parts = BrowserOperationPriority.allCases.map { priority -> String in
+            let metrics = snapshot[priority] ?? ClassMetrics()
+            return "\(priority.label)=q\(metrics.queued)/max\(metrics.maxQueued)/n\(metrics.dispatched)/avgWait\(Self.millis(metrics.averageWaitMicros))/maxWait\(Self.millis(metrics.maxWaitMicros))/promoted\(metrics.promoted)"
+        }
+        return "- browser-scheduler " + parts.joined(separator: " ")
+    }
+
+    /// Beginner note: Remote IDs with queued or running work; idle remotes are not kept.
+    func activeRemoteIDs() -> [UUID] {
+        lock.lock()
+        defer { lock.unlock() }
+        return Array(remotes.keys)
+    }
+
+    /// Beginner note: Hands the next operation to the remote's executor, or drops the idle remote.
+    /// Runs again from the executor after each operation, so only one is ever submitted at a time.
+    private func dispatchNext(remoteID: UUID) {
+        lock.lock()
+        var queues = remotes[remoteID] ?? RemoteQueues()
+        let next = takeNext(from: &queues)
+        queues.running = next != nil
+        // Nothing queued and nothing running: forget the remote so closed remotes do not pile up.
+        remotes[remoteID] = next == nil ? nil : queues
+        lock.unlock()
+        guard let next else {
+            return
+        }
+
+        executors.async(remoteID: remoteID) { [self] in
+            next()
+            dispatchNext(remoteID: remoteID)
+        }
+    }
+
+    /// Beginner note: Picks the oldest aged operation if any, else the head of the highest class.
+    /// Must be called with lock held.
+    private func takeNext(from queues: inout RemoteQueues) -> (() -> Void)? {
+        let now = DispatchTime.now().uptimeNanoseconds
+        var chosen: Int?
+        for index in queues.pending.indices {
+            guard let head = queues.pending[index].first, let limit = starvationLimitNanos[index],
+                  now &- head.enqueuedAt >= limit else {
+                continue
+            }
+            if let current = chosen, queues.pending[current][0].enqueuedAt <= head.enqueuedAt {
+                continue
+            }
+            chosen = index
+        }
+        let highest = queues.pending.firstIndex { !$0.isEmpty }
+        if let aged = chosen, let highest, highest < aged {
+            classMetrics[aged].promoted += 1
+        }
+        guard let index = chosen ?? highest else {
+            return nil
+        }
+
+        let operation = queues.pending[index].removeFirst()
+        let waitMicros = Int64((now &- operation.enqueuedAt) / 1_000)
+        classMetrics[index].queued -= 1
+        classMetrics[index].dispatched += 1
+        classMetrics[index].totalWaitMicros += waitMicros
+        classMetrics[index].maxWaitMicros = max(classMetrics[index].maxWaitMicros, waitMicros)
+        return operation.work
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func millis(_ micros: Int64) -> String {
+        String(format: "%.1fms", Double(micros) / 1_000)
+    }
+}
@@ -0,0 +1,93 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file defines the limits, counters, and candidate ranking for background subdirectory prefetch.
+// Called by: LibSSH2SessionActor (policy and stats) and RemoteBrowserViewModel (candidate ranking).
+// Calls into: Pure Swift values and BrowserPathNormalizer only.
+// Concurrency: Value types with no shared state; safe to pass across actors.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: Limits for speculative listings of likely-next folders.
+/// Prefetch only runs while no user listing is active, and every limit here caps how much
+/// background traffic one session can generate.
+struct BrowserPrefetchPolicy: Sendable, Equatable {
+    // Folders listed per round (one round per settled navigation); 0 disables prefetch.
+    var pathLimit = 4
+    // Listings allowed per budget window across all rounds.
+    var operationBudget = 24
+    var budgetWindow: TimeInterval = 60
+    // Stop a round once this many rows were listed, so one huge folder cannot flood the link.
+    var entryBudget = 4_000
+    // Quiet period after a navigation before the first background listing starts.
+    var idleDelayNanoseconds: UInt64 = 300_000_000
+    // A prefetched listing is served without a round trip only while it is this fresh.
+    var freshness: TimeInterval = 15
+}
+
+/// Beginner note: Cumulative prefetch counters; hit rate is hits over completed prefetches.
+struct BrowserPrefetchStats: Sendable, Equatable {
+    var scheduled = 0
+    var completed = 0
+    var hits = 0
+    var expired = 0
+    var cancelled = 0
+    var failed = 0
+    var budgetExhausted = 0
+
+    var hitRate: Double {
+        completed == 0 ? 0 : Double(hits) / Double(completed)
+    }
+
+    var summary: String {
+        "\(hits)/\(completed)(\(Int((hitRate * 100).rounded()))%) expired=\(expired) cancelled=\(cancelled) budget=\(budgetExhausted)"
+    }
+}
+
+/// Beginner note: Picks which child folders of the current listing to prefetch.
+enum BrowserPrefetchPlanner {
+    /// Beginner note: Children that are (or lead to) a recent come first in recents order, then
+    /// favorites in favorites order, then the rest in the order the user sees them.
+    static func candidates(
+        children: [RemoteDirectoryItem],
+        recents: [String],
+        favorites: [String],
+        limit: Int
+    ) -> [String] {
+        guard limit > 0 else {
+            return []
+        }
+        let childPaths = children
+            .filter(\.isDirectory)
+            .map { BrowserPathNormalizer.normalize(path: $0.fullPath) }
+        var ordered: [String] = []
+        var seen = Set<String>()
+
+        for remembered in recents + favorites {
+            let target = BrowserPathNormalizer.normalize(path: remembered)
+            guard let child = childPaths.first(where: { leads(from: $0, to: target) }), seen.insert(child).inserted else {
+                continue
+            }
+            ordered.append(child)
+            if ordered.count == limit {
+                return ordered
+            }
+        }
+        for child in childPaths where seen.insert(child).inserted {
+            ordered.append(child)
+            if ordered.count == limit {
+                break
+            }
+        }
+        return ordered
+    }
+
+    /// Beginner note: True when target is the child itself or somewhere below it.
+    private static func leads(from child: String, to target: String) -> Bool {
+        if child.caseInsensitiveCompare(target) == .orderedSame {
+            return true
+        }
+        let prefix = child.hasSuffix("/") ? child : child + "/"
+        return target.lowercased().hasPrefix(prefix.lowercased())
+    }
+}
@@ -0,0 +1,138 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file tracks smoothed round-trip time per browser session and derives list/ping timeouts from it.
+// Called by: LibSSH2SFTPTransport, which feeds it measured round trips and asks it for per-call budgets.
+// Calls into: Pure Swift values only.
+// Concurrency: Value types with no shared state; the transport keeps one per remote under its lock.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: Floors, ceilings and multipliers that turn an RTT estimate into timeouts.
+/// The RTO only sizes waits for a single response: the keepalive exchange, and the gap a
+/// listing may go without any reply from the server. A whole listing is many dependent round
+/// trips plus server filesystem time, so it starts with a fixed budget and the bridge extends
+/// it on every received batch; a large directory never has to fit in an RTT multiple.
+struct BrowserAdaptiveTimeoutPolicy: Sendable, Equatable {
+    // Used until the first round trip was measured.
+    var initialListTimeoutMs: Int32 = 8_000
+    var initialPingTimeoutMs: Int32 = 2_000
+    var listRTOMultiplier = 8.0
+    var pingRTOMultiplier = 3.0
+    // Bounds for the listing inactivity budget (longest wait for the next server response).
+    var listFloorMs: Int32 = 1_500
+    var listCeilingMs: Int32 = 30_000
+    // Whole-listing budget from the start, before any progress extends it.
+    var listBudgetFloorMs: Int32 = 8_000
+    var pingFloorMs: Int32 = 500
+    var pingCeilingMs: Int32 = 10_000
+    // Lower bound for the variance term (RFC 6298 "G"), so a perfectly steady LAN still gets slack.
+    var minimumVarianceMicros = 10_000.0
+    // Timeouts double after each failure up to this factor, then reset on the next good sample.
+    var maximumBackoff = 4.0
+}
+
+/// Beginner note: RFC 6298 style estimator: SRTT and RTTVAR are exponentially weighted moving
+/// averages of measured round trips, and RTO = SRTT + max(G, 4 * RTTVAR).
+struct BrowserRTTEstimator: Sendable, Equatable {
+    private static let alpha = 1.0 / 8.0
+    private static let beta = 1.0 / 4.0
+
+    private(set) var smoothedMicros: Double?
+    private(set) var varianceMicros = 0.0
+    private(set) var sampleCount = 0
+    private(set) var backoff = 1.0
+
+    /// Beginner note: Folds one measured round trip into the averages and clears any backoff.
+    mutating func record(sampleMicros: Int64) {
+        let sample = Double(max(1, sampleMicros))
+        if let smoothed = smoothedMicros {
+            varianceMicros = (1 - Self.beta) * varianceMicros + Self.beta * abs(smoothed - sample)
+            smoothedMicros = (1 - Self.alpha) * smoothed + Self.alpha * sample
+        } else {
+            smoothedMicros = sample
+            varianceMicros = sample / 2
+        }
+        sampleCount += 1
+        backoff = 1
+    }
+
+    /// Beginner note: A call failed or timed out: widen later budgets until a sample arrives.
+    mutating func backOff(policy: BrowserAdaptiveTimeoutPolicy) {
+        backoff = min(policy.maximumBackoff, backoff * 2)
+    }
+
+    /// Beginner note: Retransmission-timeout analogue in microseconds; nil before the first sample.
+    func retransmissionTimeoutMicros(policy: BrowserAdaptiveTimeoutPolicy) -> Double? {
+        smoothedMicros.map { $0 + max(policy.minimumVarianceMicros, 4 * varianceMicros) }
+    }
+
+    /// Beginner note: Longest a listing may wait for its next server response, in milliseconds.
+    /// The bridge extends the listing's deadline by this much after every batch it receives.
+    func listProgressTimeoutMs(policy: BrowserAdaptiveTimeoutPolicy) -> Int32 {
+        timeoutMs(
+            multiplier: policy.listRTOMultiplier,
+            initial: policy.initialListTimeoutMs,
+            floor: policy.listFloorMs,
+            ceiling: policy.listCeilingMs,
+            policy: policy
+        )
+    }
+
+    /// Beginner note: Whole-listing budget from the start, in milliseconds. Covers the first
+    /// responses (realpath, opendir, slow server filesystems) before progress extends it.
+    func listBudgetMs(policy: BrowserAdaptiveTimeoutPolicy) -> Int32 {
+        max(policy.listBudgetFloorMs, listProgressTimeoutMs(policy: policy))
+    }
+
+    /// Beginner note: Budget for one keepalive probe, in milliseconds.
+    func pingTimeoutMs(policy: BrowserAdaptiveTimeoutPolicy) -> Int32 {
+        timeoutMs(
+            multiplier: policy.pingRTOMultiplier,
+            initial: policy.initialPingTimeoutMs,
+            floor: policy.pingFloorMs,
+            ceiling: policy.pingCeilingMs,
+            policy: policy
+        )
+    }
+
+    /// Beginner note: Compact "srtt/rttvar list/idle/ping" text for the session summary line.
+    func summary(policy: BrowserAdaptiveTimeoutPolicy) -> String {
+        let rtt = smoothedMicros.map { String(format: "%.1f±%.1fms", $0 / 1_000, varianceMicros / 1_000) } ?? "-"
+        var text = "rtt=\(rtt)/n\(sampleCount) list=\(listBudgetMs(policy: policy))ms idle=\(listProgressTimeoutMs(policy: policy))ms ping=\(pingTimeoutMs(policy: policy))ms"
+        if backoff > 1 {
+            text += " backoff=x\(Int(backoff))"
+        }
+        return text
+    }
+
+    /// Beginner note: One round-trip sample from a listing's stage breakdown.
+    /// realpath, stat and opendir are single small request/response exchanges, so their time per
+    /// socket wait approximates the network RTT; readdir carries bulk data and is left out.
+    static func sampleMicros(from timing: BrowserStageTiming) -> Int64? {
+        let stages: [(Int64, Int)] = [
+            (timing.realpathCached ? 0 : timing.realpathMicros, timing.realpathRoundTrips),
+            (timing.statMicros, timing.statRoundTrips),
+            (timing.opendirMicros, timing.opendirRoundTrips)
+        ]
+        return stages
+            .filter { $0.0 > 0 && $0.1 > 0 }
+            .map { $0.0 / Int64($0.1) }
+            .min()
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func timeoutMs(
+        multiplier: Double,
+        initial: Int32,
+        floor: Int32,
+        ceiling: Int32,
+        policy: BrowserAdaptiveTimeoutPolicy
+    ) -> Int32 {
+        guard let rto = retransmissionTimeoutMicros(policy: policy) else {
+            return Int32(min(Double(max(initial, ceiling)), Double(initial) * backoff))
+        }
+        let derived = rto * multiplier * backoff / 1_000
+        return Int32(min(Double(ceiling), max(Double(floor), derived.rounded(.up))))
+    }
+}
@@ -0,0 +1,117 @@
+// BEGINNER FILE GUIDE
+// Layer: Browser service layer
+// Purpose: This file gives each remote its own serial executor so one slow host cannot stall browsing on the others.
+// Called by: Called by LibSSH2SFTPTransport before touching a remote's native session handle.
+// Calls into: Calls into Dispatch only.
+// Concurrency: Work for one remote is serialized on that remote's queue; different remotes run in parallel.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: Keyed pool of serial DispatchQueues, one per remote ID.
+/// A native libssh2 handle must only be touched on the queue for its remote,
+/// which keeps each C handle thread-confined while different remotes run in parallel.
+/// A remote's queue is dropped once no submitted work is pending on it and made again on next use;
+/// since work only reaches a queue through async/sync/run, at most one queue per remote ever has work.
+// @unchecked Sendable is safe here because the queue map is only accessed under lock.
+final class BrowserRemoteExecutorPool: @unchecked Sendable {
+    /// Beginner note: A remote's queue plus how many submitted jobs have not finished on it yet.
+    private struct Executor {
+        let queue: DispatchQueue
+        var pending = 0
+    }
+
+    private let lock = NSLock()
+    private let labelPrefix: String
+    private let qos: DispatchQoS
+    // Shared concurrent target: GCD still caps worker threads, but per-remote queues never wait on each other.
+    private let targetQueue: DispatchQueue
+    private let specificKey = DispatchSpecificKey<UUID>()
+    private var executors: [UUID: Executor] = [:]
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(labelPrefix: String, qos: DispatchQoS = .userInitiated) {
+        self.labelPrefix = labelPrefix
+        self.qos = qos
+        self.targetQueue = DispatchQueue(label: "\(labelPrefix).pool", qos: qos, attributes: .concurrent)
+    }
+
+    /// Beginner note: Remote IDs that currently own a queue, i.e. have work queued or running.
+    func remoteIDs() -> [UUID] {
+        lock.lock()
+        defer { lock.unlock() }
+        return Array(executors.keys)
+    }
+
+    /// Beginner note: Remote ID of the executor running the current code, or nil off-pool.
+    func currentRemoteID() -> UUID? {
+        DispatchQueue.getSpecific(key: specificKey)
+    }
+
+    /// Beginner note: Crashes in debug builds when called off the remote's executor.
+    func assertOnExecutor(for remoteID: UUID) {
+        assert(currentRemoteID() == remoteID, "Expected to run on the executor for remote \(remoteID.uuidString).")
+    }
+
+    /// Beginner note: Submits work to the remote's executor without waiting for it.
+    func async(remoteID: UUID, _ work: @escaping () -> Void) {
+        let queue = retainQueue(for: remoteID)
+        queue.async { [self] in
+            work()
+            releaseQueue(for: remoteID)
+        }
+    }
+
+    /// Beginner note: Runs work on the remote's executor and waits for it. Must not be called from
+    /// that same executor, which would deadlock.
+    func sync<T>(remoteID: UUID, _ work: () throws -> T) rethrows -> T {
+        let queue = retainQueue(for: remoteID)
+        defer { releaseQueue(for: remoteID) }
+        return try queue.sync(execute: work)
+    }
+
+    /// Beginner note: Runs blocking work on the remote's executor and resumes the caller with its result.
+    /// This is async and throwing: callers must await it and handle failures.
+    func run<T: Sendable>(remoteID: UUID, _ body: @escaping () throws -> T) async throws -> T {
+        try await withCheckedThrowingContinuation { continuation in
+            async(remoteID: remoteID) {
+                do {
+                    continuation.resume(returning: try body())
+                } catch {
+                    continuation.resume(throwing: error)
+                }
+            }
+        }
+    }
+
+    /// Beginner note: Returns the remote's serial queue, creating it if needed, and counts one pending job.
+    private func retainQueue(for remoteID: UUID) -> DispatchQueue {
+        lock.lock()
+        defer { lock.unlock() }
+        if var existing = executors[remoteID] {
+            existing.pending += 1
+            executors[remoteID] = existing
+            return existing.queue
+        }
+
+        let queue = DispatchQueue(
+            label: "\(labelPrefix).\(remoteID.uuidString)",
+            qos: qos,
+            target: targetQueue
+        )
+        queue.setSpecific(key: specificKey, value: remoteID)
+        executors[remoteID] = Executor(queue: queue, pending: 1)
+        return queue
+    }
+
+    /// Beginner note: Counts one job as finished and drops the queue when nothing else is pending.
+    private func releaseQueue(for remoteID: UUID) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard var executor = executors[remoteID] else {
+            return
+        }
+        executor.pending -= 1
+        executors[remoteID] = executor.pending > 0 ? executor : nil
+    }
+}
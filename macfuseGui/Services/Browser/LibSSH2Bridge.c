@@ -19,19 +19,30 @@
 #include <libssh2.h>
 #include <libssh2_sftp.h>
 #include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
-#include <sys/select.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <time.h>
 #include <unistd.h>
 
+#if defined(__APPLE__) || defined(__FreeBSD__)
+#define MACFUSEGUI_REACTOR_HAS_KQUEUE 1
+#include <sys/event.h>
+#elif defined(__linux__)
+#define MACFUSEGUI_REACTOR_HAS_EPOLL 1
+#include <sys/epoll.h>
+#endif
+
 static pthread_once_t g_libssh2_once = PTHREAD_ONCE_INIT;
 
 /* libssh2 global initialization should happen exactly once per process. */
@@ -74,12 +85,28 @@ static int64_t macfusegui_now_millis(void) {
     return ((int64_t)ts.tv_sec * 1000LL) + ((int64_t)ts.tv_nsec / 1000000LL);
 }
 
+static int64_t macfusegui_now_micros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((int64_t)ts.tv_sec * 1000000LL) + ((int64_t)ts.tv_nsec / 1000LL);
+}
+
+/* Socket waits on this thread; stages diff it to report round trips without threading a counter through every helper. */
+static _Thread_local int32_t g_socket_wait_count = 0;
+
 static void macfusegui_zero_list_result(macfusegui_libssh2_list_result *result) {
     memset(result, 0, sizeof(*result));
     result->status_code = -1;
     result->latency_ms = 0;
 }
 
+static void macfusegui_zero_flat_list_result(macfusegui_libssh2_flat_list_result *result) {
+    memset(result, 0, sizeof(*result));
+    result->status_code = -1;
+    result->latency_ms = 0;
+    result->first_entry_latency_ms = -1;
+}
+
 static char *macfusegui_strdup_len(const char *value, size_t len) {
     if (value == NULL) {
         return NULL;
@@ -144,20 +171,34 @@ static void macfusegui_set_error(macfusegui_libssh2_list_result *result, int32_t
     result->error_message = macfusegui_strdup(message != NULL ? message : "Unknown libssh2 error.");
 }
 
-static void macfusegui_set_session_error(
-    macfusegui_libssh2_list_result *result,
+static void macfusegui_set_flat_error(macfusegui_libssh2_flat_list_result *result, int32_t status_code, const char *message) {
+    if (result == NULL) {
+        return;
+    }
+
+    result->status_code = status_code;
+    if (result->error_message != NULL) {
+        free(result->error_message);
+        result->error_message = NULL;
+    }
+
+    result->error_message = macfusegui_strdup(message != NULL ? message : "Unknown libssh2 error.");
+}
+
+static void macfusegui_set_flat_session_error(
+    macfusegui_libssh2_flat_list_result *result,
     LIBSSH2_SESSION *session,
     int32_t fallback_status,
     const char *fallback_message
 ) {
     char *message = macfusegui_build_session_error_string(session, fallback_message);
     if (message != NULL) {
-        macfusegui_set_error(result, fallback_status, message);
+        macfusegui_set_flat_error(result, fallback_status, message);
         free(message);
         return;
     }
 
-    macfusegui_set_error(result, fallback_status, fallback_message);
+    macfusegui_set_flat_error(result, fallback_status, fallback_message);
 }
 
 static char *macfusegui_session_error_message(LIBSSH2_SESSION *session, const char *fallback_message) {
@@ -249,12 +290,64 @@ static void macfusegui_set_out_session_error(char **out_error_message, LIBSSH2_S
 }
 
 #define MACFUSEGUI_BRIDGE_WAIT_TIMEOUT (-900001)
+#define MACFUSEGUI_BRIDGE_WAIT_CANCELLED (-900002)
 #define MACFUSEGUI_CONNECT_ERROR_SOCKET_TIMEOUT_CONFIG (-900101)
 
 static int64_t macfusegui_deadline_from_timeout_seconds(int32_t timeout_seconds) {
     return macfusegui_now_millis() + ((int64_t)timeout_seconds * 1000LL);
 }
 
+static int64_t macfusegui_deadline_from_timeout_ms(int32_t timeout_ms) {
+    return macfusegui_now_millis() + (int64_t)timeout_ms;
+}
+
+static int32_t macfusegui_timeout_ms_from_seconds(int32_t timeout_seconds) {
+    if (timeout_seconds <= 0) {
+        return 0;
+    }
+    return timeout_seconds > INT32_MAX / 1000 ? INT32_MAX : timeout_seconds * 1000;
+}
+
+/* Per-call budget for session calls: the handle's millisecond override when set, else timeout_seconds. */
+static int32_t macfusegui_session_timeout_ms(const macfusegui_libssh2_session_handle *session_handle, int32_t timeout_seconds) {
+    if (session_handle != NULL && session_handle->timeout_ms > 0) {
+        return session_handle->timeout_ms;
+    }
+    return macfusegui_timeout_ms_from_seconds(timeout_seconds);
+}
+
+void macfusegui_libssh2_list_deadline_start(
+    macfusegui_libssh2_list_deadline *deadline,
+    int64_t now_ms,
+    int32_t budget_ms,
+    int32_t progress_timeout_ms
+) {
+    if (deadline == NULL) {
+        return;
+    }
+    deadline->deadline_ms = now_ms + (int64_t)budget_ms;
+    deadline->progress_timeout_ms = progress_timeout_ms > 0 ? progress_timeout_ms : 0;
+}
+
+int64_t macfusegui_libssh2_list_deadline_progress(macfusegui_libssh2_list_deadline *deadline, int64_t now_ms) {
+    if (deadline == NULL) {
+        return 0;
+    }
+    if (deadline->progress_timeout_ms > 0) {
+        /* Never shortens: the whole-call budget still covers slow first responses. */
+        int64_t extended = now_ms + (int64_t)deadline->progress_timeout_ms;
+        if (extended > deadline->deadline_ms) {
+            deadline->deadline_ms = extended;
+        }
+    }
+    return deadline->deadline_ms;
+}
+
+/* Progress budget for list calls; 0 when the caller did not set one. */
+static int32_t macfusegui_session_progress_timeout_ms(const macfusegui_libssh2_session_handle *session_handle) {
+    return session_handle != NULL && session_handle->progress_timeout_ms > 0 ? session_handle->progress_timeout_ms : 0;
+}
+
 static int32_t macfusegui_remaining_timeout_ms(int64_t deadline_ms) {
     int64_t remaining = deadline_ms - macfusegui_now_millis();
     if (remaining <= 0) {
@@ -266,709 +359,2973 @@ static int32_t macfusegui_remaining_timeout_ms(int64_t deadline_ms) {
     return (int32_t)remaining;
 }
 
-static void macfusegui_format_timeout_message(char *buffer, size_t buffer_size, const char *stage, int32_t timeout_seconds) {
+static void macfusegui_format_timeout_message(char *buffer, size_t buffer_size, const char *stage, int32_t timeout_ms) {
     if (buffer == NULL || buffer_size == 0) {
         return;
     }
 
     const char *effective_stage = (stage != NULL && stage[0] != '\0') ? stage : "libssh2 operation";
-    snprintf(buffer, buffer_size, "Timed out during %s after %d second(s).", effective_stage, (int)timeout_seconds);
+    if (timeout_ms % 1000 == 0) {
+        snprintf(buffer, buffer_size, "Timed out during %s after %d second(s).", effective_stage, (int)(timeout_ms / 1000));
+    } else {
+        snprintf(buffer, buffer_size, "Timed out during %s after %d ms.", effective_stage, (int)timeout_ms);
+    }
 }
 
-static void macfusegui_set_out_timeout_error(char **out_error_message, const char *stage, int32_t timeout_seconds) {
+static void macfusegui_set_out_timeout_error(char **out_error_message, const char *stage, int32_t timeout_ms) {
     char message[256];
-    macfusegui_format_timeout_message(message, sizeof(message), stage, timeout_seconds);
+    macfusegui_format_timeout_message(message, sizeof(message), stage, timeout_ms);
     macfusegui_set_out_error(out_error_message, message);
 }
 
-static void macfusegui_set_result_timeout_error(
-    macfusegui_libssh2_list_result *result,
+static void macfusegui_set_flat_timeout_error(
+    macfusegui_libssh2_flat_list_result *result,
     int32_t status_code,
     const char *stage,
-    int32_t timeout_seconds
+    int32_t timeout_ms
 ) {
     char message[256];
-    macfusegui_format_timeout_message(message, sizeof(message), stage, timeout_seconds);
-    macfusegui_set_error(result, status_code, message);
+    macfusegui_format_timeout_message(message, sizeof(message), stage, timeout_ms);
+    macfusegui_set_flat_error(result, status_code, message);
 }
 
-static int macfusegui_set_socket_blocking(int fd, bool blocking) {
-    int flags = fcntl(fd, F_GETFL, 0);
-    if (flags < 0) {
-        return -1;
+/*
+ Readiness reactor.
+ All waits go through macfusegui_libssh2_wait_interest arrays so the same loop can drive one
+ socket (wait_socket/connect) or many sessions (reactor_wait). poll() is the portable backend;
+ kqueue/epoll keep registrations in a kernel object so repeated waits on the same sockets
+ do not rebuild the full interest set in the kernel each time.
+*/
+typedef enum macfusegui_reactor_kind {
+    MACFUSEGUI_REACTOR_POLL = 0,
+    MACFUSEGUI_REACTOR_KQUEUE,
+    MACFUSEGUI_REACTOR_EPOLL
+} macfusegui_reactor_kind;
+
+struct macfusegui_libssh2_reactor {
+    macfusegui_reactor_kind kind;
+    int backend_fd;
+};
+
+/* Small waits use stack storage; larger ones allocate once per call. */
+#define MACFUSEGUI_REACTOR_STACK_SLOTS 16
+
+static int16_t macfusegui_wait_events_from_directions(int directions) {
+    int16_t events = 0;
+    if (directions & LIBSSH2_SESSION_BLOCK_INBOUND) {
+        events |= MACFUSEGUI_LIBSSH2_WAIT_READ;
     }
-
-    if (blocking) {
-        flags &= ~O_NONBLOCK;
-    } else {
-        flags |= O_NONBLOCK;
+    if (directions & LIBSSH2_SESSION_BLOCK_OUTBOUND) {
+        events |= MACFUSEGUI_LIBSSH2_WAIT_WRITE;
     }
-
-    return fcntl(fd, F_SETFL, flags);
+    return events;
 }
 
-static int macfusegui_connect_with_timeout(int sock, const struct sockaddr *addr, socklen_t addrlen, int timeout_seconds) {
-    int connect_result = connect(sock, addr, addrlen);
-    if (connect_result == 0) {
-        return 0;
+static int macfusegui_count_ready(const macfusegui_libssh2_wait_interest *interests, int32_t interest_count) {
+    int ready_count = 0;
+    for (int32_t idx = 0; idx < interest_count; idx += 1) {
+        if (interests[idx].ready != 0) {
+            ready_count += 1;
+        }
     }
+    return ready_count;
+}
 
-    if (errno != EINPROGRESS) {
-        return -1;
+static void macfusegui_mark_ready(
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int fd,
+    int16_t ready
+) {
+    /* Linear scan: interest sets are a handful of sessions, not thousands. */
+    for (int32_t idx = 0; idx < interest_count; idx += 1) {
+        if (interests[idx].fd == fd) {
+            interests[idx].ready |= (int16_t)(ready & (interests[idx].events | MACFUSEGUI_LIBSSH2_WAIT_ERROR));
+        }
     }
+}
 
-    fd_set write_fds;
-    FD_ZERO(&write_fds);
-    FD_SET(sock, &write_fds);
+/* Returns ready count, 0 on deadline, -1 on error. */
+static int macfusegui_poll_wait(
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int64_t deadline_ms
+) {
+    struct pollfd stack_fds[MACFUSEGUI_REACTOR_STACK_SLOTS];
+    struct pollfd *fds = stack_fds;
+    if (interest_count > MACFUSEGUI_REACTOR_STACK_SLOTS) {
+        fds = (struct pollfd *)calloc((size_t)interest_count, sizeof(struct pollfd));
+        if (fds == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
+    }
 
-    int64_t deadline_ms = macfusegui_deadline_from_timeout_seconds(timeout_seconds);
-    int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
-    if (remaining_ms <= 0) {
-        errno = ETIMEDOUT;
-        return -1;
+    for (int32_t idx = 0; idx < interest_count; idx += 1) {
+        interests[idx].ready = 0;
+        fds[idx].fd = interests[idx].fd;
+        fds[idx].events = 0;
+        fds[idx].revents = 0;
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_READ) {
+            fds[idx].events |= POLLIN;
+        }
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_WRITE) {
+            fds[idx].events |= POLLOUT;
+        }
     }
 
-    struct timeval timeout_value;
-    timeout_value.tv_sec = (time_t)(remaining_ms / 1000);
-    timeout_value.tv_usec = (suseconds_t)((remaining_ms % 1000) * 1000);
+    int result = 0;
+    while (1) {
+        int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
+        if (remaining_ms <= 0) {
+            result = 0;
+            break;
+        }
 
-    int select_result = select(sock + 1, NULL, &write_fds, NULL, &timeout_value);
-    if (select_result <= 0) {
-        errno = (select_result == 0) ? ETIMEDOUT : errno;
-        return -1;
-    }
+        int poll_result = poll(fds, (nfds_t)interest_count, remaining_ms);
+        if (poll_result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (poll_result <= 0) {
+            result = poll_result;
+            break;
+        }
 
-    int socket_error = 0;
-    socklen_t socket_error_len = sizeof(socket_error);
-    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &socket_error, &socket_error_len) != 0) {
-        return -1;
+        for (int32_t idx = 0; idx < interest_count; idx += 1) {
+            short revents = fds[idx].revents;
+            int16_t ready = 0;
+            if (revents & POLLIN) {
+                ready |= MACFUSEGUI_LIBSSH2_WAIT_READ;
+            }
+            if (revents & POLLOUT) {
+                ready |= MACFUSEGUI_LIBSSH2_WAIT_WRITE;
+            }
+            ready &= interests[idx].events;
+            if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                /*
+                 poll() reports these even when they were not requested. Count them as ready so the
+                 caller's next libssh2 call surfaces the actual socket error instead of waiting out the deadline.
+                */
+                ready |= (int16_t)(interests[idx].events | MACFUSEGUI_LIBSSH2_WAIT_ERROR);
+            }
+            interests[idx].ready = ready;
+        }
+        result = macfusegui_count_ready(interests, interest_count);
+        break;
     }
 
-    if (socket_error != 0) {
-        errno = socket_error;
-        return -1;
+    if (fds != stack_fds) {
+        free(fds);
     }
-
-    return 0;
+    return result;
 }
 
-static int macfusegui_wait_socket(LIBSSH2_SESSION *session, int sock, int64_t deadline_ms) {
-    int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
-    if (remaining_ms <= 0) {
-        errno = ETIMEDOUT;
-        return MACFUSEGUI_BRIDGE_WAIT_TIMEOUT;
+#if defined(MACFUSEGUI_REACTOR_HAS_KQUEUE)
+static int macfusegui_kqueue_wait(
+    int kq,
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int64_t deadline_ms
+) {
+    int32_t slot_count = interest_count * 2;
+    struct kevent stack_changes[MACFUSEGUI_REACTOR_STACK_SLOTS * 2];
+    struct kevent stack_events[MACFUSEGUI_REACTOR_STACK_SLOTS * 2];
+    struct kevent *changes = stack_changes;
+    struct kevent *events = stack_events;
+    if (interest_count > MACFUSEGUI_REACTOR_STACK_SLOTS) {
+        changes = (struct kevent *)calloc((size_t)slot_count, sizeof(struct kevent));
+        events = (struct kevent *)calloc((size_t)slot_count, sizeof(struct kevent));
+        if (changes == NULL || events == NULL) {
+            free(changes);
+            free(events);
+            errno = ENOMEM;
+            return -1;
+        }
     }
 
-    /* Ask libssh2 whether it is blocked on read, write, or both. */
-    int directions = session != NULL ? libssh2_session_block_directions(session) : 0;
-    if (directions == 0) {
-        directions = LIBSSH2_SESSION_BLOCK_INBOUND | LIBSSH2_SESSION_BLOCK_OUTBOUND;
+    /* One-shot filters: registration and wait share one kevent() call, and nothing stays armed after firing. */
+    int change_count = 0;
+    for (int32_t idx = 0; idx < interest_count; idx += 1) {
+        interests[idx].ready = 0;
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_READ) {
+            EV_SET(&changes[change_count], (uintptr_t)interests[idx].fd, EVFILT_READ, EV_ADD | EV_ONESHOT, 0, 0, NULL);
+            change_count += 1;
+        }
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_WRITE) {
+            EV_SET(&changes[change_count], (uintptr_t)interests[idx].fd, EVFILT_WRITE, EV_ADD | EV_ONESHOT, 0, 0, NULL);
+            change_count += 1;
+        }
     }
 
-    fd_set read_fds;
-    fd_set write_fds;
-    FD_ZERO(&read_fds);
-    FD_ZERO(&write_fds);
+    int result = 0;
+    while (1) {
+        int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
+        if (remaining_ms <= 0) {
+            result = 0;
+            break;
+        }
 
-    if (directions & LIBSSH2_SESSION_BLOCK_INBOUND) {
-        FD_SET(sock, &read_fds);
-    }
-    if (directions & LIBSSH2_SESSION_BLOCK_OUTBOUND) {
-        FD_SET(sock, &write_fds);
-    }
+        struct timespec timeout_value;
+        timeout_value.tv_sec = (time_t)(remaining_ms / 1000);
+        timeout_value.tv_nsec = (long)(remaining_ms % 1000) * 1000000L;
 
-    struct timeval timeout_value;
-    timeout_value.tv_sec = (time_t)(remaining_ms / 1000);
-    timeout_value.tv_usec = (suseconds_t)((remaining_ms % 1000) * 1000);
+        int event_count = kevent(kq, changes, change_count, events, slot_count, &timeout_value);
+        if (event_count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (event_count <= 0) {
+            result = event_count;
+            break;
+        }
+        change_count = 0;
+
+        for (int idx = 0; idx < event_count; idx += 1) {
+            int16_t ready;
+            if (events[idx].flags & EV_ERROR) {
+                ready = MACFUSEGUI_LIBSSH2_WAIT_READ | MACFUSEGUI_LIBSSH2_WAIT_WRITE | MACFUSEGUI_LIBSSH2_WAIT_ERROR;
+            } else if (events[idx].filter == EVFILT_READ) {
+                ready = MACFUSEGUI_LIBSSH2_WAIT_READ;
+            } else {
+                ready = MACFUSEGUI_LIBSSH2_WAIT_WRITE;
+            }
+            if (events[idx].flags & EV_EOF) {
+                ready = MACFUSEGUI_LIBSSH2_WAIT_READ | MACFUSEGUI_LIBSSH2_WAIT_WRITE | MACFUSEGUI_LIBSSH2_WAIT_ERROR;
+            }
+            macfusegui_mark_ready(interests, interest_count, (int)events[idx].ident, ready);
+        }
 
-    int select_result = select(sock + 1, &read_fds, &write_fds, NULL, &timeout_value);
-    if (select_result == 0) {
-        errno = ETIMEDOUT;
-        return MACFUSEGUI_BRIDGE_WAIT_TIMEOUT;
+        result = macfusegui_count_ready(interests, interest_count);
+        if (result > 0) {
+            break;
+        }
+        /* Only leftovers from an earlier wait fired; keep waiting for this set. */
     }
-    if (select_result < 0) {
-        return -1;
+
+    if (changes != stack_changes) {
+        free(changes);
+        free(events);
     }
-    return 0;
+    return result;
 }
+#endif
 
-static int macfusegui_connect_socket(const char *host, int32_t port, int32_t timeout_seconds, bool *out_timeout_config_failure) {
-    if (out_timeout_config_failure != NULL) {
-        *out_timeout_config_failure = false;
+#if defined(MACFUSEGUI_REACTOR_HAS_EPOLL)
+static int macfusegui_epoll_wait(
+    int ep,
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int64_t deadline_ms
+) {
+    struct epoll_event stack_events[MACFUSEGUI_REACTOR_STACK_SLOTS];
+    struct epoll_event *events = stack_events;
+    if (interest_count > MACFUSEGUI_REACTOR_STACK_SLOTS) {
+        events = (struct epoll_event *)calloc((size_t)interest_count, sizeof(struct epoll_event));
+        if (events == NULL) {
+            errno = ENOMEM;
+            return -1;
+        }
     }
 
-    struct addrinfo hints;
-    memset(&hints, 0, sizeof(hints));
-    hints.ai_family = AF_UNSPEC;
-    hints.ai_socktype = SOCK_STREAM;
-    hints.ai_protocol = IPPROTO_TCP;
-
-    char port_buffer[16];
-    snprintf(port_buffer, sizeof(port_buffer), "%d", (int)port);
-
-    struct addrinfo *resolved = NULL;
-    int gai_result = getaddrinfo(host, port_buffer, &hints, &resolved);
-    if (gai_result != 0) {
-        return -1;
+    /* Registrations persist in the epoll set; ONESHOT disarms after firing so MOD re-arms it. */
+    for (int32_t idx = 0; idx < interest_count; idx += 1) {
+        interests[idx].ready = 0;
+        struct epoll_event change;
+        memset(&change, 0, sizeof(change));
+        change.events = EPOLLONESHOT;
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_READ) {
+            change.events |= EPOLLIN;
+        }
+        if (interests[idx].events & MACFUSEGUI_LIBSSH2_WAIT_WRITE) {
+            change.events |= EPOLLOUT;
+        }
+        change.data.fd = interests[idx].fd;
+        if (epoll_ctl(ep, EPOLL_CTL_MOD, interests[idx].fd, &change) != 0) {
+            if (errno != ENOENT || epoll_ctl(ep, EPOLL_CTL_ADD, interests[idx].fd, &change) != 0) {
+                /* Bad fd: report it ready so the caller hits the real error on its next call. */
+                interests[idx].ready = (int16_t)(interests[idx].events | MACFUSEGUI_LIBSSH2_WAIT_ERROR);
+            }
+        }
     }
 
-    int connected_socket = -1;
-    bool timeout_config_failure = false;
-
-    for (struct addrinfo *cursor = resolved; cursor != NULL; cursor = cursor->ai_next) {
-        int candidate = socket(cursor->ai_family, cursor->ai_socktype, cursor->ai_protocol);
-        if (candidate < 0) {
-            continue;
+    int result = macfusegui_count_ready(interests, interest_count);
+    while (result == 0) {
+        int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
+        if (remaining_ms <= 0) {
+            break;
         }
 
-        int one = 1;
-        (void)setsockopt(candidate, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
-
-        /* Keep socket non-blocking after connect; bridge wait loops depend on this mode. */
-        if (macfusegui_set_socket_blocking(candidate, false) != 0) {
-            close(candidate);
+        int event_count = epoll_wait(ep, events, interest_count, remaining_ms);
+        if (event_count < 0 && errno == EINTR) {
             continue;
         }
-
-        struct timeval tv;
-        tv.tv_sec = timeout_seconds;
-        tv.tv_usec = 0;
-        if (setsockopt(candidate, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) != 0 ||
-            setsockopt(candidate, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) != 0) {
-            timeout_config_failure = true;
-            close(candidate);
-            continue;
+        if (event_count <= 0) {
+            result = event_count;
+            break;
         }
 
-        if (macfusegui_connect_with_timeout(candidate, cursor->ai_addr, cursor->ai_addrlen, timeout_seconds) == 0) {
-            connected_socket = candidate;
-            break;
+        for (int idx = 0; idx < event_count; idx += 1) {
+            int16_t ready = 0;
+            if (events[idx].events & EPOLLIN) {
+                ready |= MACFUSEGUI_LIBSSH2_WAIT_READ;
+            }
+            if (events[idx].events & EPOLLOUT) {
+                ready |= MACFUSEGUI_LIBSSH2_WAIT_WRITE;
+            }
+            if (events[idx].events & (EPOLLERR | EPOLLHUP)) {
+                ready = MACFUSEGUI_LIBSSH2_WAIT_READ | MACFUSEGUI_LIBSSH2_WAIT_WRITE | MACFUSEGUI_LIBSSH2_WAIT_ERROR;
+            }
+            macfusegui_mark_ready(interests, interest_count, events[idx].data.fd, ready);
         }
+        result = macfusegui_count_ready(interests, interest_count);
+    }
 
-        close(candidate);
+    if (events != stack_events) {
+        free(events);
     }
+    return result;
+}
+#endif
 
-    freeaddrinfo(resolved);
-    if (connected_socket < 0 && timeout_config_failure) {
-        if (out_timeout_config_failure != NULL) {
-            *out_timeout_config_failure = true;
-        }
-        return MACFUSEGUI_CONNECT_ERROR_SOCKET_TIMEOUT_CONFIG;
+macfusegui_libssh2_reactor *macfusegui_libssh2_reactor_create(void) {
+    macfusegui_libssh2_reactor *reactor = (macfusegui_libssh2_reactor *)calloc(1, sizeof(*reactor));
+    if (reactor == NULL) {
+        return NULL;
     }
 
-    return connected_socket;
+    reactor->kind = MACFUSEGUI_REACTOR_POLL;
+    reactor->backend_fd = -1;
+#if defined(MACFUSEGUI_REACTOR_HAS_KQUEUE)
+    reactor->backend_fd = kqueue();
+    if (reactor->backend_fd >= 0) {
+        (void)fcntl(reactor->backend_fd, F_SETFD, FD_CLOEXEC);
+        reactor->kind = MACFUSEGUI_REACTOR_KQUEUE;
+    }
+#elif defined(MACFUSEGUI_REACTOR_HAS_EPOLL)
+    reactor->backend_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (reactor->backend_fd >= 0) {
+        reactor->kind = MACFUSEGUI_REACTOR_EPOLL;
+    }
+#endif
+    return reactor;
 }
 
-static int macfusegui_append_entry(
-    macfusegui_libssh2_list_result *result,
-    const char *name,
-    uint8_t is_directory,
-    uint8_t has_size,
-    uint64_t size_bytes,
-    uint8_t has_modified_at,
-    int64_t modified_at_unix
-) {
-    if (result == NULL || name == NULL || name[0] == '\0') {
-        return -1;
+void macfusegui_libssh2_reactor_destroy(macfusegui_libssh2_reactor *reactor) {
+    if (reactor == NULL) {
+        return;
+    }
+    if (reactor->backend_fd >= 0) {
+        close(reactor->backend_fd);
+    }
+    free(reactor);
+}
+
+const char *macfusegui_libssh2_reactor_backend_name(const macfusegui_libssh2_reactor *reactor) {
+    if (reactor == NULL) {
+        return "none";
     }
+    switch (reactor->kind) {
+    case MACFUSEGUI_REACTOR_KQUEUE:
+        return "kqueue";
+    case MACFUSEGUI_REACTOR_EPOLL:
+        return "epoll";
+    case MACFUSEGUI_REACTOR_POLL:
+        break;
+    }
+    return "poll";
+}
 
-    char *name_copy = macfusegui_strdup(name);
-    if (name_copy == NULL) {
+int32_t macfusegui_libssh2_reactor_wait(
+    macfusegui_libssh2_reactor *reactor,
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int32_t timeout_ms
+) {
+    if (interests == NULL || interest_count <= 0 || timeout_ms < 0) {
+        errno = EINVAL;
         return -1;
     }
 
-    int32_t next_count = result->entry_count + 1;
-    size_t bytes = (size_t)next_count * sizeof(macfusegui_libssh2_entry);
+    int64_t deadline_ms = macfusegui_now_millis() + timeout_ms;
+    if (reactor != NULL) {
+        switch (reactor->kind) {
+#if defined(MACFUSEGUI_REACTOR_HAS_KQUEUE)
+        case MACFUSEGUI_REACTOR_KQUEUE:
+            return macfusegui_kqueue_wait(reactor->backend_fd, interests, interest_count, deadline_ms);
+#endif
+#if defined(MACFUSEGUI_REACTOR_HAS_EPOLL)
+        case MACFUSEGUI_REACTOR_EPOLL:
+            return macfusegui_epoll_wait(reactor->backend_fd, interests, interest_count, deadline_ms);
+#endif
+        default:
+            break;
+        }
+    }
+    return macfusegui_poll_wait(interests, interest_count, deadline_ms);
+}
 
-    macfusegui_libssh2_entry *resized = (macfusegui_libssh2_entry *)realloc(result->entries, bytes);
-    if (resized == NULL) {
-        free(name_copy);
+static int macfusegui_set_socket_blocking(int fd, bool blocking) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
         return -1;
     }
 
-    result->entries = resized;
+    if (blocking) {
+        flags &= ~O_NONBLOCK;
+    } else {
+        flags |= O_NONBLOCK;
+    }
 
-    macfusegui_libssh2_entry *entry = &result->entries[result->entry_count];
-    memset(entry, 0, sizeof(*entry));
+    return fcntl(fd, F_SETFL, flags);
+}
 
-    entry->name = name_copy;
-    entry->is_directory = is_directory;
-    entry->has_size = has_size;
-    entry->size_bytes = size_bytes;
-    entry->has_modified_at = has_modified_at;
-    entry->modified_at_unix = modified_at_unix;
+struct macfusegui_libssh2_cancel_token {
+    atomic_int cancelled;
+    /* Self-pipe: cancel() writes one byte so a poll() on the read end wakes up. */
+    int pipe_fds[2];
+};
 
-    result->entry_count = next_count;
-    return 0;
+/* Token of the list call running on this thread; wait_socket watches it alongside the socket. */
+static _Thread_local macfusegui_libssh2_cancel_token *g_active_cancel_token = NULL;
+
+macfusegui_libssh2_cancel_token *macfusegui_libssh2_cancel_token_create(void) {
+    macfusegui_libssh2_cancel_token *token = (macfusegui_libssh2_cancel_token *)calloc(1, sizeof(*token));
+    if (token == NULL) {
+        return NULL;
+    }
+    if (pipe(token->pipe_fds) != 0) {
+        free(token);
+        return NULL;
+    }
+    for (int idx = 0; idx < 2; idx += 1) {
+        (void)fcntl(token->pipe_fds[idx], F_SETFD, FD_CLOEXEC);
+        (void)macfusegui_set_socket_blocking(token->pipe_fds[idx], false);
+    }
+    atomic_init(&token->cancelled, 0);
+    return token;
 }
 
-static int macfusegui_session_handshake_with_deadline(
-    LIBSSH2_SESSION *session,
-    int sock,
-    int64_t deadline_ms
-) {
-    while (1) {
-        int handshake_result = libssh2_session_handshake(session, sock);
-        if (handshake_result == 0) {
-            return 0;
-        }
-        if (handshake_result != LIBSSH2_ERROR_EAGAIN) {
-            return handshake_result;
-        }
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            return wait_result;
-        }
+void macfusegui_libssh2_cancel_token_destroy(macfusegui_libssh2_cancel_token *token) {
+    if (token == NULL) {
+        return;
     }
+    close(token->pipe_fds[0]);
+    close(token->pipe_fds[1]);
+    free(token);
 }
 
-static int macfusegui_password_auth_with_deadline(
-    LIBSSH2_SESSION *session,
-    int sock,
-    const char *username,
-    const char *password,
-    int64_t deadline_ms
-) {
-    while (1) {
-        int auth_result = libssh2_userauth_password_ex(
-            session,
-            username,
-            (unsigned int)strlen(username),
-            password,
-            (unsigned int)strlen(password),
-            NULL
-        );
-        if (auth_result == 0) {
-            return 0;
-        }
-        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
-            return auth_result;
-        }
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            return wait_result;
-        }
+void macfusegui_libssh2_cancel_token_cancel(macfusegui_libssh2_cancel_token *token) {
+    if (token == NULL) {
+        return;
+    }
+    if (atomic_exchange(&token->cancelled, 1) == 0) {
+        const char wake = 1;
+        ssize_t written;
+        do {
+            written = write(token->pipe_fds[1], &wake, 1);
+        } while (written < 0 && errno == EINTR);
     }
 }
 
-static int macfusegui_kbdint_auth_with_deadline(
-    LIBSSH2_SESSION *session,
-    int sock,
-    const char *username,
-    const char *password,
-    int64_t deadline_ms
-) {
-    macfusegui_kbdint_context *keyboard_context = (macfusegui_kbdint_context *)malloc(sizeof(*keyboard_context));
-    if (keyboard_context == NULL) {
-        return LIBSSH2_ERROR_ALLOC;
+int32_t macfusegui_libssh2_cancel_token_is_cancelled(const macfusegui_libssh2_cancel_token *token) {
+    if (token == NULL) {
+        return 0;
     }
-    keyboard_context->password = password;
+    return atomic_load((atomic_int *)&token->cancelled) != 0 ? 1 : 0;
+}
 
-    void **session_abstract = libssh2_session_abstract(session);
-    void *previous_abstract = NULL;
-    if (session_abstract != NULL) {
-        previous_abstract = *session_abstract;
-        *session_abstract = keyboard_context;
+/* Waits for sock in the given libssh2 block directions, the active cancel token, or deadline_ms. */
+static int macfusegui_wait_socket_directions(int sock, int directions, int64_t deadline_ms) {
+    int32_t remaining_ms = macfusegui_remaining_timeout_ms(deadline_ms);
+    if (remaining_ms <= 0) {
+        errno = ETIMEDOUT;
+        return MACFUSEGUI_BRIDGE_WAIT_TIMEOUT;
     }
 
-    int auth_result = LIBSSH2_ERROR_EAGAIN;
-    while (1) {
-        auth_result = libssh2_userauth_keyboard_interactive_ex(
-            session,
-            username,
-            (unsigned int)strlen(username),
-            macfusegui_kbdint_response_callback
-        );
-        if (auth_result == 0) {
-            break;
-        }
-        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
-            break;
-        }
+    macfusegui_libssh2_cancel_token *cancel_token = g_active_cancel_token;
+    if (macfusegui_libssh2_cancel_token_is_cancelled(cancel_token)) {
+        errno = ECANCELED;
+        return MACFUSEGUI_BRIDGE_WAIT_CANCELLED;
+    }
 
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            auth_result = wait_result;
-            break;
-        }
+    g_socket_wait_count += 1;
+
+    /* One or two fds need no kernel reactor object: one poll() call, no FD_SETSIZE ceiling. */
+    macfusegui_libssh2_wait_interest interests[2] = {
+        { sock, macfusegui_wait_events_from_directions(directions), 0 },
+        { cancel_token != NULL ? cancel_token->pipe_fds[0] : -1, MACFUSEGUI_LIBSSH2_WAIT_READ, 0 }
+    };
+    int wait_result = macfusegui_poll_wait(interests, cancel_token != NULL ? 2 : 1, deadline_ms);
+    if (wait_result > 0 && interests[1].ready != 0) {
+        errno = ECANCELED;
+        return MACFUSEGUI_BRIDGE_WAIT_CANCELLED;
+    }
+    if (wait_result == 0) {
+        errno = ETIMEDOUT;
+        return MACFUSEGUI_BRIDGE_WAIT_TIMEOUT;
+    }
+    if (wait_result < 0) {
+        return -1;
     }
+    return 0;
+}
 
-    if (session_abstract != NULL) {
-        *session_abstract = previous_abstract;
+static int macfusegui_wait_socket(LIBSSH2_SESSION *session, int sock, int64_t deadline_ms) {
+    /* Ask libssh2 whether it is blocked on read, write, or both. */
+    int directions = session != NULL ? libssh2_session_block_directions(session) : 0;
+    if (directions == 0) {
+        directions = LIBSSH2_SESSION_BLOCK_INBOUND | LIBSSH2_SESSION_BLOCK_OUTBOUND;
     }
-    free(keyboard_context);
-    return auth_result;
+    return macfusegui_wait_socket_directions(sock, directions, deadline_ms);
 }
 
-static int macfusegui_publickey_auth_with_deadline(
-    LIBSSH2_SESSION *session,
-    int sock,
-    const char *username,
-    const char *private_key_path,
-    int64_t deadline_ms
+/* RFC 8305 "Connection Attempt Delay": stagger, don't serialize, attempts across addresses. */
+#define MACFUSEGUI_CONNECT_ATTEMPT_DELAY_MS 250
+#define MACFUSEGUI_CONNECT_MAX_CANDIDATES 16
+
+/* One resolved socket address, copied out of getaddrinfo so it can outlive the addrinfo list. */
+typedef struct macfusegui_resolved_address {
+    int family;
+    int socktype;
+    int protocol;
+    socklen_t addrlen;
+    struct sockaddr_storage addr;
+} macfusegui_resolved_address;
+
+static int32_t macfusegui_copy_addrinfo(
+    const struct addrinfo *resolved,
+    macfusegui_resolved_address *out_addresses,
+    int32_t capacity
 ) {
-    while (1) {
-        int auth_result = libssh2_userauth_publickey_fromfile_ex(
-            session,
-            username,
-            (unsigned int)strlen(username),
-            NULL,
-            private_key_path,
-            NULL
-        );
-        if (auth_result == 0) {
-            return 0;
-        }
-        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
-            return auth_result;
-        }
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            return wait_result;
+    int32_t count = 0;
+    for (const struct addrinfo *cursor = resolved; cursor != NULL && count < capacity; cursor = cursor->ai_next) {
+        if (cursor->ai_addr == NULL || cursor->ai_addrlen > sizeof(struct sockaddr_storage)) {
+            continue;
         }
+        macfusegui_resolved_address *address = &out_addresses[count];
+        memset(address, 0, sizeof(*address));
+        address->family = cursor->ai_family;
+        address->socktype = cursor->ai_socktype;
+        address->protocol = cursor->ai_protocol;
+        address->addrlen = cursor->ai_addrlen;
+        memcpy(&address->addr, cursor->ai_addr, cursor->ai_addrlen);
+        count += 1;
     }
+    return count;
 }
 
-static LIBSSH2_SFTP *macfusegui_sftp_init_with_deadline(
-    LIBSSH2_SESSION *session,
-    int sock,
-    int64_t deadline_ms,
-    int *out_status
+/*
+ Resolver cache keyed by host and port. open_session uses the shared instance; tests create their own.
+ - Positive answers live for positive_ttl_ms, failures for negative_ttl_ms. A still-fresh entry keeps
+   its expiry when another answer for the same key lands, so a later lookup never extends it.
+ - getaddrinfo runs outside the lock, so a slow DNS server only stalls the host being resolved.
+ - Single flight: while one thread resolves host:port, other lookups for that key wait for its answer
+   instead of sending their own query.
+ - If a refresh fails while an expired positive answer exists, the stale addresses are served
+   (RFC 8767 style) and the refresh is retried after negative_ttl_ms. This keeps reconnect
+   storms after wake from failing just because DNS is not back yet.
+ - flush bumps an epoch, so an answer that was in flight across a network change is not cached.
+*/
+#define MACFUSEGUI_RESOLVER_MAX_ENTRIES 32
+#define MACFUSEGUI_RESOLVER_MAX_HOST_LENGTH 256
+#define MACFUSEGUI_RESOLVER_DEFAULT_POSITIVE_TTL_MS 60000
+#define MACFUSEGUI_RESOLVER_DEFAULT_NEGATIVE_TTL_MS 5000
+
+typedef struct macfusegui_resolver_entry {
+    bool in_use;
+    char host[MACFUSEGUI_RESOLVER_MAX_HOST_LENGTH];
+    int32_t port;
+    /* 0 for a positive entry, otherwise the getaddrinfo error being cached. */
+    int gai_error;
+    int32_t address_count;
+    macfusegui_resolved_address addresses[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int64_t expires_at_ms;
+    int64_t last_used_ms;
+} macfusegui_resolver_entry;
+
+/* One getaddrinfo in progress. The last of the leader and its waiters to leave frees the slot. */
+typedef struct macfusegui_resolver_flight {
+    bool in_use;
+    bool done;
+    char host[MACFUSEGUI_RESOLVER_MAX_HOST_LENGTH];
+    int32_t port;
+    int32_t waiters;
+    int result;
+    int32_t address_count;
+    macfusegui_resolved_address addresses[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+} macfusegui_resolver_flight;
+
+struct macfusegui_libssh2_resolver {
+    pthread_mutex_t lock;
+    pthread_cond_t flight_done;
+    macfusegui_resolver_entry entries[MACFUSEGUI_RESOLVER_MAX_ENTRIES];
+    macfusegui_resolver_flight flights[MACFUSEGUI_RESOLVER_MAX_ENTRIES];
+    int32_t positive_ttl_ms;
+    int32_t negative_ttl_ms;
+    uint64_t epoch;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t negative_hits;
+    uint64_t stale_hits;
+    uint64_t coalesced;
+};
+
+static macfusegui_libssh2_resolver g_shared_resolver = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .flight_done = PTHREAD_COND_INITIALIZER,
+    .positive_ttl_ms = MACFUSEGUI_RESOLVER_DEFAULT_POSITIVE_TTL_MS,
+    .negative_ttl_ms = MACFUSEGUI_RESOLVER_DEFAULT_NEGATIVE_TTL_MS
+};
+
+/* Caller holds resolver->lock. */
+static macfusegui_resolver_entry *macfusegui_resolver_find(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port
 ) {
-    while (1) {
-        LIBSSH2_SFTP *sftp = libssh2_sftp_init(session);
-        if (sftp != NULL) {
-            if (out_status != NULL) {
-                *out_status = 0;
-            }
-            return sftp;
-        }
-
-        int last_error = libssh2_session_last_errno(session);
-        if (last_error != LIBSSH2_ERROR_EAGAIN) {
-            if (out_status != NULL) {
-                *out_status = last_error;
-            }
-            return NULL;
-        }
-
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            if (out_status != NULL) {
-                *out_status = wait_result;
-            }
-            return NULL;
+    for (int32_t idx = 0; idx < MACFUSEGUI_RESOLVER_MAX_ENTRIES; idx += 1) {
+        macfusegui_resolver_entry *entry = &resolver->entries[idx];
+        if (entry->in_use && entry->port == port && strcmp(entry->host, host) == 0) {
+            return entry;
         }
     }
+    return NULL;
 }
 
-static ssize_t macfusegui_sftp_realpath_with_deadline(
-    LIBSSH2_SESSION *session,
-    LIBSSH2_SFTP *sftp,
-    int sock,
-    const char *remote_path,
-    char *buffer,
-    size_t buffer_size,
-    int64_t deadline_ms,
-    int *out_status
+/* Caller holds resolver->lock. Reuses a free slot or evicts the least recently used entry. */
+static macfusegui_resolver_entry *macfusegui_resolver_slot(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port
 ) {
-    if (buffer_size > (size_t)UINT_MAX) {
-        if (out_status != NULL) {
-            *out_status = LIBSSH2_ERROR_BUFFER_TOO_SMALL;
-        }
-        return LIBSSH2_ERROR_BUFFER_TOO_SMALL;
+    macfusegui_resolver_entry *existing = macfusegui_resolver_find(resolver, host, port);
+    if (existing != NULL) {
+        return existing;
     }
 
-    unsigned int buffer_size_u32 = (unsigned int)buffer_size;
-
-    while (1) {
-        ssize_t result = libssh2_sftp_realpath(sftp, remote_path, buffer, buffer_size_u32);
-        if (result >= 0) {
-            if (out_status != NULL) {
-                *out_status = 0;
-            }
-            return result;
-        }
-        if (result != LIBSSH2_ERROR_EAGAIN) {
-            if (out_status != NULL) {
-                *out_status = (int)result;
-            }
-            return result;
+    macfusegui_resolver_entry *victim = &resolver->entries[0];
+    for (int32_t idx = 0; idx < MACFUSEGUI_RESOLVER_MAX_ENTRIES; idx += 1) {
+        macfusegui_resolver_entry *entry = &resolver->entries[idx];
+        if (!entry->in_use) {
+            victim = entry;
+            break;
         }
-
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            if (out_status != NULL) {
-                *out_status = wait_result;
-            }
-            return result;
+        if (entry->last_used_ms < victim->last_used_ms) {
+            victim = entry;
         }
     }
+
+    memset(victim, 0, sizeof(*victim));
+    victim->in_use = true;
+    snprintf(victim->host, sizeof(victim->host), "%s", host);
+    victim->port = port;
+    return victim;
 }
 
-static LIBSSH2_SFTP_HANDLE *macfusegui_sftp_opendir_with_deadline(
-    LIBSSH2_SESSION *session,
-    LIBSSH2_SFTP *sftp,
-    int sock,
-    const char *path,
-    int64_t deadline_ms,
-    int *out_status
+/*
+ Caller holds resolver->lock. Writes an answer for host:port. An entry that is still fresh keeps the
+ earlier of its expiry and the new one, and a fresh positive answer is never replaced by a failure.
+*/
+static void macfusegui_resolver_store(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port,
+    int gai_error,
+    const macfusegui_resolved_address *addresses,
+    int32_t address_count,
+    int32_t ttl_ms,
+    int64_t now
 ) {
-    while (1) {
-        LIBSSH2_SFTP_HANDLE *handle = libssh2_sftp_opendir(sftp, path);
-        if (handle != NULL) {
-            if (out_status != NULL) {
-                *out_status = 0;
-            }
-            return handle;
-        }
+    macfusegui_resolver_entry *slot = macfusegui_resolver_slot(resolver, host, port);
+    int64_t expires_at_ms = now + ttl_ms;
+    bool fresh = now < slot->expires_at_ms;
+    slot->last_used_ms = now;
+    if (fresh && slot->gai_error == 0 && gai_error != 0) {
+        return;
+    }
+    if (!fresh || expires_at_ms < slot->expires_at_ms) {
+        slot->expires_at_ms = expires_at_ms;
+    }
+    slot->gai_error = gai_error;
+    slot->address_count = gai_error == 0 ? address_count : 0;
+    if (slot->address_count > 0) {
+        memcpy(slot->addresses, addresses, (size_t)slot->address_count * sizeof(*addresses));
+    }
+}
 
-        int last_error = libssh2_session_last_errno(session);
-        if (last_error != LIBSSH2_ERROR_EAGAIN) {
-            if (out_status != NULL) {
-                *out_status = last_error;
-            }
-            return NULL;
+/* Caller holds resolver->lock. */
+static macfusegui_resolver_flight *macfusegui_resolver_find_flight(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port
+) {
+    for (int32_t idx = 0; idx < MACFUSEGUI_RESOLVER_MAX_ENTRIES; idx += 1) {
+        macfusegui_resolver_flight *flight = &resolver->flights[idx];
+        if (flight->in_use && !flight->done && flight->port == port && strcmp(flight->host, host) == 0) {
+            return flight;
         }
+    }
+    return NULL;
+}
 
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            if (out_status != NULL) {
-                *out_status = wait_result;
-            }
-            return NULL;
+/* Caller holds resolver->lock. Returns NULL when every slot is busy; the lookup then runs unshared. */
+static macfusegui_resolver_flight *macfusegui_resolver_begin_flight(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port
+) {
+    for (int32_t idx = 0; idx < MACFUSEGUI_RESOLVER_MAX_ENTRIES; idx += 1) {
+        macfusegui_resolver_flight *flight = &resolver->flights[idx];
+        if (!flight->in_use) {
+            memset(flight, 0, sizeof(*flight));
+            flight->in_use = true;
+            snprintf(flight->host, sizeof(flight->host), "%s", host);
+            flight->port = port;
+            return flight;
         }
     }
+    return NULL;
 }
 
-static ssize_t macfusegui_sftp_readdir_with_deadline(
-    LIBSSH2_SESSION *session,
-    LIBSSH2_SFTP_HANDLE *directory_handle,
-    int sock,
-    char *file_name,
-    size_t file_name_size,
-    char *long_entry,
-    size_t long_entry_size,
-    LIBSSH2_SFTP_ATTRIBUTES *attrs,
-    int64_t deadline_ms,
-    int *out_status
+/* Returns 0 with addresses filled, or the getaddrinfo error (possibly from the negative cache). */
+static int macfusegui_resolve_cached(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port,
+    macfusegui_resolved_address *out_addresses,
+    int32_t capacity,
+    int32_t *out_count,
+    bool *out_from_cache
 ) {
-    while (1) {
-        ssize_t result = libssh2_sftp_readdir_ex(
-            directory_handle,
-            file_name,
-            file_name_size,
-            long_entry,
-            long_entry_size,
-            attrs
-        );
-        if (result != LIBSSH2_ERROR_EAGAIN) {
-            if (out_status != NULL) {
-                *out_status = (result < 0) ? (int)result : 0;
+    *out_count = 0;
+    if (out_from_cache != NULL) {
+        *out_from_cache = false;
+    }
+    bool cacheable = strlen(host) < MACFUSEGUI_RESOLVER_MAX_HOST_LENGTH;
+    int32_t stale_count = 0;
+
+    pthread_mutex_lock(&resolver->lock);
+    int64_t now = macfusegui_now_millis();
+    macfusegui_resolver_entry *entry = cacheable ? macfusegui_resolver_find(resolver, host, port) : NULL;
+    if (entry != NULL) {
+        entry->last_used_ms = now;
+        if (now < entry->expires_at_ms) {
+            int gai_error = entry->gai_error;
+            if (gai_error == 0) {
+                int32_t count = entry->address_count < capacity ? entry->address_count : capacity;
+                memcpy(out_addresses, entry->addresses, (size_t)count * sizeof(*out_addresses));
+                *out_count = count;
+                resolver->hits += 1;
+            } else {
+                resolver->negative_hits += 1;
             }
-            return result;
+            if (out_from_cache != NULL) {
+                *out_from_cache = true;
+            }
+            pthread_mutex_unlock(&resolver->lock);
+            return gai_error;
+        }
+        if (entry->gai_error == 0) {
+            /* Keep the expired answer in the caller's buffer as a fallback for a failed refresh. */
+            stale_count = entry->address_count < capacity ? entry->address_count : capacity;
+            memcpy(out_addresses, entry->addresses, (size_t)stale_count * sizeof(*out_addresses));
         }
+    }
 
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            if (out_status != NULL) {
-                *out_status = wait_result;
-            }
-            return result;
+    macfusegui_resolver_flight *flight = cacheable ? macfusegui_resolver_find_flight(resolver, host, port) : NULL;
+    if (flight != NULL) {
+        /* Someone is already asking DNS for this key: take their answer. */
+        flight->waiters += 1;
+        resolver->coalesced += 1;
+        while (!flight->done) {
+            pthread_cond_wait(&resolver->flight_done, &resolver->lock);
+        }
+        int result = flight->result;
+        int32_t count = flight->address_count < capacity ? flight->address_count : capacity;
+        memcpy(out_addresses, flight->addresses, (size_t)count * sizeof(*out_addresses));
+        *out_count = count;
+        flight->waiters -= 1;
+        if (flight->waiters == 0) {
+            flight->in_use = false;
         }
+        pthread_mutex_unlock(&resolver->lock);
+        return result;
     }
-}
 
-static int macfusegui_sftp_stat_with_deadline(
-    LIBSSH2_SESSION *session,
-    LIBSSH2_SFTP *sftp,
-    int sock,
-    const char *path,
-    LIBSSH2_SFTP_ATTRIBUTES *attrs,
+    resolver->misses += 1;
+    flight = cacheable ? macfusegui_resolver_begin_flight(resolver, host, port) : NULL;
+    uint64_t epoch = resolver->epoch;
+    pthread_mutex_unlock(&resolver->lock);
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+
+    char port_buffer[16];
+    snprintf(port_buffer, sizeof(port_buffer), "%d", (int)port);
+
+    struct addrinfo *resolved = NULL;
+    int gai_result = getaddrinfo(host, port_buffer, &hints, &resolved);
+    macfusegui_resolved_address fresh[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t fresh_count = 0;
+    if (gai_result == 0) {
+        fresh_count = macfusegui_copy_addrinfo(resolved, fresh, MACFUSEGUI_CONNECT_MAX_CANDIDATES);
+        freeaddrinfo(resolved);
+        if (fresh_count == 0) {
+            gai_result = EAI_NONAME;
+        }
+    }
+
+    pthread_mutex_lock(&resolver->lock);
+    now = macfusegui_now_millis();
+    /* A flush while getaddrinfo ran means this answer may predate the network change. */
+    bool store = cacheable && epoch == resolver->epoch;
+    int result = gai_result;
+    if (gai_result == 0) {
+        int32_t count = fresh_count < capacity ? fresh_count : capacity;
+        memcpy(out_addresses, fresh, (size_t)count * sizeof(*out_addresses));
+        *out_count = count;
+        if (store && resolver->positive_ttl_ms > 0) {
+            macfusegui_resolver_store(resolver, host, port, 0, fresh, fresh_count, resolver->positive_ttl_ms, now);
+        }
+    } else if (stale_count > 0) {
+        /* Serve stale: the old addresses are a better bet than failing the whole session open. */
+        *out_count = stale_count;
+        resolver->stale_hits += 1;
+        result = 0;
+        macfusegui_resolver_entry *slot = store ? macfusegui_resolver_find(resolver, host, port) : NULL;
+        if (slot != NULL && slot->gai_error == 0 && slot->expires_at_ms <= now) {
+            slot->expires_at_ms = now + resolver->negative_ttl_ms;
+            slot->last_used_ms = now;
+        }
+    } else if (store && resolver->negative_ttl_ms > 0) {
+        macfusegui_resolver_store(resolver, host, port, gai_result, NULL, 0, resolver->negative_ttl_ms, now);
+    }
+
+    if (flight != NULL) {
+        flight->done = true;
+        flight->result = result;
+        flight->address_count = *out_count;
+        memcpy(flight->addresses, out_addresses, (size_t)*out_count * sizeof(*out_addresses));
+        if (flight->waiters == 0) {
+            flight->in_use = false;
+        } else {
+            pthread_cond_broadcast(&resolver->flight_done);
+        }
+    }
+    pthread_mutex_unlock(&resolver->lock);
+    return result;
+}
+
+macfusegui_libssh2_resolver *macfusegui_libssh2_resolver_shared(void) {
+    return &g_shared_resolver;
+}
+
+macfusegui_libssh2_resolver *macfusegui_libssh2_resolver_create(int32_t positive_ttl_ms, int32_t negative_ttl_ms) {
+    macfusegui_libssh2_resolver *resolver = calloc(1, sizeof(*resolver));
+    if (resolver == NULL) {
+        return NULL;
+    }
+    pthread_mutex_init(&resolver->lock, NULL);
+    pthread_cond_init(&resolver->flight_done, NULL);
+    resolver->positive_ttl_ms = positive_ttl_ms > 0 ? positive_ttl_ms : 0;
+    resolver->negative_ttl_ms = negative_ttl_ms > 0 ? negative_ttl_ms : 0;
+    return resolver;
+}
+
+void macfusegui_libssh2_resolver_destroy(macfusegui_libssh2_resolver *resolver) {
+    if (resolver == NULL || resolver == &g_shared_resolver) {
+        return;
+    }
+    pthread_cond_destroy(&resolver->flight_done);
+    pthread_mutex_destroy(&resolver->lock);
+    free(resolver);
+}
+
+void macfusegui_libssh2_resolver_configure(
+    macfusegui_libssh2_resolver *resolver,
+    int32_t positive_ttl_ms,
+    int32_t negative_ttl_ms
+) {
+    if (resolver == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&resolver->lock);
+    resolver->positive_ttl_ms = positive_ttl_ms > 0 ? positive_ttl_ms : 0;
+    resolver->negative_ttl_ms = negative_ttl_ms > 0 ? negative_ttl_ms : 0;
+    pthread_mutex_unlock(&resolver->lock);
+}
+
+void macfusegui_libssh2_resolver_flush(macfusegui_libssh2_resolver *resolver) {
+    if (resolver == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&resolver->lock);
+    memset(resolver->entries, 0, sizeof(resolver->entries));
+    resolver->epoch += 1;
+    pthread_mutex_unlock(&resolver->lock);
+}
+
+void macfusegui_libssh2_resolver_get_stats(
+    macfusegui_libssh2_resolver *resolver,
+    macfusegui_libssh2_resolver_stats *out_stats
+) {
+    if (out_stats == NULL) {
+        return;
+    }
+    memset(out_stats, 0, sizeof(*out_stats));
+    if (resolver == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&resolver->lock);
+    out_stats->hits = resolver->hits;
+    out_stats->misses = resolver->misses;
+    out_stats->negative_hits = resolver->negative_hits;
+    out_stats->stale_hits = resolver->stale_hits;
+    out_stats->coalesced = resolver->coalesced;
+    out_stats->positive_ttl_ms = resolver->positive_ttl_ms;
+    out_stats->negative_ttl_ms = resolver->negative_ttl_ms;
+    for (int32_t idx = 0; idx < MACFUSEGUI_RESOLVER_MAX_ENTRIES; idx += 1) {
+        if (resolver->entries[idx].in_use) {
+            out_stats->entry_count += 1;
+        }
+    }
+    pthread_mutex_unlock(&resolver->lock);
+}
+
+int32_t macfusegui_libssh2_resolver_lookup(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port,
+    int32_t *out_address_count
+) {
+    if (out_address_count != NULL) {
+        *out_address_count = 0;
+    }
+    if (resolver == NULL || host == NULL || port <= 0) {
+        return EAI_NONAME;
+    }
+
+    pthread_once(&g_libssh2_once, macfusegui_libssh2_global_init);
+    macfusegui_resolved_address addresses[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t count = 0;
+    int result = macfusegui_resolve_cached(resolver, host, port, addresses, MACFUSEGUI_CONNECT_MAX_CANDIDATES, &count, NULL);
+    if (out_address_count != NULL) {
+        *out_address_count = count;
+    }
+    return result;
+}
+
+static int32_t macfusegui_family_number(int family) {
+    if (family == AF_INET6) {
+        return 6;
+    }
+    if (family == AF_INET) {
+        return 4;
+    }
+    return 0;
+}
+
+/*
+ Orders resolver output per RFC 8305 section 4: keep the resolver's first family first,
+ then alternate families so one broken family cannot starve the other.
+*/
+static int32_t macfusegui_order_connect_candidates(
+    const macfusegui_resolved_address *resolved,
+    int32_t resolved_count,
+    const macfusegui_resolved_address **out_ordered,
+    int32_t capacity
+) {
+    const macfusegui_resolved_address *primary[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    const macfusegui_resolved_address *secondary[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t primary_count = 0;
+    int32_t secondary_count = 0;
+    int primary_family = resolved_count > 0 ? resolved[0].family : AF_UNSPEC;
+
+    for (int32_t idx = 0; idx < resolved_count; idx += 1) {
+        if (resolved[idx].family == primary_family) {
+            if (primary_count < MACFUSEGUI_CONNECT_MAX_CANDIDATES) {
+                primary[primary_count++] = &resolved[idx];
+            }
+        } else if (secondary_count < MACFUSEGUI_CONNECT_MAX_CANDIDATES) {
+            secondary[secondary_count++] = &resolved[idx];
+        }
+    }
+
+    int32_t count = 0;
+    for (int32_t idx = 0; (idx < primary_count || idx < secondary_count) && count < capacity; idx += 1) {
+        if (idx < primary_count && count < capacity) {
+            out_ordered[count++] = primary[idx];
+        }
+        if (idx < secondary_count && count < capacity) {
+            out_ordered[count++] = secondary[idx];
+        }
+    }
+    return count;
+}
+
+/* Starts one non-blocking connect. Returns the fd (connect in progress or done) or -1. */
+static int macfusegui_start_connect_attempt(
+    const macfusegui_resolved_address *candidate_addr,
+    int32_t timeout_seconds,
+    bool *out_connected,
+    bool *out_timeout_config_failure
+) {
+    *out_connected = false;
+    int candidate = socket(candidate_addr->family, candidate_addr->socktype, candidate_addr->protocol);
+    if (candidate < 0) {
+        return -1;
+    }
+
+    int one = 1;
+    (void)setsockopt(candidate, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+#if defined(SO_NOSIGPIPE)
+    (void)setsockopt(candidate, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+    /* Keep socket non-blocking after connect; bridge wait loops depend on this mode. */
+    if (macfusegui_set_socket_blocking(candidate, false) != 0) {
+        close(candidate);
+        return -1;
+    }
+
+    if (timeout_seconds > 0) {
+        struct timeval tv;
+        tv.tv_sec = timeout_seconds;
+        tv.tv_usec = 0;
+        if (setsockopt(candidate, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) != 0 ||
+            setsockopt(candidate, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv)) != 0) {
+            *out_timeout_config_failure = true;
+            close(candidate);
+            return -1;
+        }
+    }
+
+    if (connect(candidate, (const struct sockaddr *)&candidate_addr->addr, candidate_addr->addrlen) == 0) {
+        *out_connected = true;
+        return candidate;
+    }
+    if (errno != EINPROGRESS) {
+        close(candidate);
+        return -1;
+    }
+    return candidate;
+}
+
+/*
+ Happy Eyeballs race (RFC 8305): start the next candidate every attempt_delay_ms, or at once
+ when any attempt fails (refused by connect() itself or reported failed by poll), and keep the
+ first socket that connects. All attempts share
+ one deadline, so a blackholed address costs at most attempt_delay_ms before the next starts.
+*/
+static int macfusegui_race_connect(
+    const macfusegui_resolved_address **candidates,
+    int32_t candidate_count,
     int64_t deadline_ms,
-    int *out_status
+    int32_t attempt_delay_ms,
+    int32_t timeout_seconds,
+    bool *out_timeout_config_failure,
+    macfusegui_libssh2_connect_report *out_report
 ) {
-    while (1) {
-        int stat_result = libssh2_sftp_stat_ex(
-            sftp,
-            path,
-            (unsigned int)strlen(path),
-            LIBSSH2_SFTP_STAT,
-            attrs
-        );
-        if (stat_result != LIBSSH2_ERROR_EAGAIN) {
-            if (out_status != NULL) {
-                *out_status = 0;
+    int sockets[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    for (int32_t idx = 0; idx < MACFUSEGUI_CONNECT_MAX_CANDIDATES; idx += 1) {
+        sockets[idx] = -1;
+    }
+
+    int64_t started_at = macfusegui_now_millis();
+    int32_t next_candidate = 0;
+    int32_t active_count = 0;
+    int64_t next_start_at = started_at;
+    int winner = -1;
+    int32_t winner_index = -1;
+    int32_t attempts_started = 0;
+
+    while (winner < 0) {
+        int64_t now = macfusegui_now_millis();
+        if (now >= deadline_ms) {
+            errno = ETIMEDOUT;
+            break;
+        }
+
+        if (next_candidate < candidate_count && (active_count == 0 || now >= next_start_at)) {
+            int32_t index = next_candidate;
+            next_candidate += 1;
+            attempts_started += 1;
+            bool connected = false;
+            int candidate = macfusegui_start_connect_attempt(
+                candidates[index],
+                timeout_seconds,
+                &connected,
+                out_timeout_config_failure
+            );
+            if (candidate < 0) {
+                /* Refused before it was even in flight (RFC 8305 section 5): try the next address now. */
+                next_start_at = now;
+                continue;
             }
-            return stat_result;
+            if (connected) {
+                winner = candidate;
+                winner_index = index;
+                break;
+            }
+            sockets[index] = candidate;
+            active_count += 1;
+            next_start_at = now + attempt_delay_ms;
+            continue;
         }
 
-        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
-        if (wait_result != 0) {
-            if (out_status != NULL) {
-                *out_status = wait_result;
+        if (active_count == 0) {
+            break;
+        }
+
+        macfusegui_libssh2_wait_interest interests[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+        int32_t interest_index[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+        int32_t interest_count = 0;
+        for (int32_t idx = 0; idx < next_candidate; idx += 1) {
+            if (sockets[idx] >= 0) {
+                interests[interest_count].fd = sockets[idx];
+                interests[interest_count].events = MACFUSEGUI_LIBSSH2_WAIT_WRITE;
+                interests[interest_count].ready = 0;
+                interest_index[interest_count] = idx;
+                interest_count += 1;
             }
-            return stat_result;
         }
+
+        int64_t wait_until = deadline_ms;
+        if (next_candidate < candidate_count && next_start_at < wait_until) {
+            wait_until = next_start_at;
+        }
+        int wait_result = macfusegui_poll_wait(interests, interest_count, wait_until);
+        if (wait_result < 0) {
+            break;
+        }
+
+        for (int32_t idx = 0; idx < interest_count && winner < 0; idx += 1) {
+            if (interests[idx].ready == 0) {
+                continue;
+            }
+            int32_t index = interest_index[idx];
+            int socket_error = 0;
+            socklen_t socket_error_len = sizeof(socket_error);
+            if (getsockopt(sockets[index], SOL_SOCKET, SO_ERROR, &socket_error, &socket_error_len) == 0 && socket_error == 0) {
+                winner = sockets[index];
+                winner_index = index;
+                sockets[index] = -1;
+                break;
+            }
+
+            /* Failed attempt: drop it and let the next candidate start right away. */
+            close(sockets[index]);
+            sockets[index] = -1;
+            active_count -= 1;
+            next_start_at = macfusegui_now_millis();
+        }
+    }
+
+    for (int32_t idx = 0; idx < MACFUSEGUI_CONNECT_MAX_CANDIDATES; idx += 1) {
+        if (sockets[idx] >= 0) {
+            close(sockets[idx]);
+        }
+    }
+
+    if (out_report != NULL) {
+        int64_t elapsed_ms = macfusegui_now_millis() - started_at;
+        out_report->attempts_started = attempts_started;
+        out_report->elapsed_ms = (int32_t)(elapsed_ms > 0 ? elapsed_ms : 0);
+        out_report->family = winner_index >= 0 ? macfusegui_family_number(candidates[winner_index]->family) : 0;
     }
+    return winner;
 }
 
-int32_t macfusegui_libssh2_bridge_version(void) {
-    return 2;
+void macfusegui_libssh2_socket_options_default(macfusegui_libssh2_socket_options *out_options) {
+    if (out_options == NULL) {
+        return;
+    }
+    /* Roughly 25 s from last traffic to a dead-peer error, without keepalive chatter on busy links. */
+    out_options->keepalive_idle_seconds = 10;
+    out_options->keepalive_interval_seconds = 5;
+    out_options->keepalive_count = 3;
+    out_options->user_timeout_ms = 15000;
+    out_options->no_delay = 1;
 }
 
-int32_t macfusegui_libssh2_open_session(
+static bool macfusegui_set_tcp_option(int fd, int option, int value) {
+    return setsockopt(fd, IPPROTO_TCP, option, &value, sizeof(value)) == 0;
+}
+
+int32_t macfusegui_libssh2_apply_socket_options(int fd, const macfusegui_libssh2_socket_options *options) {
+    if (fd < 0 || options == NULL) {
+        return 0;
+    }
+
+    /* Each option is best effort: a kernel that rejects one still gets the others. */
+    int32_t applied = 0;
+    if (options->keepalive_idle_seconds > 0) {
+#if defined(TCP_KEEPALIVE)
+        if (macfusegui_set_tcp_option(fd, TCP_KEEPALIVE, options->keepalive_idle_seconds)) {
+            applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_IDLE;
+        }
+#elif defined(TCP_KEEPIDLE)
+        if (macfusegui_set_tcp_option(fd, TCP_KEEPIDLE, options->keepalive_idle_seconds)) {
+            applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_IDLE;
+        }
+#endif
+    }
+#if defined(TCP_KEEPINTVL)
+    if (options->keepalive_interval_seconds > 0 &&
+        macfusegui_set_tcp_option(fd, TCP_KEEPINTVL, options->keepalive_interval_seconds)) {
+        applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_INTERVAL;
+    }
+#endif
+#if defined(TCP_KEEPCNT)
+    if (options->keepalive_count > 0 && macfusegui_set_tcp_option(fd, TCP_KEEPCNT, options->keepalive_count)) {
+        applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_COUNT;
+    }
+#endif
+    if (options->user_timeout_ms > 0) {
+#if defined(TCP_USER_TIMEOUT)
+        if (macfusegui_set_tcp_option(fd, TCP_USER_TIMEOUT, options->user_timeout_ms)) {
+            applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_USER_TIMEOUT;
+        }
+#elif defined(TCP_RXT_CONNDROPTIME)
+        if (macfusegui_set_tcp_option(fd, TCP_RXT_CONNDROPTIME, (options->user_timeout_ms + 999) / 1000)) {
+            applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_USER_TIMEOUT;
+        }
+#endif
+    }
+    if (options->no_delay != 0 && macfusegui_set_tcp_option(fd, TCP_NODELAY, 1)) {
+        applied |= MACFUSEGUI_LIBSSH2_SOCKOPT_NODELAY;
+    }
+    return applied;
+}
+
+static int macfusegui_connect_socket(
     const char *host,
     int32_t port,
-    const char *username,
-    const char *password,
-    const char *private_key_path,
     int32_t timeout_seconds,
-    macfusegui_libssh2_session_handle **out_session,
-    char **out_error_message
+    const macfusegui_libssh2_socket_options *socket_options,
+    bool *out_timeout_config_failure,
+    macfusegui_libssh2_connect_report *out_report,
+    macfusegui_libssh2_stage_timing *out_timing
 ) {
-    /*
-     Open session flow:
-     1) Connect TCP socket with timeout.
-     2) Handshake SSH session.
-     3) Authenticate (password/kbdint/private key).
-     4) Initialize SFTP subsystem.
-     5) Return persistent session handle.
-    */
-    if (out_session == NULL) {
+    if (out_timeout_config_failure != NULL) {
+        *out_timeout_config_failure = false;
+    }
+
+    macfusegui_resolved_address resolved[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t resolved_count = 0;
+    bool resolve_cached = false;
+    int64_t resolve_started_at = macfusegui_now_micros();
+    int resolve_result = macfusegui_resolve_cached(
+        &g_shared_resolver,
+        host,
+        port,
+        resolved,
+        MACFUSEGUI_CONNECT_MAX_CANDIDATES,
+        &resolved_count,
+        &resolve_cached
+    );
+    int64_t connect_started_at = macfusegui_now_micros();
+    if (out_timing != NULL) {
+        out_timing->resolve_us = connect_started_at - resolve_started_at;
+        out_timing->resolve_cached = resolve_cached ? 1 : 0;
+    }
+    if (resolve_result != 0) {
         return -1;
     }
-    *out_session = NULL;
 
-    if (out_error_message != NULL) {
-        *out_error_message = NULL;
+    const macfusegui_resolved_address *ordered[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t ordered_count = macfusegui_order_connect_candidates(resolved, resolved_count, ordered, MACFUSEGUI_CONNECT_MAX_CANDIDATES);
+
+    bool timeout_config_failure = false;
+    int connected_socket = macfusegui_race_connect(
+        ordered,
+        ordered_count,
+        macfusegui_deadline_from_timeout_seconds(timeout_seconds),
+        MACFUSEGUI_CONNECT_ATTEMPT_DELAY_MS,
+        timeout_seconds,
+        &timeout_config_failure,
+        out_report
+    );
+    if (out_timing != NULL) {
+        out_timing->connect_us = macfusegui_now_micros() - connect_started_at;
+        out_timing->connect_attempts = out_report != NULL ? out_report->attempts_started : 0;
     }
 
-    if (host == NULL || username == NULL || port <= 0 || timeout_seconds <= 0) {
-        macfusegui_set_out_error(out_error_message, "Invalid browser session open request.");
-        return -100;
+    if (connected_socket < 0 && timeout_config_failure) {
+        if (out_timeout_config_failure != NULL) {
+            *out_timeout_config_failure = true;
+        }
+        return MACFUSEGUI_CONNECT_ERROR_SOCKET_TIMEOUT_CONFIG;
     }
 
-    pthread_once(&g_libssh2_once, macfusegui_libssh2_global_init);
+    /* Tune only the winner; losing race attempts are already closed. */
+    if (connected_socket >= 0) {
+        int32_t applied = macfusegui_libssh2_apply_socket_options(connected_socket, socket_options);
+        if (out_report != NULL) {
+            out_report->socket_options_applied = applied;
+        }
+    }
+    return connected_socket;
+}
 
-    int sock = -1;
-    LIBSSH2_SESSION *session = NULL;
-    LIBSSH2_SFTP *sftp = NULL;
-    macfusegui_libssh2_session_handle *handle = NULL;
-    int64_t deadline_ms = macfusegui_deadline_from_timeout_seconds(timeout_seconds);
+int32_t macfusegui_libssh2_connect_numeric_candidates(
+    const char *const *numeric_hosts,
+    int32_t host_count,
+    int32_t port,
+    int32_t timeout_ms,
+    int32_t attempt_delay_ms,
+    macfusegui_libssh2_connect_report *out_report
+) {
+    if (out_report != NULL) {
+        memset(out_report, 0, sizeof(*out_report));
+    }
+    if (numeric_hosts == NULL || host_count <= 0 || port <= 0 || timeout_ms <= 0 || attempt_delay_ms < 0) {
+        return -1;
+    }
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    hints.ai_flags = AI_NUMERICHOST | AI_NUMERICSERV;
+
+    char port_buffer[16];
+    snprintf(port_buffer, sizeof(port_buffer), "%d", (int)port);
+
+    /* Candidates keep caller order, which stands in for resolver preference. */
+    macfusegui_resolved_address resolved[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    const macfusegui_resolved_address *candidates[MACFUSEGUI_CONNECT_MAX_CANDIDATES];
+    int32_t candidate_count = 0;
+    for (int32_t idx = 0; idx < host_count && candidate_count < MACFUSEGUI_CONNECT_MAX_CANDIDATES; idx += 1) {
+        struct addrinfo *numeric = NULL;
+        if (numeric_hosts[idx] == NULL || getaddrinfo(numeric_hosts[idx], port_buffer, &hints, &numeric) != 0) {
+            continue;
+        }
+        if (macfusegui_copy_addrinfo(numeric, &resolved[candidate_count], 1) == 1) {
+            candidates[candidate_count] = &resolved[candidate_count];
+            candidate_count += 1;
+        }
+        freeaddrinfo(numeric);
+    }
+
+    bool timeout_config_failure = false;
+    int connected_socket = macfusegui_race_connect(
+        candidates,
+        candidate_count,
+        macfusegui_now_millis() + timeout_ms,
+        attempt_delay_ms,
+        0,
+        &timeout_config_failure,
+        out_report
+    );
+
+    return connected_socket;
+}
+
+#define MACFUSEGUI_FLAT_INITIAL_ENTRY_CAPACITY 64
+#define MACFUSEGUI_FLAT_INITIAL_NAME_BLOB_CAPACITY 4096
+
+/* Grows the entry array geometrically so N appends cost O(log N) reallocs, not N. */
+static int macfusegui_flat_reserve_entries(macfusegui_libssh2_flat_list_result *result, int32_t needed) {
+    if (needed <= result->entry_capacity) {
+        return 0;
+    }
+
+    int64_t capacity = result->entry_capacity > 0 ? result->entry_capacity : MACFUSEGUI_FLAT_INITIAL_ENTRY_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    if (capacity > INT32_MAX) {
+        capacity = INT32_MAX;
+    }
+    if (capacity < needed) {
+        return -1;
+    }
+
+    macfusegui_libssh2_flat_entry *resized = (macfusegui_libssh2_flat_entry *)realloc(
+        result->entries,
+        (size_t)capacity * sizeof(macfusegui_libssh2_flat_entry)
+    );
+    if (resized == NULL) {
+        return -1;
+    }
+
+    result->entries = resized;
+    result->entry_capacity = (int32_t)capacity;
+    result->allocation_count += 1;
+    return 0;
+}
+
+/* Name offsets are 32-bit, so the blob is capped at UINT32_MAX bytes. */
+static int macfusegui_flat_reserve_name_bytes(macfusegui_libssh2_flat_list_result *result, uint64_t needed) {
+    if (needed <= result->name_blob_capacity) {
+        return 0;
+    }
+    if (needed > (uint64_t)UINT32_MAX) {
+        return -1;
+    }
+
+    uint64_t capacity = result->name_blob_capacity > 0 ? result->name_blob_capacity : MACFUSEGUI_FLAT_INITIAL_NAME_BLOB_CAPACITY;
+    while (capacity < needed) {
+        capacity *= 2;
+    }
+    if (capacity > (uint64_t)UINT32_MAX) {
+        capacity = (uint64_t)UINT32_MAX;
+    }
+
+    char *resized = (char *)realloc(result->name_blob, (size_t)capacity);
+    if (resized == NULL) {
+        return -1;
+    }
+
+    result->name_blob = resized;
+    result->name_blob_capacity = capacity;
+    result->allocation_count += 1;
+    return 0;
+}
+
+static int macfusegui_flat_append_entry(
+    macfusegui_libssh2_flat_list_result *result,
+    const char *name,
+    size_t name_len,
+    uint8_t is_directory,
+    uint8_t has_size,
+    uint64_t size_bytes,
+    uint8_t has_modified_at,
+    int64_t modified_at_unix
+) {
+    if (result == NULL || name == NULL || name_len == 0 || result->entry_count == INT32_MAX) {
+        return -1;
+    }
+
+    uint64_t name_offset = result->name_blob_length;
+    if (macfusegui_flat_reserve_entries(result, result->entry_count + 1) != 0 ||
+        macfusegui_flat_reserve_name_bytes(result, name_offset + (uint64_t)name_len + 1) != 0) {
+        return -1;
+    }
+
+    memcpy(result->name_blob + name_offset, name, name_len);
+    result->name_blob[name_offset + name_len] = '\0';
+    result->name_blob_length = name_offset + (uint64_t)name_len + 1;
+
+    macfusegui_libssh2_flat_entry *entry = &result->entries[result->entry_count];
+    memset(entry, 0, sizeof(*entry));
+
+    entry->name_offset = (uint32_t)name_offset;
+    entry->name_length = (uint32_t)name_len;
+    entry->is_directory = is_directory;
+    entry->has_size = has_size;
+    entry->size_bytes = size_bytes;
+    entry->has_modified_at = has_modified_at;
+    entry->modified_at_unix = modified_at_unix;
+
+    result->entry_count += 1;
+    return 0;
+}
+
+/* Legacy layout support: one exact-size entry array plus one string per name. */
+static int macfusegui_copy_flat_to_list_result(
+    const macfusegui_libssh2_flat_list_result *flat,
+    macfusegui_libssh2_list_result *result
+) {
+    result->status_code = flat->status_code;
+    result->latency_ms = flat->latency_ms;
+    result->timing = flat->timing;
+
+    if (flat->resolved_path != NULL) {
+        result->resolved_path = macfusegui_strdup(flat->resolved_path);
+    }
+    if (flat->error_message != NULL) {
+        result->error_message = macfusegui_strdup(flat->error_message);
+    }
+
+    if (flat->entry_count <= 0) {
+        return 0;
+    }
+
+    result->entries = (macfusegui_libssh2_entry *)calloc((size_t)flat->entry_count, sizeof(macfusegui_libssh2_entry));
+    if (result->entries == NULL) {
+        return -1;
+    }
+
+    for (int32_t idx = 0; idx < flat->entry_count; idx += 1) {
+        const macfusegui_libssh2_flat_entry *source = &flat->entries[idx];
+        macfusegui_libssh2_entry *entry = &result->entries[idx];
+
+        entry->name = macfusegui_strdup_len(flat->name_blob + source->name_offset, source->name_length);
+        if (entry->name == NULL) {
+            return -1;
+        }
+        entry->is_directory = source->is_directory;
+        entry->has_size = source->has_size;
+        entry->size_bytes = source->size_bytes;
+        entry->has_modified_at = source->has_modified_at;
+        entry->modified_at_unix = source->modified_at_unix;
+        result->entry_count = idx + 1;
+    }
+
+    return 0;
+}
+
+static int macfusegui_session_handshake_with_deadline(
+    LIBSSH2_SESSION *session,
+    int sock,
+    int64_t deadline_ms
+) {
+    while (1) {
+        int handshake_result = libssh2_session_handshake(session, sock);
+        if (handshake_result == 0) {
+            return 0;
+        }
+        if (handshake_result != LIBSSH2_ERROR_EAGAIN) {
+            return handshake_result;
+        }
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            return wait_result;
+        }
+    }
+}
+
+static int macfusegui_password_auth_with_deadline(
+    LIBSSH2_SESSION *session,
+    int sock,
+    const char *username,
+    const char *password,
+    int64_t deadline_ms
+) {
+    while (1) {
+        int auth_result = libssh2_userauth_password_ex(
+            session,
+            username,
+            (unsigned int)strlen(username),
+            password,
+            (unsigned int)strlen(password),
+            NULL
+        );
+        if (auth_result == 0) {
+            return 0;
+        }
+        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
+            return auth_result;
+        }
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            return wait_result;
+        }
+    }
+}
+
+static int macfusegui_kbdint_auth_with_deadline(
+    LIBSSH2_SESSION *session,
+    int sock,
+    const char *username,
+    const char *password,
+    int64_t deadline_ms
+) {
+    macfusegui_kbdint_context *keyboard_context = (macfusegui_kbdint_context *)malloc(sizeof(*keyboard_context));
+    if (keyboard_context == NULL) {
+        return LIBSSH2_ERROR_ALLOC;
+    }
+    keyboard_context->password = password;
+
+    void **session_abstract = libssh2_session_abstract(session);
+    void *previous_abstract = NULL;
+    if (session_abstract != NULL) {
+        previous_abstract = *session_abstract;
+        *session_abstract = keyboard_context;
+    }
+
+    int auth_result = LIBSSH2_ERROR_EAGAIN;
+    while (1) {
+        auth_result = libssh2_userauth_keyboard_interactive_ex(
+            session,
+            username,
+            (unsigned int)strlen(username),
+            macfusegui_kbdint_response_callback
+        );
+        if (auth_result == 0) {
+            break;
+        }
+        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
+            break;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            auth_result = wait_result;
+            break;
+        }
+    }
+
+    if (session_abstract != NULL) {
+        *session_abstract = previous_abstract;
+    }
+    free(keyboard_context);
+    return auth_result;
+}
+
+static int macfusegui_publickey_auth_with_deadline(
+    LIBSSH2_SESSION *session,
+    int sock,
+    const char *username,
+    const char *private_key_path,
+    int64_t deadline_ms
+) {
+    while (1) {
+        int auth_result = libssh2_userauth_publickey_fromfile_ex(
+            session,
+            username,
+            (unsigned int)strlen(username),
+            NULL,
+            private_key_path,
+            NULL
+        );
+        if (auth_result == 0) {
+            return 0;
+        }
+        if (auth_result != LIBSSH2_ERROR_EAGAIN) {
+            return auth_result;
+        }
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            return wait_result;
+        }
+    }
+}
+
+static LIBSSH2_SFTP *macfusegui_sftp_init_with_deadline(
+    LIBSSH2_SESSION *session,
+    int sock,
+    int64_t deadline_ms,
+    int *out_status
+) {
+    while (1) {
+        LIBSSH2_SFTP *sftp = libssh2_sftp_init(session);
+        if (sftp != NULL) {
+            if (out_status != NULL) {
+                *out_status = 0;
+            }
+            return sftp;
+        }
+
+        int last_error = libssh2_session_last_errno(session);
+        if (last_error != LIBSSH2_ERROR_EAGAIN) {
+            if (out_status != NULL) {
+                *out_status = last_error;
+            }
+            return NULL;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            if (out_status != NULL) {
+                *out_status = wait_result;
+            }
+            return NULL;
+        }
+    }
+}
+
+static ssize_t macfusegui_sftp_realpath_with_deadline(
+    LIBSSH2_SESSION *session,
+    LIBSSH2_SFTP *sftp,
+    int sock,
+    const char *remote_path,
+    char *buffer,
+    size_t buffer_size,
+    int64_t deadline_ms,
+    int *out_status
+) {
+    if (buffer_size > (size_t)UINT_MAX) {
+        if (out_status != NULL) {
+            *out_status = LIBSSH2_ERROR_BUFFER_TOO_SMALL;
+        }
+        return LIBSSH2_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    unsigned int buffer_size_u32 = (unsigned int)buffer_size;
+
+    while (1) {
+        ssize_t result = libssh2_sftp_realpath(sftp, remote_path, buffer, buffer_size_u32);
+        if (result >= 0) {
+            if (out_status != NULL) {
+                *out_status = 0;
+            }
+            return result;
+        }
+        if (result != LIBSSH2_ERROR_EAGAIN) {
+            if (out_status != NULL) {
+                *out_status = (int)result;
+            }
+            return result;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            if (out_status != NULL) {
+                *out_status = wait_result;
+            }
+            return result;
+        }
+    }
+}
+
+static LIBSSH2_SFTP_HANDLE *macfusegui_sftp_opendir_with_deadline(
+    LIBSSH2_SESSION *session,
+    LIBSSH2_SFTP *sftp,
+    int sock,
+    const char *path,
+    int64_t deadline_ms,
+    int *out_status
+) {
+    while (1) {
+        LIBSSH2_SFTP_HANDLE *handle = libssh2_sftp_opendir(sftp, path);
+        if (handle != NULL) {
+            if (out_status != NULL) {
+                *out_status = 0;
+            }
+            return handle;
+        }
+
+        int last_error = libssh2_session_last_errno(session);
+        if (last_error != LIBSSH2_ERROR_EAGAIN) {
+            if (out_status != NULL) {
+                *out_status = last_error;
+            }
+            return NULL;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            if (out_status != NULL) {
+                *out_status = wait_result;
+            }
+            return NULL;
+        }
+    }
+}
+
+static ssize_t macfusegui_sftp_readdir_with_deadline(
+    LIBSSH2_SESSION *session,
+    LIBSSH2_SFTP_HANDLE *directory_handle,
+    int sock,
+    char *file_name,
+    size_t file_name_size,
+    char *long_entry,
+    size_t long_entry_size,
+    LIBSSH2_SFTP_ATTRIBUTES *attrs,
+    int64_t deadline_ms,
+    int *out_status
+) {
+    while (1) {
+        ssize_t result = libssh2_sftp_readdir_ex(
+            directory_handle,
+            file_name,
+            file_name_size,
+            long_entry,
+            long_entry_size,
+            attrs
+        );
+        if (result != LIBSSH2_ERROR_EAGAIN) {
+            if (out_status != NULL) {
+                *out_status = (result < 0) ? (int)result : 0;
+            }
+            return result;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            if (out_status != NULL) {
+                *out_status = wait_result;
+            }
+            return result;
+        }
+    }
+}
+
+static int macfusegui_sftp_stat_with_deadline(
+    LIBSSH2_SESSION *session,
+    LIBSSH2_SFTP *sftp,
+    int sock,
+    const char *path,
+    LIBSSH2_SFTP_ATTRIBUTES *attrs,
+    int64_t deadline_ms,
+    int *out_status
+) {
+    while (1) {
+        int stat_result = libssh2_sftp_stat_ex(
+            sftp,
+            path,
+            (unsigned int)strlen(path),
+            LIBSSH2_SFTP_STAT,
+            attrs
+        );
+        if (stat_result != LIBSSH2_ERROR_EAGAIN) {
+            if (out_status != NULL) {
+                *out_status = 0;
+            }
+            return stat_result;
+        }
+
+        int wait_result = macfusegui_wait_socket(session, sock, deadline_ms);
+        if (wait_result != 0) {
+            if (out_status != NULL) {
+                *out_status = wait_result;
+            }
+            return stat_result;
+        }
+    }
+}
+
+/*
+ Per-session canonical path cache. The handle is only touched from its remote's executor,
+ so the cache needs no lock. A small LRU is enough: navigation revisits a handful of
+ ancestors, and children are derived from their canonical parent once a full listing of
+ that parent has shown they are not symlinks.
+*/
+#define MACFUSEGUI_CANONICAL_CACHE_SLOTS 64
+/* Directories with more symlinks than this simply do not derive children. */
+#define MACFUSEGUI_LINK_NAMES_MAX_BYTES 16384
+
+typedef struct macfusegui_canonical_entry {
+    char *requested;
+    size_t requested_length;
+    char *canonical;
+    uint64_t last_used;
+    /* Set after a complete listing of this directory; link_names lists its symlinked entries. */
+    bool children_known;
+    char *link_names;
+    size_t link_names_length;
+} macfusegui_canonical_entry;
+
+/* NUL-separated names of the symlinks seen while listing one directory. */
+typedef struct macfusegui_link_names {
+    char *names;
+    size_t length;
+    size_t capacity;
+    bool overflowed;
+} macfusegui_link_names;
+
+typedef struct macfusegui_canonical_cache {
+    macfusegui_canonical_entry entries[MACFUSEGUI_CANONICAL_CACHE_SLOTS];
+    uint64_t clock;
+} macfusegui_canonical_cache;
+
+static macfusegui_canonical_entry *macfusegui_canonical_find(
+    macfusegui_canonical_cache *cache,
+    const char *requested,
+    size_t requested_length
+) {
+    for (int32_t idx = 0; idx < MACFUSEGUI_CANONICAL_CACHE_SLOTS; idx += 1) {
+        macfusegui_canonical_entry *entry = &cache->entries[idx];
+        if (entry->requested != NULL && entry->requested_length == requested_length &&
+            memcmp(entry->requested, requested, requested_length) == 0) {
+            cache->clock += 1;
+            entry->last_used = cache->clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void macfusegui_canonical_entry_clear(macfusegui_canonical_entry *entry) {
+    free(entry->requested);
+    free(entry->canonical);
+    free(entry->link_names);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static void macfusegui_canonical_entry_forget_children(macfusegui_canonical_entry *entry) {
+    free(entry->link_names);
+    entry->link_names = NULL;
+    entry->link_names_length = 0;
+    entry->children_known = false;
+}
+
+static bool macfusegui_canonical_entry_has_link(
+    const macfusegui_canonical_entry *entry,
+    const char *name,
+    size_t name_length
+) {
+    size_t offset = 0;
+    while (offset < entry->link_names_length) {
+        const char *candidate = entry->link_names + offset;
+        size_t candidate_length = strlen(candidate);
+        if (candidate_length == name_length && memcmp(candidate, name, name_length) == 0) {
+            return true;
+        }
+        offset += candidate_length + 1;
+    }
+    return false;
+}
+
+/* True when path equals prefix or lies below it (prefix "/" contains every absolute path). */
+static bool macfusegui_path_within(const char *path, size_t path_length, const char *prefix, size_t prefix_length) {
+    if (path == NULL || path_length < prefix_length || memcmp(path, prefix, prefix_length) != 0) {
+        return false;
+    }
+    return path_length == prefix_length || path[prefix_length] == '/' ||
+        (prefix_length == 1 && prefix[0] == '/');
+}
+
+static bool macfusegui_entry_is_link(unsigned long attrs_flags, unsigned long permissions, const char *long_entry) {
+    if ((attrs_flags & LIBSSH2_SFTP_ATTR_PERMISSIONS) && LIBSSH2_SFTP_S_ISLNK(permissions)) {
+        return true;
+    }
+    return long_entry != NULL && long_entry[0] == 'l';
+}
+
+static void macfusegui_link_names_add(macfusegui_link_names *links, const char *name, size_t name_length) {
+    if (links->overflowed) {
+        return;
+    }
+    size_t needed = links->length + name_length + 1;
+    if (needed > MACFUSEGUI_LINK_NAMES_MAX_BYTES) {
+        links->overflowed = true;
+        return;
+    }
+    if (needed > links->capacity) {
+        size_t capacity = links->capacity > 0 ? links->capacity * 2 : 256;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+        char *grown = (char *)realloc(links->names, capacity);
+        if (grown == NULL) {
+            links->overflowed = true;
+            return;
+        }
+        links->names = grown;
+        links->capacity = capacity;
+    }
+    memcpy(links->names + links->length, name, name_length);
+    links->names[links->length + name_length] = '\0';
+    links->length = needed;
+}
+
+static void macfusegui_link_names_reset(macfusegui_link_names *links) {
+    free(links->names);
+    memset(links, 0, sizeof(*links));
+}
+
+/* Only plain components can be appended to a canonical parent; "." and ".." need the server. */
+static bool macfusegui_path_suffix_is_plain(const char *suffix) {
+    const char *cursor = suffix;
+    while (*cursor != '\0') {
+        while (*cursor == '/') {
+            cursor += 1;
+        }
+        const char *component = cursor;
+        while (*cursor != '\0' && *cursor != '/') {
+            cursor += 1;
+        }
+        size_t length = (size_t)(cursor - component);
+        if ((length == 1 && component[0] == '.') || (length == 2 && component[0] == '.' && component[1] == '.')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int32_t macfusegui_libssh2_session_canonical_path(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *requested_path,
+    char *buffer,
+    int32_t buffer_size
+) {
+    if (session_handle == NULL || session_handle->canonical_paths == NULL || requested_path == NULL ||
+        buffer == NULL || buffer_size <= 0) {
+        return -1;
+    }
+    macfusegui_canonical_cache *cache = (macfusegui_canonical_cache *)session_handle->canonical_paths;
+    size_t requested_length = strlen(requested_path);
+    while (requested_length > 1 && requested_path[requested_length - 1] == '/') {
+        requested_length -= 1;
+    }
+
+    macfusegui_canonical_entry *exact = macfusegui_canonical_find(cache, requested_path, requested_length);
+    if (exact != NULL) {
+        size_t length = strlen(exact->canonical);
+        if (length + 1 > (size_t)buffer_size) {
+            return -1;
+        }
+        memcpy(buffer, exact->canonical, length + 1);
+        return (int32_t)length;
+    }
+
+    /* Relative and "~" paths depend on the server's idea of home; only derive absolute ones. */
+    if (requested_path[0] != '/' || !macfusegui_path_suffix_is_plain(requested_path)) {
+        return -1;
+    }
+
+    /*
+     Derive a direct child of a cached parent: canonical(parent) + "/" + name is the server's
+     canonical spelling only when name is not a symlink, which a complete listing of the parent
+     has to have shown. Anything deeper, or any link, goes through realpath.
+    */
+    const char *last_separator = NULL;
+    for (size_t idx = requested_length; idx > 0; idx -= 1) {
+        if (requested_path[idx - 1] == '/') {
+            last_separator = requested_path + idx - 1;
+            break;
+        }
+    }
+    if (last_separator == NULL) {
+        return -1;
+    }
+    const char *name = last_separator + 1;
+    size_t name_length = requested_length - (size_t)(name - requested_path);
+    size_t parent_length = last_separator > requested_path ? (size_t)(last_separator - requested_path) : 1;
+    if (name_length == 0) {
+        return -1;
+    }
+    macfusegui_canonical_entry *parent = macfusegui_canonical_find(cache, requested_path, parent_length);
+    if (parent == NULL) {
+        return -1;
+    }
+    /* Children are recorded on the parent's canonical spelling, e.g. "/Users/dev" for "/home/dev". */
+    macfusegui_canonical_entry *listing = parent;
+    if (!listing->children_known) {
+        listing = macfusegui_canonical_find(cache, parent->canonical, strlen(parent->canonical));
+    }
+    if (listing == NULL || !listing->children_known || macfusegui_canonical_entry_has_link(listing, name, name_length)) {
+        return -1;
+    }
+
+    size_t canonical_length = strlen(parent->canonical);
+    bool needs_separator = canonical_length == 0 || parent->canonical[canonical_length - 1] != '/';
+    size_t total = canonical_length + (needs_separator ? 1 : 0) + name_length;
+    if (total + 1 > (size_t)buffer_size) {
+        return -1;
+    }
+    memcpy(buffer, parent->canonical, canonical_length);
+    size_t offset = canonical_length;
+    if (needs_separator) {
+        buffer[offset] = '/';
+        offset += 1;
+    }
+    memcpy(buffer + offset, name, name_length);
+    buffer[total] = '\0';
+    return (int32_t)total;
+}
+
+void macfusegui_libssh2_session_remember_canonical_path(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *requested_path,
+    const char *canonical_path
+) {
+    if (session_handle == NULL || requested_path == NULL || canonical_path == NULL || canonical_path[0] != '/') {
+        return;
+    }
+    if (session_handle->canonical_paths == NULL) {
+        session_handle->canonical_paths = calloc(1, sizeof(macfusegui_canonical_cache));
+        if (session_handle->canonical_paths == NULL) {
+            return;
+        }
+    }
+    macfusegui_canonical_cache *cache = (macfusegui_canonical_cache *)session_handle->canonical_paths;
+    size_t requested_length = strlen(requested_path);
+    while (requested_length > 1 && requested_path[requested_length - 1] == '/') {
+        requested_length -= 1;
+    }
+
+    macfusegui_canonical_entry *slot = macfusegui_canonical_find(cache, requested_path, requested_length);
+    if (slot == NULL) {
+        slot = &cache->entries[0];
+        for (int32_t idx = 0; idx < MACFUSEGUI_CANONICAL_CACHE_SLOTS; idx += 1) {
+            macfusegui_canonical_entry *candidate = &cache->entries[idx];
+            if (candidate->requested == NULL) {
+                slot = candidate;
+                break;
+            }
+            if (candidate->last_used < slot->last_used) {
+                slot = candidate;
+            }
+        }
+        macfusegui_canonical_entry_clear(slot);
+        slot->requested = macfusegui_strdup_len(requested_path, requested_length);
+        slot->requested_length = requested_length;
+    } else if (strcmp(slot->canonical, canonical_path) == 0) {
+        return;
+    }
+
+    /* A different canonical target means a different directory: its children are unknown. */
+    macfusegui_canonical_entry_forget_children(slot);
+    free(slot->canonical);
+    slot->canonical = macfusegui_strdup(canonical_path);
+    if (slot->requested == NULL || slot->canonical == NULL) {
+        macfusegui_canonical_entry_clear(slot);
+        return;
+    }
+    cache->clock += 1;
+    slot->last_used = cache->clock;
+}
+
+void macfusegui_libssh2_session_forget_canonical_paths(macfusegui_libssh2_session_handle *session_handle) {
+    if (session_handle == NULL || session_handle->canonical_paths == NULL) {
+        return;
+    }
+    macfusegui_canonical_cache *cache = (macfusegui_canonical_cache *)session_handle->canonical_paths;
+    for (int32_t idx = 0; idx < MACFUSEGUI_CANONICAL_CACHE_SLOTS; idx += 1) {
+        macfusegui_canonical_entry_clear(&cache->entries[idx]);
+    }
+    free(cache);
+    session_handle->canonical_paths = NULL;
+}
+
+void macfusegui_libssh2_session_forget_canonical_subtree(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *path
+) {
+    if (session_handle == NULL || session_handle->canonical_paths == NULL || path == NULL) {
+        return;
+    }
+    size_t path_length = strlen(path);
+    while (path_length > 1 && path[path_length - 1] == '/') {
+        path_length -= 1;
+    }
+    if (path_length == 0) {
+        return;
+    }
+
+    /* Any spelling that resolved into the subtree goes too, e.g. "~" for a removed home. */
+    macfusegui_canonical_cache *cache = (macfusegui_canonical_cache *)session_handle->canonical_paths;
+    for (int32_t idx = 0; idx < MACFUSEGUI_CANONICAL_CACHE_SLOTS; idx += 1) {
+        macfusegui_canonical_entry *entry = &cache->entries[idx];
+        if (entry->requested == NULL) {
+            continue;
+        }
+        if (macfusegui_path_within(entry->requested, entry->requested_length, path, path_length) ||
+            macfusegui_path_within(entry->canonical, strlen(entry->canonical), path, path_length)) {
+            macfusegui_canonical_entry_clear(entry);
+        }
+    }
+}
+
+/* True when the last SFTP failure means the path (or a component of it) no longer exists. */
+static bool macfusegui_sftp_path_missing(LIBSSH2_SFTP *sftp) {
+    unsigned long sftp_error = libssh2_sftp_last_error(sftp);
+    return sftp_error == LIBSSH2_FX_NO_SUCH_FILE || sftp_error == LIBSSH2_FX_NO_SUCH_PATH;
+}
+
+/*
+ Records which entries of a completely listed directory are symlinks, so its other children can
+ be derived without realpath. The directory must already be cached under its canonical path.
+*/
+static void macfusegui_remember_directory_children(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *canonical_path,
+    const macfusegui_link_names *links
+) {
+    if (session_handle == NULL || session_handle->canonical_paths == NULL || canonical_path == NULL) {
+        return;
+    }
+    size_t length = strlen(canonical_path);
+    while (length > 1 && canonical_path[length - 1] == '/') {
+        length -= 1;
+    }
+    macfusegui_canonical_cache *cache = (macfusegui_canonical_cache *)session_handle->canonical_paths;
+    macfusegui_canonical_entry *entry = macfusegui_canonical_find(cache, canonical_path, length);
+    if (entry == NULL) {
+        return;
+    }
+    macfusegui_canonical_entry_forget_children(entry);
+    if (links->overflowed) {
+        return;
+    }
+    if (links->length > 0) {
+        entry->link_names = (char *)malloc(links->length);
+        if (entry->link_names == NULL) {
+            return;
+        }
+        memcpy(entry->link_names, links->names, links->length);
+        entry->link_names_length = links->length;
+    }
+    entry->children_known = true;
+}
+
+void macfusegui_libssh2_session_remember_directory_links(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *canonical_path,
+    const char *const *link_names,
+    int32_t link_count
+) {
+    macfusegui_link_names links;
+    memset(&links, 0, sizeof(links));
+    for (int32_t idx = 0; idx < link_count && link_names != NULL; idx += 1) {
+        if (link_names[idx] != NULL) {
+            macfusegui_link_names_add(&links, link_names[idx], strlen(link_names[idx]));
+        }
+    }
+    macfusegui_remember_directory_children(session_handle, canonical_path, &links);
+    macfusegui_link_names_reset(&links);
+}
+
+/* Evicts a path opendir/stat reported missing, under both spellings, with everything below it. */
+static void macfusegui_forget_missing_path(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *requested_path,
+    const char *effective_path
+) {
+    if (requested_path != NULL && requested_path[0] == '/') {
+        macfusegui_libssh2_session_forget_canonical_subtree(session_handle, requested_path);
+    }
+    if (effective_path != NULL && effective_path != requested_path) {
+        macfusegui_libssh2_session_forget_canonical_subtree(session_handle, effective_path);
+    }
+}
+
+/* Remembers both the requested spelling and the canonical path itself, so children of either derive. */
+static void macfusegui_remember_resolved_path(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *requested_path,
+    const char *canonical_path
+) {
+    macfusegui_libssh2_session_remember_canonical_path(session_handle, requested_path, canonical_path);
+    if (strcmp(requested_path, canonical_path) != 0) {
+        macfusegui_libssh2_session_remember_canonical_path(session_handle, canonical_path, canonical_path);
+    }
+}
+
+int32_t macfusegui_libssh2_bridge_version(void) {
+    return 21;
+}
+
+int32_t macfusegui_libssh2_open_session(
+    const char *host,
+    int32_t port,
+    const char *username,
+    const char *password,
+    const char *private_key_path,
+    int32_t timeout_seconds,
+    macfusegui_libssh2_session_handle **out_session,
+    char **out_error_message
+) {
+    return macfusegui_libssh2_open_session_with_options(
+        host,
+        port,
+        username,
+        password,
+        private_key_path,
+        timeout_seconds,
+        NULL,
+        out_session,
+        out_error_message
+    );
+}
+
+int32_t macfusegui_libssh2_open_session_with_options(
+    const char *host,
+    int32_t port,
+    const char *username,
+    const char *password,
+    const char *private_key_path,
+    int32_t timeout_seconds,
+    const macfusegui_libssh2_socket_options *socket_options,
+    macfusegui_libssh2_session_handle **out_session,
+    char **out_error_message
+) {
+    /*
+     Open session flow:
+     1) Connect TCP socket with timeout.
+     2) Handshake SSH session.
+     3) Authenticate (password/kbdint/private key).
+     4) Initialize SFTP subsystem.
+     5) Return persistent session handle.
+    */
+    if (out_session == NULL) {
+        return -1;
+    }
+    *out_session = NULL;
+
+    if (out_error_message != NULL) {
+        *out_error_message = NULL;
+    }
+
+    if (host == NULL || username == NULL || port <= 0 || timeout_seconds <= 0) {
+        macfusegui_set_out_error(out_error_message, "Invalid browser session open request.");
+        return -100;
+    }
+    int32_t timeout_ms = macfusegui_timeout_ms_from_seconds(timeout_seconds);
+
+    pthread_once(&g_libssh2_once, macfusegui_libssh2_global_init);
+
+    int sock = -1;
+    LIBSSH2_SESSION *session = NULL;
+    LIBSSH2_SFTP *sftp = NULL;
+    macfusegui_libssh2_session_handle *handle = NULL;
+    int64_t deadline_ms = macfusegui_deadline_from_timeout_ms(timeout_ms);
+
+    bool timeout_config_failure = false;
+    macfusegui_libssh2_connect_report connect_report;
+    memset(&connect_report, 0, sizeof(connect_report));
+    macfusegui_libssh2_stage_timing timing;
+    memset(&timing, 0, sizeof(timing));
+    macfusegui_libssh2_socket_options default_socket_options;
+    if (socket_options == NULL) {
+        macfusegui_libssh2_socket_options_default(&default_socket_options);
+        socket_options = &default_socket_options;
+    }
+    sock = macfusegui_connect_socket(host, port, timeout_seconds, socket_options, &timeout_config_failure, &connect_report, &timing);
+    if (sock == MACFUSEGUI_CONNECT_ERROR_SOCKET_TIMEOUT_CONFIG || timeout_config_failure) {
+        macfusegui_set_out_error(out_error_message, "Failed to configure socket send/receive timeouts.");
+        goto cleanup_error;
+    }
+    if (sock < 0) {
+        macfusegui_set_out_error(out_error_message, "Could not connect to remote host.");
+        goto cleanup_error;
+    }
+
+    session = libssh2_session_init_ex(NULL, NULL, NULL, NULL);
+    if (session == NULL) {
+        macfusegui_set_out_error(out_error_message, "Failed to initialize libssh2 session.");
+        goto cleanup_error;
+    }
+
+    libssh2_session_set_blocking(session, 0);
+    libssh2_session_set_timeout(session, timeout_ms);
+
+    int64_t stage_started_at = macfusegui_now_micros();
+    int32_t stage_waits = g_socket_wait_count;
+    int handshake_result = macfusegui_session_handshake_with_deadline(session, sock, deadline_ms);
+    timing.handshake_us = macfusegui_now_micros() - stage_started_at;
+    timing.handshake_round_trips = g_socket_wait_count - stage_waits;
+    if (handshake_result == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+        macfusegui_set_out_timeout_error(out_error_message, "SSH handshake", timeout_ms);
+        goto cleanup_error;
+    }
+    if (handshake_result != 0) {
+        macfusegui_set_out_session_error(out_error_message, session, "SSH handshake failed.");
+        goto cleanup_error;
+    }
+
+    stage_started_at = macfusegui_now_micros();
+    stage_waits = g_socket_wait_count;
+    if (password != NULL && password[0] != '\0') {
+        int auth = macfusegui_password_auth_with_deadline(session, sock, username, password, deadline_ms);
+
+        if (auth != 0) {
+            if (auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_out_timeout_error(out_error_message, "password authentication", timeout_ms);
+                goto cleanup_error;
+            }
+
+            int keyboard_auth = macfusegui_kbdint_auth_with_deadline(session, sock, username, password, deadline_ms);
+
+            if (keyboard_auth != 0) {
+                if (keyboard_auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                    macfusegui_set_out_timeout_error(out_error_message, "keyboard-interactive authentication", timeout_ms);
+                    goto cleanup_error;
+                }
+                macfusegui_set_out_session_error(out_error_message, session, "Password authentication failed.");
+                goto cleanup_error;
+            }
+        }
+    } else if (private_key_path != NULL && private_key_path[0] != '\0') {
+        int auth = macfusegui_publickey_auth_with_deadline(session, sock, username, private_key_path, deadline_ms);
+        if (auth != 0) {
+            if (auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_out_timeout_error(out_error_message, "public-key authentication", timeout_ms);
+                goto cleanup_error;
+            }
+            macfusegui_set_out_session_error(out_error_message, session, "Private key authentication failed.");
+            goto cleanup_error;
+        }
+    } else {
+        macfusegui_set_out_error(out_error_message, "No authentication material provided.");
+        goto cleanup_error;
+    }
+
+    timing.auth_us = macfusegui_now_micros() - stage_started_at;
+    timing.auth_round_trips = g_socket_wait_count - stage_waits;
+
+    stage_started_at = macfusegui_now_micros();
+    stage_waits = g_socket_wait_count;
+    int sftp_init_status = 0;
+    sftp = macfusegui_sftp_init_with_deadline(session, sock, deadline_ms, &sftp_init_status);
+    timing.sftp_init_us = macfusegui_now_micros() - stage_started_at;
+    timing.sftp_init_round_trips = g_socket_wait_count - stage_waits;
+    if (sftp == NULL) {
+        if (sftp_init_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+            macfusegui_set_out_timeout_error(out_error_message, "SFTP subsystem initialization", timeout_ms);
+            goto cleanup_error;
+        }
+        macfusegui_set_out_session_error(out_error_message, session, "Unable to initialize SFTP subsystem.");
+        goto cleanup_error;
+    }
+
+    handle = (macfusegui_libssh2_session_handle *)malloc(sizeof(*handle));
+    if (handle == NULL) {
+        macfusegui_set_out_error(out_error_message, "Failed to allocate libssh2 browser session.");
+        goto cleanup_error;
+    }
+
+    memset(handle, 0, sizeof(*handle));
+    handle->sock = sock;
+    handle->session = session;
+    handle->sftp = sftp;
+    handle->connect_report = connect_report;
+    handle->open_timing = timing;
+
+    *out_session = handle;
+    return 0;
+
+cleanup_error:
+    if (sftp != NULL) {
+        (void)libssh2_sftp_shutdown(sftp);
+        sftp = NULL;
+    }
+
+    if (session != NULL) {
+        (void)libssh2_session_disconnect_ex(session, SSH_DISCONNECT_BY_APPLICATION, "macfuseGui", "en");
+        (void)libssh2_session_free(session);
+        session = NULL;
+    }
+
+    if (sock >= 0) {
+        close(sock);
+        sock = -1;
+    }
+
+    if (handle != NULL) {
+        free(handle);
+        handle = NULL;
+    }
+
+    return -101;
+}
+
+/*
+ libssh2 keeps per-request state on the SFTP channel, so abandoning a request mid-flight would
+ hand its reply to the next call. Cancellation therefore stops watching the token and finishes
+ the current request (result discarded) under a short deadline; if that also times out, the
+ stage's timeout error tells Swift to drop the session instead.
+*/
+static int64_t macfusegui_begin_cancel_drain(int64_t deadline_ms) {
+    g_active_cancel_token = NULL;
+    int64_t drain_deadline = macfusegui_now_millis() + MACFUSEGUI_LIBSSH2_CANCEL_DRAIN_MS;
+    return drain_deadline < deadline_ms ? drain_deadline : deadline_ms;
+}
+
+static void macfusegui_set_flat_cancelled(macfusegui_libssh2_flat_list_result *result) {
+    macfusegui_set_flat_error(result, MACFUSEGUI_LIBSSH2_STATUS_CANCELLED, "Remote directory listing was cancelled.");
+}
+
+int32_t macfusegui_libssh2_list_directories_flat_with_session(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    macfusegui_libssh2_flat_list_result *out_result
+) {
+    return macfusegui_libssh2_list_directories_streaming_with_session(
+        session_handle,
+        remote_path,
+        timeout_seconds,
+        0,
+        0,
+        NULL,
+        NULL,
+        out_result
+    );
+}
+
+static void macfusegui_validator_from_attrs(
+    const LIBSSH2_SFTP_ATTRIBUTES *attrs,
+    macfusegui_libssh2_directory_validator *out_validator
+) {
+    out_validator->modified_at_unix = (int64_t)attrs->mtime;
+    out_validator->has_size = (attrs->flags & LIBSSH2_SFTP_ATTR_SIZE) ? 1 : 0;
+    out_validator->size_bytes = out_validator->has_size ? attrs->filesize : 0;
+    /* Unsettled until the listing sets a server-clock reference. */
+    out_validator->captured_at_unix = out_validator->modified_at_unix;
+}
+
+/* Tracks the newest server timestamp seen; every mtime/atime is a lower bound on the server's clock. */
+static void macfusegui_note_server_time(int64_t *newest_server_unix, const LIBSSH2_SFTP_ATTRIBUTES *attrs) {
+    if (!(attrs->flags & LIBSSH2_SFTP_ATTR_ACMODTIME)) {
+        return;
+    }
+    if ((int64_t)attrs->mtime > *newest_server_unix) {
+        *newest_server_unix = (int64_t)attrs->mtime;
+    }
+    if ((int64_t)attrs->atime > *newest_server_unix) {
+        *newest_server_unix = (int64_t)attrs->atime;
+    }
+}
+
+void macfusegui_libssh2_directory_validator_set_reference(
+    macfusegui_libssh2_directory_validator *validator,
+    int64_t newest_server_unix,
+    int64_t client_now_unix
+) {
+    if (validator == NULL) {
+        return;
+    }
+    int64_t reference = newest_server_unix < client_now_unix ? newest_server_unix : client_now_unix;
+    /* Never earlier than the mtime itself; that already reads as unsettled. */
+    validator->captured_at_unix = reference > validator->modified_at_unix ? reference : validator->modified_at_unix;
+}
+
+int32_t macfusegui_libssh2_directory_validator_matches(
+    const macfusegui_libssh2_directory_validator *cached,
+    const macfusegui_libssh2_directory_validator *current
+) {
+    if (cached == NULL || current == NULL) {
+        return 0;
+    }
+    /*
+     A change in the same (or next) second as the capture would leave a coarse mtime unchanged,
+     so an mtime that close to the capture time proves nothing. Both values are server-clock
+     seconds, so client/server skew does not enter.
+    */
+    if (cached->captured_at_unix - cached->modified_at_unix < MACFUSEGUI_LIBSSH2_MTIME_SETTLE_SECONDS) {
+        return 0;
+    }
+    if (cached->modified_at_unix != current->modified_at_unix) {
+        return 0;
+    }
+    if (cached->has_size && current->has_size && cached->size_bytes != current->size_bytes) {
+        return 0;
+    }
+    return 1;
+}
+
+int32_t macfusegui_libssh2_list_directories_streaming_with_session(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    int32_t batch_entry_count,
+    int32_t batch_interval_ms,
+    macfusegui_libssh2_list_batch_callback batch_callback,
+    void *batch_context,
+    macfusegui_libssh2_flat_list_result *out_result
+) {
+    return macfusegui_libssh2_list_directories_if_modified_with_session(
+        session_handle,
+        remote_path,
+        timeout_seconds,
+        NULL,
+        batch_entry_count,
+        batch_interval_ms,
+        batch_callback,
+        batch_context,
+        out_result
+    );
+}
+
+int32_t macfusegui_libssh2_list_directories_if_modified_with_session(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    const macfusegui_libssh2_directory_validator *validator,
+    int32_t batch_entry_count,
+    int32_t batch_interval_ms,
+    macfusegui_libssh2_list_batch_callback batch_callback,
+    void *batch_context,
+    macfusegui_libssh2_flat_list_result *out_result
+) {
+    /*
+     List flow using existing session:
+     1) Resolve canonical path (realpath).
+     2) With a validator: stat the directory and stop early when it is unchanged.
+     3) Open directory handle.
+     4) Iterate readdir entries, flushing batches to batch_callback when set.
+     5) Keep directory entries only.
+     6) Return results + latency.
+    */
+    if (out_result == NULL) {
+        return -1;
+    }
+
+    macfusegui_zero_flat_list_result(out_result);
+
+    int32_t timeout_ms = macfusegui_session_timeout_ms(session_handle, timeout_seconds);
+    if (session_handle == NULL || session_handle->session == NULL || session_handle->sftp == NULL ||
+        remote_path == NULL || timeout_ms <= 0) {
+        macfusegui_set_flat_error(out_result, -30, "Invalid libssh2 browse session state.");
+        return out_result->status_code;
+    }
+
+    int64_t started_at = macfusegui_now_millis();
+    macfusegui_libssh2_list_deadline list_deadline;
+    macfusegui_libssh2_list_deadline_start(
+        &list_deadline,
+        started_at,
+        timeout_ms,
+        macfusegui_session_progress_timeout_ms(session_handle)
+    );
+    int64_t deadline_ms = list_deadline.deadline_ms;
+    LIBSSH2_SFTP_HANDLE *directory_handle = NULL;
+    int32_t batch_start_index = 0;
+    int64_t last_batch_at = started_at;
+
+    libssh2_session_set_blocking(session_handle->session, 0);
+    libssh2_session_set_timeout(session_handle->session, timeout_ms);
+
+    char real_path_buffer[4096];
+    const char *effective_path = remote_path;
+    int64_t stage_started_at = 0;
+    int32_t stage_waits = 0;
+    macfusegui_link_names links;
+    memset(&links, 0, sizeof(links));
+    /* Newest server timestamp seen in this call; becomes the validator's clock reference. */
+    int64_t newest_server_unix = INT64_MIN;
+
+    g_active_cancel_token = session_handle->cancel_token;
+    if (macfusegui_libssh2_cancel_token_is_cancelled(session_handle->cancel_token)) {
+        macfusegui_set_flat_cancelled(out_result);
+        goto cleanup;
+    }
+
+    bool used_cached_path = macfusegui_libssh2_session_canonical_path(
+        session_handle,
+        remote_path,
+        real_path_buffer,
+        (int32_t)sizeof(real_path_buffer)
+    ) > 0;
+
+    while (1) {
+        effective_path = remote_path;
+        if (used_cached_path) {
+            /* Cached canonical form: skip the realpath round trip entirely. */
+            effective_path = real_path_buffer;
+            out_result->timing.realpath_cached = 1;
+        } else {
+            int real_path_status = 0;
+            stage_started_at = macfusegui_now_micros();
+            stage_waits = g_socket_wait_count;
+            ssize_t real_path_len = macfusegui_sftp_realpath_with_deadline(
+                session_handle->session,
+                session_handle->sftp,
+                session_handle->sock,
+                remote_path,
+                real_path_buffer,
+                sizeof(real_path_buffer) - 1,
+                deadline_ms,
+                &real_path_status
+            );
+            if (real_path_status == MACFUSEGUI_BRIDGE_WAIT_CANCELLED) {
+                (void)macfusegui_sftp_realpath_with_deadline(
+                    session_handle->session,
+                    session_handle->sftp,
+                    session_handle->sock,
+                    remote_path,
+                    real_path_buffer,
+                    sizeof(real_path_buffer) - 1,
+                    macfusegui_begin_cancel_drain(deadline_ms),
+                    &real_path_status
+                );
+                if (real_path_status != MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                    macfusegui_set_flat_cancelled(out_result);
+                    goto cleanup;
+                }
+            }
+            out_result->timing.realpath_cached = 0;
+            out_result->timing.realpath_us += macfusegui_now_micros() - stage_started_at;
+            out_result->timing.realpath_round_trips += g_socket_wait_count - stage_waits;
+            if (real_path_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_flat_timeout_error(out_result, -30, "SFTP realpath", timeout_ms);
+                goto cleanup;
+            }
+            if (real_path_len > 0 && real_path_len < (ssize_t)(sizeof(real_path_buffer) - 1)) {
+                real_path_buffer[real_path_len] = '\0';
+                effective_path = real_path_buffer;
+            }
+        }
+
+        free(out_result->resolved_path);
+        out_result->resolved_path = macfusegui_strdup(effective_path);
+        if (out_result->resolved_path != NULL) {
+            out_result->allocation_count += 1;
+        }
+
+        if (validator != NULL) {
+            LIBSSH2_SFTP_ATTRIBUTES dir_attrs;
+            memset(&dir_attrs, 0, sizeof(dir_attrs));
+            int stat_status = 0;
+            stage_started_at = macfusegui_now_micros();
+            stage_waits = g_socket_wait_count;
+            int stat_result = macfusegui_sftp_stat_with_deadline(
+                session_handle->session,
+                session_handle->sftp,
+                session_handle->sock,
+                effective_path,
+                &dir_attrs,
+                deadline_ms,
+                &stat_status
+            );
+            if (stat_status == MACFUSEGUI_BRIDGE_WAIT_CANCELLED) {
+                (void)macfusegui_sftp_stat_with_deadline(
+                    session_handle->session,
+                    session_handle->sftp,
+                    session_handle->sock,
+                    effective_path,
+                    &dir_attrs,
+                    macfusegui_begin_cancel_drain(deadline_ms),
+                    &stat_status
+                );
+                if (stat_status != MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                    macfusegui_set_flat_cancelled(out_result);
+                    goto cleanup;
+                }
+            }
+            out_result->timing.stat_us += macfusegui_now_micros() - stage_started_at;
+            out_result->timing.stat_round_trips += g_socket_wait_count - stage_waits;
+            if (stat_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_flat_timeout_error(out_result, -31, "SFTP stat", timeout_ms);
+                goto cleanup;
+            }
+            if (stat_result == 0 && (dir_attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME)) {
+                /* Captured before readdir, so a change during the listing still shows up next time. */
+                macfusegui_validator_from_attrs(&dir_attrs, &out_result->validator);
+                out_result->has_validator = 1;
+                macfusegui_note_server_time(&newest_server_unix, &dir_attrs);
+                if (macfusegui_libssh2_directory_validator_matches(validator, &out_result->validator)) {
+                    /* The cached reference was already settled on the server clock and still applies. */
+                    if (validator->captured_at_unix > newest_server_unix) {
+                        newest_server_unix = validator->captured_at_unix;
+                    }
+                    macfusegui_libssh2_directory_validator_set_reference(
+                        &out_result->validator,
+                        newest_server_unix,
+                        (int64_t)time(NULL)
+                    );
+                    if (effective_path == real_path_buffer) {
+                        macfusegui_remember_resolved_path(session_handle, remote_path, effective_path);
+                    }
+                    out_result->not_modified = 1;
+                    out_result->status_code = 0;
+                    goto cleanup;
+                }
+            } else if (stat_result != 0 && used_cached_path &&
+                       macfusegui_sftp_path_missing((LIBSSH2_SFTP *)session_handle->sftp)) {
+                macfusegui_forget_missing_path(session_handle, remote_path, effective_path);
+                used_cached_path = false;
+                continue;
+            }
+            /* Anything else (changed, no mtime, stat refused) falls through to a full listing. */
+        }
+
+        int opendir_status = 0;
+        stage_started_at = macfusegui_now_micros();
+        stage_waits = g_socket_wait_count;
+        directory_handle = macfusegui_sftp_opendir_with_deadline(
+            session_handle->session,
+            session_handle->sftp,
+            session_handle->sock,
+            effective_path,
+            deadline_ms,
+            &opendir_status
+        );
+        if (opendir_status == MACFUSEGUI_BRIDGE_WAIT_CANCELLED) {
+            directory_handle = macfusegui_sftp_opendir_with_deadline(
+                session_handle->session,
+                session_handle->sftp,
+                session_handle->sock,
+                effective_path,
+                macfusegui_begin_cancel_drain(deadline_ms),
+                &opendir_status
+            );
+            if (opendir_status != MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                /* cleanup closes the drained handle, if the server granted one. */
+                macfusegui_set_flat_cancelled(out_result);
+                goto cleanup;
+            }
+        }
+        out_result->timing.opendir_us += macfusegui_now_micros() - stage_started_at;
+        out_result->timing.opendir_round_trips += g_socket_wait_count - stage_waits;
+        if (directory_handle != NULL) {
+            if (effective_path == real_path_buffer) {
+                macfusegui_remember_resolved_path(session_handle, remote_path, effective_path);
+            }
+            break;
+        }
+        if (opendir_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+            macfusegui_set_flat_timeout_error(out_result, -31, "SFTP opendir", timeout_ms);
+            goto cleanup;
+        }
+        if (macfusegui_sftp_path_missing((LIBSSH2_SFTP *)session_handle->sftp)) {
+            /* A cached answer may describe a directory that was renamed or removed since. */
+            macfusegui_forget_missing_path(session_handle, remote_path, effective_path);
+            if (used_cached_path) {
+                used_cached_path = false;
+                continue;
+            }
+        }
+        macfusegui_set_flat_session_error(out_result, session_handle->session, -31, "Unable to open remote directory.");
+        goto cleanup;
+    }
+
+    /* readdir time includes batch callbacks; they run inline on this thread. */
+    stage_started_at = macfusegui_now_micros();
+    stage_waits = g_socket_wait_count;
+    while (1) {
+        char file_name[2048];
+        char long_entry[4096];
+        LIBSSH2_SFTP_ATTRIBUTES attrs;
+        memset(file_name, 0, sizeof(file_name));
+        memset(long_entry, 0, sizeof(long_entry));
+        memset(&attrs, 0, sizeof(attrs));
+
+        int readdir_status = 0;
+        ssize_t read_count = macfusegui_sftp_readdir_with_deadline(
+            session_handle->session,
+            directory_handle,
+            session_handle->sock,
+            file_name,
+            sizeof(file_name) - 1,
+            long_entry,
+            sizeof(long_entry) - 1,
+            &attrs,
+            deadline_ms,
+            &readdir_status
+        );
 
-    bool timeout_config_failure = false;
-    sock = macfusegui_connect_socket(host, port, timeout_seconds, &timeout_config_failure);
-    if (sock == MACFUSEGUI_CONNECT_ERROR_SOCKET_TIMEOUT_CONFIG || timeout_config_failure) {
-        macfusegui_set_out_error(out_error_message, "Failed to configure socket send/receive timeouts.");
-        goto cleanup_error;
-    }
-    if (sock < 0) {
-        macfusegui_set_out_error(out_error_message, "Could not connect to remote host.");
-        goto cleanup_error;
-    }
+        if (read_count > 0) {
+            file_name[read_count] = '\0';
+            macfusegui_note_server_time(&newest_server_unix, &attrs);
+            /* Every entry (files included) shows the server is still streaming this directory. */
+            deadline_ms = macfusegui_libssh2_list_deadline_progress(&list_deadline, macfusegui_now_millis());
 
-    session = libssh2_session_init_ex(NULL, NULL, NULL, NULL);
-    if (session == NULL) {
-        macfusegui_set_out_error(out_error_message, "Failed to initialize libssh2 session.");
-        goto cleanup_error;
-    }
+            if ((strcmp(file_name, ".") == 0) || (strcmp(file_name, "..") == 0)) {
+                if (file_name[1] == '\0' && out_result->has_validator == 0 &&
+                    (attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME)) {
+                    /* Free validator for the next conditional listing: "." carries the directory's own attributes. */
+                    macfusegui_validator_from_attrs(&attrs, &out_result->validator);
+                    out_result->has_validator = 1;
+                }
+                continue;
+            }
 
-    libssh2_session_set_blocking(session, 0);
-    libssh2_session_set_timeout(session, timeout_seconds * 1000);
+            if (macfusegui_entry_is_link(attrs.flags, attrs.permissions, long_entry)) {
+                macfusegui_link_names_add(&links, file_name, (size_t)read_count);
+            }
 
-    int handshake_result = macfusegui_session_handshake_with_deadline(session, sock, deadline_ms);
-    if (handshake_result == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-        macfusegui_set_out_timeout_error(out_error_message, "SSH handshake", timeout_seconds);
-        goto cleanup_error;
-    }
-    if (handshake_result != 0) {
-        macfusegui_set_out_session_error(out_error_message, session, "SSH handshake failed.");
-        goto cleanup_error;
-    }
+            uint8_t is_directory = (uint8_t)macfusegui_libssh2_classify_directory_entry(
+                attrs.flags,
+                attrs.permissions,
+                long_entry
+            );
 
-    if (password != NULL && password[0] != '\0') {
-        int auth = macfusegui_password_auth_with_deadline(session, sock, username, password, deadline_ms);
+            if (is_directory == 0) {
+                /* Browser is directories-only by product design. */
+                continue;
+            }
 
-        if (auth != 0) {
-            if (auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-                macfusegui_set_out_timeout_error(out_error_message, "password authentication", timeout_seconds);
-                goto cleanup_error;
+            uint8_t has_size = (attrs.flags & LIBSSH2_SFTP_ATTR_SIZE) ? 1 : 0;
+            uint64_t size_bytes = has_size ? attrs.filesize : 0;
+            uint8_t has_modified_at = (attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME) ? 1 : 0;
+            int64_t modified_at_unix = has_modified_at ? (int64_t)attrs.mtime : 0;
+
+            if (macfusegui_flat_append_entry(
+                out_result,
+                file_name,
+                (size_t)read_count,
+                is_directory,
+                has_size,
+                size_bytes,
+                has_modified_at,
+                modified_at_unix
+            ) != 0) {
+                macfusegui_set_flat_error(out_result, -32, "Failed to store SFTP directory entry.");
+                goto cleanup;
             }
 
-            int keyboard_auth = macfusegui_kbdint_auth_with_deadline(session, sock, username, password, deadline_ms);
+            int64_t now_ms = macfusegui_now_millis();
+            if (out_result->entry_count == 1) {
+                int64_t first_entry_ms = now_ms - started_at;
+                out_result->first_entry_latency_ms = (int32_t)(first_entry_ms > 0 ? first_entry_ms : 0);
+            }
 
-            if (keyboard_auth != 0) {
-                if (keyboard_auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-                    macfusegui_set_out_timeout_error(out_error_message, "keyboard-interactive authentication", timeout_seconds);
-                    goto cleanup_error;
+            if (batch_callback != NULL) {
+                int32_t pending = out_result->entry_count - batch_start_index;
+                bool count_due = batch_entry_count > 0 && pending >= batch_entry_count;
+                bool time_due = batch_interval_ms > 0 && (now_ms - last_batch_at) >= batch_interval_ms;
+                if (count_due || time_due) {
+                    batch_callback(batch_context, out_result, batch_start_index, pending);
+                    batch_start_index = out_result->entry_count;
+                    last_batch_at = now_ms;
                 }
-                macfusegui_set_out_session_error(out_error_message, session, "Password authentication failed.");
-                goto cleanup_error;
             }
+
+            continue;
         }
-    } else if (private_key_path != NULL && private_key_path[0] != '\0') {
-        int auth = macfusegui_publickey_auth_with_deadline(session, sock, username, private_key_path, deadline_ms);
-        if (auth != 0) {
-            if (auth == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-                macfusegui_set_out_timeout_error(out_error_message, "public-key authentication", timeout_seconds);
-                goto cleanup_error;
+
+        if (read_count == 0) {
+            break;
+        }
+
+        if (readdir_status == MACFUSEGUI_BRIDGE_WAIT_CANCELLED) {
+            (void)macfusegui_sftp_readdir_with_deadline(
+                session_handle->session,
+                directory_handle,
+                session_handle->sock,
+                file_name,
+                sizeof(file_name) - 1,
+                long_entry,
+                sizeof(long_entry) - 1,
+                &attrs,
+                macfusegui_begin_cancel_drain(deadline_ms),
+                &readdir_status
+            );
+            if (readdir_status != MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_flat_cancelled(out_result);
+                goto cleanup;
             }
-            macfusegui_set_out_session_error(out_error_message, session, "Private key authentication failed.");
-            goto cleanup_error;
         }
-    } else {
-        macfusegui_set_out_error(out_error_message, "No authentication material provided.");
-        goto cleanup_error;
-    }
 
-    int sftp_init_status = 0;
-    sftp = macfusegui_sftp_init_with_deadline(session, sock, deadline_ms, &sftp_init_status);
-    if (sftp == NULL) {
-        if (sftp_init_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-            macfusegui_set_out_timeout_error(out_error_message, "SFTP subsystem initialization", timeout_seconds);
-            goto cleanup_error;
+        if (readdir_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+            /* Progress may have extended the budget; report the time actually spent. */
+            int64_t waited_ms = macfusegui_now_millis() - started_at;
+            macfusegui_set_flat_timeout_error(
+                out_result,
+                -33,
+                "SFTP readdir",
+                waited_ms > timeout_ms ? (int32_t)(waited_ms < INT32_MAX ? waited_ms : INT32_MAX) : timeout_ms
+            );
+            goto cleanup;
         }
-        macfusegui_set_out_session_error(out_error_message, session, "Unable to initialize SFTP subsystem.");
-        goto cleanup_error;
-    }
 
-    handle = (macfusegui_libssh2_session_handle *)malloc(sizeof(*handle));
-    if (handle == NULL) {
-        macfusegui_set_out_error(out_error_message, "Failed to allocate libssh2 browser session.");
-        goto cleanup_error;
+        macfusegui_set_flat_session_error(out_result, session_handle->session, -33, "Failed while reading remote directory.");
+        goto cleanup;
     }
 
-    handle->sock = sock;
-    handle->session = session;
-    handle->sftp = sftp;
-
-    *out_session = handle;
-    return 0;
-
-cleanup_error:
-    if (sftp != NULL) {
-        (void)libssh2_sftp_shutdown(sftp);
-        sftp = NULL;
+    out_result->status_code = 0;
+    if (out_result->has_validator) {
+        macfusegui_libssh2_directory_validator_set_reference(
+            &out_result->validator,
+            newest_server_unix,
+            (int64_t)time(NULL)
+        );
     }
-
-    if (session != NULL) {
-        (void)libssh2_session_disconnect_ex(session, SSH_DISCONNECT_BY_APPLICATION, "macfuseGui", "en");
-        (void)libssh2_session_free(session);
-        session = NULL;
+    if (effective_path == real_path_buffer) {
+        macfusegui_remember_directory_children(session_handle, effective_path, &links);
+    }
+    if (batch_callback != NULL && out_result->entry_count > batch_start_index) {
+        batch_callback(batch_context, out_result, batch_start_index, out_result->entry_count - batch_start_index);
     }
 
-    if (sock >= 0) {
-        close(sock);
-        sock = -1;
+cleanup:
+    macfusegui_link_names_reset(&links);
+    if (directory_handle != NULL) {
+        out_result->timing.readdir_us = macfusegui_now_micros() - stage_started_at;
+        out_result->timing.readdir_round_trips = g_socket_wait_count - stage_waits;
+        (void)libssh2_sftp_closedir(directory_handle);
+        directory_handle = NULL;
     }
 
-    if (handle != NULL) {
-        free(handle);
-        handle = NULL;
+    g_active_cancel_token = NULL;
+    if (out_result->status_code != 0 && out_result->error_message == NULL) {
+        macfusegui_set_flat_error(out_result, -34, "Unknown libssh2 browse error.");
     }
 
-    return -101;
+    int64_t elapsed_ms = macfusegui_now_millis() - started_at;
+    out_result->latency_ms = (int32_t)(elapsed_ms > 0 ? elapsed_ms : 0);
+    return out_result->status_code;
 }
 
 int32_t macfusegui_libssh2_list_directories_with_session(
@@ -977,76 +3334,154 @@ int32_t macfusegui_libssh2_list_directories_with_session(
     int32_t timeout_seconds,
     macfusegui_libssh2_list_result *out_result
 ) {
-    /*
-     List flow using existing session:
-     1) Resolve canonical path (realpath).
-     2) Open directory handle.
-     3) Iterate readdir entries.
-     4) Keep directory entries only.
-     5) Return results + latency.
-    */
+    /* Compatibility wrapper: list into the flat layout, then expand to per-entry strings. */
     if (out_result == NULL) {
         return -1;
     }
 
     macfusegui_zero_list_result(out_result);
 
-    if (session_handle == NULL || session_handle->session == NULL || session_handle->sftp == NULL ||
-        remote_path == NULL || timeout_seconds <= 0) {
-        macfusegui_set_error(out_result, -30, "Invalid libssh2 browse session state.");
-        return out_result->status_code;
+    macfusegui_libssh2_flat_list_result flat;
+    (void)macfusegui_libssh2_list_directories_flat_with_session(session_handle, remote_path, timeout_seconds, &flat);
+
+    if (macfusegui_copy_flat_to_list_result(&flat, out_result) != 0) {
+        int32_t latency_ms = flat.latency_ms;
+        macfusegui_libssh2_free_list_result(out_result);
+        macfusegui_set_error(out_result, -32, "Failed to store SFTP directory entry.");
+        out_result->latency_ms = latency_ms;
     }
 
-    int64_t started_at = macfusegui_now_millis();
-    int64_t deadline_ms = macfusegui_deadline_from_timeout_seconds(timeout_seconds);
-    LIBSSH2_SFTP_HANDLE *directory_handle = NULL;
+    macfusegui_libssh2_free_flat_list_result(&flat);
+    return out_result->status_code;
+}
 
-    libssh2_session_set_blocking(session_handle->session, 0);
-    libssh2_session_set_timeout(session_handle->session, timeout_seconds * 1000);
+/* libssh2 errors that mean the transport is gone, not that one SFTP request failed. */
+static bool macfusegui_error_is_session_lost(int error) {
+    return error == LIBSSH2_ERROR_SOCKET_RECV ||
+        error == LIBSSH2_ERROR_SOCKET_SEND ||
+        error == LIBSSH2_ERROR_SOCKET_DISCONNECT;
+}
 
-    char real_path_buffer[4096];
-    const char *effective_path = remote_path;
-    int real_path_status = 0;
-    ssize_t real_path_len = macfusegui_sftp_realpath_with_deadline(
-        session_handle->session,
-        session_handle->sftp,
-        session_handle->sock,
-        remote_path,
-        real_path_buffer,
-        sizeof(real_path_buffer) - 1,
-        deadline_ms,
-        &real_path_status
-    );
-    if (real_path_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-        macfusegui_set_result_timeout_error(out_result, -30, "SFTP realpath", timeout_seconds);
-        goto cleanup;
+typedef enum macfusegui_list_lane_stage {
+    MACFUSEGUI_LANE_IDLE = 0,
+    MACFUSEGUI_LANE_REALPATH,
+    MACFUSEGUI_LANE_OPENDIR,
+    MACFUSEGUI_LANE_READDIR,
+    MACFUSEGUI_LANE_CLOSEDIR
+} macfusegui_list_lane_stage;
+
+/* One SFTP channel working through one path at a time for list_many. */
+typedef struct macfusegui_list_lane {
+    LIBSSH2_SFTP *sftp;
+    macfusegui_list_lane_stage stage;
+    int32_t path_index;
+    LIBSSH2_SFTP_HANDLE *directory_handle;
+    const char *effective_path;
+    int64_t started_at;
+    /* real_path came from the session's canonical path cache rather than a realpath reply. */
+    bool used_cached_path;
+    char real_path[4096];
+    macfusegui_link_names links;
+} macfusegui_list_lane;
+
+static void macfusegui_list_lane_finish(macfusegui_list_lane *lane, macfusegui_libssh2_flat_list_result *result) {
+    if (result->status_code != 0 && result->error_message == NULL) {
+        macfusegui_set_flat_error(result, -34, "Unknown libssh2 browse error.");
     }
-    if (real_path_len > 0 && real_path_len < (ssize_t)(sizeof(real_path_buffer) - 1)) {
-        real_path_buffer[real_path_len] = '\0';
-        effective_path = real_path_buffer;
+
+    int64_t elapsed_ms = macfusegui_now_millis() - lane->started_at;
+    result->latency_ms = (int32_t)(elapsed_ms > 0 ? elapsed_ms : 0);
+    lane->stage = MACFUSEGUI_LANE_IDLE;
+    lane->directory_handle = NULL;
+    lane->effective_path = NULL;
+    macfusegui_link_names_reset(&lane->links);
+}
+
+/*
+ Advances one lane by a single non-blocking libssh2 call. Returns false on EAGAIN, or when the call
+ failed because the socket is gone (out_session_lost set; the lane is left for the caller to fail).
+*/
+static bool macfusegui_list_lane_step(
+    macfusegui_libssh2_session_handle *session_handle,
+    macfusegui_list_lane *lane,
+    const char *const *remote_paths,
+    macfusegui_libssh2_flat_list_result *results,
+    bool *out_session_lost
+) {
+    LIBSSH2_SESSION *session = (LIBSSH2_SESSION *)session_handle->session;
+    macfusegui_libssh2_flat_list_result *result = &results[lane->path_index];
+    const char *remote_path = remote_paths[lane->path_index];
+
+    switch (lane->stage) {
+    case MACFUSEGUI_LANE_IDLE:
+        return true;
+
+    case MACFUSEGUI_LANE_REALPATH: {
+        ssize_t real_path_len = libssh2_sftp_realpath(
+            lane->sftp,
+            remote_path,
+            lane->real_path,
+            (unsigned int)(sizeof(lane->real_path) - 1)
+        );
+        if (real_path_len == LIBSSH2_ERROR_EAGAIN) {
+            return false;
+        }
+        if (real_path_len < 0 && macfusegui_error_is_session_lost((int)real_path_len)) {
+            *out_session_lost = true;
+            return false;
+        }
+
+        /* Same policy as single listing: realpath failure falls back to the requested path. */
+        lane->effective_path = remote_path;
+        if (real_path_len > 0 && real_path_len < (ssize_t)(sizeof(lane->real_path) - 1)) {
+            lane->real_path[real_path_len] = '\0';
+            lane->effective_path = lane->real_path;
+        }
+
+        free(result->resolved_path);
+        result->resolved_path = macfusegui_strdup(lane->effective_path);
+        if (result->resolved_path != NULL) {
+            result->allocation_count += 1;
+        }
+        lane->stage = MACFUSEGUI_LANE_OPENDIR;
+        return true;
     }
 
-    out_result->resolved_path = macfusegui_strdup(effective_path);
+    case MACFUSEGUI_LANE_OPENDIR: {
+        LIBSSH2_SFTP_HANDLE *handle = libssh2_sftp_opendir(lane->sftp, lane->effective_path);
+        if (handle == NULL) {
+            int open_error = libssh2_session_last_errno(session);
+            if (open_error == LIBSSH2_ERROR_EAGAIN) {
+                return false;
+            }
+            if (macfusegui_error_is_session_lost(open_error)) {
+                *out_session_lost = true;
+                return false;
+            }
+            if (macfusegui_sftp_path_missing(lane->sftp)) {
+                macfusegui_forget_missing_path(session_handle, remote_path, lane->effective_path);
+                if (lane->used_cached_path) {
+                    /* Stale cached path: resolve it properly before giving up. */
+                    lane->used_cached_path = false;
+                    result->timing.realpath_cached = 0;
+                    lane->stage = MACFUSEGUI_LANE_REALPATH;
+                    return true;
+                }
+            }
+            macfusegui_set_flat_session_error(result, session, -31, "Unable to open remote directory.");
+            macfusegui_list_lane_finish(lane, result);
+            return true;
+        }
 
-    int opendir_status = 0;
-    directory_handle = macfusegui_sftp_opendir_with_deadline(
-        session_handle->session,
-        session_handle->sftp,
-        session_handle->sock,
-        effective_path,
-        deadline_ms,
-        &opendir_status
-    );
-    if (directory_handle == NULL) {
-        if (opendir_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-            macfusegui_set_result_timeout_error(out_result, -31, "SFTP opendir", timeout_seconds);
-            goto cleanup;
+        if (lane->effective_path == lane->real_path) {
+            macfusegui_remember_resolved_path(session_handle, remote_path, lane->effective_path);
         }
-        macfusegui_set_session_error(out_result, session_handle->session, -31, "Unable to open remote directory.");
-        goto cleanup;
+        lane->directory_handle = handle;
+        lane->stage = MACFUSEGUI_LANE_READDIR;
+        return true;
     }
 
-    while (1) {
+    case MACFUSEGUI_LANE_READDIR: {
         char file_name[2048];
         char long_entry[4096];
         LIBSSH2_SFTP_ATTRIBUTES attrs;
@@ -1054,82 +3489,302 @@ int32_t macfusegui_libssh2_list_directories_with_session(
         memset(long_entry, 0, sizeof(long_entry));
         memset(&attrs, 0, sizeof(attrs));
 
-        int readdir_status = 0;
-        ssize_t read_count = macfusegui_sftp_readdir_with_deadline(
-            session_handle->session,
-            directory_handle,
-            session_handle->sock,
+        ssize_t read_count = libssh2_sftp_readdir_ex(
+            lane->directory_handle,
             file_name,
             sizeof(file_name) - 1,
             long_entry,
             sizeof(long_entry) - 1,
-            &attrs,
-            deadline_ms,
-            &readdir_status
+            &attrs
         );
+        if (read_count == LIBSSH2_ERROR_EAGAIN) {
+            return false;
+        }
+        if (read_count < 0 && macfusegui_error_is_session_lost((int)read_count)) {
+            *out_session_lost = true;
+            return false;
+        }
+
+        if (read_count > 0) {
+            file_name[read_count] = '\0';
+            if ((strcmp(file_name, ".") == 0) || (strcmp(file_name, "..") == 0)) {
+                return true;
+            }
+            if (macfusegui_entry_is_link(attrs.flags, attrs.permissions, long_entry)) {
+                macfusegui_link_names_add(&lane->links, file_name, (size_t)read_count);
+            }
+
+            uint8_t is_directory = (uint8_t)macfusegui_libssh2_classify_directory_entry(
+                attrs.flags,
+                attrs.permissions,
+                long_entry
+            );
+            if (is_directory == 0) {
+                /* Browser is directories-only by product design. */
+                return true;
+            }
+
+            uint8_t has_size = (attrs.flags & LIBSSH2_SFTP_ATTR_SIZE) ? 1 : 0;
+            uint8_t has_modified_at = (attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME) ? 1 : 0;
+            if (macfusegui_flat_append_entry(
+                result,
+                file_name,
+                (size_t)read_count,
+                is_directory,
+                has_size,
+                has_size ? attrs.filesize : 0,
+                has_modified_at,
+                has_modified_at ? (int64_t)attrs.mtime : 0
+            ) != 0) {
+                macfusegui_set_flat_error(result, -32, "Failed to store SFTP directory entry.");
+                lane->stage = MACFUSEGUI_LANE_CLOSEDIR;
+                return true;
+            }
+            if (result->entry_count == 1) {
+                int64_t first_entry_ms = macfusegui_now_millis() - lane->started_at;
+                result->first_entry_latency_ms = (int32_t)(first_entry_ms > 0 ? first_entry_ms : 0);
+            }
+            return true;
+        }
+
+        if (read_count == 0) {
+            result->status_code = 0;
+            if (lane->effective_path == lane->real_path) {
+                macfusegui_remember_directory_children(session_handle, lane->effective_path, &lane->links);
+            }
+        } else {
+            macfusegui_set_flat_session_error(result, session, -33, "Failed while reading remote directory.");
+        }
+        lane->stage = MACFUSEGUI_LANE_CLOSEDIR;
+        return true;
+    }
+
+    case MACFUSEGUI_LANE_CLOSEDIR: {
+        int close_result = libssh2_sftp_closedir(lane->directory_handle);
+        if (close_result == LIBSSH2_ERROR_EAGAIN) {
+            return false;
+        }
+        macfusegui_list_lane_finish(lane, result);
+        return true;
+    }
+    }
+
+    return true;
+}
+
+static const char *macfusegui_list_lane_stage_name(macfusegui_list_lane_stage stage) {
+    switch (stage) {
+    case MACFUSEGUI_LANE_REALPATH:
+        return "SFTP realpath";
+    case MACFUSEGUI_LANE_OPENDIR:
+        return "SFTP opendir";
+    case MACFUSEGUI_LANE_READDIR:
+    case MACFUSEGUI_LANE_CLOSEDIR:
+        return "SFTP readdir";
+    case MACFUSEGUI_LANE_IDLE:
+        break;
+    }
+    return "SFTP batch listing";
+}
+
+int32_t macfusegui_libssh2_list_many(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *const *remote_paths,
+    int32_t path_count,
+    int32_t timeout_seconds,
+    macfusegui_libssh2_list_many_result *out_result
+) {
+    /*
+     Batch list flow:
+     1) Make sure up to MAX_LIST_LANES SFTP channels exist on the session (extra ones are kept).
+     2) Give each idle lane the next pending path.
+     3) Step every lane until all of them report EAGAIN, then wait on the shared socket once.
+     4) Repeat until every path finished or the batch deadline passes.
+    */
+    if (out_result == NULL) {
+        return -1;
+    }
 
-        if (read_count > 0) {
-            file_name[read_count] = '\0';
+    memset(out_result, 0, sizeof(*out_result));
+    out_result->status_code = -1;
 
-            if ((strcmp(file_name, ".") == 0) || (strcmp(file_name, "..") == 0)) {
-                continue;
-            }
+    int32_t timeout_ms = macfusegui_session_timeout_ms(session_handle, timeout_seconds);
+    if (session_handle == NULL || session_handle->session == NULL || session_handle->sftp == NULL ||
+        remote_paths == NULL || path_count <= 0 || timeout_ms <= 0) {
+        out_result->status_code = -30;
+        out_result->error_message = macfusegui_strdup("Invalid libssh2 batch browse request.");
+        return out_result->status_code;
+    }
 
-            uint8_t is_directory = (uint8_t)macfusegui_libssh2_classify_directory_entry(
-                attrs.flags,
-                attrs.permissions,
-                long_entry
-            );
+    out_result->results = (macfusegui_libssh2_flat_list_result *)calloc(
+        (size_t)path_count,
+        sizeof(macfusegui_libssh2_flat_list_result)
+    );
+    if (out_result->results == NULL) {
+        out_result->status_code = -32;
+        out_result->error_message = macfusegui_strdup("Failed to allocate batch listing results.");
+        return out_result->status_code;
+    }
+    out_result->path_count = path_count;
+    for (int32_t idx = 0; idx < path_count; idx += 1) {
+        macfusegui_zero_flat_list_result(&out_result->results[idx]);
+    }
 
-            if (is_directory == 0) {
-                /* Browser is directories-only by product design. */
-                continue;
-            }
+    int64_t started_at = macfusegui_now_millis();
+    macfusegui_libssh2_list_deadline list_deadline;
+    macfusegui_libssh2_list_deadline_start(
+        &list_deadline,
+        started_at,
+        timeout_ms,
+        macfusegui_session_progress_timeout_ms(session_handle)
+    );
+    int64_t deadline_ms = list_deadline.deadline_ms;
+    LIBSSH2_SESSION *session = (LIBSSH2_SESSION *)session_handle->session;
 
-            uint8_t has_size = (attrs.flags & LIBSSH2_SFTP_ATTR_SIZE) ? 1 : 0;
-            uint64_t size_bytes = has_size ? attrs.filesize : 0;
-            uint8_t has_modified_at = (attrs.flags & LIBSSH2_SFTP_ATTR_ACMODTIME) ? 1 : 0;
-            int64_t modified_at_unix = has_modified_at ? (int64_t)attrs.mtime : 0;
+    libssh2_session_set_blocking(session, 0);
+    libssh2_session_set_timeout(session, timeout_ms);
+
+    int32_t wanted_lanes = path_count < MACFUSEGUI_LIBSSH2_MAX_LIST_LANES ? path_count : MACFUSEGUI_LIBSSH2_MAX_LIST_LANES;
+    while (session_handle->lane_sftp_count + 1 < wanted_lanes) {
+        /* Lane channels are opened one at a time (libssh2 serializes sftp_init per session). */
+        int lane_status = 0;
+        LIBSSH2_SFTP *lane_sftp = macfusegui_sftp_init_with_deadline(session, session_handle->sock, deadline_ms, &lane_status);
+        if (lane_sftp == NULL) {
+            break;
+        }
+        session_handle->lane_sftp[session_handle->lane_sftp_count] = lane_sftp;
+        session_handle->lane_sftp_count += 1;
+    }
 
-            if (macfusegui_append_entry(
-                out_result,
-                file_name,
-                is_directory,
-                has_size,
-                size_bytes,
-                has_modified_at,
-                modified_at_unix
-            ) != 0) {
-                macfusegui_set_error(out_result, -32, "Failed to store SFTP directory entry.");
-                goto cleanup;
+    macfusegui_list_lane lanes[MACFUSEGUI_LIBSSH2_MAX_LIST_LANES];
+    int32_t lane_count = 1 + session_handle->lane_sftp_count;
+    if (lane_count > wanted_lanes) {
+        lane_count = wanted_lanes;
+    }
+    for (int32_t idx = 0; idx < lane_count; idx += 1) {
+        memset(&lanes[idx], 0, sizeof(lanes[idx]));
+        lanes[idx].sftp = idx == 0 ? (LIBSSH2_SFTP *)session_handle->sftp : (LIBSSH2_SFTP *)session_handle->lane_sftp[idx - 1];
+        lanes[idx].stage = MACFUSEGUI_LANE_IDLE;
+    }
+    out_result->lane_count = lane_count;
+
+    int32_t next_path = 0;
+    bool session_lost = false;
+    while (1) {
+        bool any_blocked = false;
+        bool any_progress = false;
+
+        for (int32_t idx = 0; idx < lane_count; idx += 1) {
+            macfusegui_list_lane *lane = &lanes[idx];
+            while (1) {
+                if (lane->stage == MACFUSEGUI_LANE_IDLE) {
+                    if (next_path >= path_count) {
+                        break;
+                    }
+                    lane->path_index = next_path;
+                    next_path += 1;
+                    lane->started_at = macfusegui_now_millis();
+                    if (remote_paths[lane->path_index] == NULL) {
+                        macfusegui_set_flat_error(&out_result->results[lane->path_index], -30, "Invalid libssh2 browse session state.");
+                        continue;
+                    }
+                    lane->used_cached_path = macfusegui_libssh2_session_canonical_path(
+                        session_handle,
+                        remote_paths[lane->path_index],
+                        lane->real_path,
+                        (int32_t)sizeof(lane->real_path)
+                    ) > 0;
+                    if (lane->used_cached_path) {
+                        macfusegui_libssh2_flat_list_result *result = &out_result->results[lane->path_index];
+                        lane->effective_path = lane->real_path;
+                        result->resolved_path = macfusegui_strdup(lane->real_path);
+                        if (result->resolved_path != NULL) {
+                            result->allocation_count += 1;
+                        }
+                        result->timing.realpath_cached = 1;
+                        lane->stage = MACFUSEGUI_LANE_OPENDIR;
+                    } else {
+                        lane->stage = MACFUSEGUI_LANE_REALPATH;
+                    }
+                }
+
+                if (!macfusegui_list_lane_step(session_handle, lane, remote_paths, out_result->results, &session_lost)) {
+                    any_blocked = true;
+                    break;
+                }
+                any_progress = true;
+            }
+            if (session_lost) {
+                break;
             }
+        }
 
-            continue;
+        if (session_lost) {
+            break;
+        }
+        if (!any_blocked) {
+            break;
+        }
+        if (any_progress) {
+            deadline_ms = macfusegui_libssh2_list_deadline_progress(&list_deadline, macfusegui_now_millis());
         }
 
-        if (read_count == 0) {
+        int wait_result = macfusegui_wait_socket(session, session_handle->sock, deadline_ms);
+        if (wait_result == 0) {
+            continue;
+        }
+        if (wait_result == -1) {
+            /* poll() itself failed on the session socket. */
+            session_lost = true;
             break;
         }
 
-        if (readdir_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-            macfusegui_set_result_timeout_error(out_result, -33, "SFTP readdir", timeout_seconds);
-            goto cleanup;
+        /* Deadline: fail every unfinished path with its current stage. */
+        for (int32_t idx = 0; idx < lane_count; idx += 1) {
+            macfusegui_list_lane *lane = &lanes[idx];
+            if (lane->stage == MACFUSEGUI_LANE_IDLE) {
+                continue;
+            }
+            macfusegui_libssh2_flat_list_result *result = &out_result->results[lane->path_index];
+            int32_t status = lane->stage == MACFUSEGUI_LANE_REALPATH ? -30 : (lane->stage == MACFUSEGUI_LANE_OPENDIR ? -31 : -33);
+            macfusegui_set_flat_timeout_error(result, status, macfusegui_list_lane_stage_name(lane->stage), timeout_ms);
+            if (lane->directory_handle != NULL) {
+                /* Best effort only; libssh2 reclaims the handle when the session closes. */
+                (void)libssh2_sftp_closedir(lane->directory_handle);
+            }
+            macfusegui_list_lane_finish(lane, result);
+        }
+        for (; next_path < path_count; next_path += 1) {
+            macfusegui_set_flat_timeout_error(&out_result->results[next_path], -30, "SFTP batch listing", timeout_ms);
         }
 
-        macfusegui_set_session_error(out_result, session_handle->session, -33, "Failed while reading remote directory.");
-        goto cleanup;
+        char message[256];
+        macfusegui_format_timeout_message(message, sizeof(message), "SFTP batch listing", timeout_ms);
+        out_result->error_message = macfusegui_strdup(message);
+        out_result->status_code = -35;
+        break;
     }
 
-    out_result->status_code = 0;
-
-cleanup:
-    if (directory_handle != NULL) {
-        (void)libssh2_sftp_closedir(directory_handle);
-        directory_handle = NULL;
+    if (session_lost) {
+        /* The link is gone: nothing else on this session can finish, and the caller must drop it. */
+        for (int32_t idx = 0; idx < lane_count; idx += 1) {
+            macfusegui_list_lane *lane = &lanes[idx];
+            if (lane->stage == MACFUSEGUI_LANE_IDLE) {
+                continue;
+            }
+            macfusegui_libssh2_flat_list_result *result = &out_result->results[lane->path_index];
+            macfusegui_set_flat_session_error(result, session, MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST, "SSH session lost during batch listing.");
+            macfusegui_list_lane_finish(lane, result);
+        }
+        for (; next_path < path_count; next_path += 1) {
+            macfusegui_set_flat_error(&out_result->results[next_path], MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST, "SSH session lost during batch listing.");
+        }
+        out_result->error_message = macfusegui_session_error_message(session, "SSH session lost during batch listing.");
+        out_result->status_code = MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST;
     }
 
-    if (out_result->status_code != 0 && out_result->error_message == NULL) {
-        macfusegui_set_error(out_result, -34, "Unknown libssh2 browse error.");
+    if (out_result->status_code == -1) {
+        out_result->status_code = 0;
     }
 
     int64_t elapsed_ms = macfusegui_now_millis() - started_at;
@@ -1137,28 +3792,36 @@ cleanup:
     return out_result->status_code;
 }
 
-int32_t macfusegui_libssh2_ping_session(
+int32_t macfusegui_libssh2_session_wait_interest(
     macfusegui_libssh2_session_handle *session_handle,
-    const char *remote_path,
-    int32_t timeout_seconds,
-    char **out_error_message
+    macfusegui_libssh2_wait_interest *out_interest
 ) {
-    /* Keepalive probe uses lightweight SFTP stat on current path. */
-    if (out_error_message != NULL) {
-        *out_error_message = NULL;
+    if (out_interest == NULL) {
+        return -1;
     }
-
-    if (session_handle == NULL || session_handle->session == NULL || session_handle->sftp == NULL ||
-        remote_path == NULL || timeout_seconds <= 0) {
-        macfusegui_set_out_error(out_error_message, "Invalid libssh2 browser session state.");
-        return -40;
+    memset(out_interest, 0, sizeof(*out_interest));
+    out_interest->fd = -1;
+    if (session_handle == NULL || session_handle->session == NULL || session_handle->sock < 0) {
+        return -1;
     }
 
-    int64_t deadline_ms = macfusegui_deadline_from_timeout_seconds(timeout_seconds);
-
-    libssh2_session_set_blocking(session_handle->session, 0);
-    libssh2_session_set_timeout(session_handle->session, timeout_seconds * 1000);
+    int directions = libssh2_session_block_directions((LIBSSH2_SESSION *)session_handle->session);
+    if (directions == 0) {
+        directions = LIBSSH2_SESSION_BLOCK_INBOUND | LIBSSH2_SESSION_BLOCK_OUTBOUND;
+    }
+    out_interest->fd = session_handle->sock;
+    out_interest->events = macfusegui_wait_events_from_directions(directions);
+    return 0;
+}
 
+/* One stat of remote_path (plus the trailing-slash retry) against deadline_ms; 0, or -41 with an error. */
+static int32_t macfusegui_keepalive_stat(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int64_t deadline_ms,
+    int32_t timeout_ms,
+    char **out_error_message
+) {
     LIBSSH2_SFTP_ATTRIBUTES attrs;
     memset(&attrs, 0, sizeof(attrs));
 
@@ -1173,7 +3836,7 @@ int32_t macfusegui_libssh2_ping_session(
         &stat_status
     );
     if (stat_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-        macfusegui_set_out_timeout_error(out_error_message, "SFTP stat", timeout_seconds);
+        macfusegui_set_out_timeout_error(out_error_message, "SFTP stat", timeout_ms);
         return -41;
     }
     if (stat_result == 0) {
@@ -1204,7 +3867,7 @@ int32_t macfusegui_libssh2_ping_session(
             }
             free(trimmed);
             if (stat_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
-                macfusegui_set_out_timeout_error(out_error_message, "SFTP stat", timeout_seconds);
+                macfusegui_set_out_timeout_error(out_error_message, "SFTP stat", timeout_ms);
                 return -41;
             }
             if (stat_result == 0) {
@@ -1217,6 +3880,157 @@ int32_t macfusegui_libssh2_ping_session(
     return -41;
 }
 
+/*
+ Lets libssh2 read whatever is buffered on the socket without waiting, so a disconnect or EOF
+ the server already sent is noticed before probing. Returns -1 once the session is known closed.
+*/
+static int macfusegui_drain_session_input(macfusegui_libssh2_session_handle *session_handle) {
+    LIBSSH2_CHANNEL *channel = libssh2_sftp_get_channel((LIBSSH2_SFTP *)session_handle->sftp);
+    if (channel == NULL) {
+        return -1;
+    }
+
+    LIBSSH2_POLLFD poll_fd;
+    memset(&poll_fd, 0, sizeof(poll_fd));
+    poll_fd.type = LIBSSH2_POLLFD_CHANNEL;
+    poll_fd.fd.channel = channel;
+    poll_fd.events = LIBSSH2_POLLFD_POLLIN;
+    (void)libssh2_poll(&poll_fd, 1, 0);
+    return (poll_fd.revents & LIBSSH2_POLLFD_SESSION_CLOSED) != 0 ? -1 : 0;
+}
+
+int32_t macfusegui_libssh2_ping_session(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    char **out_error_message
+) {
+    return macfusegui_libssh2_keepalive_session(
+        session_handle,
+        remote_path,
+        timeout_seconds,
+        MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SFTP_STAT,
+        NULL,
+        out_error_message
+    );
+}
+
+int32_t macfusegui_libssh2_keepalive_session(
+    macfusegui_libssh2_session_handle *session_handle,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    int32_t mode,
+    macfusegui_libssh2_keepalive_outcome *out_outcome,
+    char **out_error_message
+) {
+    if (out_error_message != NULL) {
+        *out_error_message = NULL;
+    }
+    if (out_outcome != NULL) {
+        memset(out_outcome, 0, sizeof(*out_outcome));
+        out_outcome->mode_used = mode;
+    }
+
+    int32_t timeout_ms = macfusegui_session_timeout_ms(session_handle, timeout_seconds);
+    if (session_handle == NULL || session_handle->session == NULL || session_handle->sftp == NULL ||
+        remote_path == NULL || timeout_ms <= 0) {
+        macfusegui_set_out_error(out_error_message, "Invalid libssh2 browser session state.");
+        return -40;
+    }
+
+    int64_t started_at = macfusegui_now_millis();
+    int64_t deadline_ms = macfusegui_deadline_from_timeout_ms(timeout_ms);
+    LIBSSH2_SESSION *session = (LIBSSH2_SESSION *)session_handle->session;
+
+    libssh2_session_set_blocking(session, 0);
+    libssh2_session_set_timeout(session, timeout_ms);
+
+    int32_t status = 0;
+    if (mode == MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SSH) {
+        if (macfusegui_drain_session_input(session_handle) != 0) {
+            macfusegui_set_out_session_error(out_error_message, session, "SSH session closed by server.");
+            return MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST;
+        }
+
+        /*
+         No reply is requested: libssh2 has no public call that removes a global-request reply
+         from its packet queue, so want-reply keepalives would pile up there for the session's
+         lifetime. The send still refreshes server and middlebox idle timers, and puts data in
+         flight for the socket's unacknowledged-data timeout. libssh2 skips it when its own
+         interval has not elapsed or the socket would block, so it proves nothing by itself.
+        */
+        libssh2_keepalive_config(session, 0, 1);
+        int seconds_to_next = 0;
+        if (libssh2_keepalive_send(session, &seconds_to_next) != 0) {
+            macfusegui_set_out_session_error(out_error_message, session, "SSH keepalive send failed.");
+            return MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST;
+        }
+
+        /*
+         Liveness comes from one SFTP realpath of "." instead: a full round trip whose reply
+         libssh2 consumes, without statting the browsed folder. The first wait uses half the
+         budget so a late reply still leaves time to drain it.
+        */
+        int64_t reply_deadline_ms = started_at + ((deadline_ms - started_at) / 2);
+        char real_path_buffer[4096];
+        int real_path_status = 0;
+        ssize_t real_path_len = macfusegui_sftp_realpath_with_deadline(
+            session,
+            session_handle->sftp,
+            session_handle->sock,
+            ".",
+            real_path_buffer,
+            sizeof(real_path_buffer) - 1,
+            reply_deadline_ms,
+            &real_path_status
+        );
+        if (real_path_len < 0 && real_path_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+            /*
+             The request is still pending on the SFTP channel, and abandoning it would hand its
+             reply (the home directory) to the next list's realpath. Finish it under the rest of
+             the budget, as a cancelled list does; if it never arrives the session must go.
+            */
+            real_path_len = macfusegui_sftp_realpath_with_deadline(
+                session,
+                session_handle->sftp,
+                session_handle->sock,
+                ".",
+                real_path_buffer,
+                sizeof(real_path_buffer) - 1,
+                deadline_ms,
+                &real_path_status
+            );
+            if (real_path_status == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+                macfusegui_set_out_timeout_error(out_error_message, "SFTP realpath", timeout_ms);
+                status = -41;
+            }
+        }
+        if (real_path_len >= 0) {
+            if (out_outcome != NULL) {
+                out_outcome->reply_seen = 1;
+            }
+        } else if (status == 0) {
+            /* Realpath refused: one stat of the browsed folder decides. */
+            if (out_outcome != NULL) {
+                out_outcome->sftp_probed = 1;
+            }
+            status = macfusegui_keepalive_stat(session_handle, remote_path, deadline_ms, timeout_ms, out_error_message);
+        }
+    } else {
+        /* Legacy probe: lightweight SFTP stat on current path. */
+        if (out_outcome != NULL) {
+            out_outcome->sftp_probed = 1;
+        }
+        status = macfusegui_keepalive_stat(session_handle, remote_path, deadline_ms, timeout_ms, out_error_message);
+    }
+
+    if (out_outcome != NULL) {
+        int64_t elapsed_ms = macfusegui_now_millis() - started_at;
+        out_outcome->latency_ms = elapsed_ms > 0 ? elapsed_ms : 0;
+    }
+    return status;
+}
+
 void macfusegui_libssh2_close_session(macfusegui_libssh2_session_handle *session_handle) {
     /*
      Close flow is defensive:
@@ -1227,6 +4041,25 @@ void macfusegui_libssh2_close_session(macfusegui_libssh2_session_handle *session
         return;
     }
 
+    for (int32_t idx = 0; idx < session_handle->lane_sftp_count; idx += 1) {
+        LIBSSH2_SFTP *lane_sftp = (LIBSSH2_SFTP *)session_handle->lane_sftp[idx];
+        if (lane_sftp == NULL) {
+            continue;
+        }
+        int64_t lane_deadline = macfusegui_now_millis() + 250;
+        while (session_handle->session != NULL && session_handle->sock >= 0) {
+            int shutdown_result = libssh2_sftp_shutdown(lane_sftp);
+            if (shutdown_result != LIBSSH2_ERROR_EAGAIN) {
+                break;
+            }
+            if (macfusegui_wait_socket(session_handle->session, session_handle->sock, lane_deadline) != 0) {
+                break;
+            }
+        }
+        session_handle->lane_sftp[idx] = NULL;
+    }
+    session_handle->lane_sftp_count = 0;
+
     if (session_handle->sftp != NULL && session_handle->session != NULL && session_handle->sock >= 0) {
         int64_t shutdown_deadline = macfusegui_now_millis() + 1000;
         while (1) {
@@ -1267,9 +4100,153 @@ void macfusegui_libssh2_close_session(macfusegui_libssh2_session_handle *session
         session_handle->sock = -1;
     }
 
+    macfusegui_libssh2_session_forget_canonical_paths(session_handle);
     free(session_handle);
 }
 
+/*
+ Teardown reaper:
+ - One detached thread, started on first use, closes handed-off sessions in FIFO order.
+ - The queue is a fixed ring; capacity bounds how many sockets can sit in teardown at once.
+ - A full queue (or a thread that failed to start) falls back to closing on the caller.
+ - queue_depth counts handles waiting plus the one being closed, so drain can wait for zero.
+*/
+#define MACFUSEGUI_REAPER_MAX_CAPACITY 64
+#define MACFUSEGUI_REAPER_DEFAULT_CAPACITY 8
+
+static pthread_mutex_t g_reaper_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_reaper_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t g_reaper_idle = PTHREAD_COND_INITIALIZER;
+static macfusegui_libssh2_session_handle *g_reaper_queue[MACFUSEGUI_REAPER_MAX_CAPACITY];
+static int32_t g_reaper_head = 0;
+static int32_t g_reaper_waiting = 0;
+static int32_t g_reaper_in_progress = 0;
+static int32_t g_reaper_capacity = MACFUSEGUI_REAPER_DEFAULT_CAPACITY;
+static bool g_reaper_started = false;
+static uint64_t g_reaper_enqueued = 0;
+static uint64_t g_reaper_reaped = 0;
+static uint64_t g_reaper_inline_closes = 0;
+static uint64_t g_reaper_total_close_ms = 0;
+static int64_t g_reaper_max_close_ms = 0;
+static int32_t g_reaper_max_depth = 0;
+
+static void *macfusegui_reaper_main(void *unused) {
+    (void)unused;
+    pthread_mutex_lock(&g_reaper_lock);
+    while (1) {
+        while (g_reaper_waiting == 0) {
+            pthread_cond_wait(&g_reaper_work, &g_reaper_lock);
+        }
+        macfusegui_libssh2_session_handle *handle = g_reaper_queue[g_reaper_head];
+        g_reaper_queue[g_reaper_head] = NULL;
+        g_reaper_head = (g_reaper_head + 1) % MACFUSEGUI_REAPER_MAX_CAPACITY;
+        g_reaper_waiting -= 1;
+        g_reaper_in_progress = 1;
+        pthread_mutex_unlock(&g_reaper_lock);
+
+        int64_t started_at = macfusegui_now_millis();
+        macfusegui_libssh2_close_session(handle);
+        int64_t elapsed_ms = macfusegui_now_millis() - started_at;
+
+        pthread_mutex_lock(&g_reaper_lock);
+        g_reaper_in_progress = 0;
+        g_reaper_reaped += 1;
+        g_reaper_total_close_ms += (uint64_t)(elapsed_ms > 0 ? elapsed_ms : 0);
+        if (elapsed_ms > g_reaper_max_close_ms) {
+            g_reaper_max_close_ms = elapsed_ms;
+        }
+        if (g_reaper_waiting == 0) {
+            pthread_cond_broadcast(&g_reaper_idle);
+        }
+    }
+    return NULL;
+}
+
+/* Caller holds g_reaper_lock. */
+static bool macfusegui_reaper_ensure_started(void) {
+    if (g_reaper_started) {
+        return true;
+    }
+    pthread_attr_t attributes;
+    if (pthread_attr_init(&attributes) != 0) {
+        return false;
+    }
+    (void)pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    pthread_t thread;
+    g_reaper_started = pthread_create(&thread, &attributes, macfusegui_reaper_main, NULL) == 0;
+    pthread_attr_destroy(&attributes);
+    return g_reaper_started;
+}
+
+void macfusegui_libssh2_reaper_configure(int32_t capacity) {
+    pthread_mutex_lock(&g_reaper_lock);
+    if (capacity < 0) {
+        capacity = 0;
+    }
+    g_reaper_capacity = capacity > MACFUSEGUI_REAPER_MAX_CAPACITY ? MACFUSEGUI_REAPER_MAX_CAPACITY : capacity;
+    pthread_mutex_unlock(&g_reaper_lock);
+}
+
+void macfusegui_libssh2_close_session_async(macfusegui_libssh2_session_handle *session_handle) {
+    if (session_handle == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_reaper_lock);
+    if (g_reaper_waiting < g_reaper_capacity && macfusegui_reaper_ensure_started()) {
+        int32_t tail = (g_reaper_head + g_reaper_waiting) % MACFUSEGUI_REAPER_MAX_CAPACITY;
+        g_reaper_queue[tail] = session_handle;
+        g_reaper_waiting += 1;
+        g_reaper_enqueued += 1;
+        int32_t depth = g_reaper_waiting + g_reaper_in_progress;
+        if (depth > g_reaper_max_depth) {
+            g_reaper_max_depth = depth;
+        }
+        pthread_cond_signal(&g_reaper_work);
+        pthread_mutex_unlock(&g_reaper_lock);
+        return;
+    }
+    g_reaper_inline_closes += 1;
+    pthread_mutex_unlock(&g_reaper_lock);
+
+    macfusegui_libssh2_close_session(session_handle);
+}
+
+void macfusegui_libssh2_reaper_get_stats(macfusegui_libssh2_reaper_stats *out_stats) {
+    if (out_stats == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&g_reaper_lock);
+    memset(out_stats, 0, sizeof(*out_stats));
+    out_stats->enqueued = g_reaper_enqueued;
+    out_stats->reaped = g_reaper_reaped;
+    out_stats->inline_closes = g_reaper_inline_closes;
+    out_stats->total_close_ms = g_reaper_total_close_ms;
+    out_stats->max_close_ms = g_reaper_max_close_ms;
+    out_stats->queue_depth = g_reaper_waiting + g_reaper_in_progress;
+    out_stats->max_queue_depth = g_reaper_max_depth;
+    out_stats->capacity = g_reaper_capacity;
+    pthread_mutex_unlock(&g_reaper_lock);
+}
+
+int32_t macfusegui_libssh2_reaper_drain(int32_t timeout_ms) {
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    int64_t deadline_ns = (int64_t)deadline.tv_nsec + (int64_t)(timeout_ms > 0 ? timeout_ms : 0) * 1000000LL;
+    deadline.tv_sec += (time_t)(deadline_ns / 1000000000LL);
+    deadline.tv_nsec = (long)(deadline_ns % 1000000000LL);
+
+    pthread_mutex_lock(&g_reaper_lock);
+    int wait_result = 0;
+    while (g_reaper_waiting + g_reaper_in_progress > 0 && wait_result == 0) {
+        wait_result = pthread_cond_timedwait(&g_reaper_idle, &g_reaper_lock, &deadline);
+    }
+    int32_t status = g_reaper_waiting + g_reaper_in_progress == 0 ? 0 : -1;
+    pthread_mutex_unlock(&g_reaper_lock);
+    return status;
+}
+
 void macfusegui_libssh2_free_error(char *error_message) {
     free(error_message);
 }
@@ -1331,6 +4308,18 @@ int32_t macfusegui_libssh2_list_directories(
         timeout_seconds,
         out_result
     );
+    /* One-shot timing covers both halves: open stages from the handle, list stages from the call. */
+    const macfusegui_libssh2_stage_timing *open_timing = &session_handle->open_timing;
+    out_result->timing.resolve_us = open_timing->resolve_us;
+    out_result->timing.connect_us = open_timing->connect_us;
+    out_result->timing.handshake_us = open_timing->handshake_us;
+    out_result->timing.auth_us = open_timing->auth_us;
+    out_result->timing.sftp_init_us = open_timing->sftp_init_us;
+    out_result->timing.handshake_round_trips = open_timing->handshake_round_trips;
+    out_result->timing.auth_round_trips = open_timing->auth_round_trips;
+    out_result->timing.sftp_init_round_trips = open_timing->sftp_init_round_trips;
+    out_result->timing.connect_attempts = open_timing->connect_attempts;
+    out_result->timing.resolve_cached = open_timing->resolve_cached;
     macfusegui_libssh2_close_session(session_handle);
     session_handle = NULL;
 
@@ -1377,3 +4366,98 @@ void macfusegui_libssh2_free_list_result(macfusegui_libssh2_list_result *result)
     result->status_code = 0;
     result->latency_ms = 0;
 }
+
+void macfusegui_libssh2_free_flat_list_result(macfusegui_libssh2_flat_list_result *result) {
+    /* Flat results own exactly four buffers regardless of entry count. */
+    if (result == NULL) {
+        return;
+    }
+
+    free(result->entries);
+    free(result->name_blob);
+    free(result->resolved_path);
+    free(result->error_message);
+
+    memset(result, 0, sizeof(*result));
+}
+
+void macfusegui_libssh2_free_list_many_result(macfusegui_libssh2_list_many_result *result) {
+    if (result == NULL) {
+        return;
+    }
+
+    if (result->results != NULL) {
+        for (int32_t idx = 0; idx < result->path_count; idx += 1) {
+            macfusegui_libssh2_free_flat_list_result(&result->results[idx]);
+        }
+        free(result->results);
+    }
+    free(result->error_message);
+
+    memset(result, 0, sizeof(*result));
+}
+
+#if MACFUSEGUI_BRIDGE_TEST_HOOKS
+int32_t macfusegui_libssh2_wait_readable_for_test(
+    int fd,
+    int32_t timeout_ms,
+    macfusegui_libssh2_cancel_token *cancel_token
+) {
+    if (fd < 0 || timeout_ms <= 0) {
+        return -1;
+    }
+
+    /* Same token plumbing as a list call: set for the wait, cleared before returning. */
+    g_active_cancel_token = cancel_token;
+    int wait_result = macfusegui_wait_socket_directions(fd, LIBSSH2_SESSION_BLOCK_INBOUND, macfusegui_deadline_from_timeout_ms(timeout_ms));
+    g_active_cancel_token = NULL;
+    if (wait_result == MACFUSEGUI_BRIDGE_WAIT_CANCELLED) {
+        return MACFUSEGUI_LIBSSH2_STATUS_CANCELLED;
+    }
+    if (wait_result == MACFUSEGUI_BRIDGE_WAIT_TIMEOUT) {
+        return 1;
+    }
+    return wait_result;
+}
+
+int32_t macfusegui_libssh2_fill_synthetic_flat_result(
+    int32_t entry_count,
+    macfusegui_libssh2_flat_list_result *out_result
+) {
+    if (out_result == NULL) {
+        return -1;
+    }
+
+    macfusegui_zero_flat_list_result(out_result);
+
+    if (entry_count < 0) {
+        macfusegui_set_flat_error(out_result, -30, "Invalid synthetic entry count.");
+        return out_result->status_code;
+    }
+
+    int64_t started_at = macfusegui_now_millis();
+    out_result->first_entry_latency_ms = entry_count > 0 ? 0 : -1;
+    char name[64];
+    for (int32_t idx = 0; idx < entry_count; idx += 1) {
+        int name_len = snprintf(name, sizeof(name), "build-artifact-%08d", (int)idx);
+        if (macfusegui_flat_append_entry(
+            out_result,
+            name,
+            (size_t)name_len,
+            1,
+            1,
+            4096,
+            1,
+            (int64_t)1700000000 + idx
+        ) != 0) {
+            macfusegui_set_flat_error(out_result, -32, "Failed to store SFTP directory entry.");
+            return out_result->status_code;
+        }
+    }
+
+    int64_t elapsed_ms = macfusegui_now_millis() - started_at;
+    out_result->latency_ms = (int32_t)(elapsed_ms > 0 ? elapsed_ms : 0);
+    out_result->status_code = 0;
+    return 0;
+}
+#endif
@@ -12,11 +12,24 @@
  Ownership rules:
  - Any char* returned via out_error_message must be freed with macfusegui_libssh2_free_error.
  - Any list result allocated buffers must be released with macfusegui_libssh2_free_list_result.
+ - Any flat list result buffers must be released with macfusegui_libssh2_free_flat_list_result.
  - Session handles returned from open_session must be closed with macfusegui_libssh2_close_session.
 */
 
 #include <stdint.h>
 
+/* Upper bound on SFTP channels ("lanes") one session drives in parallel for batch listing. */
+#define MACFUSEGUI_LIBSSH2_MAX_LIST_LANES 4
+
+/* List status when the session's cancel token fired; the session is still usable. */
+#define MACFUSEGUI_LIBSSH2_STATUS_CANCELLED (-36)
+
+/* Grace window for finishing the one SFTP request that was in flight when a list call was cancelled. */
+#define MACFUSEGUI_LIBSSH2_CANCEL_DRAIN_MS 500
+
+/* Status when the link itself failed (socket send/receive error or disconnect); close the session. */
+#define MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST (-42)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,6 +47,59 @@ typedef struct macfusegui_libssh2_entry {
     int64_t modified_at_unix;
 } macfusegui_libssh2_entry;
 
+/*
+ Where the time went inside one bridge call. Durations are microseconds; 0 means the stage
+ did not run. Round trips are counted as socket waits, i.e. the number of times the stage
+ blocked on the server before it could continue.
+*/
+typedef struct macfusegui_libssh2_stage_timing {
+    /* Session-open stages (filled by open_session). */
+    int64_t resolve_us;
+    int64_t connect_us;
+    int64_t handshake_us;
+    int64_t auth_us;
+    int64_t sftp_init_us;
+    /* Listing stages (filled by the *_with_session list calls). */
+    int64_t realpath_us;
+    int64_t opendir_us;
+    int64_t readdir_us;
+    /* Directory stat of a conditional (if-modified) listing. */
+    int64_t stat_us;
+    int32_t handshake_round_trips;
+    int32_t auth_round_trips;
+    int32_t sftp_init_round_trips;
+    int32_t realpath_round_trips;
+    int32_t opendir_round_trips;
+    int32_t readdir_round_trips;
+    int32_t stat_round_trips;
+    /* Connection attempts started by the connect race. */
+    int32_t connect_attempts;
+    /* 1 when the host answer came from the resolver cache. */
+    uint8_t resolve_cached;
+    /* 1 when the canonical path came from the session's path cache (no realpath round trip). */
+    uint8_t realpath_cached;
+} macfusegui_libssh2_stage_timing;
+
+/*
+ What a cached listing knows about its directory, for conditional revalidation. Servers with
+ one-second (or coarser) mtimes cannot show a change made in the same second the validator was
+ captured, so the bridge only trusts a validator whose mtime is at least
+ MACFUSEGUI_LIBSSH2_MTIME_SETTLE_SECONDS older than captured_at_unix. captured_at_unix is on the
+ server's clock (see macfusegui_libssh2_directory_validator_set_reference), so client/server
+ clock skew cannot make a fresh mtime look settled.
+*/
+#define MACFUSEGUI_LIBSSH2_MTIME_SETTLE_SECONDS 2
+
+typedef struct macfusegui_libssh2_directory_validator {
+    /* Directory mtime (server clock, seconds). */
+    int64_t modified_at_unix;
+    /* Directory size; only compared when has_size is set on both sides. */
+    uint64_t size_bytes;
+    uint8_t has_size;
+    /* Server-clock second known to have passed when the listing was read. */
+    int64_t captured_at_unix;
+} macfusegui_libssh2_directory_validator;
+
 typedef struct macfusegui_libssh2_list_result {
     /* status_code == 0 means success. Negative values are categorized bridge/libssh2 errors. */
     int32_t status_code;
@@ -47,8 +113,115 @@ typedef struct macfusegui_libssh2_list_result {
     char *error_message;
     /* Entry array (allocated). */
     macfusegui_libssh2_entry *entries;
+    /* Per-stage breakdown for this call. */
+    macfusegui_libssh2_stage_timing timing;
 } macfusegui_libssh2_list_result;
 
+/*
+ Flat list entry. The name is not a separate allocation: its UTF-8 bytes live in the
+ owning flat result's name_blob at [name_offset, name_offset + name_length) and are
+ followed by a NUL terminator.
+*/
+typedef struct macfusegui_libssh2_flat_entry {
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint8_t is_directory;
+    uint8_t has_size;
+    uint8_t has_modified_at;
+    uint64_t size_bytes;
+    int64_t modified_at_unix;
+} macfusegui_libssh2_flat_entry;
+
+typedef struct macfusegui_libssh2_flat_list_result {
+    /* Same status/latency semantics as macfusegui_libssh2_list_result. */
+    int32_t status_code;
+    int32_t latency_ms;
+    /* Milliseconds from call start until the first entry was stored; -1 when no entry was stored. */
+    int32_t first_entry_latency_ms;
+    int32_t entry_count;
+    /* Allocated entry slots; grows geometrically so large listings stay O(log n) reallocs. */
+    int32_t entry_capacity;
+    char *resolved_path;
+    char *error_message;
+    /* Entry array (allocated, entry_capacity slots, entry_count used). */
+    macfusegui_libssh2_flat_entry *entries;
+    /* Single contiguous buffer holding every entry name, NUL-separated. */
+    char *name_blob;
+    uint64_t name_blob_length;
+    uint64_t name_blob_capacity;
+    /* Number of heap allocations (malloc/realloc) made while building this result. */
+    int32_t allocation_count;
+    /* Per-stage breakdown (realpath/opendir/readdir) for this call. */
+    macfusegui_libssh2_stage_timing timing;
+    /* 1 when a conditional listing matched the caller's validator; no entries were read. */
+    uint8_t not_modified;
+    /*
+     1 when validator describes this directory: from the stat of a conditional listing, or from
+     the "." entry of a full listing when the server sends one with an mtime.
+    */
+    uint8_t has_validator;
+    macfusegui_libssh2_directory_validator validator;
+} macfusegui_libssh2_flat_list_result;
+
+/*
+ Streaming batch callback. partial is the in-progress result (entries [0, first_new_index +
+ new_entry_count) are valid, plus resolved_path); it is only valid for the duration of the call.
+ first_new_index == 0 marks the first batch of a listing.
+*/
+typedef void (*macfusegui_libssh2_list_batch_callback)(
+    void *context,
+    const macfusegui_libssh2_flat_list_result *partial,
+    int32_t first_new_index,
+    int32_t new_entry_count
+);
+
+/* How the TCP connection for a session was established (Happy Eyeballs race). */
+typedef struct macfusegui_libssh2_connect_report {
+    /* 6 for IPv6, 4 for IPv4, 0 when no attempt connected. */
+    int32_t family;
+    /* Connection attempts started before a winner (or failure). */
+    int32_t attempts_started;
+    /* Wall time from first attempt to winner (or failure). */
+    int32_t elapsed_ms;
+    /* MACFUSEGUI_LIBSSH2_SOCKOPT_* bits the kernel accepted on the winning socket. */
+    int32_t socket_options_applied;
+} macfusegui_libssh2_connect_report;
+
+/* Bits reported in socket_options_applied. */
+#define MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_IDLE 0x1
+#define MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_INTERVAL 0x2
+#define MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_COUNT 0x4
+#define MACFUSEGUI_LIBSSH2_SOCKOPT_USER_TIMEOUT 0x8
+#define MACFUSEGUI_LIBSSH2_SOCKOPT_NODELAY 0x10
+
+/*
+ TCP tuning for browser sockets. SO_KEEPALIVE alone probes after the OS default idle time
+ (hours), so a half-open connection after a network change goes unnoticed until a request
+ times out. Zero fields keep the OS default.
+*/
+typedef struct macfusegui_libssh2_socket_options {
+    /* Idle seconds before the first keepalive probe (TCP_KEEPALIVE on macOS, TCP_KEEPIDLE elsewhere). */
+    int32_t keepalive_idle_seconds;
+    /* Seconds between unanswered probes. */
+    int32_t keepalive_interval_seconds;
+    /* Unanswered probes before the kernel drops the connection. */
+    int32_t keepalive_count;
+    /*
+     Drop the connection when sent data stays unacknowledged this long. TCP_USER_TIMEOUT where
+     available (milliseconds); macOS uses TCP_RXT_CONNDROPTIME rounded up to whole seconds.
+    */
+    int32_t user_timeout_ms;
+    /* Non-zero disables Nagle so small SFTP requests are not held back waiting for ACKs. */
+    int32_t no_delay;
+} macfusegui_libssh2_socket_options;
+
+/*
+ Cancellation token for in-flight list calls. cancel() may be called from any thread; it sets
+ an atomic flag and wakes the bridge's socket wait through a pipe, so a blocked call notices
+ within milliseconds instead of at its deadline.
+*/
+typedef struct macfusegui_libssh2_cancel_token macfusegui_libssh2_cancel_token;
+
 typedef struct macfusegui_libssh2_session_handle {
     /* Open TCP socket descriptor. */
     int sock;
@@ -56,8 +229,74 @@ typedef struct macfusegui_libssh2_session_handle {
     void *session;
     /* Opaque libssh2 sftp pointer. */
     void *sftp;
+    /*
+     Extra SFTP channels on the same SSH session, opened lazily by list_many.
+     libssh2 keeps per-channel request state, so each lane runs one request chain at a time.
+    */
+    void *lane_sftp[MACFUSEGUI_LIBSSH2_MAX_LIST_LANES - 1];
+    int32_t lane_sftp_count;
+    /* Winning address family and attempt count from the connect race. */
+    macfusegui_libssh2_connect_report connect_report;
+    /* Open-stage breakdown (resolve through SFTP init) recorded when the session was opened. */
+    macfusegui_libssh2_stage_timing open_timing;
+    /* Requested path -> canonical path memo (opaque, bridge-owned); dies with the session. */
+    void *canonical_paths;
+    /*
+     Optional, caller-owned. Checked by the single-path list calls; set and cleared on the
+     session's executor around a call. Not owned or freed by close_session.
+    */
+    macfusegui_libssh2_cancel_token *cancel_token;
+    /*
+     Optional per-call budget in milliseconds for the session calls (list, list_many, keepalive).
+     When > 0 it replaces their timeout_seconds argument, so callers can pass sub-second or
+     fractional budgets. Set on the session's executor around a call, like cancel_token.
+    */
+    int32_t timeout_ms;
+    /*
+     Optional inactivity budget in milliseconds for list and list_many. When > 0, every server
+     response that moves a listing forward extends its deadline to at least this long after the
+     response, so a large directory keeps streaming past timeout_ms and only a stall times out.
+     Set and cleared around a call, like timeout_ms.
+    */
+    int32_t progress_timeout_ms;
 } macfusegui_libssh2_session_handle;
 
+/*
+ Deadline for one listing call: budget_ms from the start, extended by progress (see
+ progress_timeout_ms on the session handle). Exposed so tests can drive it with synthetic clocks.
+*/
+typedef struct macfusegui_libssh2_list_deadline {
+    int64_t deadline_ms;
+    int32_t progress_timeout_ms;
+} macfusegui_libssh2_list_deadline;
+
+void macfusegui_libssh2_list_deadline_start(
+    macfusegui_libssh2_list_deadline *deadline,
+    int64_t now_ms,
+    int32_t budget_ms,
+    int32_t progress_timeout_ms
+);
+
+/* Records a response that moved the listing forward at now_ms; returns the resulting deadline. */
+int64_t macfusegui_libssh2_list_deadline_progress(macfusegui_libssh2_list_deadline *deadline, int64_t now_ms);
+
+typedef struct macfusegui_libssh2_list_many_result {
+    /*
+     0 when the batch ran to completion; per-path outcome lives in results[i].status_code.
+     -35 when the batch deadline passed, MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST when the socket failed.
+    */
+    int32_t status_code;
+    /* Wall time for the whole batch in milliseconds. */
+    int32_t latency_ms;
+    int32_t path_count;
+    /* Number of SFTP channels that were driven concurrently. */
+    int32_t lane_count;
+    /* Batch-level error (allocated) when status_code != 0. */
+    char *error_message;
+    /* One flat result per requested path, same order as the input (allocated). */
+    macfusegui_libssh2_flat_list_result *results;
+} macfusegui_libssh2_list_many_result;
+
 /* Returns bridge version integer for compatibility checks. */
 int32_t macfusegui_libssh2_bridge_version(void);
 
@@ -78,6 +317,25 @@ int32_t macfusegui_libssh2_open_session(
     char **out_error_message
 );
 
+/* Same as open_session with explicit TCP tuning; NULL socket_options means the bridge defaults. */
+int32_t macfusegui_libssh2_open_session_with_options(
+    const char *host,
+    int32_t port,
+    const char *username,
+    const char *password,
+    const char *private_key_path,
+    int32_t timeout_seconds,
+    const macfusegui_libssh2_socket_options *socket_options,
+    macfusegui_libssh2_session_handle **out_session,
+    char **out_error_message
+);
+
+/* Fills the bridge defaults: probes after 10 s idle, every 5 s, 3 tries; 15 s user timeout; no delay. */
+void macfusegui_libssh2_socket_options_default(macfusegui_libssh2_socket_options *out_options);
+
+/* Applies options to a connected TCP socket; returns the MACFUSEGUI_LIBSSH2_SOCKOPT_* bits that took. */
+int32_t macfusegui_libssh2_apply_socket_options(int fd, const macfusegui_libssh2_socket_options *options);
+
 /*
  Lists directories using an already-open session.
  remote_path should be normalized by caller.
@@ -91,6 +349,88 @@ int32_t macfusegui_libssh2_list_directories_with_session(
     macfusegui_libssh2_list_result *out_result
 );
 
+/*
+ Same flow as list_directories_with_session, but fills a flat result: one entry array
+ plus one name blob instead of one heap string per entry.
+ Caller must free out_result with macfusegui_libssh2_free_flat_list_result.
+*/
+int32_t macfusegui_libssh2_list_directories_flat_with_session(
+    macfusegui_libssh2_session_handle *session,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    macfusegui_libssh2_flat_list_result *out_result
+);
+
+/*
+ Streaming variant of list_directories_flat_with_session. While readdir is running, batch_callback
+ is invoked on the calling thread whenever batch_entry_count new entries were stored or
+ batch_interval_ms elapsed since the last batch (whichever comes first), and once more for any
+ remainder on success. A value <= 0 disables that trigger. The final out_result still holds the
+ complete listing and must be freed with macfusegui_libssh2_free_flat_list_result.
+*/
+int32_t macfusegui_libssh2_list_directories_streaming_with_session(
+    macfusegui_libssh2_session_handle *session,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    int32_t batch_entry_count,
+    int32_t batch_interval_ms,
+    macfusegui_libssh2_list_batch_callback batch_callback,
+    void *batch_context,
+    macfusegui_libssh2_flat_list_result *out_result
+);
+
+/*
+ Conditional variant of list_directories_streaming_with_session. When validator is non-NULL, the
+ directory is stat'ed first (one small request instead of opendir + readdir); if its mtime and
+ size match a trusted validator, the call returns 0 with not_modified = 1, resolved_path set and
+ no entries. Otherwise (changed, no mtime from the server, untrusted validator, or stat failed)
+ it falls back to a full listing. NULL validator behaves exactly like the streaming call.
+*/
+int32_t macfusegui_libssh2_list_directories_if_modified_with_session(
+    macfusegui_libssh2_session_handle *session,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    const macfusegui_libssh2_directory_validator *validator,
+    int32_t batch_entry_count,
+    int32_t batch_interval_ms,
+    macfusegui_libssh2_list_batch_callback batch_callback,
+    void *batch_context,
+    macfusegui_libssh2_flat_list_result *out_result
+);
+
+/*
+ Sets validator->captured_at_unix from server time: newest_server_unix is the newest mtime/atime
+ the server reported while the directory was read (each is at most the server's "now"). It is
+ capped at client_now_unix so a single future-dated file cannot vouch for a fresh directory;
+ with no newer timestamp than the directory's own mtime the validator stays unsettled and the
+ next listing is a full one.
+*/
+void macfusegui_libssh2_directory_validator_set_reference(
+    macfusegui_libssh2_directory_validator *validator,
+    int64_t newest_server_unix,
+    int64_t client_now_unix
+);
+
+/* 1 when current (fresh attributes) proves the directory unchanged since cached was captured. */
+int32_t macfusegui_libssh2_directory_validator_matches(
+    const macfusegui_libssh2_directory_validator *cached,
+    const macfusegui_libssh2_directory_validator *current
+);
+
+/*
+ Lists several directories at once over one session. Up to MACFUSEGUI_LIBSSH2_MAX_LIST_LANES
+ realpath -> opendir -> readdir chains are interleaved on the non-blocking socket, so N paths
+ cost roughly one round-trip chain instead of N. timeout_seconds bounds the whole batch.
+ Caller must free out_result with macfusegui_libssh2_free_list_many_result.
+*/
+int32_t macfusegui_libssh2_list_many(
+    macfusegui_libssh2_session_handle *session,
+    const char *const *remote_paths,
+    int32_t path_count,
+    int32_t timeout_seconds,
+    macfusegui_libssh2_list_many_result *out_result
+);
+
 /*
  Lightweight health probe for existing session.
  Used by keepalive loops in Swift actor.
@@ -102,9 +442,90 @@ int32_t macfusegui_libssh2_ping_session(
     char **out_error_message
 );
 
+/* Keepalive modes for macfusegui_libssh2_keepalive_session. */
+#define MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SFTP_STAT 0
+#define MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SSH 1
+
+typedef struct macfusegui_libssh2_keepalive_outcome {
+    /* Mode that was requested (SSH mode still reports SSH when it fell back to a stat). */
+    int32_t mode_used;
+    /* 1 when the server refused the SSH-mode realpath probe and an SFTP stat had to confirm the link. */
+    uint8_t sftp_probed;
+    /* 1 when the server answered the SSH-mode realpath probe. */
+    uint8_t reply_seen;
+    /* Wall time for the whole probe in milliseconds. */
+    int64_t latency_ms;
+} macfusegui_libssh2_keepalive_outcome;
+
+/*
+ Keepalive probe for an existing session.
+ SSH mode sends a keepalive@libssh2.org global request without want-reply (so no replies queue
+ up inside libssh2), then proves liveness with one SFTP realpath of "." without statting the
+ browsed folder. A reply missing after half the timeout is still drained within the rest, so no
+ stale reply is left for the next call; if it never comes the call fails and the session must be
+ closed. Only when the server refuses realpath does it fall back to one SFTP stat of remote_path.
+ SFTP_STAT mode behaves like macfusegui_libssh2_ping_session.
+ Returns 0 when the link answered; -40 invalid state, -41 stat/realpath failure or timeout,
+ MACFUSEGUI_LIBSSH2_STATUS_SESSION_LOST send failure or closed session. out_outcome may be NULL.
+*/
+int32_t macfusegui_libssh2_keepalive_session(
+    macfusegui_libssh2_session_handle *session,
+    const char *remote_path,
+    int32_t timeout_seconds,
+    int32_t mode,
+    macfusegui_libssh2_keepalive_outcome *out_outcome,
+    char **out_error_message
+);
+
+/* Returns a new token, or NULL when the wake-up pipe could not be created. */
+macfusegui_libssh2_cancel_token *macfusegui_libssh2_cancel_token_create(void);
+
+/* Safe to call with NULL. The token must not be installed on a session while being destroyed. */
+void macfusegui_libssh2_cancel_token_destroy(macfusegui_libssh2_cancel_token *token);
+
+/* Thread-safe and idempotent. */
+void macfusegui_libssh2_cancel_token_cancel(macfusegui_libssh2_cancel_token *token);
+
+/* 1 after cancel() was called, 0 otherwise (including NULL). */
+int32_t macfusegui_libssh2_cancel_token_is_cancelled(const macfusegui_libssh2_cancel_token *token);
+
 /* Closes session and releases native resources. Safe to call with NULL. */
 void macfusegui_libssh2_close_session(macfusegui_libssh2_session_handle *session);
 
+/*
+ Background teardown ("reaper"). close_session_async hands the handle to one process-wide
+ teardown thread and returns at once, so a reconnect does not wait behind the graceful SFTP
+ shutdown and disconnect (up to about 2 s on a dead link). The handle must not be touched
+ after the call. When capacity handles are already waiting, the close runs inline instead,
+ which bounds how many sockets can sit in teardown at once.
+*/
+typedef struct macfusegui_libssh2_reaper_stats {
+    /* Handles handed to the teardown thread. */
+    uint64_t enqueued;
+    /* Closes the teardown thread finished. */
+    uint64_t reaped;
+    /* Closes run on the caller because the queue was full or the thread could not start. */
+    uint64_t inline_closes;
+    /* Sum and maximum of close times on the teardown thread. */
+    uint64_t total_close_ms;
+    int64_t max_close_ms;
+    /* Handles waiting plus the one being closed, and the highest value seen. */
+    int32_t queue_depth;
+    int32_t max_queue_depth;
+    int32_t capacity;
+} macfusegui_libssh2_reaper_stats;
+
+/* Waiting-handle limit, clamped to 0...64 (0 closes everything inline). Default 8. */
+void macfusegui_libssh2_reaper_configure(int32_t capacity);
+
+/* Queues session for teardown, or closes it inline when the queue is full. Safe to call with NULL. */
+void macfusegui_libssh2_close_session_async(macfusegui_libssh2_session_handle *session);
+
+void macfusegui_libssh2_reaper_get_stats(macfusegui_libssh2_reaper_stats *out_stats);
+
+/* Waits until no teardown is queued or running. Returns 0 when idle, -1 if timeout_ms passed first. */
+int32_t macfusegui_libssh2_reaper_drain(int32_t timeout_ms);
+
 /* Frees error string returned by bridge out_error_message APIs. */
 void macfusegui_libssh2_free_error(char *error_message);
 
@@ -136,6 +557,205 @@ int32_t macfusegui_libssh2_classify_directory_entry(
 /* Frees all allocated buffers inside result and resets fields to safe defaults. */
 void macfusegui_libssh2_free_list_result(macfusegui_libssh2_list_result *result);
 
+/* Frees entry array, name blob and strings inside a flat result and resets fields. */
+void macfusegui_libssh2_free_flat_list_result(macfusegui_libssh2_flat_list_result *result);
+
+/* Frees every per-path result and the batch error, then resets fields. */
+void macfusegui_libssh2_free_list_many_result(macfusegui_libssh2_list_many_result *result);
+
+/*
+ Readiness reactor: waits on many sockets at once without select()'s FD_SETSIZE limit.
+ Backend is kqueue on macOS/BSD, epoll on Linux, and poll() everywhere else (or when the
+ kernel object cannot be created). One reactor may be reused across waits from one thread;
+ it is not safe to wait on the same reactor from two threads at once.
+*/
+typedef struct macfusegui_libssh2_reactor macfusegui_libssh2_reactor;
+
+#define MACFUSEGUI_LIBSSH2_WAIT_READ 0x1
+#define MACFUSEGUI_LIBSSH2_WAIT_WRITE 0x2
+/* Output only: the descriptor reported an error or hangup. Never needs to be requested. */
+#define MACFUSEGUI_LIBSSH2_WAIT_ERROR 0x4
+
+typedef struct macfusegui_libssh2_wait_interest {
+    int32_t fd;
+    /* Bitmask of MACFUSEGUI_LIBSSH2_WAIT_READ / MACFUSEGUI_LIBSSH2_WAIT_WRITE. */
+    int16_t events;
+    /*
+     Set by the wait: ready subset of events. Errors/hangups report every requested event plus
+     MACFUSEGUI_LIBSSH2_WAIT_ERROR, so they count as ready even when no requested event fired.
+    */
+    int16_t ready;
+} macfusegui_libssh2_wait_interest;
+
+/* Returns NULL only on allocation failure. Destroy with macfusegui_libssh2_reactor_destroy. */
+macfusegui_libssh2_reactor *macfusegui_libssh2_reactor_create(void);
+
+void macfusegui_libssh2_reactor_destroy(macfusegui_libssh2_reactor *reactor);
+
+/* "kqueue", "epoll" or "poll"; for diagnostics. */
+const char *macfusegui_libssh2_reactor_backend_name(const macfusegui_libssh2_reactor *reactor);
+
+/*
+ Fills interest with the session socket and the direction(s) libssh2 is currently blocked on.
+ Returns 0 on success, -1 for a closed/invalid handle.
+*/
+int32_t macfusegui_libssh2_session_wait_interest(
+    macfusegui_libssh2_session_handle *session_handle,
+    macfusegui_libssh2_wait_interest *out_interest
+);
+
+/*
+ Waits until at least one interest is ready or timeout_ms passes.
+ Returns the number of ready interests, 0 on timeout, or -1 on error (errno set).
+*/
+int32_t macfusegui_libssh2_reactor_wait(
+    macfusegui_libssh2_reactor *reactor,
+    macfusegui_libssh2_wait_interest *interests,
+    int32_t interest_count,
+    int32_t timeout_ms
+);
+
+/*
+ Resolver cache keyed by host and port. open_session uses the shared instance; tests can create
+ their own so they do not disturb it. Concurrent lookups of one key share a single getaddrinfo.
+ Counters are cumulative since the cache was created; flush only drops cached answers.
+*/
+typedef struct macfusegui_libssh2_resolver macfusegui_libssh2_resolver;
+
+typedef struct macfusegui_libssh2_resolver_stats {
+    /* Fresh positive answers served from cache. */
+    uint64_t hits;
+    /* Lookups that went to getaddrinfo. */
+    uint64_t misses;
+    /* Cached failures served without asking the resolver again. */
+    uint64_t negative_hits;
+    /* Expired answers served because the refresh lookup failed. */
+    uint64_t stale_hits;
+    /* Lookups that waited for another thread's getaddrinfo of the same host and port. */
+    uint64_t coalesced;
+    int32_t entry_count;
+    int32_t positive_ttl_ms;
+    int32_t negative_ttl_ms;
+} macfusegui_libssh2_resolver_stats;
+
+/* The process-wide cache open_session resolves through. Never destroy it. */
+macfusegui_libssh2_resolver *macfusegui_libssh2_resolver_shared(void);
+
+/* TTLs of 0 disable caching for that kind of answer. Returns NULL only on allocation failure. */
+macfusegui_libssh2_resolver *macfusegui_libssh2_resolver_create(int32_t positive_ttl_ms, int32_t negative_ttl_ms);
+
+/* No lookup may still be running on the cache. Ignores the shared cache. */
+void macfusegui_libssh2_resolver_destroy(macfusegui_libssh2_resolver *resolver);
+
+/* Shared cache defaults: 60000 ms positive, 5000 ms negative. */
+void macfusegui_libssh2_resolver_configure(
+    macfusegui_libssh2_resolver *resolver,
+    int32_t positive_ttl_ms,
+    int32_t negative_ttl_ms
+);
+
+/* Drops every cached answer (for example after a network change). Counters are kept. */
+void macfusegui_libssh2_resolver_flush(macfusegui_libssh2_resolver *resolver);
+
+void macfusegui_libssh2_resolver_get_stats(
+    macfusegui_libssh2_resolver *resolver,
+    macfusegui_libssh2_resolver_stats *out_stats
+);
+
+/*
+ Resolves host:port through the cache. Returns 0 on success or the getaddrinfo error code.
+ out_address_count receives the number of addresses available to connect to.
+*/
+int32_t macfusegui_libssh2_resolver_lookup(
+    macfusegui_libssh2_resolver *resolver,
+    const char *host,
+    int32_t port,
+    int32_t *out_address_count
+);
+
+/*
+ Canonical path cache on a session handle. Listings consult it before realpath: an exact hit, or
+ a direct child of a cached parent whose last complete listing showed that child is not a
+ symlink, goes straight to opendir. Deeper paths and links always go through realpath, so the
+ resolved path matches what the server's realpath returns. A path opendir reports missing is
+ dropped with everything below it; the whole cache goes when the session is closed.
+
+ canonical_path copies the cached canonical form of requested_path into buffer and returns its
+ length, or -1 when it is neither cached nor derivable (or buffer is too small).
+*/
+int32_t macfusegui_libssh2_session_canonical_path(
+    macfusegui_libssh2_session_handle *session,
+    const char *requested_path,
+    char *buffer,
+    int32_t buffer_size
+);
+
+void macfusegui_libssh2_session_remember_canonical_path(
+    macfusegui_libssh2_session_handle *session,
+    const char *requested_path,
+    const char *canonical_path
+);
+
+/* Drops every cached canonical path and releases the cache storage. */
+void macfusegui_libssh2_session_forget_canonical_paths(macfusegui_libssh2_session_handle *session);
+
+/* Drops path and every cached path below it, under requested and canonical spellings alike. */
+void macfusegui_libssh2_session_forget_canonical_subtree(
+    macfusegui_libssh2_session_handle *session,
+    const char *path
+);
+
+/*
+ Records the symlinked entries of a completely listed directory (already cached under
+ canonical_path); its other children then derive without realpath. Listings call this
+ themselves; it is exported for tests.
+*/
+void macfusegui_libssh2_session_remember_directory_links(
+    macfusegui_libssh2_session_handle *session,
+    const char *canonical_path,
+    const char *const *link_names,
+    int32_t link_count
+);
+
+/*
+ Test helper: races TCP connects to numeric addresses (in the given preference order) with the
+ same Happy Eyeballs logic open_session uses. Returns a connected non-blocking fd that the
+ caller must close, or -1 when no address connected before timeout_ms.
+*/
+int32_t macfusegui_libssh2_connect_numeric_candidates(
+    const char *const *numeric_hosts,
+    int32_t host_count,
+    int32_t port,
+    int32_t timeout_ms,
+    int32_t attempt_delay_ms,
+    macfusegui_libssh2_connect_report *out_report
+);
+
+#if MACFUSEGUI_BRIDGE_TEST_HOOKS
+/*
+ Test helper: the socket wait every list call blocks in, for a read on fd. cancel_token (may be
+ NULL) is active for this wait only, exactly as during a list call. Returns 0 when fd is readable,
+ 1 on timeout, MACFUSEGUI_LIBSSH2_STATUS_CANCELLED when the token fired, or -1 on error.
+ Only built when MACFUSEGUI_BRIDGE_TEST_HOOKS is set (Debug configuration).
+*/
+int32_t macfusegui_libssh2_wait_readable_for_test(
+    int fd,
+    int32_t timeout_ms,
+    macfusegui_libssh2_cancel_token *cancel_token
+);
+
+/*
+ Benchmark/test helper: fills out_result with entry_count synthetic directory entries
+ through the same append path used by real listings. No network access.
+ Caller must free out_result with macfusegui_libssh2_free_flat_list_result.
+ Only built when MACFUSEGUI_BRIDGE_TEST_HOOKS is set (Debug configuration).
+*/
+int32_t macfusegui_libssh2_fill_synthetic_flat_result(
+    int32_t entry_count,
+    macfusegui_libssh2_flat_list_result *out_result
+);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -15,6 +15,124 @@ struct BrowserTransportListResult: Sendable {
     var entries: [RemoteDirectoryItem]
     var latencyMs: Int
     var reopenedSession: Bool
+    // Time until the first entry arrived; nil when the listing had no entries.
+    var firstEntryLatencyMs: Int? = nil
+    // Where the time went inside the bridge; nil for transports that do not measure stages.
+    var stageTiming: BrowserStageTiming? = nil
+    // Directory attributes to revalidate this listing with next time; nil when the server gave none.
+    var directoryValidator: BrowserDirectoryValidator? = nil
+    // True when a conditional listing found the directory unchanged; entries are then empty
+    // and the caller keeps the rows it already has.
+    var notModified = false
+}
+
+/// Beginner note: Directory mtime/size captured with a listing, used to skip re-reading an
+/// unchanged directory. The bridge decides whether a validator is trustworthy (coarse mtimes).
+struct BrowserDirectoryValidator: Sendable, Equatable {
+    var modifiedAtUnix: Int64
+    var sizeBytes: UInt64?
+    // Server clock second known to have passed when the listing was read (not the client clock).
+    var capturedAtUnix: Int64
+}
+
+/// Beginner note: TCP dead-peer tuning applied to every browser socket.
+/// Defaults notice a half-open connection (for example after Wi-Fi roaming) in roughly 25 s of
+/// silence instead of the OS default of hours; zero keeps the OS default for that field.
+struct BrowserSocketOptions: Sendable, Equatable {
+    var keepAliveIdleSeconds: Int32 = 10
+    var keepAliveIntervalSeconds: Int32 = 5
+    var keepAliveCount: Int32 = 3
+    // Unacknowledged sent data older than this drops the connection (whole seconds on macOS).
+    var userTimeoutMs: Int32 = 15_000
+    // Small SFTP requests go out immediately instead of waiting on Nagle.
+    var noDelay = true
+}
+
+/// Beginner note: Per-stage breakdown of one native list call, in microseconds.
+/// Open stages (resolve through SFTP init) are only set when the call had to open a session.
+/// Round trips count how often a stage blocked waiting for the server.
+struct BrowserStageTiming: Sendable, Equatable {
+    var resolveMicros: Int64 = 0
+    var connectMicros: Int64 = 0
+    var handshakeMicros: Int64 = 0
+    var authMicros: Int64 = 0
+    var sftpInitMicros: Int64 = 0
+    var realpathMicros: Int64 = 0
+    var opendirMicros: Int64 = 0
+    var readdirMicros: Int64 = 0
+    var statMicros: Int64 = 0
+    var handshakeRoundTrips = 0
+    var authRoundTrips = 0
+    var sftpInitRoundTrips = 0
+    var realpathRoundTrips = 0
+    var opendirRoundTrips = 0
+    var readdirRoundTrips = 0
+    var statRoundTrips = 0
+    var connectAttempts = 0
+    var resolveCached = false
+    // True when the session's canonical path cache made the realpath round trip unnecessary.
+    var realpathCached = false
+
+    var includesSessionOpen: Bool {
+        connectAttempts > 0 || connectMicros > 0
+    }
+
+    /// Beginner note: Compact "stage=ms/round-trips" text for diagnostics lines.
+    var summary: String {
+        var parts: [String] = []
+        if includesSessionOpen {
+            parts.append("resolve=\(Self.millis(resolveMicros))\(resolveCached ? "(cached)" : "")")
+            parts.append("connect=\(Self.millis(connectMicros))/\(connectAttempts)att")
+            parts.append("handshake=\(Self.millis(handshakeMicros))/\(handshakeRoundTrips)rt")
+            parts.append("auth=\(Self.millis(authMicros))/\(authRoundTrips)rt")
+            parts.append("sftpInit=\(Self.millis(sftpInitMicros))/\(sftpInitRoundTrips)rt")
+        }
+        parts.append(realpathCached ? "realpath=cached" : "realpath=\(Self.millis(realpathMicros))/\(realpathRoundTrips)rt")
+        if statMicros > 0 || statRoundTrips > 0 {
+            parts.append("stat=\(Self.millis(statMicros))/\(statRoundTrips)rt")
+        }
+        parts.append("opendir=\(Self.millis(opendirMicros))/\(opendirRoundTrips)rt")
+        parts.append("readdir=\(Self.millis(readdirMicros))/\(readdirRoundTrips)rt")
+        return parts.joined(separator: ",")
+    }
+
+    /// Beginner note: Copies the session-open stages from another breakdown, keeping list stages.
+    mutating func adoptOpenStages(from other: BrowserStageTiming) {
+        resolveMicros = other.resolveMicros
+        connectMicros = other.connectMicros
+        handshakeMicros = other.handshakeMicros
+        authMicros = other.authMicros
+        sftpInitMicros = other.sftpInitMicros
+        handshakeRoundTrips = other.handshakeRoundTrips
+        authRoundTrips = other.authRoundTrips
+        sftpInitRoundTrips = other.sftpInitRoundTrips
+        connectAttempts = other.connectAttempts
+        resolveCached = other.resolveCached
+    }
+
+    private static func millis(_ micros: Int64) -> String {
+        String(format: "%.1fms", Double(micros) / 1000)
+    }
+}
+
+/// Beginner note: One streamed slice of an in-progress listing.
+/// A higher generation (or startIndex == 0) means a new listing pass started, for example after the
+/// session was reopened, so rows from the earlier pass are obsolete.
+struct BrowserTransportListBatch: Sendable {
+    var resolvedPath: String
+    var startIndex: Int
+    var entries: [RemoteDirectoryItem]
+    var generation = 0
+}
+
+typealias BrowserTransportBatchHandler = @Sendable (BrowserTransportListBatch) -> Void
+
+/// Beginner note: Outcome for one path of a multi-path listing.
+/// Exactly one of result or errorMessage is set.
+struct BrowserTransportPathListOutcome: Sendable {
+    var requestedPath: String
+    var result: BrowserTransportListResult?
+    var errorMessage: String?
 }
 
 /// Beginner note: This type groups related state and behavior for one part of the app.
@@ -23,104 +141,334 @@ protocol BrowserTransport {
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async and throwing: callers must await it and handle failures.
     func listDirectories(remote: RemoteConfig, path: String, password: String?) async throws -> BrowserTransportListResult
+    /// Beginner note: Streaming variant; onBatch receives rows while the listing is still running.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?
+    ) async throws -> BrowserTransportListResult
+    /// Beginner note: Conditional variant; with a validator the transport may answer notModified
+    /// instead of re-reading an unchanged directory. A nil validator is a normal listing.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?,
+        ifModified validator: BrowserDirectoryValidator?
+    ) async throws -> BrowserTransportListResult
+    /// Beginner note: Lists several paths in one call and returns one outcome per path, in input order.
+    /// Throws only when the whole batch could not run (for example, no session could be opened).
+    func listDirectories(remote: RemoteConfig, paths: [String], password: String?) async throws -> [BrowserTransportPathListOutcome]
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async and throwing: callers must await it and handle failures.
     func ping(remote: RemoteConfig, path: String, password: String?) async throws
+    /// Beginner note: Keepalive probe in the requested mode; reports how the link answered.
+    /// This is async and throwing: callers must await it and handle failures.
+    func keepAlive(remote: RemoteConfig, path: String, password: String?, mode: BrowserKeepAliveMode) async throws -> BrowserKeepAliveResult
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     func invalidate(remoteID: UUID) async
+    /// Beginner note: Optional one-line transport-wide state for the diagnostics snapshot.
+    func diagnosticsSummaryLine() -> String?
+    /// Beginner note: Optional RTT estimate and current per-call budgets for one remote.
+    func adaptiveTimeoutSummary(remoteID: UUID) -> String?
 }
 
 extension BrowserTransport {
+    /// Beginner note: Transports without streaming support deliver everything in the final result.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?
+    ) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password)
+    }
+
+    /// Beginner note: Transports without conditional listing always return the full listing.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?,
+        ifModified validator: BrowserDirectoryValidator?
+    ) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password, onBatch: onBatch)
+    }
+
+    /// Beginner note: Transports without a batch primitive list each path in turn.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(remote: RemoteConfig, paths: [String], password: String?) async throws -> [BrowserTransportPathListOutcome] {
+        var outcomes: [BrowserTransportPathListOutcome] = []
+        outcomes.reserveCapacity(paths.count)
+        for path in paths {
+            do {
+                let result = try await listDirectories(remote: remote, path: path, password: password)
+                outcomes.append(BrowserTransportPathListOutcome(requestedPath: path, result: result, errorMessage: nil))
+            } catch {
+                outcomes.append(BrowserTransportPathListOutcome(requestedPath: path, result: nil, errorMessage: error.localizedDescription))
+            }
+        }
+        return outcomes
+    }
+
+    /// Beginner note: Transports without protocol keepalives answer every mode with a ping.
+    /// This is async and throwing: callers must await it and handle failures.
+    func keepAlive(remote: RemoteConfig, path: String, password: String?, mode: BrowserKeepAliveMode) async throws -> BrowserKeepAliveResult {
+        let startedAt = Date()
+        try await ping(remote: remote, path: path, password: password)
+        return BrowserKeepAliveResult(
+            modeUsed: .sftpStat,
+            sftpProbed: true,
+            replySeen: false,
+            latencyMs: Int(Date().timeIntervalSince(startedAt) * 1000)
+        )
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     func invalidate(remoteID: UUID) async {}
+
+    /// Beginner note: Transports without shared state have nothing to report.
+    func diagnosticsSummaryLine() -> String? {
+        nil
+    }
+
+    /// Beginner note: Transports with fixed timeouts have no estimate to report.
+    func adaptiveTimeoutSummary(remoteID: UUID) -> String? {
+        nil
+    }
 }
 
 /// Beginner note: This type groups related state and behavior for one part of the app.
 /// Read stored properties first, then follow methods top-to-bottom to understand flow.
-// @unchecked Sendable is safe here because the sessions map is only accessed on the private serial bridgeQueue.
+// @unchecked Sendable is safe here because the sessions and RTT maps are guarded by sessionsLock and
+// each native handle is only touched on its own remote's serial executor.
 final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
     private let diagnostics: DiagnosticsService
-    private let bridgeQueue = DispatchQueue(label: "com.visualweb.macfusegui.browser.libssh2", qos: .userInitiated)
-    private let bridgeQueueSpecificKey = DispatchSpecificKey<UInt8>()
-    private let bridgeQueueSpecificValue: UInt8 = 1
-    private let listTimeoutSeconds: TimeInterval
-    private let pingTimeoutSeconds: TimeInterval
+    // One serial executor per remote: a blackholed host only ever blocks its own queue.
+    // Work reaches it through the scheduler, which runs queued clicks before pings and prefetches.
+    private let scheduler = BrowserOperationScheduler(
+        executors: BrowserRemoteExecutorPool(labelPrefix: "com.visualweb.macfusegui.browser.libssh2")
+    )
+    private let sessionsLock = NSLock()
+    // Session open (TCP, handshake, auth) keeps a fixed budget; list and keepalive budgets
+    // follow each remote's measured round-trip time.
+    private let openTimeoutSeconds: TimeInterval
+    private let timeoutPolicy: BrowserAdaptiveTimeoutPolicy
+    // Streaming listings flush a batch every N entries or T milliseconds, whichever comes first.
+    private let streamBatchEntryCount: Int32
+    private let streamBatchIntervalMs: Int32
+    private let socketOptions: BrowserSocketOptions
     private var sessions: [UUID: UnsafeMutablePointer<macfusegui_libssh2_session_handle>] = [:]
+    private var rttEstimators: [UUID: BrowserRTTEstimator] = [:]
 
-    private func assertOnBridgeQueue() {
-        dispatchPrecondition(condition: .onQueue(bridgeQueue))
+    private var executors: BrowserRemoteExecutorPool {
+        scheduler.executors
     }
 
-    private func isOnBridgeQueue() -> Bool {
-        DispatchQueue.getSpecific(key: bridgeQueueSpecificKey) == bridgeQueueSpecificValue
+    private func assertOnExecutor(for remoteID: UUID) {
+        executors.assertOnExecutor(for: remoteID)
     }
 
-    private func closeAllSessionsOnBridgeQueue() {
-        assertOnBridgeQueue()
-        for (_, handle) in sessions {
-            macfusegui_libssh2_close_session(handle)
-        }
-        sessions.removeAll()
+    private func session(for remoteID: UUID) -> UnsafeMutablePointer<macfusegui_libssh2_session_handle>? {
+        sessionsLock.lock()
+        defer { sessionsLock.unlock() }
+        return sessions[remoteID]
+    }
+
+    private func setSession(_ handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>?, for remoteID: UUID) {
+        sessionsLock.lock()
+        defer { sessionsLock.unlock() }
+        sessions[remoteID] = handle
+    }
+
+    /// Beginner note: Applies one update to a remote's RTT estimator under the sessions lock.
+    private func updateRTTEstimator(for remoteID: UUID, _ update: (inout BrowserRTTEstimator) -> Void) {
+        sessionsLock.lock()
+        defer { sessionsLock.unlock() }
+        var estimator = rttEstimators[remoteID] ?? BrowserRTTEstimator()
+        update(&estimator)
+        rttEstimators[remoteID] = estimator
+    }
+
+    private func rttEstimator(for remoteID: UUID) -> BrowserRTTEstimator {
+        sessionsLock.lock()
+        defer { sessionsLock.unlock() }
+        return rttEstimators[remoteID] ?? BrowserRTTEstimator()
     }
 
     /// Beginner note: Initializers create valid state before any other method is used.
     init(
         diagnostics: DiagnosticsService,
-        listTimeoutSeconds: TimeInterval = 8,
-        pingTimeoutSeconds: TimeInterval = 2
+        openTimeoutSeconds: TimeInterval = 8,
+        timeoutPolicy: BrowserAdaptiveTimeoutPolicy = BrowserAdaptiveTimeoutPolicy(),
+        streamBatchEntryCount: Int32 = 256,
+        streamBatchIntervalMs: Int32 = 100,
+        resolverPositiveTTLSeconds: TimeInterval = 60,
+        resolverNegativeTTLSeconds: TimeInterval = 5,
+        teardownQueueCapacity: Int32 = 8,
+        socketOptions: BrowserSocketOptions = BrowserSocketOptions()
     ) {
         self.diagnostics = diagnostics
-        self.listTimeoutSeconds = listTimeoutSeconds
-        self.pingTimeoutSeconds = pingTimeoutSeconds
-        bridgeQueue.setSpecific(key: bridgeQueueSpecificKey, value: bridgeQueueSpecificValue)
+        self.openTimeoutSeconds = openTimeoutSeconds
+        self.timeoutPolicy = timeoutPolicy
+        self.streamBatchEntryCount = streamBatchEntryCount
+        self.streamBatchIntervalMs = streamBatchIntervalMs
+        self.socketOptions = socketOptions
+        // The native resolver cache is process-wide; reconnect storms reuse answers within the TTL.
+        macfusegui_libssh2_resolver_configure(
+            macfusegui_libssh2_resolver_shared(),
+            Int32(max(0, min(resolverPositiveTTLSeconds * 1_000, Double(Int32.max)))),
+            Int32(max(0, min(resolverNegativeTTLSeconds * 1_000, Double(Int32.max))))
+        )
+        // Closed sessions are torn down on a native background thread; see closeSessionSync.
+        macfusegui_libssh2_reaper_configure(teardownQueueCapacity)
     }
 
     /// Beginner note: Deinitializer runs during teardown to stop background work and free resources.
     deinit {
-        if isOnBridgeQueue() {
-            assertionFailure("LibSSH2SFTPTransport deinit called on bridge queue; closing sessions inline to avoid deadlock.")
-            closeAllSessionsOnBridgeQueue()
-            return
-        }
-
-        bridgeQueue.sync {
-            closeAllSessionsOnBridgeQueue()
+        // Each handle is released on its own executor (so no call is still using it), then torn down by the reaper.
+        let currentRemoteID = executors.currentRemoteID()
+        sessionsLock.lock()
+        let openRemoteIDs = Array(sessions.keys)
+        sessionsLock.unlock()
+        for remoteID in openRemoteIDs {
+            if remoteID == currentRemoteID {
+                assertionFailure("LibSSH2SFTPTransport deinit called on a remote executor; closing that session inline to avoid deadlock.")
+                closeSessionSync(for: remoteID)
+                continue
+            }
+            executors.sync(remoteID: remoteID) {
+                closeSessionSync(for: remoteID)
+            }
         }
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async and throwing: callers must await it and handle failures.
     func listDirectories(remote: RemoteConfig, path: String, password: String?) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password, onBatch: nil)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?
+    ) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password, onBatch: onBatch, ifModified: nil)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?,
+        ifModified validator: BrowserDirectoryValidator?
+    ) async throws -> BrowserTransportListResult {
         let normalizedPath = BrowserPathNormalizer.normalize(path: path)
 
         diagnostics.append(
             level: .info,
             category: "remote-browser",
-            message: "libssh2 list start host=\(remote.host) port=\(remote.port) user=\(remote.username) path=\(normalizedPath) auth=\(remote.authMode.rawValue)"
+            message: "libssh2 list start host=\(remote.host) port=\(remote.port) user=\(remote.username) path=\(normalizedPath) auth=\(remote.authMode.rawValue) conditional=\(validator != nil)"
+        )
+
+        // Task cancellation (a newer navigation superseded this one) wakes the native wait loop,
+        // so the remote's executor is freed within milliseconds instead of at the list timeout.
+        let cancellation = BrowserListCancellation()
+        let priority = BrowserOperationPriority.current
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                scheduler.enqueue(remoteID: remote.id, priority: priority) { [self] in
+                    do {
+                        let result = try listDirectoriesSync(
+                            remote: remote,
+                            path: normalizedPath,
+                            password: password,
+                            cancellation: cancellation,
+                            onBatch: onBatch,
+                            validator: validator
+                        )
+                        let directoryCount = result.entries.reduce(into: 0) { partial, item in
+                            if item.isDirectory {
+                                partial += 1
+                            }
+                        }
+                        diagnostics.append(
+                            level: .info,
+                            category: "remote-browser",
+                            message: "libssh2 list success path=\(result.resolvedPath) entries=\(result.entries.count) dirs=\(directoryCount) notModified=\(result.notModified) latencyMs=\(result.latencyMs) firstEntryMs=\(result.firstEntryLatencyMs.map(String.init) ?? "-") reopenedSession=\(result.reopenedSession) stages=\(result.stageTiming?.summary ?? "-")"
+                        )
+                        continuation.resume(returning: result)
+                    } catch is CancellationError {
+                        diagnostics.append(
+                            level: .debug,
+                            category: "remote-browser",
+                            message: "libssh2 list cancelled host=\(remote.host) path=\(normalizedPath)"
+                        )
+                        continuation.resume(throwing: CancellationError())
+                    } catch {
+                        diagnostics.append(
+                            level: .warning,
+                            category: "remote-browser",
+                            message: "libssh2 list failed host=\(remote.host) path=\(normalizedPath): \(error.localizedDescription)"
+                        )
+                        continuation.resume(throwing: error)
+                    }
+                }
+            }
+        } onCancel: {
+            cancellation.cancel()
+        }
+    }
+
+    /// Beginner note: Batch listing drives several SFTP channels on the same session at once,
+    /// so N directories cost roughly one realpath/opendir/readdir round-trip chain.
+    /// This is async and throwing: callers must await it and handle failures.
+    func listDirectories(remote: RemoteConfig, paths: [String], password: String?) async throws -> [BrowserTransportPathListOutcome] {
+        let normalizedPaths = paths.map { BrowserPathNormalizer.normalize(path: $0) }
+        guard !normalizedPaths.isEmpty else {
+            return []
+        }
+
+        diagnostics.append(
+            level: .info,
+            category: "remote-browser",
+            message: "libssh2 batch list start host=\(remote.host) port=\(remote.port) user=\(remote.username) paths=\(normalizedPaths.count)"
         )
 
+        let priority = BrowserOperationPriority.current
         return try await withCheckedThrowingContinuation { continuation in
-            bridgeQueue.async { [self] in
+            scheduler.enqueue(remoteID: remote.id, priority: priority) { [self] in
                 do {
-                    let result = try listDirectoriesSync(remote: remote, path: normalizedPath, password: password)
-                    let directoryCount = result.entries.reduce(into: 0) { partial, item in
-                        if item.isDirectory {
+                    let outcomes = try listManySync(remote: remote, paths: normalizedPaths, password: password)
+                    let failed = outcomes.reduce(into: 0) { partial, outcome in
+                        if outcome.result == nil {
                             partial += 1
                         }
                     }
                     diagnostics.append(
-                        level: .info,
+                        level: failed == 0 ? .info : .warning,
                         category: "remote-browser",
-                        message: "libssh2 list success path=\(result.resolvedPath) entries=\(result.entries.count) dirs=\(directoryCount) latencyMs=\(result.latencyMs) reopenedSession=\(result.reopenedSession)"
+                        message: "libssh2 batch list done paths=\(outcomes.count) failed=\(failed)"
                     )
-                    continuation.resume(returning: result)
+                    continuation.resume(returning: outcomes)
                 } catch {
                     diagnostics.append(
                         level: .warning,
                         category: "remote-browser",
-                        message: "libssh2 list failed host=\(remote.host) path=\(normalizedPath): \(error.localizedDescription)"
+                        message: "libssh2 batch list failed host=\(remote.host) paths=\(normalizedPaths.count): \(error.localizedDescription)"
                     )
                     continuation.resume(throwing: error)
                 }
@@ -131,12 +479,19 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async and throwing: callers must await it and handle failures.
     func ping(remote: RemoteConfig, path: String, password: String?) async throws {
+        _ = try await keepAlive(remote: remote, path: path, password: password, mode: .sftpStat)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This is async and throwing: callers must await it and handle failures.
+    func keepAlive(remote: RemoteConfig, path: String, password: String?, mode: BrowserKeepAliveMode) async throws -> BrowserKeepAliveResult {
         let normalizedPath = BrowserPathNormalizer.normalize(path: path)
-        try await withCheckedThrowingContinuation { continuation in
-            bridgeQueue.async { [self] in
+        let priority = BrowserOperationPriority.current
+        return try await withCheckedThrowingContinuation { continuation in
+            scheduler.enqueue(remoteID: remote.id, priority: priority) { [self] in
                 do {
-                    try pingSync(remote: remote, path: normalizedPath, password: password)
-                    continuation.resume()
+                    let result = try keepAliveSync(remote: remote, path: normalizedPath, password: password, mode: mode)
+                    continuation.resume(returning: result)
                 } catch {
                     continuation.resume(throwing: error)
                 }
@@ -148,20 +503,63 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
     /// This is async: it can suspend and resume later without blocking a thread.
     func invalidate(remoteID: UUID) async {
         await withCheckedContinuation { continuation in
-            bridgeQueue.async { [self] in
+            // Closing is what the user asked for; it must not wait behind background work.
+            scheduler.enqueue(remoteID: remoteID, priority: .interactive) { [self] in
                 closeSessionSync(for: remoteID)
+                // A reconnect may take a different path (VPN up or down), so start from the defaults.
+                sessionsLock.lock()
+                rttEstimators[remoteID] = nil
+                sessionsLock.unlock()
                 continuation.resume()
             }
         }
     }
 
+    /// Beginner note: Drops cached host answers so the next session open asks DNS again.
+    /// Called when the network path changes, since addresses from the old network may be wrong.
+    static func flushResolverCache() {
+        macfusegui_libssh2_resolver_flush(macfusegui_libssh2_resolver_shared())
+    }
+
+    /// Beginner note: Resolver cache counters, so slow-reconnect reports can rule DNS in or out,
+    /// plus per-class scheduler queue depth and wait times.
+    func diagnosticsSummaryLine() -> String? {
+        var stats = macfusegui_libssh2_resolver_stats()
+        macfusegui_libssh2_resolver_get_stats(macfusegui_libssh2_resolver_shared(), &stats)
+        let resolverLine = "- resolver-cache hits=\(stats.hits) misses=\(stats.misses) negativeHits=\(stats.negative_hits) staleHits=\(stats.stale_hits) coalesced=\(stats.coalesced) entries=\(stats.entry_count) ttlMs=\(stats.positive_ttl_ms) negativeTtlMs=\(stats.negative_ttl_ms)"
+        var reaper = macfusegui_libssh2_reaper_stats()
+        macfusegui_libssh2_reaper_get_stats(&reaper)
+        let reaperLine = "- session-reaper enqueued=\(reaper.enqueued) reaped=\(reaper.reaped) inline=\(reaper.inline_closes) depth=\(reaper.queue_depth) maxDepth=\(reaper.max_queue_depth) capacity=\(reaper.capacity) avgCloseMs=\(reaper.reaped == 0 ? 0 : reaper.total_close_ms / reaper.reaped) maxCloseMs=\(reaper.max_close_ms)"
+        return resolverLine + "\n" + reaperLine + "\n" + scheduler.summaryLine()
+    }
+
+    /// Beginner note: Smoothed RTT and the list/ping budgets derived from it, for the session summary.
+    func adaptiveTimeoutSummary(remoteID: UUID) -> String? {
+        rttEstimator(for: remoteID).summary(policy: timeoutPolicy)
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This can throw an error: callers should use do/try/catch or propagate the error.
-    private func listDirectoriesSync(remote: RemoteConfig, path: String, password: String?) throws -> BrowserTransportListResult {
-        let timeout = Int32(max(1, Int(listTimeoutSeconds.rounded())))
+    private func listDirectoriesSync(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        cancellation: BrowserListCancellation,
+        onBatch: BrowserTransportBatchHandler?,
+        validator: BrowserDirectoryValidator?
+    ) throws -> BrowserTransportListResult {
+        // Superseded while queued behind another call for this remote: skip the network entirely.
+        if cancellation.isCancelled {
+            throw CancellationError()
+        }
+        let timeout = openTimeoutSecondsValue
+        let estimator = rttEstimator(for: remote.id)
+        let budgetMs = estimator.listBudgetMs(policy: timeoutPolicy)
+        let progressTimeoutMs = estimator.listProgressTimeoutMs(policy: timeoutPolicy)
         let credentials = try resolveCredentials(for: remote, password: password)
 
         do {
+            let openedSession = session(for: remote.id) == nil
             let handle = try ensureSessionSync(
                 remote: remote,
                 password: credentials.password,
@@ -172,10 +570,19 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
                 handle: handle,
                 remoteID: remote.id,
                 path: path,
-                timeout: timeout,
-                reopenedSession: false
+                budgetMs: budgetMs,
+                progressTimeoutMs: progressTimeoutMs,
+                reopenedSession: false,
+                includeOpenTiming: openedSession,
+                cancellation: cancellation,
+                onBatch: onBatch,
+                validator: validator
             )
         } catch {
+            // A cancelled call leaves the session open (or already dropped it); never reconnect for it.
+            if error is CancellationError || cancellation.isCancelled {
+                throw CancellationError()
+            }
             closeSessionSync(for: remote.id)
             let handle = try ensureSessionSync(
                 remote: remote,
@@ -187,16 +594,60 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
                 handle: handle,
                 remoteID: remote.id,
                 path: path,
-                timeout: timeout,
-                reopenedSession: true
+                budgetMs: budgetMs,
+                progressTimeoutMs: progressTimeoutMs,
+                reopenedSession: true,
+                includeOpenTiming: true,
+                cancellation: cancellation,
+                onBatch: onBatch,
+                validator: validator
+            )
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This can throw an error: callers should use do/try/catch or propagate the error.
+    private func listManySync(
+        remote: RemoteConfig,
+        paths: [String],
+        password: String?
+    ) throws -> [BrowserTransportPathListOutcome] {
+        let timeout = openTimeoutSecondsValue
+        let estimator = rttEstimator(for: remote.id)
+        let budgetMs = estimator.listBudgetMs(policy: timeoutPolicy)
+        let progressTimeoutMs = estimator.listProgressTimeoutMs(policy: timeoutPolicy)
+        let credentials = try resolveCredentials(for: remote, password: password)
+
+        do {
+            let handle = try ensureSessionSync(
+                remote: remote,
+                password: credentials.password,
+                privateKeyPath: credentials.privateKeyPath,
+                timeout: timeout
             )
+            return try listManyWithSessionSync(handle: handle, remoteID: remote.id, paths: paths, budgetMs: budgetMs, progressTimeoutMs: progressTimeoutMs, reopenedSession: false)
+        } catch {
+            closeSessionSync(for: remote.id)
+            let handle = try ensureSessionSync(
+                remote: remote,
+                password: credentials.password,
+                privateKeyPath: credentials.privateKeyPath,
+                timeout: timeout
+            )
+            return try listManyWithSessionSync(handle: handle, remoteID: remote.id, paths: paths, budgetMs: budgetMs, progressTimeoutMs: progressTimeoutMs, reopenedSession: true)
         }
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This can throw an error: callers should use do/try/catch or propagate the error.
-    private func pingSync(remote: RemoteConfig, path: String, password: String?) throws {
-        let timeout = Int32(max(1, Int(pingTimeoutSeconds.rounded())))
+    private func keepAliveSync(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        mode: BrowserKeepAliveMode
+    ) throws -> BrowserKeepAliveResult {
+        let timeout = openTimeoutSecondsValue
+        let budgetMs = rttEstimator(for: remote.id).pingTimeoutMs(policy: timeoutPolicy)
         let credentials = try resolveCredentials(for: remote, password: password)
 
         do {
@@ -206,7 +657,7 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
                 privateKeyPath: credentials.privateKeyPath,
                 timeout: timeout
             )
-            try pingWithSessionSync(handle: handle, path: path, timeout: timeout)
+            return try keepAliveWithSessionSync(handle: handle, remoteID: remote.id, path: path, budgetMs: budgetMs, mode: mode)
         } catch {
             closeSessionSync(for: remote.id)
             let handle = try ensureSessionSync(
@@ -216,7 +667,7 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
                 timeout: timeout
             )
             do {
-                try pingWithSessionSync(handle: handle, path: path, timeout: timeout)
+                return try keepAliveWithSessionSync(handle: handle, remoteID: remote.id, path: path, budgetMs: budgetMs, mode: mode)
             } catch {
                 closeSessionSync(for: remote.id)
                 throw error
@@ -224,16 +675,21 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
         }
     }
 
-    private func pingWithSessionSync(
+    private func keepAliveWithSessionSync(
         handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>,
+        remoteID: UUID,
         path: String,
-        timeout: Int32
-    ) throws {
-        assertOnBridgeQueue()
+        budgetMs: Int32,
+        mode: BrowserKeepAliveMode
+    ) throws -> BrowserKeepAliveResult {
+        assertOnExecutor(for: remoteID)
         var errorPtr: UnsafeMutablePointer<CChar>?
+        var outcome = macfusegui_libssh2_keepalive_outcome()
+        handle.pointee.timeout_ms = budgetMs
         let status = path.withCString { pathPtr in
-            macfusegui_libssh2_ping_session(handle, pathPtr, timeout, &errorPtr)
+            macfusegui_libssh2_keepalive_session(handle, pathPtr, Self.wholeSeconds(budgetMs), mode.cValue, &outcome, &errorPtr)
         }
+        handle.pointee.timeout_ms = 0
         defer {
             if let errorPtr {
                 macfusegui_libssh2_free_error(errorPtr)
@@ -241,10 +697,21 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
         }
 
         if status != 0 {
-            let timeoutSeconds = Int(timeout)
-            let message = errorPtr.map { String(cString: $0) } ?? L10n.format("libssh2 keepalive failed with status %lld after %llds.", Int64(status), Int64(timeoutSeconds))
+            updateRTTEstimator(for: remoteID) { $0.backOff(policy: timeoutPolicy) }
+            let message = errorPtr.map { String(cString: $0) } ?? L10n.format("libssh2 keepalive failed with status %lld after %llds.", Int64(status), Int64(Self.wholeSeconds(budgetMs)))
             throw AppError.remoteBrowserError(message)
         }
+        // An answered realpath probe or a plain stat is one round trip; a refused probe followed
+        // by a stat is two, so it says nothing about the RTT.
+        if outcome.reply_seen != 0 || mode == .sftpStat {
+            updateRTTEstimator(for: remoteID) { $0.record(sampleMicros: max(1, outcome.latency_ms) * 1_000) }
+        }
+        return BrowserKeepAliveResult(
+            modeUsed: mode,
+            sftpProbed: outcome.sftp_probed != 0,
+            replySeen: outcome.reply_seen != 0,
+            latencyMs: Int(outcome.latency_ms)
+        )
     }
 
     private func resolveCredentials(
@@ -273,24 +740,26 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
         privateKeyPath: String?,
         timeout: Int32
     ) throws -> UnsafeMutablePointer<macfusegui_libssh2_session_handle> {
-        assertOnBridgeQueue()
-        if let existing = sessions[remote.id] {
+        assertOnExecutor(for: remote.id)
+        if let existing = session(for: remote.id) {
             return existing
         }
 
         var handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>?
         var errorPtr: UnsafeMutablePointer<CChar>?
+        var cSocketOptions = socketOptions.cValue
         let status = remote.host.withCString { hostPtr in
             remote.username.withCString { usernamePtr in
                 withOptionalCString(password) { passwordPtr in
                     withOptionalCString(privateKeyPath) { keyPtr in
-                        macfusegui_libssh2_open_session(
+                        macfusegui_libssh2_open_session_with_options(
                             hostPtr,
                             Int32(remote.port),
                             usernamePtr,
                             passwordPtr,
                             keyPtr,
                             timeout,
+                            &cSocketOptions,
                             &handle,
                             &errorPtr
                         )
@@ -310,11 +779,12 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
             throw AppError.remoteBrowserError(message)
         }
 
-        sessions[remote.id] = resolved
+        setSession(resolved, for: remote.id)
+        let connectReport = resolved.pointee.connect_report
         diagnostics.append(
             level: .debug,
             category: "remote-browser",
-            message: "Opened persistent libssh2 session for \(remote.displayName) (\(remote.id.uuidString))"
+            message: "Opened persistent libssh2 session for \(remote.displayName) (\(remote.id.uuidString)) family=\(Self.addressFamilyLabel(connectReport.family)) connectAttempts=\(connectReport.attempts_started) connectMs=\(connectReport.elapsed_ms) tcpOptions=\(Self.socketOptionsLabel(connectReport.socket_options_applied))"
         )
         return resolved
     }
@@ -324,32 +794,60 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
         handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>,
         remoteID: UUID,
         path: String,
-        timeout: Int32,
-        reopenedSession: Bool
+        budgetMs: Int32,
+        progressTimeoutMs: Int32,
+        reopenedSession: Bool,
+        includeOpenTiming: Bool,
+        cancellation: BrowserListCancellation,
+        onBatch: BrowserTransportBatchHandler?,
+        validator: BrowserDirectoryValidator?
     ) throws -> BrowserTransportListResult {
-        assertOnBridgeQueue()
-        var cResult = macfusegui_libssh2_list_result()
+        assertOnExecutor(for: remoteID)
+        var cResult = macfusegui_libssh2_flat_list_result()
+        let batchSink = onBatch.map { BatchSink(requestedPath: path, generation: reopenedSession ? 1 : 0, handler: $0) }
+        handle.pointee.cancel_token = cancellation.token
+        handle.pointee.timeout_ms = budgetMs
+        handle.pointee.progress_timeout_ms = progressTimeoutMs
         let status = path.withCString { pathPtr in
-            macfusegui_libssh2_list_directories_with_session(
-                handle,
-                pathPtr,
-                timeout,
-                &cResult
-            )
+            withExtendedLifetime(batchSink) {
+                withOptionalValidator(validator) { validatorPtr in
+                    macfusegui_libssh2_list_directories_if_modified_with_session(
+                        handle,
+                        pathPtr,
+                        Self.wholeSeconds(budgetMs),
+                        validatorPtr,
+                        streamBatchEntryCount,
+                        streamBatchIntervalMs,
+                        batchSink == nil ? nil : Self.batchCallback,
+                        batchSink.map { Unmanaged.passUnretained($0).toOpaque() },
+                        &cResult
+                    )
+                }
+            }
         }
 
+        // Cleared before any path below can close (and free) the handle.
+        handle.pointee.cancel_token = nil
+        handle.pointee.timeout_ms = 0
+        handle.pointee.progress_timeout_ms = 0
+
         defer {
-            macfusegui_libssh2_free_list_result(&cResult)
+            macfusegui_libssh2_free_flat_list_result(&cResult)
+        }
+
+        if status == MACFUSEGUI_LIBSSH2_STATUS_CANCELLED {
+            // The bridge finished the in-flight request before returning, so the session stays open.
+            throw CancellationError()
         }
 
         guard status == 0 else {
             closeSessionSync(for: remoteID)
+            updateRTTEstimator(for: remoteID) { $0.backOff(policy: timeoutPolicy) }
             let message: String
             if let errorPtr = cResult.error_message {
                 message = String(cString: errorPtr)
             } else {
-                let timeoutSeconds = Int(timeout)
-                message = L10n.format("libssh2 browse failed with status %lld on path %@ after %llds.", Int64(status), path, Int64(timeoutSeconds))
+                message = L10n.format("libssh2 browse failed with status %lld on path %@ after %llds.", Int64(status), path, Int64(Self.wholeSeconds(budgetMs)))
             }
             throw AppError.remoteBrowserError(message)
         }
@@ -361,46 +859,223 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
             resolvedPath = path
         }
 
-        let entries = convertEntries(from: cResult, resolvedPath: resolvedPath)
+        let entries = Self.convertEntries(from: cResult, resolvedPath: resolvedPath)
+        var stageTiming = BrowserStageTiming(cResult.timing)
+        if let sample = BrowserRTTEstimator.sampleMicros(from: stageTiming) {
+            updateRTTEstimator(for: remoteID) { $0.record(sampleMicros: sample) }
+        }
+        if includeOpenTiming {
+            stageTiming.adoptOpenStages(from: BrowserStageTiming(handle.pointee.open_timing))
+        }
 
         return BrowserTransportListResult(
             resolvedPath: resolvedPath,
             entries: entries,
             latencyMs: clampedLatencyMs(cResult.latency_ms),
-            reopenedSession: reopenedSession
+            reopenedSession: reopenedSession,
+            firstEntryLatencyMs: cResult.first_entry_latency_ms >= 0 ? clampedLatencyMs(cResult.first_entry_latency_ms) : nil,
+            stageTiming: stageTiming,
+            directoryValidator: cResult.has_validator != 0 ? BrowserDirectoryValidator(cResult.validator) : nil,
+            notModified: cResult.not_modified != 0
+        )
+    }
+
+    /// Beginner note: A batch timeout still returns the paths that finished; only an invalid batch throws.
+    private func listManyWithSessionSync(
+        handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>,
+        remoteID: UUID,
+        paths: [String],
+        budgetMs: Int32,
+        progressTimeoutMs: Int32,
+        reopenedSession: Bool
+    ) throws -> [BrowserTransportPathListOutcome] {
+        assertOnExecutor(for: remoteID)
+        let cPaths: [UnsafeMutablePointer<CChar>?] = paths.map { strdup($0) }
+        defer {
+            cPaths.forEach { free($0) }
+        }
+
+        let timeout = Self.wholeSeconds(budgetMs)
+        var cResult = macfusegui_libssh2_list_many_result()
+        handle.pointee.timeout_ms = budgetMs
+        handle.pointee.progress_timeout_ms = progressTimeoutMs
+        let status = cPaths.map { UnsafePointer($0) }.withUnsafeBufferPointer { buffer in
+            macfusegui_libssh2_list_many(handle, buffer.baseAddress, Int32(paths.count), timeout, &cResult)
+        }
+        handle.pointee.timeout_ms = 0
+        handle.pointee.progress_timeout_ms = 0
+
+        defer {
+            macfusegui_libssh2_free_list_many_result(&cResult)
+        }
+
+        guard let cResults = cResult.results, Int(cResult.path_count) == paths.count else {
+            closeSessionSync(for: remoteID)
+            updateRTTEstimator(for: remoteID) { $0.backOff(policy: timeoutPolicy) }
+            let message: String
+            if let errorPtr = cResult.error_message {
+                message = String(cString: errorPtr)
+            } else {
+                message = L10n.format("libssh2 batch browse failed with status %lld after %llds.", Int64(status), Int64(timeout))
+            }
+            throw AppError.remoteBrowserError(message)
+        }
+
+        if status != 0 {
+            // Timed-out lanes leave the session in an unknown protocol state; a lost link (-42) is simply gone.
+            closeSessionSync(for: remoteID)
+            updateRTTEstimator(for: remoteID) { $0.backOff(policy: timeoutPolicy) }
+        }
+
+        var outcomes: [BrowserTransportPathListOutcome] = []
+        outcomes.reserveCapacity(paths.count)
+        for (index, path) in paths.enumerated() {
+            let pathResult = cResults[index]
+            guard pathResult.status_code == 0 else {
+                let message: String
+                if let errorPtr = pathResult.error_message {
+                    message = String(cString: errorPtr)
+                } else {
+                    message = L10n.format("libssh2 browse failed with status %lld on path %@ after %llds.", Int64(pathResult.status_code), path, Int64(timeout))
+                }
+                outcomes.append(BrowserTransportPathListOutcome(requestedPath: path, result: nil, errorMessage: message))
+                continue
+            }
+
+            let resolvedPath = pathResult.resolved_path.map {
+                BrowserPathNormalizer.normalize(path: String(cString: $0))
+            } ?? path
+            let result = BrowserTransportListResult(
+                resolvedPath: resolvedPath,
+                entries: Self.convertEntries(from: pathResult, resolvedPath: resolvedPath),
+                latencyMs: clampedLatencyMs(pathResult.latency_ms),
+                reopenedSession: reopenedSession,
+                firstEntryLatencyMs: pathResult.first_entry_latency_ms >= 0 ? clampedLatencyMs(pathResult.first_entry_latency_ms) : nil
+            )
+            outcomes.append(BrowserTransportPathListOutcome(requestedPath: path, result: result, errorMessage: nil))
+        }
+        return outcomes
+    }
+
+    /// Beginner note: Holds the Swift handler for one streaming call; the C side only sees an opaque pointer.
+    private final class BatchSink {
+        let requestedPath: String
+        // 0 for the first pass of a call, 1 for the pass after the session was reopened.
+        let generation: Int
+        let handler: BrowserTransportBatchHandler
+
+        init(requestedPath: String, generation: Int, handler: @escaping BrowserTransportBatchHandler) {
+            self.requestedPath = requestedPath
+            self.generation = generation
+            self.handler = handler
+        }
+    }
+
+    /// Beginner note: Runs on the remote's executor inside the native readdir loop, so keep it cheap.
+    private static let batchCallback: macfusegui_libssh2_list_batch_callback = { context, partial, firstNewIndex, newEntryCount in
+        guard let context, let partial else {
+            return
+        }
+        let sink = Unmanaged<BatchSink>.fromOpaque(context).takeUnretainedValue()
+        let resolvedPath = partial.pointee.resolved_path.map {
+            BrowserPathNormalizer.normalize(path: String(cString: $0))
+        } ?? sink.requestedPath
+        let range = Int(firstNewIndex)..<(Int(firstNewIndex) + Int(newEntryCount))
+        let entries = LibSSH2SFTPTransport.convertEntries(from: partial.pointee, resolvedPath: resolvedPath, range: range)
+        sink.handler(
+            BrowserTransportListBatch(
+                resolvedPath: resolvedPath,
+                startIndex: Int(firstNewIndex),
+                entries: entries,
+                generation: sink.generation
+            )
         )
     }
 
+    /// Beginner note: Diagnostics label for the address family that won the connect race.
+    static func addressFamilyLabel(_ family: Int32) -> String {
+        switch family {
+        case 6:
+            return "IPv6"
+        case 4:
+            return "IPv4"
+        default:
+            return "unknown"
+        }
+    }
+
+    /// Beginner note: Names the TCP options the kernel accepted, for the session-open diagnostics line.
+    static func socketOptionsLabel(_ applied: Int32) -> String {
+        let names: [(Int32, String)] = [
+            (MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_IDLE, "keepidle"),
+            (MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_INTERVAL, "keepintvl"),
+            (MACFUSEGUI_LIBSSH2_SOCKOPT_KEEPALIVE_COUNT, "keepcnt"),
+            (MACFUSEGUI_LIBSSH2_SOCKOPT_USER_TIMEOUT, "usertimeout"),
+            (MACFUSEGUI_LIBSSH2_SOCKOPT_NODELAY, "nodelay")
+        ]
+        let labels = names.compactMap { bit, name in applied & bit != 0 ? name : nil }
+        return labels.isEmpty ? "-" : labels.joined(separator: ",")
+    }
+
+    private var openTimeoutSecondsValue: Int32 {
+        Int32(max(1, Int(openTimeoutSeconds.rounded())))
+    }
+
+    /// Beginner note: Whole-second form of a millisecond budget, rounded up, for the bridge's
+    /// seconds parameter and fallback error text; the bridge itself honors timeout_ms.
+    static func wholeSeconds(_ milliseconds: Int32) -> Int32 {
+        max(1, (milliseconds + 999) / 1_000)
+    }
+
     private func clampedLatencyMs(_ value: Int32) -> Int {
         max(0, min(Int(value), 60_000))
     }
 
-    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// Beginner note: Forgets the remote's session and hands the handle to the native reaper.
+    /// A graceful SFTP shutdown and disconnect can take about 2 s on a dead link; doing that on
+    /// the remote's executor would delay the reconnect that usually follows a failed call.
     private func closeSessionSync(for remoteID: UUID) {
-        assertOnBridgeQueue()
-        guard let handle = sessions.removeValue(forKey: remoteID) else {
+        assertOnExecutor(for: remoteID)
+        sessionsLock.lock()
+        let removed = sessions.removeValue(forKey: remoteID)
+        sessionsLock.unlock()
+        guard let handle = removed else {
             return
         }
-        macfusegui_libssh2_close_session(handle)
+        macfusegui_libssh2_close_session_async(handle)
     }
 
-    /// Beginner note: This method is one step in the feature workflow for this file.
-    private func convertEntries(from cResult: macfusegui_libssh2_list_result, resolvedPath: String) -> [RemoteDirectoryItem] {
-        let count = Int(cResult.entry_count)
-        guard count > 0, let cEntries = cResult.entries else {
+    /// Beginner note: Names are decoded straight out of the flat result's shared name blob,
+    /// so there is no per-entry C string to walk or free.
+    static func convertEntries(from cResult: macfusegui_libssh2_flat_list_result, resolvedPath: String) -> [RemoteDirectoryItem] {
+        convertEntries(from: cResult, resolvedPath: resolvedPath, range: 0..<Int(max(0, cResult.entry_count)))
+    }
+
+    /// Beginner note: Converts only entries in range; streaming batches use this to decode new rows.
+    static func convertEntries(
+        from cResult: macfusegui_libssh2_flat_list_result,
+        resolvedPath: String,
+        range: Range<Int>
+    ) -> [RemoteDirectoryItem] {
+        let range = range.clamped(to: 0..<Int(max(0, cResult.entry_count)))
+        guard !range.isEmpty, let cEntries = cResult.entries, let nameBlob = cResult.name_blob else {
             return []
         }
+        let blobLength = Int(cResult.name_blob_length)
 
         var output: [RemoteDirectoryItem] = []
-        output.reserveCapacity(count)
+        output.reserveCapacity(range.count)
 
-        for index in 0..<count {
+        for index in range {
             let cEntry = cEntries[index]
-            guard let namePtr = cEntry.name else {
+            let nameOffset = Int(cEntry.name_offset)
+            let nameLength = Int(cEntry.name_length)
+            guard nameLength > 0, nameOffset + nameLength <= blobLength else {
                 continue
             }
 
-            let name = String(cString: namePtr).trimmingCharacters(in: .whitespacesAndNewlines)
+            let nameBytes = UnsafeRawBufferPointer(start: nameBlob + nameOffset, count: nameLength)
+            let name = String(decoding: nameBytes, as: UTF8.self).trimmingCharacters(in: .whitespacesAndNewlines)
             guard !name.isEmpty, name != ".", name != ".." else {
                 continue
             }
@@ -442,4 +1117,117 @@ final class LibSSH2SFTPTransport: BrowserTransport, @unchecked Sendable {
             body(ptr)
         }
     }
+
+    /// Beginner note: Same idea as withOptionalCString for the bridge's validator struct.
+    private func withOptionalValidator<R>(
+        _ validator: BrowserDirectoryValidator?,
+        _ body: (UnsafePointer<macfusegui_libssh2_directory_validator>?) -> R
+    ) -> R {
+        guard let validator else {
+            return body(nil)
+        }
+        var cValidator = validator.cValue
+        return withUnsafePointer(to: &cValidator) { ptr in
+            body(ptr)
+        }
+    }
+}
+
+extension BrowserStageTiming {
+    /// Beginner note: Copies the bridge's C timing struct into the Swift value type.
+    init(_ cTiming: macfusegui_libssh2_stage_timing) {
+        self.init(
+            resolveMicros: cTiming.resolve_us,
+            connectMicros: cTiming.connect_us,
+            handshakeMicros: cTiming.handshake_us,
+            authMicros: cTiming.auth_us,
+            sftpInitMicros: cTiming.sftp_init_us,
+            realpathMicros: cTiming.realpath_us,
+            opendirMicros: cTiming.opendir_us,
+            readdirMicros: cTiming.readdir_us,
+            statMicros: cTiming.stat_us,
+            handshakeRoundTrips: Int(cTiming.handshake_round_trips),
+            authRoundTrips: Int(cTiming.auth_round_trips),
+            sftpInitRoundTrips: Int(cTiming.sftp_init_round_trips),
+            realpathRoundTrips: Int(cTiming.realpath_round_trips),
+            opendirRoundTrips: Int(cTiming.opendir_round_trips),
+            readdirRoundTrips: Int(cTiming.readdir_round_trips),
+            statRoundTrips: Int(cTiming.stat_round_trips),
+            connectAttempts: Int(cTiming.connect_attempts),
+            resolveCached: cTiming.resolve_cached != 0,
+            realpathCached: cTiming.realpath_cached != 0
+        )
+    }
+}
+
+extension BrowserSocketOptions {
+    /// Beginner note: Copies the Swift options into the bridge's C struct.
+    var cValue: macfusegui_libssh2_socket_options {
+        macfusegui_libssh2_socket_options(
+            keepalive_idle_seconds: max(0, keepAliveIdleSeconds),
+            keepalive_interval_seconds: max(0, keepAliveIntervalSeconds),
+            keepalive_count: max(0, keepAliveCount),
+            user_timeout_ms: max(0, userTimeoutMs),
+            no_delay: noDelay ? 1 : 0
+        )
+    }
+}
+
+extension BrowserKeepAliveMode {
+    /// Beginner note: Bridge constant for this mode.
+    var cValue: Int32 {
+        switch self {
+        case .sshProtocol:
+            return MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SSH
+        case .sftpStat:
+            return MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SFTP_STAT
+        }
+    }
+}
+
+extension BrowserDirectoryValidator {
+    /// Beginner note: Copies the bridge's validator struct; has_size 0 means the server sent no size.
+    init(_ cValidator: macfusegui_libssh2_directory_validator) {
+        self.init(
+            modifiedAtUnix: cValidator.modified_at_unix,
+            sizeBytes: cValidator.has_size != 0 ? cValidator.size_bytes : nil,
+            capturedAtUnix: cValidator.captured_at_unix
+        )
+    }
+
+    var cValue: macfusegui_libssh2_directory_validator {
+        macfusegui_libssh2_directory_validator(
+            modified_at_unix: modifiedAtUnix,
+            size_bytes: sizeBytes ?? 0,
+            has_size: sizeBytes == nil ? 0 : 1,
+            captured_at_unix: capturedAtUnix
+        )
+    }
+}
+
+/// Beginner note: Owns one native cancel token for a single list call.
+/// cancel() may run on any thread (Swift's cancellation handler); the bridge polls the token
+/// alongside the socket, so a blocked wait returns as soon as it fires.
+// @unchecked Sendable is safe here because the native token is atomic and never reassigned.
+final class BrowserListCancellation: @unchecked Sendable {
+    let token: OpaquePointer?
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init() {
+        token = macfusegui_libssh2_cancel_token_create()
+    }
+
+    /// Beginner note: Deinitializer runs during teardown to stop background work and free resources.
+    deinit {
+        macfusegui_libssh2_cancel_token_destroy(token)
+    }
+
+    var isCancelled: Bool {
+        macfusegui_libssh2_cancel_token_is_cancelled(token) != 0
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func cancel() {
+        macfusegui_libssh2_cancel_token_cancel(token)
+    }
 }
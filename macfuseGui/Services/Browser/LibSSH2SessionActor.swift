@@ -8,6 +8,112 @@
 
 import Foundation
 
+typealias RemoteBrowserPartialSnapshotHandler = @Sendable (RemoteBrowserSnapshot) -> Void
+
+/// Beginner note: Partial-snapshot listeners of one shared listing. The caller that started it
+/// subscribes first; coalesced callers that join mid-stream see the next cumulative snapshot.
+private final class PartialListingSubscribers: @unchecked Sendable {
+    private let lock = NSLock()
+    private var handlers: [(requestID: UInt64, handler: RemoteBrowserPartialSnapshotHandler)] = []
+
+    var isEmpty: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return handlers.isEmpty
+    }
+
+    func subscribe(requestID: UInt64, handler: @escaping RemoteBrowserPartialSnapshotHandler) {
+        lock.lock()
+        handlers.append((requestID, handler))
+        lock.unlock()
+    }
+
+    func current() -> [(requestID: UInt64, handler: RemoteBrowserPartialSnapshotHandler)] {
+        lock.lock()
+        defer { lock.unlock() }
+        return handlers
+    }
+}
+
+/// Beginner note: One transport listing shared by every concurrent list(...) call for the same path.
+/// Mutated only on the owning actor; @unchecked Sendable lets the cancellation handler hand it back there.
+private final class SharedListing: @unchecked Sendable {
+    let id: UUID
+    let path: String
+    let partials: PartialListingSubscribers
+    let task: Task<RemoteBrowserSnapshot, Never>
+    // Callers still waiting; the transport call is cancelled only when all of them have given up.
+    var activeWaiters = 0
+
+    init(id: UUID, path: String, partials: PartialListingSubscribers, task: Task<RemoteBrowserSnapshot, Never>) {
+        self.id = id
+        self.path = path
+        self.partials = partials
+        self.task = task
+    }
+}
+
+/// Beginner note: Collects streamed transport batches for one list attempt and re-emits them
+/// as cumulative partial snapshots. Batches arrive serially from the transport queue.
+/// Rows are appended in arrival order and deduplicated by name, so each batch costs only its own size.
+private final class PartialListingAccumulator: @unchecked Sendable {
+    private let lock = NSLock()
+    private let health: BrowserConnectionHealth
+    private let startedAt = Date()
+    private let subscribers: PartialListingSubscribers
+    private var entries: [RemoteDirectoryItem] = []
+    private var seenNames: Set<String> = []
+    private var generation = 0
+
+    init(health: BrowserConnectionHealth, subscribers: PartialListingSubscribers) {
+        self.health = health
+        self.subscribers = subscribers
+    }
+
+    func append(_ batch: BrowserTransportListBatch) {
+        lock.lock()
+        guard batch.generation >= generation else {
+            // Late rows from a pass that has already been restarted.
+            lock.unlock()
+            return
+        }
+        var changed = false
+        if batch.generation > generation || batch.startIndex == 0 {
+            // Transport restarted the listing (for example after reopening the session): drop the aborted pass.
+            generation = batch.generation
+            changed = !entries.isEmpty
+            entries.removeAll(keepingCapacity: true)
+            seenNames.removeAll(keepingCapacity: true)
+        }
+        for entry in batch.entries where seenNames.insert(entry.name).inserted {
+            entries.append(entry)
+            changed = true
+        }
+        let snapshotEntries = entries
+        lock.unlock()
+        guard changed else {
+            return
+        }
+
+        let partial = RemoteBrowserSnapshot(
+            path: batch.resolvedPath,
+            entries: snapshotEntries,
+            isStale: true,
+            isConfirmedEmpty: false,
+            health: health,
+            message: nil,
+            generatedAt: Date(),
+            fromCache: false,
+            requestID: 0,
+            latencyMs: Int(Date().timeIntervalSince(startedAt) * 1000),
+            isPartial: true
+        )
+        for subscriber in subscribers.current() {
+            subscriber.handler(partial.withRequestID(subscriber.requestID))
+        }
+    }
+}
+
 // Session actor lifecycle:
 // - Created when the browser sheet opens.
 // - Serves list/goUp/retry requests for that sheet.
@@ -38,16 +144,25 @@ actor LibSSH2SessionActor {
         var sourcePath: String?
     }
 
+    /// Beginner note: A background listing waiting for the user to open it.
+    private struct PrefetchedListing {
+        var resolvedPath: String
+        var listedAt: Date
+    }
+
     private let id: RemoteBrowserSessionID
     private let remote: RemoteConfig
     private let password: String?
     private let transport: BrowserTransport
     private let diagnostics: DiagnosticsService
+    // Optional on-disk copy of good listings, used to render last-known rows on the next open.
+    private let listingStore: BrowserListingDiskCache?
+    private let listingStoreKey: BrowserListingCacheKey
 
     // Health exposed to UI so users can see connecting/recovering/failed states.
     private var health: BrowserConnectionHealth = .connecting
-    // Sticky cache by normalized path.
-    private var cache: [String: [RemoteDirectoryItem]] = [:]
+    // Sticky cache by normalized path, bounded by a byte budget with LRU eviction.
+    private var cache: BrowserDirectoryCache
     // Last active path for retryCurrentPath and recovery loop.
     private var lastPath: String
     private var closed = false
@@ -61,6 +176,23 @@ actor LibSSH2SessionActor {
     private var emptyListingStrikeByPath: [String: Int] = [:]
     private var lastSuccessfulListAt: Date?
     private var lastSuccessfulListing: LastSuccessfulListing?
+    // Single-flight: at most one transport listing per normalized path; later callers join it.
+    private var sharedListings: [String: SharedListing] = [:]
+    private var sharedListingCount = 0
+    private var coalescedListCount = 0
+    // Stage breakdown from the most recent transport listing that reported one.
+    private var lastStageTiming: BrowserStageTiming?
+    // Speculative listings of likely-next folders; see prefetch(paths:).
+    private let prefetchPolicy: BrowserPrefetchPolicy
+    private var prefetchTask: Task<Void, Never>?
+    private var prefetchRound = 0
+    private var prefetchInFlightPath: String?
+    private var prefetchedListings: [String: PrefetchedListing] = [:]
+    private var prefetchOperationTimes: [Date] = []
+    private var prefetchStats = BrowserPrefetchStats()
+    // Keepalive mode for this server and how each mode has behaved; see keepAliveTick().
+    private var keepAliveTracker: BrowserKeepAliveTracker
+    private let keepAliveModeMemory: BrowserKeepAliveModeMemory?
 
     // Nanosecond delays between immediate request retries.
     private let requestRetrySchedule: [UInt64]
@@ -81,18 +213,28 @@ actor LibSSH2SessionActor {
         recoveryRetrySchedule: [UInt64] = [200_000_000, 800_000_000, 2_000_000_000, 5_000_000_000],
         keepAliveIntervalNanoseconds: UInt64 = 12_000_000_000,
         breakerThreshold: Int = 8,
-        breakerWindow: TimeInterval = 30
+        breakerWindow: TimeInterval = 30,
+        cacheByteBudget: Int = BrowserDirectoryCache.defaultByteBudget,
+        listingStore: BrowserListingDiskCache? = nil,
+        prefetchPolicy: BrowserPrefetchPolicy = BrowserPrefetchPolicy(),
+        keepAliveModeMemory: BrowserKeepAliveModeMemory? = nil
     ) {
         self.id = id
         self.remote = remote
         self.password = password
         self.transport = transport
         self.diagnostics = diagnostics
+        self.listingStore = listingStore
+        self.listingStoreKey = BrowserListingCacheKey(remote: remote)
+        self.prefetchPolicy = prefetchPolicy
+        self.keepAliveModeMemory = keepAliveModeMemory
+        self.keepAliveTracker = BrowserKeepAliveTracker(mode: keepAliveModeMemory?.mode(for: remote) ?? .sshProtocol)
         self.requestRetrySchedule = requestRetrySchedule
         self.recoveryRetrySchedule = recoveryRetrySchedule
         self.keepAliveIntervalNanoseconds = keepAliveIntervalNanoseconds
         self.breakerThreshold = breakerThreshold
         self.breakerWindow = breakerWindow
+        self.cache = BrowserDirectoryCache(byteBudget: cacheByteBudget)
         self.lastPath = BrowserPathNormalizer.normalize(path: remote.remoteDirectory)
         self.health = BrowserConnectionHealth(
             state: .connecting,
@@ -114,6 +256,7 @@ actor LibSSH2SessionActor {
     deinit {
         keepAliveTask?.cancel()
         recoveryTask?.cancel()
+        prefetchTask?.cancel()
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -127,6 +270,13 @@ actor LibSSH2SessionActor {
         recoveryTask?.cancel()
         recoveryTask = nil
         isRecoveryInFlight = false
+        prefetchTask?.cancel()
+        prefetchTask = nil
+        prefetchedListings.removeAll()
+        for shared in sharedListings.values {
+            shared.task.cancel()
+        }
+        sharedListings.removeAll()
         await transport.invalidate(remoteID: remote.id)
         health = BrowserConnectionHealth(
             state: .closed,
@@ -146,7 +296,13 @@ actor LibSSH2SessionActor {
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
-    func list(path: String, requestID: UInt64, forceRefresh: Bool = false) async -> RemoteBrowserSnapshot {
+    /// onPartial, when set, receives cumulative partial snapshots while a large listing streams in.
+    func list(
+        path: String,
+        requestID: UInt64,
+        forceRefresh: Bool = false,
+        onPartial: RemoteBrowserPartialSnapshotHandler? = nil
+    ) async -> RemoteBrowserSnapshot {
         let normalizedPath = BrowserPathNormalizer.normalize(path: path)
         lastPath = normalizedPath
         resetBreakerIfExpired()
@@ -176,6 +332,12 @@ actor LibSSH2SessionActor {
             )
         }
 
+        if !forceRefresh, let prefetched = await takePrefetchedListing(path: normalizedPath, requestID: requestID) {
+            return prefetched
+        }
+        // User navigation outranks speculative work; free the remote's executor right away.
+        cancelPrefetch()
+
         if isCircuitOpen(), !forceRefresh {
             // Circuit-open state means repeated failures in a short window.
             // We return cached content immediately and let recovery run in background.
@@ -201,8 +363,256 @@ actor LibSSH2SessionActor {
             return snapshot
         }
 
+        if let shared = sharedListings[normalizedPath], !shared.task.isCancelled {
+            // Same path already on the wire (refresh loop, health loop, retry, user click):
+            // wait for that call instead of queueing another round trip behind it.
+            coalescedListCount += 1
+            if let onPartial {
+                shared.partials.subscribe(requestID: requestID, handler: onPartial)
+            }
+            diagnostics.append(
+                level: .debug,
+                category: "remote-browser",
+                message: "list coalesced session=\(id.uuidString) requestID=\(requestID) pathIn=\(normalizedPath) coalescedTotal=\(coalescedListCount)"
+            )
+            return await awaitSharedListing(shared).withRequestID(requestID)
+        }
+
+        let partials = PartialListingSubscribers()
+        if let onPartial {
+            partials.subscribe(requestID: requestID, handler: onPartial)
+        }
+        let listingID = UUID()
+        // Inherits this actor; it cannot start before this method suspends, so the map entry exists first.
+        let task = Task {
+            let snapshot = await self.performList(path: normalizedPath, requestID: requestID, partials: partials)
+            self.finishSharedListing(path: normalizedPath, listingID: listingID)
+            return snapshot
+        }
+        let shared = SharedListing(id: listingID, path: normalizedPath, partials: partials, task: task)
+        sharedListings[normalizedPath] = shared
+        sharedListingCount += 1
+        return await awaitSharedListing(shared).withRequestID(requestID)
+    }
+
+    /// Beginner note: Waits for a shared listing. Cancelling one waiter does not cancel the
+    /// transport call for the others; the last waiter to cancel does.
+    private func awaitSharedListing(_ shared: SharedListing) async -> RemoteBrowserSnapshot {
+        shared.activeWaiters += 1
+        return await withTaskCancellationHandler {
+            await shared.task.value
+        } onCancel: {
+            Task { await self.leaveSharedListing(shared) }
+        }
+    }
+
+    /// Beginner note: The last waiter to leave cancels the call. The map entry goes first, so a
+    /// list(...) for the same path arriving while the cancelled call drains starts a fresh one
+    /// instead of joining a call that can only return the cancelled (stale) snapshot.
+    private func leaveSharedListing(_ shared: SharedListing) {
+        shared.activeWaiters -= 1
+        if shared.activeWaiters <= 0 {
+            finishSharedListing(path: shared.path, listingID: shared.id)
+            shared.task.cancel()
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func finishSharedListing(path: String, listingID: UUID) {
+        if sharedListings[path]?.id == listingID {
+            sharedListings[path] = nil
+        }
+    }
+
+    /// Beginner note: Lists likely-next folders in the background so opening one needs no round trip.
+    /// A new call replaces the previous round. Listings run one at a time, only while no user listing
+    /// is active, within the policy's per-round and per-window budgets; any list(...) cancels the
+    /// round. Failures are logged only: prefetch never changes health, lastPath, or breaker state.
+    func prefetch(paths: [String]) {
+        cancelPrefetch()
+        guard !closed, prefetchPolicy.pathLimit > 0 else {
+            return
+        }
+
+        let now = Date()
+        for (path, listing) in prefetchedListings where now.timeIntervalSince(listing.listedAt) > prefetchPolicy.freshness {
+            prefetchedListings[path] = nil
+            prefetchStats.expired += 1
+        }
+        var queue: [String] = []
+        for path in paths {
+            let normalized = BrowserPathNormalizer.normalize(path: path)
+            guard normalized != lastPath, prefetchedListings[normalized] == nil, !queue.contains(normalized) else {
+                continue
+            }
+            queue.append(normalized)
+            if queue.count == prefetchPolicy.pathLimit {
+                break
+            }
+        }
+        guard !queue.isEmpty else {
+            return
+        }
+
+        prefetchRound += 1
+        let round = prefetchRound
+        prefetchTask = Task(priority: .utility) {
+            // Queued prefetches yield to clicks, recovery and pings on the remote's executor.
+            await BrowserOperationPriority.$current.withValue(.background) {
+                await self.runPrefetch(queue, round: round)
+            }
+        }
+    }
+
+    /// Beginner note: Counters behind the prefetch hit rate, for diagnostics and tests.
+    func prefetchStatistics() -> BrowserPrefetchStats {
+        prefetchStats
+    }
+
+    /// Beginner note: One prefetch round; stops at the first sign of user activity, budget, or error.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    private func runPrefetch(_ paths: [String], round: Int) async {
+        defer {
+            if prefetchRound == round {
+                prefetchTask = nil
+                prefetchInFlightPath = nil
+            }
+        }
+        if prefetchPolicy.idleDelayNanoseconds > 0 {
+            try? await Task.sleep(nanoseconds: prefetchPolicy.idleDelayNanoseconds)
+        }
+
+        var listedEntries = 0
+        for path in paths {
+            guard !Task.isCancelled, !closed, activeListRequests == 0, !isRecoveryInFlight, !isCircuitOpen() else {
+                return
+            }
+            guard listedEntries < prefetchPolicy.entryBudget, takePrefetchOperation() else {
+                prefetchStats.budgetExhausted += 1
+                return
+            }
+
+            prefetchStats.scheduled += 1
+            var validator = cache.validator(for: path)
+            let cachedEntries = validator == nil ? [] : cache[path] ?? []
+            if cachedEntries.isEmpty {
+                validator = nil
+            }
+            prefetchInFlightPath = path
+            do {
+                var result = try await transport.listDirectories(
+                    remote: remote,
+                    path: path,
+                    password: password,
+                    onBatch: nil,
+                    ifModified: validator
+                )
+                prefetchInFlightPath = nil
+                if result.notModified {
+                    result.entries = cachedEntries
+                }
+                let resolvedPath = BrowserPathNormalizer.normalize(path: result.resolvedPath)
+                // Same transient-empty rule as list(...): an unconfirmed empty folder is not worth serving.
+                guard !result.entries.isEmpty, !closed else {
+                    continue
+                }
+                cache.store(result.entries, validator: result.directoryValidator, for: resolvedPath)
+                listingStore?.store(
+                    key: listingStoreKey,
+                    path: resolvedPath,
+                    requestedPath: path,
+                    entries: result.entries,
+                    validator: result.directoryValidator
+                )
+                prefetchedListings[path] = PrefetchedListing(resolvedPath: resolvedPath, listedAt: Date())
+                prefetchStats.completed += 1
+                listedEntries += result.entries.count
+                diagnostics.append(
+                    level: .debug,
+                    category: "remote-browser",
+                    message: "prefetch listed session=\(id.uuidString) path=\(path) entries=\(result.entries.count) notModified=\(result.notModified) latencyMs=\(result.latencyMs)"
+                )
+            } catch {
+                prefetchInFlightPath = nil
+                if error is CancellationError || Task.isCancelled {
+                    prefetchStats.cancelled += 1
+                } else {
+                    prefetchStats.failed += 1
+                    diagnostics.append(
+                        level: .debug,
+                        category: "remote-browser",
+                        message: "prefetch failed session=\(id.uuidString) path=\(path) error=\(error.localizedDescription)"
+                    )
+                }
+                return
+            }
+        }
+    }
+
+    /// Beginner note: Sliding-window operation budget shared by all prefetch rounds.
+    private func takePrefetchOperation() -> Bool {
+        let now = Date()
+        prefetchOperationTimes.removeAll { now.timeIntervalSince($0) > prefetchPolicy.budgetWindow }
+        guard prefetchOperationTimes.count < prefetchPolicy.operationBudget else {
+            return false
+        }
+        prefetchOperationTimes.append(now)
+        return true
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func cancelPrefetch() {
+        prefetchTask?.cancel()
+        prefetchTask = nil
+        prefetchInFlightPath = nil
+    }
+
+    /// Beginner note: Serves a fresh prefetched listing as a normal successful listing.
+    /// When the requested folder is the one being prefetched right now, waits for that call
+    /// instead of cancelling it and paying for the same listing twice.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    private func takePrefetchedListing(path: String, requestID: UInt64) async -> RemoteBrowserSnapshot? {
+        if prefetchInFlightPath == path, let prefetchTask {
+            // activeListRequests > 0 now, so the round stops after this listing.
+            await prefetchTask.value
+        }
+        guard let prefetched = prefetchedListings.removeValue(forKey: path) else {
+            return nil
+        }
+        guard Date().timeIntervalSince(prefetched.listedAt) <= prefetchPolicy.freshness,
+              let entries = cache[prefetched.resolvedPath], !entries.isEmpty else {
+            prefetchStats.expired += 1
+            return nil
+        }
+
+        prefetchStats.hits += 1
+        emptyListingStrikeByPath[prefetched.resolvedPath] = 0
+        let snapshot = recordSuccessfulListing(
+            path: prefetched.resolvedPath,
+            entries: entries,
+            requestID: requestID,
+            latencyMs: 0,
+            isConfirmedEmpty: false,
+            validator: cache.validator(for: prefetched.resolvedPath)
+        )
+        diagnostics.append(
+            level: .debug,
+            category: "remote-browser",
+            message: "prefetch hit session=\(id.uuidString) requestID=\(requestID) path=\(path) ageMs=\(Int(Date().timeIntervalSince(prefetched.listedAt) * 1000)) hitRate=\(prefetchStats.summary)"
+        )
+        return snapshot
+    }
+
+    /// Beginner note: The retrying transport listing behind list(...); runs once per shared listing.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    private func performList(
+        path normalizedPath: String,
+        requestID: UInt64,
+        partials: PartialListingSubscribers
+    ) async -> RemoteBrowserSnapshot {
         let attempts = max(1, requestRetrySchedule.count + 1)
         var lastError: String?
+        let healthBeforeRequest = health
         for index in 0..<attempts {
             if index > 0 {
                 setHealth(state: .reconnecting, retryCount: index, lastError: lastError)
@@ -214,12 +624,37 @@ actor LibSSH2SessionActor {
                 }
             } else {
                 // First attempt state reflects whether we already have cached content.
-                let initialState: BrowserConnectionState = cache[normalizedPath] == nil ? .connecting : .reconnecting
+                let initialState: BrowserConnectionState = !cache.contains(normalizedPath) ? .connecting : .reconnecting
                 setHealth(state: initialState, retryCount: 0, lastError: nil)
             }
 
+            var onBatch: BrowserTransportBatchHandler?
+            if !partials.isEmpty {
+                let accumulator = PartialListingAccumulator(health: health, subscribers: partials)
+                onBatch = { batch in accumulator.append(batch) }
+            }
+            // Cached rows with a validator let the transport answer "unchanged" after a single stat.
+            var validator = cache.validator(for: normalizedPath)
+            let revalidatedEntries = validator == nil ? [] : cache[normalizedPath] ?? []
+            if revalidatedEntries.isEmpty {
+                validator = nil
+            }
             do {
-                let result = try await transport.listDirectories(remote: remote, path: normalizedPath, password: password)
+                var result = try await transport.listDirectories(
+                    remote: remote,
+                    path: normalizedPath,
+                    password: password,
+                    onBatch: onBatch,
+                    ifModified: validator
+                )
+                if result.notModified {
+                    result.entries = revalidatedEntries
+                    diagnostics.append(
+                        level: .debug,
+                        category: "remote-browser",
+                        message: "list not modified session=\(id.uuidString) requestID=\(requestID) path=\(normalizedPath) entries=\(revalidatedEntries.count) latencyMs=\(result.latencyMs)"
+                    )
+                }
                 let snapshot = await applyListResult(
                     result,
                     requestID: requestID,
@@ -230,10 +665,25 @@ actor LibSSH2SessionActor {
                     requestID: requestID,
                     pathIn: normalizedPath,
                     resolvedPath: result.resolvedPath,
-                    reopenedSession: result.reopenedSession
+                    reopenedSession: result.reopenedSession,
+                    firstEntryLatencyMs: result.firstEntryLatencyMs,
+                    stageTiming: result.stageTiming
                 )
+                if !snapshot.isStale, snapshot.path != normalizedPath {
+                    // Lets a later warm start for "~" (or a symlinked path) find the canonical listing.
+                    listingStore?.store(
+                        key: listingStoreKey,
+                        path: snapshot.path,
+                        requestedPath: normalizedPath,
+                        entries: snapshot.entries,
+                        validator: result.directoryValidator
+                    )
+                }
                 return snapshot
             } catch {
+                if error is CancellationError || Task.isCancelled {
+                    return cancelledListSnapshot(path: normalizedPath, requestID: requestID, restoring: healthBeforeRequest)
+                }
                 lastError = error.localizedDescription
                 diagnostics.append(
                     level: .warning,
@@ -250,6 +700,142 @@ actor LibSSH2SessionActor {
         return snapshot
     }
 
+    /// Beginner note: Last-known rows for a path without touching the network, for instant rendering
+    /// while the first real listing is still connecting. Disk hits also seed the in-memory cache so
+    /// failure fallbacks have them. Returns nil when nothing is known about the path.
+    func warmStartSnapshot(path: String, requestID: UInt64) -> RemoteBrowserSnapshot? {
+        let normalizedPath = BrowserPathNormalizer.normalize(path: path)
+        guard !closed else {
+            return nil
+        }
+
+        var sourcePath = normalizedPath
+        var entries = cache[normalizedPath]
+        var listedAt: Date?
+        if entries == nil, let stored = listingStore?.listing(key: listingStoreKey, path: normalizedPath) {
+            sourcePath = stored.path
+            entries = stored.entries
+            listedAt = stored.listedAt
+            if !cache.contains(stored.path) {
+                cache.store(stored.entries, validator: stored.validator, for: stored.path)
+            }
+        }
+        guard let entries, !entries.isEmpty else {
+            return nil
+        }
+
+        diagnostics.append(
+            level: .debug,
+            category: "remote-browser",
+            message: "warm start session=\(id.uuidString) requestID=\(requestID) pathIn=\(normalizedPath) source=\(listedAt == nil ? "memory" : "disk") path=\(sourcePath) entries=\(entries.count) ageSec=\(listedAt.map { String(Int(Date().timeIntervalSince($0))) } ?? "-")"
+        )
+        return makeSnapshot(
+            path: sourcePath,
+            entries: entries,
+            isStale: true,
+            isConfirmedEmpty: false,
+            fromCache: true,
+            requestID: requestID,
+            latencyMs: 0,
+            message: L10n.tr("Showing the last saved listing while connecting."),
+            stateOverride: nil
+        )
+    }
+
+    /// Beginner note: Lists several paths in one transport round-trip chain and fills the sticky cache.
+    /// Unlike list(...), this never moves lastPath, health, or breaker counters: it is a background
+    /// warm-up, so one missing favorite must not make the whole session look unhealthy.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func listMany(paths: [String], requestID: UInt64) async -> [RemoteBrowserSnapshot] {
+        var normalizedPaths: [String] = []
+        for path in paths {
+            let normalized = BrowserPathNormalizer.normalize(path: path)
+            if !normalizedPaths.contains(normalized) {
+                normalizedPaths.append(normalized)
+            }
+        }
+        guard !normalizedPaths.isEmpty, !closed else {
+            return []
+        }
+        resetBreakerIfExpired()
+        guard !isCircuitOpen() else {
+            return []
+        }
+
+        activeListRequests += 1
+        defer {
+            if activeListRequests > 0 {
+                activeListRequests -= 1
+            }
+        }
+
+        let outcomes: [BrowserTransportPathListOutcome]
+        do {
+            // Warm-up batches are background work; a click queued behind one runs first.
+            outcomes = try await BrowserOperationPriority.$current.withValue(.background) {
+                try await transport.listDirectories(remote: remote, paths: normalizedPaths, password: password)
+            }
+        } catch {
+            diagnostics.append(
+                level: .warning,
+                category: "remote-browser",
+                message: "batch list failed session=\(id.uuidString) requestID=\(requestID) paths=\(normalizedPaths.count) error=\(error.localizedDescription)"
+            )
+            return []
+        }
+
+        var snapshots: [RemoteBrowserSnapshot] = []
+        snapshots.reserveCapacity(outcomes.count)
+        for outcome in outcomes {
+            guard let result = outcome.result else {
+                let cached = cache[outcome.requestedPath] ?? []
+                snapshots.append(
+                    makeSnapshot(
+                        path: outcome.requestedPath,
+                        entries: cached,
+                        isStale: true,
+                        isConfirmedEmpty: false,
+                        fromCache: !cached.isEmpty,
+                        requestID: requestID,
+                        latencyMs: 0,
+                        message: outcome.errorMessage,
+                        stateOverride: nil
+                    )
+                )
+                continue
+            }
+
+            let resolvedPath = BrowserPathNormalizer.normalize(path: result.resolvedPath)
+            // Same transient-empty rule as list(...): never replace known rows with an unconfirmed empty result.
+            if !result.entries.isEmpty || (cache[resolvedPath]?.isEmpty ?? true) {
+                cache[resolvedPath] = result.entries
+                listingStore?.store(key: listingStoreKey, path: resolvedPath, requestedPath: outcome.requestedPath, entries: result.entries)
+            }
+            let snapshot = makeSnapshot(
+                path: resolvedPath,
+                entries: cache[resolvedPath] ?? [],
+                isStale: false,
+                isConfirmedEmpty: false,
+                fromCache: false,
+                requestID: requestID,
+                latencyMs: result.latencyMs,
+                message: nil,
+                stateOverride: nil
+            )
+            logSnapshot(
+                snapshot,
+                requestID: requestID,
+                pathIn: outcome.requestedPath,
+                resolvedPath: resolvedPath,
+                reopenedSession: result.reopenedSession,
+                firstEntryLatencyMs: result.firstEntryLatencyMs,
+                stageTiming: result.stageTiming
+            )
+            snapshots.append(snapshot)
+        }
+        return snapshots
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     func retryCurrentPath(requestID: UInt64) async -> RemoteBrowserSnapshot {
@@ -276,14 +862,32 @@ actor LibSSH2SessionActor {
             lastSuccessText = "-"
         }
 
-        return "- \(remote.displayName) session=\(id.uuidString) state=\(health.state.rawValue) retries=\(health.retryCount) path=\(sessionPath) failures=\(consecutiveFailures) emptyStrikes=\(totalEmptyStrikes) lastSuccessAt=\(lastSuccessText) lastLatencyMs=\(health.lastLatencyMs.map(String.init) ?? "-") error=\(health.lastError ?? "")"
+        return "- \(remote.displayName) session=\(id.uuidString) state=\(health.state.rawValue) retries=\(health.retryCount) path=\(sessionPath) failures=\(consecutiveFailures) emptyStrikes=\(totalEmptyStrikes) sharedLists=\(sharedListingCount) coalescedLists=\(coalescedListCount) lastSuccessAt=\(lastSuccessText) lastLatencyMs=\(health.lastLatencyMs.map(String.init) ?? "-") stages=\(lastStageTiming?.summary ?? "-") cache=\(cacheSummary) prefetch=\(prefetchStats.summary) keepalive=\(keepAliveTracker.summary) timeouts=\(transport.adaptiveTimeoutSummary(remoteID: remote.id) ?? "-") error=\(health.lastError ?? "")"
+    }
+
+    /// Beginner note: Current keepalive mode and per-mode counters, for diagnostics and tests.
+    func keepAliveStatistics() -> BrowserKeepAliveTracker {
+        keepAliveTracker
+    }
+
+    /// Beginner note: Current cache footprint and eviction counters, for diagnostics and tests.
+    func cacheMetrics() -> BrowserDirectoryCache.Metrics {
+        cache.metrics
+    }
+
+    /// Beginner note: Compact cache footprint text for summaryLine.
+    private var cacheSummary: String {
+        let metrics = cache.metrics
+        return "\(metrics.entryCount)dirs/\(metrics.totalBytes / 1024)KiB/\(metrics.byteBudget / 1024)KiB evictions=\(metrics.evictions)"
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     private func startKeepAlive() {
         keepAliveTask?.cancel()
         keepAliveTask = Task {
-            await self.keepAliveLoop()
+            await BrowserOperationPriority.$current.withValue(.keepalive) {
+                await self.keepAliveLoop()
+            }
         }
     }
 
@@ -317,8 +921,20 @@ actor LibSSH2SessionActor {
             return
         }
 
+        let mode = keepAliveTracker.mode
         do {
-            try await transport.ping(remote: remote, path: lastPath, password: password)
+            let result = try await transport.keepAlive(remote: remote, path: lastPath, password: password, mode: mode)
+            if keepAliveTracker.recordSuccess(result) {
+                // Every tick paid the probe wait and a stat anyway; stat alone is cheaper.
+                keepAliveModeMemory?.remember(keepAliveTracker.mode, for: remote)
+                diagnostics.append(
+                    level: .info,
+                    category: "remote-browser",
+                    message: "keepalive mode \(mode.rawValue)->\(keepAliveTracker.mode.rawValue) session=\(id.uuidString) host=\(remote.host) (server did not answer keepalive probes)"
+                )
+            } else if mode == .sshProtocol, result.replySeen {
+                keepAliveModeMemory?.remember(.sshProtocol, for: remote)
+            }
             if consecutiveFailures > 0 || breakerOpenedAt != nil {
                 consecutiveFailures = 0
                 breakerOpenedAt = nil
@@ -335,6 +951,7 @@ actor LibSSH2SessionActor {
                 )
             }
         } catch {
+            keepAliveTracker.recordFailure(mode: mode)
             setHealth(
                 state: .reconnecting,
                 retryCount: max(1, health.retryCount),
@@ -344,7 +961,7 @@ actor LibSSH2SessionActor {
             diagnostics.append(
                 level: .warning,
                 category: "remote-browser",
-                message: "keepalive failed session=\(id.uuidString) path=\(lastPath) error=\(error.localizedDescription)"
+                message: "keepalive failed session=\(id.uuidString) mode=\(mode.rawValue) path=\(lastPath) error=\(error.localizedDescription)"
             )
             // Ping failure does not wipe cache or force-close session.
             scheduleRecoveryIfNeeded(reason: "keepalive-failed", path: lastPath)
@@ -360,6 +977,9 @@ actor LibSSH2SessionActor {
         let effectivePath = BrowserPathNormalizer.normalize(path: result.resolvedPath)
         let pathKey = effectivePath
         let cachedForPath = cache[effectivePath] ?? []
+        if let stageTiming = result.stageTiming {
+            lastStageTiming = stageTiming
+        }
 
         if result.entries.isEmpty {
             if !cachedForPath.isEmpty {
@@ -402,7 +1022,8 @@ actor LibSSH2SessionActor {
                         entries: confirmation.entries,
                         requestID: requestID,
                         latencyMs: confirmation.latencyMs,
-                        isConfirmedEmpty: false
+                        isConfirmedEmpty: false,
+                        validator: confirmation.directoryValidator
                     )
                 }
 
@@ -412,7 +1033,8 @@ actor LibSSH2SessionActor {
                     entries: [],
                     requestID: requestID,
                     latencyMs: confirmation.latencyMs,
-                    isConfirmedEmpty: true
+                    isConfirmedEmpty: true,
+                    validator: confirmation.directoryValidator
                 )
             } catch {
                 // Could not confirm emptiness; stay on cached or degraded view and recover.
@@ -455,7 +1077,8 @@ actor LibSSH2SessionActor {
             entries: result.entries,
             requestID: requestID,
             latencyMs: result.latencyMs,
-            isConfirmedEmpty: false
+            isConfirmedEmpty: false,
+            validator: result.directoryValidator
         )
 
         if recoveryContext {
@@ -475,10 +1098,12 @@ actor LibSSH2SessionActor {
         entries: [RemoteDirectoryItem],
         requestID: UInt64,
         latencyMs: Int,
-        isConfirmedEmpty: Bool
+        isConfirmedEmpty: Bool,
+        validator: BrowserDirectoryValidator? = nil
     ) -> RemoteBrowserSnapshot {
         // Successful listing resets failure counters and breaker state.
-        cache[path] = entries
+        cache.store(entries, validator: validator, for: path)
+        listingStore?.store(key: listingStoreKey, path: path, entries: entries, validator: validator)
         lastPath = path
         consecutiveFailures = 0
         breakerOpenedAt = nil
@@ -577,7 +1202,9 @@ actor LibSSH2SessionActor {
 
         // Only one recovery loop is allowed at a time.
         recoveryTask = Task {
-            await self.runRecoveryLoop(path: normalizedPath)
+            await BrowserOperationPriority.$current.withValue(.recovery) {
+                await self.runRecoveryLoop(path: normalizedPath)
+            }
         }
     }
 
@@ -782,18 +1409,48 @@ actor LibSSH2SessionActor {
         )
     }
 
+    /// Beginner note: A superseded request is not a connection failure: no retries, no breaker
+    /// strike, no recovery. Health goes back to what it was and cached rows are returned as stale.
+    private func cancelledListSnapshot(
+        path: String,
+        requestID: UInt64,
+        restoring previousHealth: BrowserConnectionHealth
+    ) -> RemoteBrowserSnapshot {
+        health = previousHealth
+        let cached = cachedEntries(preferredPath: path)
+        let snapshot = makeSnapshot(
+            path: path,
+            entries: cached.entries,
+            isStale: true,
+            isConfirmedEmpty: false,
+            fromCache: cached.fromCache,
+            requestID: requestID,
+            latencyMs: 0,
+            message: nil,
+            stateOverride: nil
+        )
+        diagnostics.append(
+            level: .debug,
+            category: "remote-browser",
+            message: "list cancelled session=\(id.uuidString) requestID=\(requestID) pathIn=\(path)"
+        )
+        return snapshot
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     private func logSnapshot(
         _ snapshot: RemoteBrowserSnapshot,
         requestID: UInt64,
         pathIn: String,
         resolvedPath: String,
-        reopenedSession: Bool
+        reopenedSession: Bool,
+        firstEntryLatencyMs: Int? = nil,
+        stageTiming: BrowserStageTiming? = nil
     ) {
         diagnostics.append(
             level: .debug,
             category: "remote-browser",
-            message: "snapshot session=\(id.uuidString) requestID=\(requestID) pathIn=\(pathIn) resolvedPath=\(resolvedPath) elapsedMs=\(snapshot.latencyMs) entryCount=\(snapshot.entries.count) reopenedSession=\(reopenedSession) healthState=\(snapshot.health.state.rawValue) fromCache=\(snapshot.fromCache) stale=\(snapshot.isStale) confirmedEmpty=\(snapshot.isConfirmedEmpty)"
+            message: "snapshot session=\(id.uuidString) requestID=\(requestID) pathIn=\(pathIn) resolvedPath=\(resolvedPath) elapsedMs=\(snapshot.latencyMs) firstEntryMs=\(firstEntryLatencyMs.map(String.init) ?? "-") entryCount=\(snapshot.entries.count) reopenedSession=\(reopenedSession) healthState=\(snapshot.health.state.rawValue) fromCache=\(snapshot.fromCache) stale=\(snapshot.isStale) confirmedEmpty=\(snapshot.isConfirmedEmpty) stages=\(stageTiming?.summary ?? "-")"
         )
     }
 }
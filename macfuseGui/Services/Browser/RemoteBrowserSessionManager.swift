@@ -15,6 +15,10 @@ actor RemoteBrowserSessionManager {
     private let diagnostics: DiagnosticsService
     private let breakerThreshold: Int
     private let breakerWindow: TimeInterval
+    private let listingStore: BrowserListingDiskCache?
+    private let prefetchPolicy: BrowserPrefetchPolicy
+    // Keepalive mode learned per server, shared by every session this manager opens.
+    private let keepAliveModeMemory = BrowserKeepAliveModeMemory()
     private var sessions: [RemoteBrowserSessionID: LibSSH2SessionActor] = [:]
     private var sessionRemoteIDs: [RemoteBrowserSessionID: UUID] = [:]
 
@@ -23,12 +27,16 @@ actor RemoteBrowserSessionManager {
         transport: BrowserTransport,
         diagnostics: DiagnosticsService,
         breakerThreshold: Int = 8,
-        breakerWindow: TimeInterval = 30
+        breakerWindow: TimeInterval = 30,
+        listingStore: BrowserListingDiskCache? = nil,
+        prefetchPolicy: BrowserPrefetchPolicy = BrowserPrefetchPolicy()
     ) {
         self.transport = transport
         self.diagnostics = diagnostics
         self.breakerThreshold = breakerThreshold
         self.breakerWindow = breakerWindow
+        self.listingStore = listingStore
+        self.prefetchPolicy = prefetchPolicy
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -51,6 +59,8 @@ actor RemoteBrowserSessionManager {
             )
         }
 
+        // Map the remote's saved listings now so the first warm-start lookup does not wait on disk.
+        listingStore?.preload(key: BrowserListingCacheKey(remote: remote))
         let sessionID = UUID()
         let session = LibSSH2SessionActor(
             id: sessionID,
@@ -59,7 +69,10 @@ actor RemoteBrowserSessionManager {
             transport: transport,
             diagnostics: diagnostics,
             breakerThreshold: breakerThreshold,
-            breakerWindow: breakerWindow
+            breakerWindow: breakerWindow,
+            listingStore: listingStore,
+            prefetchPolicy: prefetchPolicy,
+            keepAliveModeMemory: keepAliveModeMemory
         )
         sessions[sessionID] = session
         sessionRemoteIDs[sessionID] = remote.id
@@ -85,15 +98,56 @@ actor RemoteBrowserSessionManager {
         )
         // Remove first so concurrent callers immediately observe this session as closed.
         await session.close()
+        // Start persisting the session's last listings now instead of waiting for the coalesced write.
+        // The write runs on the cache's own queue, so closing never waits on disk.
+        listingStore?.flush()
+    }
+
+    /// Beginner note: Drops a remote's saved listings after it is deleted or pointed elsewhere.
+    func forgetCachedListings(remoteID: UUID) {
+        listingStore?.removeAll(remoteID: remoteID)
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
-    func listDirectories(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot {
+    func listDirectories(
+        sessionID: RemoteBrowserSessionID,
+        path: String,
+        requestID: UInt64,
+        onPartial: RemoteBrowserPartialSnapshotHandler? = nil
+    ) async -> RemoteBrowserSnapshot {
         guard let session = sessions[sessionID] else {
             return missingSessionSnapshot(path: path, requestID: requestID)
         }
-        return await session.list(path: path, requestID: requestID)
+        return await session.list(path: path, requestID: requestID, onPartial: onPartial)
+    }
+
+    /// Beginner note: Last-known listing for instant rendering while the first real listing runs.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func warmStartSnapshot(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot? {
+        guard let session = sessions[sessionID] else {
+            return nil
+        }
+        return await session.warmStartSnapshot(path: path, requestID: requestID)
+    }
+
+    /// Beginner note: Background prefetch of likely-next folders; unknown sessions ignore it.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func prefetch(sessionID: RemoteBrowserSessionID, paths: [String]) async {
+        await sessions[sessionID]?.prefetch(paths: paths)
+    }
+
+    /// Beginner note: Batch listing used for background cache warm-up; unknown sessions yield no snapshots.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func listDirectories(
+        sessionID: RemoteBrowserSessionID,
+        paths: [String],
+        requestID: UInt64
+    ) async -> [RemoteBrowserSnapshot] {
+        guard let session = sessions[sessionID] else {
+            return []
+        }
+        return await session.listMany(paths: paths, requestID: requestID)
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -131,8 +185,9 @@ actor RemoteBrowserSessionManager {
     /// This is async: it can suspend and resume later without blocking a thread.
     func sessionsSummary() async -> String {
         let sessionPairs = sessions.map { ($0.key, $0.value) }
+        let transportLine = transport.diagnosticsSummaryLine()
         if sessionPairs.isEmpty {
-            return "- none"
+            return (["- none"] + [transportLine].compactMap { $0 }).joined(separator: "\n")
         }
 
         let lines = await withTaskGroup(of: String.self, returning: [String].self) { group in
@@ -150,7 +205,7 @@ actor RemoteBrowserSessionManager {
             return collected
         }
 
-        return lines.sorted().joined(separator: "\n")
+        return (lines.sorted() + [transportLine].compactMap { $0 }).joined(separator: "\n")
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
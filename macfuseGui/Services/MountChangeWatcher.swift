@@ -0,0 +1,340 @@
+// BEGINNER FILE GUIDE
+// Layer: Core service layer
+// Purpose: This file turns kernel mount-table change notifications into events, so status checks run on change instead of on a timer.
+// Called by: RemotesViewModel starts the platform watcher with recovery monitoring and forwards events to MountManager.
+// Calls into: kqueue EVFILT_FS on macOS, poll(POLLPRI) on /proc/self/mountinfo on Linux.
+// Concurrency: Backends deliver events on their own queue or thread; handlers must hop to their own actor.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: What kind of change the kernel reported. Backends that only know "something
+/// changed" report .changed; consumers re-read the mount table either way.
+struct MountChangeFlags: OptionSet, Sendable, Hashable {
+    let rawValue: Int
+
+    static let mounted = MountChangeFlags(rawValue: 1 << 0)
+    static let unmounted = MountChangeFlags(rawValue: 1 << 1)
+    static let changed = MountChangeFlags(rawValue: 1 << 2)
+    // The filesystem stopped answering (for sshfs: the server or the sshfs process is gone).
+    static let notResponding = MountChangeFlags(rawValue: 1 << 3)
+    static let dead = MountChangeFlags(rawValue: 1 << 4)
+
+    /// Beginner note: Compact "mounted,dead" text for diagnostics lines.
+    var label: String {
+        let names: [(MountChangeFlags, String)] = [
+            (.mounted, "mounted"),
+            (.unmounted, "unmounted"),
+            (.changed, "changed"),
+            (.notResponding, "notResponding"),
+            (.dead, "dead")
+        ]
+        let parts = names.compactMap { contains($0.0) ? $0.1 : nil }
+        return parts.isEmpty ? "-" : parts.joined(separator: ",")
+    }
+}
+
+/// Beginner note: One (possibly coalesced) notification, stamped when the backend saw it so
+/// consumers can measure detection-to-reaction latency.
+struct MountChangeEvent: Sendable, Equatable {
+    var flags: MountChangeFlags
+    var detectedAtUptimeNanos: UInt64
+
+    init(flags: MountChangeFlags, detectedAtUptimeNanos: UInt64 = DispatchTime.now().uptimeNanoseconds) {
+        self.flags = flags
+        self.detectedAtUptimeNanos = detectedAtUptimeNanos
+    }
+
+    /// Beginner note: Folds a later event into this one, keeping the earliest detection time.
+    mutating func merge(_ other: MountChangeEvent) {
+        flags.formUnion(other.flags)
+        detectedAtUptimeNanos = min(detectedAtUptimeNanos, other.detectedAtUptimeNanos)
+    }
+}
+
+typealias MountChangeHandler = @Sendable (MountChangeEvent) -> Void
+
+/// Beginner note: One OS backend that pushes mount-table changes.
+protocol MountChangeWatching: AnyObject, Sendable {
+    var backendName: String { get }
+    /// Beginner note: Starts delivering events; throws when the kernel interface is unavailable.
+    func start(onChange: @escaping MountChangeHandler) throws
+    /// Beginner note: Stops delivery and releases the descriptor. Safe to call more than once.
+    func stop()
+}
+
+/// Beginner note: Picks the backend for the OS the app runs on.
+enum MountChangeWatchers {
+    /// Beginner note: nil means no native backend; status then relies on periodic probes alone.
+    static func platformDefault() -> MountChangeWatching? {
+        #if canImport(Darwin)
+        return KqueueMountChangeWatcher()
+        #elseif os(Linux)
+        return MountInfoChangeWatcher()
+        #else
+        return nil
+        #endif
+    }
+}
+
+#if canImport(Darwin)
+/// Beginner note: Which kqueue filter feeds the watcher. The kernel's EVFILT_FS is the real one;
+/// .user registers an EVFILT_USER event that post(vqFlags:) triggers, so tests can drive the
+/// same kqueue and dispatch path without mounting a volume.
+enum KqueueMountEventSource: Sendable, Equatable {
+    case filesystem
+    case user(ident: UInt)
+}
+
+/// Beginner note: macOS backend. A kqueue EVFILT_FS filter receives VQ_* filesystem events
+/// (mount, unmount, not responding, dead) for every filesystem, and the kqueue descriptor is
+/// itself readable while events are pending, so a dispatch read source wakes us only on change.
+// @unchecked Sendable is safe here because source and kqueueFD are only touched under lock.
+final class KqueueMountChangeWatcher: MountChangeWatching, @unchecked Sendable {
+    private let queue = DispatchQueue(label: "com.visualweb.macfusegui.mount-change-watcher")
+    private let eventSource: KqueueMountEventSource
+    private let lock = NSLock()
+    private var source: DispatchSourceRead?
+    private var kqueueFD: Int32 = -1
+
+    init(eventSource: KqueueMountEventSource = .filesystem) {
+        self.eventSource = eventSource
+    }
+
+    var backendName: String {
+        switch eventSource {
+        case .filesystem:
+            return "kqueue"
+        case .user:
+            return "kqueue-user"
+        }
+    }
+
+    /// Beginner note: This can throw an error: callers should fall back to periodic probes.
+    func start(onChange: @escaping MountChangeHandler) throws {
+        lock.lock()
+        defer { lock.unlock() }
+        guard source == nil else {
+            return
+        }
+
+        let kq = kqueue()
+        guard kq >= 0 else {
+            throw Self.startError()
+        }
+        let filter = eventSource.filter
+        var registration = kevent(
+            ident: eventSource.ident,
+            filter: filter,
+            flags: UInt16(EV_ADD | EV_CLEAR),
+            fflags: 0,
+            data: 0,
+            udata: nil
+        )
+        guard kevent(kq, &registration, 1, nil, 0, nil) == 0 else {
+            let error = Self.startError()
+            close(kq)
+            throw error
+        }
+
+        let readSource = DispatchSource.makeReadSource(fileDescriptor: kq, queue: queue)
+        readSource.setEventHandler {
+            var events = [kevent](repeating: kevent(), count: 8)
+            var zero = timespec(tv_sec: 0, tv_nsec: 0)
+            var flags: MountChangeFlags = []
+            while true {
+                let count = kevent(kq, nil, 0, &events, Int32(events.count), &zero)
+                guard count > 0 else {
+                    break
+                }
+                for event in events.prefix(Int(count)) where event.filter == filter {
+                    flags.formUnion(MountChangeFlags(vqFlags: event.fflags & UInt32(NOTE_FFLAGSMASK)))
+                }
+            }
+            if !flags.isEmpty {
+                onChange(MountChangeEvent(flags: flags))
+            }
+        }
+        readSource.setCancelHandler {
+            close(kq)
+        }
+        source = readSource
+        kqueueFD = kq
+        readSource.resume()
+    }
+
+    /// Beginner note: Raises VQ_* bits on a .user source as if the kernel had reported them.
+    /// Returns false for the filesystem source or when the watcher is not running.
+    @discardableResult
+    func post(vqFlags: UInt32) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard case .user(let ident) = eventSource, source != nil else {
+            return false
+        }
+        var trigger = kevent(
+            ident: ident,
+            filter: Int16(EVFILT_USER),
+            flags: 0,
+            fflags: UInt32(NOTE_TRIGGER) | UInt32(NOTE_FFOR) | (vqFlags & UInt32(NOTE_FFLAGSMASK)),
+            data: 0,
+            udata: nil
+        )
+        return kevent(kqueueFD, &trigger, 1, nil, 0, nil) == 0
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func stop() {
+        lock.lock()
+        let current = source
+        source = nil
+        kqueueFD = -1
+        lock.unlock()
+        current?.cancel()
+    }
+
+    deinit {
+        source?.cancel()
+    }
+
+    private static func startError() -> AppError {
+        AppError.processFailure(L10n.format("Failed to watch mount changes: %@", String(cString: strerror(errno))))
+    }
+}
+
+private extension KqueueMountEventSource {
+    var filter: Int16 {
+        switch self {
+        case .filesystem:
+            return Int16(EVFILT_FS)
+        case .user:
+            return Int16(EVFILT_USER)
+        }
+    }
+
+    var ident: UInt {
+        switch self {
+        case .filesystem:
+            return 0
+        case .user(let ident):
+            return ident
+        }
+    }
+}
+
+extension MountChangeFlags {
+    /// Beginner note: Maps kqueue VQ_* bits; unrecognized bits (low disk, quota, ...) report .changed.
+    init(vqFlags: UInt32) {
+        var flags: MountChangeFlags = []
+        if vqFlags & UInt32(VQ_MOUNT) != 0 {
+            flags.insert(.mounted)
+        }
+        if vqFlags & UInt32(VQ_UNMOUNT) != 0 {
+            flags.insert(.unmounted)
+        }
+        if vqFlags & UInt32(VQ_NOTRESP) != 0 {
+            flags.insert(.notResponding)
+        }
+        if vqFlags & UInt32(VQ_DEAD) != 0 {
+            flags.insert(.dead)
+        }
+        if flags.isEmpty, vqFlags != 0 {
+            flags.insert(.changed)
+        }
+        self = flags
+    }
+}
+#endif
+
+#if os(Linux)
+/// Beginner note: Linux backend. The kernel marks /proc/self/mountinfo with POLLPRI|POLLERR
+/// whenever this mount namespace changes; the descriptor must be re-read from offset 0 to re-arm.
+/// A small thread blocks in poll() on it plus a wake pipe used by stop().
+// @unchecked Sendable is safe here because descriptors are only touched under lock.
+final class MountInfoChangeWatcher: MountChangeWatching, @unchecked Sendable {
+    private let path: String
+    private let lock = NSLock()
+    private var mountInfoFD: Int32 = -1
+    private var wakePipe: [Int32] = [-1, -1]
+
+    init(path: String = "/proc/self/mountinfo") {
+        self.path = path
+    }
+
+    var backendName: String { "mountinfo-poll" }
+
+    /// Beginner note: This can throw an error: callers should fall back to periodic probes.
+    func start(onChange: @escaping MountChangeHandler) throws {
+        lock.lock()
+        defer { lock.unlock() }
+        guard mountInfoFD < 0 else {
+            return
+        }
+
+        let fd = open(path, O_RDONLY | O_CLOEXEC)
+        guard fd >= 0 else {
+            throw AppError.processFailure(L10n.format("Failed to watch mount changes: %@", String(cString: strerror(errno))))
+        }
+        var pipeFDs: [Int32] = [-1, -1]
+        guard pipe(&pipeFDs) == 0 else {
+            close(fd)
+            throw AppError.processFailure(L10n.format("Failed to watch mount changes: %@", String(cString: strerror(errno))))
+        }
+        Self.drain(fd)
+        mountInfoFD = fd
+        wakePipe = pipeFDs
+
+        let thread = Thread {
+            var descriptors = [
+                pollfd(fd: fd, events: Int16(POLLPRI), revents: 0),
+                pollfd(fd: pipeFDs[0], events: Int16(POLLIN), revents: 0)
+            ]
+            while true {
+                descriptors[0].revents = 0
+                descriptors[1].revents = 0
+                let ready = poll(&descriptors, 2, -1)
+                if ready < 0 && errno == EINTR {
+                    continue
+                }
+                if ready < 0 || descriptors[1].revents != 0 {
+                    break
+                }
+                if descriptors[0].revents & Int16(POLLPRI | POLLERR) != 0 {
+                    Self.drain(fd)
+                    onChange(MountChangeEvent(flags: .changed))
+                }
+            }
+            close(fd)
+            close(pipeFDs[0])
+        }
+        thread.name = "macfusegui.mount-change-watcher"
+        thread.start()
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func stop() {
+        lock.lock()
+        let writer = wakePipe[1]
+        wakePipe = [-1, -1]
+        mountInfoFD = -1
+        lock.unlock()
+        guard writer >= 0 else {
+            return
+        }
+        var byte: UInt8 = 1
+        _ = write(writer, &byte, 1)
+        close(writer)
+    }
+
+    deinit {
+        stop()
+    }
+
+    /// Beginner note: Reads the table to EOF from offset 0, which re-arms the POLLPRI notification.
+    private static func drain(_ fd: Int32) {
+        _ = lseek(fd, 0, SEEK_SET)
+        var buffer = [UInt8](repeating: 0, count: 16 * 1_024)
+        while buffer.withUnsafeMutableBytes({ read(fd, $0.baseAddress, $0.count) }) > 0 {}
+    }
+}
+#endif
@@ -42,11 +42,23 @@ actor MountManager {
         var lastHealthyAt: Date?
     }
 
+    /// Beginner note: Counters for pushed mount-change events, shown in the diagnostics snapshot.
+    struct MountChangeStats: Equatable, Sendable {
+        var events = 0
+        var remotesFlagged = 0
+        var lastFlags: MountChangeFlags = []
+        // Kernel event to "remotes that need a refresh are known", including any debounce upstream.
+        var lastDetectionLatencyMicros: Int64 = 0
+        var maxDetectionLatencyMicros: Int64 = 0
+    }
+
     private let runner: ProcessRunning
     private let dependencyChecker: DependencyChecking
     private let askpassHelper: AskpassHelper
     private let unmountService: UnmountService
     private let mountStateParser: MountStateParser
+    // Shared in-process mount table; when nil (or a read fails) probes spawn /sbin/mount and /bin/df.
+    private let mountSnapshots: MountTableSnapshotService?
     private let diagnostics: DiagnosticsService
     private let commandBuilder: MountCommandBuilder
     // Keep mount inspection probes short. These are "status checks", not full recovery work.
@@ -75,6 +87,7 @@ actor MountManager {
     private var directoryQueryFailurePreserveMisses: [UUID: Int] = [:]
     private var reconnectDirectoryQueryCooldownUntil: [UUID: Date] = [:]
     private var directoryQueryProbeStatsByRemote: [UUID: DirectoryQueryProbeStats] = [:]
+    private var mountChangeStats = MountChangeStats()
 
     /// Beginner note: Initializers create valid state before any other method is used.
     init(
@@ -83,6 +96,7 @@ actor MountManager {
         askpassHelper: AskpassHelper,
         unmountService: UnmountService,
         mountStateParser: MountStateParser,
+        mountSnapshots: MountTableSnapshotService? = nil,
         diagnostics: DiagnosticsService,
         commandBuilder: MountCommandBuilder,
         sshfsConnectCommandTimeout: TimeInterval = 20,
@@ -93,6 +107,7 @@ actor MountManager {
         self.askpassHelper = askpassHelper
         self.unmountService = unmountService
         self.mountStateParser = mountStateParser
+        self.mountSnapshots = mountSnapshots
         self.diagnostics = diagnostics
         self.commandBuilder = commandBuilder
         self.sshfsConnectCommandTimeout = sshfsConnectCommandTimeout
@@ -141,7 +156,64 @@ actor MountManager {
                     "lastFailureReason=\(compactReason.isEmpty ? "-" : compactReason)"
             }
 
-        return lines.joined(separator: "\n")
+        let mountTableLine = mountSnapshots.map { "\n" + $0.summaryLine() } ?? ""
+        let changeLine = mountChangeStats.events > 0
+            ? "\n- mount-change events=\(mountChangeStats.events) remotesFlagged=\(mountChangeStats.remotesFlagged) lastFlags=\(mountChangeStats.lastFlags.label) lastLatencyUs=\(mountChangeStats.lastDetectionLatencyMicros) maxLatencyUs=\(mountChangeStats.maxDetectionLatencyMicros)"
+            : ""
+        return lines.joined(separator: "\n") + mountTableLine + changeLine
+    }
+
+    /// Beginner note: Handles one pushed mount-table change and returns the remotes whose cached
+    /// status no longer matches the table, so the caller refreshes only those.
+    /// Remotes with an operation in flight (connecting/disconnecting) are left to that operation.
+    func mountTableDidChange(_ event: MountChangeEvent, remotes: [RemoteConfig]) -> [UUID] {
+        let candidates = remotes.filter { remote in
+            let state = cachedStatus(for: remote.id).state
+            return state != .connecting && state != .disconnecting
+        }
+
+        var snapshot: MountTableSnapshot?
+        if let mountSnapshots {
+            mountSnapshots.invalidate()
+            snapshot = try? mountSnapshots.snapshot(maxAge: 0)
+        }
+
+        var flagged: [UUID]
+        if let snapshot {
+            flagged = candidates.compactMap { remote in
+                let isMounted = snapshot.record(forMountPoint: remote.localMountPoint) != nil
+                let cachedConnected = cachedStatus(for: remote.id).state == .connected
+                return isMounted != cachedConnected ? remote.id : nil
+            }
+            // A hung or dead filesystem stays in the table; only a probe of each connected mount can tell which one.
+            if !event.flags.isDisjoint(with: [.notResponding, .dead]) {
+                let connected = candidates
+                    .filter { cachedStatus(for: $0.id).state == .connected && !flagged.contains($0.id) }
+                    .map(\.id)
+                flagged.append(contentsOf: connected)
+            }
+        } else {
+            // No native table to compare against: every remote gets a regular refresh.
+            flagged = candidates.map(\.id)
+        }
+
+        let latencyMicros = Int64((DispatchTime.now().uptimeNanoseconds &- event.detectedAtUptimeNanos) / 1_000)
+        mountChangeStats.events += 1
+        mountChangeStats.remotesFlagged += flagged.count
+        mountChangeStats.lastFlags = event.flags
+        mountChangeStats.lastDetectionLatencyMicros = latencyMicros
+        mountChangeStats.maxDetectionLatencyMicros = max(mountChangeStats.maxDetectionLatencyMicros, latencyMicros)
+        diagnostics.append(
+            level: .debug,
+            category: "mount",
+            message: "Mount table changed flags=\(event.flags.label) remotesFlagged=\(flagged.count) latencyUs=\(latencyMicros)"
+        )
+        return flagged
+    }
+
+    /// Beginner note: Counters for pushed mount-change events, for diagnostics and tests.
+    func mountChangeStatistics() -> MountChangeStats {
+        mountChangeStats
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -165,10 +237,13 @@ actor MountManager {
             // Normalize path once so comparisons do not fail due to equivalent path formats.
             let normalizedMountPoint = URL(fileURLWithPath: remote.localMountPoint).standardizedFileURL.path
             let previousStatus = cachedStatus(for: remote.id)
+            // The pass-level lookup shares one table read with the other remotes refreshing now;
+            // the confirmation lookups below always read fresh.
             var mountedRecord = try await currentMountRecord(
                 for: remote.localMountPoint,
                 remoteID: remote.id,
-                operationID: operationID
+                operationID: operationID,
+                sharedSnapshot: true
             )
             if let cancelled = cancelledStatus() {
                 return cancelled
@@ -854,6 +929,8 @@ actor MountManager {
                                 timeout: 3
                             )
                         }
+                        // A killed sshfs takes its mount with it.
+                        mountSnapshots?.invalidate()
                         if signal == "-TERM" {
                             try? await Task.sleep(nanoseconds: 300_000_000)
                         }
@@ -1094,6 +1171,7 @@ actor MountManager {
                 environment: command.environment,
                 timeout: sshfsConnectCommandTimeout
             )
+            mountSnapshots?.invalidate()
             let commandElapsedMs = Int(Date().timeIntervalSince(commandStartedAt) * 1_000)
             diagnostics.append(
                 level: .debug,
@@ -1309,12 +1387,22 @@ actor MountManager {
         for mountPoint: String,
         remoteID: UUID? = nil,
         operationID: UUID? = nil,
-        allowMountFallbackOnDFNotMounted: Bool = false
+        allowMountFallbackOnDFNotMounted: Bool = false,
+        sharedSnapshot: Bool = false
     ) async throws -> MountRecord? {
         let normalizedMountPoint = URL(fileURLWithPath: mountPoint).standardizedFileURL.path
         let remoteText = remoteID?.uuidString ?? "-"
         let operationText = operationID?.uuidString ?? "-"
         try throwIfCancelled()
+        // The kernel table is authoritative, so neither df nor the mount fallback is needed.
+        if let snapshot = nativeMountSnapshot(
+            for: normalizedMountPoint,
+            remoteID: remoteID,
+            operationID: operationID,
+            shared: sharedSnapshot
+        ) {
+            return snapshot.record(forMountPoint: normalizedMountPoint)
+        }
         switch try await currentMountRecordViaDFLookup(
             for: normalizedMountPoint,
             remoteID: remoteID,
@@ -1341,8 +1429,7 @@ actor MountManager {
         )
 
         if !mountResult.timedOut && mountResult.exitCode == 0 {
-            let records = mountStateParser.parseMountOutput(mountResult.stdout)
-            return mountStateParser.record(forMountPoint: normalizedMountPoint, from: records)
+            return mountStateParser.record(forMountPoint: normalizedMountPoint, inMountOutput: mountResult.stdout)
         }
 
         let lastFailure = mountInspectionFailureDetail(from: mountResult)
@@ -1417,6 +1504,9 @@ actor MountManager {
         let normalizedMountPoint = URL(fileURLWithPath: mountPoint).standardizedFileURL.path
         let remoteText = remoteID?.uuidString ?? "-"
         let operationText = operationID?.uuidString ?? "-"
+        if let snapshot = nativeMountSnapshot(for: normalizedMountPoint, remoteID: remoteID, operationID: operationID) {
+            return snapshot.record(forMountPoint: normalizedMountPoint)
+        }
         let mountResult = try await runMountInspection(
             for: normalizedMountPoint,
             remoteID: remoteID,
@@ -1424,8 +1514,7 @@ actor MountManager {
         )
 
         if !mountResult.timedOut && mountResult.exitCode == 0 {
-            let records = mountStateParser.parseMountOutput(mountResult.stdout)
-            return mountStateParser.record(forMountPoint: normalizedMountPoint, from: records)
+            return mountStateParser.record(forMountPoint: normalizedMountPoint, inMountOutput: mountResult.stdout)
         }
 
         let lastFailure = mountInspectionFailureDetail(from: mountResult)
@@ -1442,6 +1531,12 @@ actor MountManager {
         remoteID: UUID? = nil,
         operationID: UUID? = nil
     ) async throws -> DFMountLookupResult {
+        if let snapshot = nativeMountSnapshot(for: mountPoint, remoteID: remoteID, operationID: operationID) {
+            if let record = snapshot.record(forMountPoint: mountPoint) {
+                return .mounted(record)
+            }
+            return .notMounted
+        }
         let startedAt = Date()
         let remoteText = remoteID?.uuidString ?? "-"
         let operationText = operationID?.uuidString ?? "-"
@@ -1483,6 +1578,41 @@ actor MountManager {
         return .mounted(MountRecord(source: source, mountPoint: mountedOn, filesystemType: "unknown"))
     }
 
+    /// Beginner note: Kernel mount table from the shared snapshot service (no fork/exec, no text to parse).
+    /// shared reuses a snapshot taken within the service's window (refresh passes); otherwise the
+    /// table is re-read, because connect/disconnect and confirmation checks must see the latest state.
+    /// Returns nil when no service is configured or the read failed, so callers fall back to mount/df.
+    private func nativeMountSnapshot(
+        for mountPoint: String,
+        remoteID: UUID? = nil,
+        operationID: UUID? = nil,
+        shared: Bool = false
+    ) -> MountTableSnapshot? {
+        guard let mountSnapshots else {
+            return nil
+        }
+        let remoteText = remoteID?.uuidString ?? "-"
+        let operationText = operationID?.uuidString ?? "-"
+        let startedAt = Date()
+        do {
+            let snapshot = try mountSnapshots.snapshot(maxAge: shared ? nil : 0)
+            let elapsedMicros = Int(Date().timeIntervalSince(startedAt) * 1_000_000)
+            diagnostics.append(
+                level: .debug,
+                category: "mount",
+                message: "probe end op=mount-table backend=\(mountSnapshots.reader.backendName) remoteID=\(remoteText) operationID=\(operationText) path=\(mountPoint) generation=\(snapshot.generation) records=\(snapshot.records.count) shared=\(shared) elapsedUs=\(elapsedMicros)"
+            )
+            return snapshot
+        } catch {
+            diagnostics.append(
+                level: .warning,
+                category: "mount",
+                message: "Native mount-table read failed backend=\(mountSnapshots.reader.backendName) remoteID=\(remoteText) operationID=\(operationText) path=\(mountPoint): \(error.localizedDescription); falling back to process probes."
+            )
+            return nil
+        }
+    }
+
     private func runMountInspection(
         for mountPoint: String,
         remoteID: UUID? = nil,
@@ -1681,6 +1811,7 @@ actor MountManager {
                     arguments: command.args,
                     timeout: command.timeout
                 )
+                mountSnapshots?.invalidate()
 
                 if result.exitCode == 0 {
                     diagnostics.append(
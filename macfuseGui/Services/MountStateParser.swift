@@ -11,46 +11,37 @@ import Foundation
 /// Beginner note: This type groups related state and behavior for one part of the app.
 /// Read stored properties first, then follow methods top-to-bottom to understand flow.
 final class MountStateParser {
-    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// Beginner note: Parses every line of `mount` output ("<source> on <mount point> (<type>, <options>)").
+    /// Lines are scanned as UTF-8 bytes in one pass; only well-formed lines become records.
     func parseMountOutput(_ output: String) -> [MountRecord] {
-        output
-            .split(separator: "\n", omittingEmptySubsequences: true)
-            .compactMap { line in
-                let lineString = String(line)
-                guard let typeStart = lineString.range(of: " (", options: .backwards) else {
-                    return nil
-                }
-                guard let onRange = lineString.range(
-                    of: " on ",
-                    options: .backwards,
-                    range: lineString.startIndex..<typeStart.lowerBound
-                ) else {
-                    return nil
-                }
-                guard let typeEnd = lineString[typeStart.upperBound...].firstIndex(of: ")") else {
-                    return nil
+        var records: [MountRecord] = []
+        Self.withUTF8Bytes(of: output) { bytes in
+            Self.scanMountLines(bytes) { fields in
+                if let record = fields.record(in: bytes) {
+                    records.append(record)
                 }
+                return true
+            }
+        }
+        return records
+    }
 
-                let source = decodeEscapedMountField(
-                    lineString[..<onRange.lowerBound]
-                        .trimmingCharacters(in: .whitespacesAndNewlines)
-                )
-                let mountPoint = decodeEscapedMountField(
-                    lineString[onRange.upperBound..<typeStart.lowerBound]
-                        .trimmingCharacters(in: .whitespacesAndNewlines)
-                )
-                let fsType = lineString[typeStart.upperBound..<typeEnd]
-                    .split(separator: ",", maxSplits: 1, omittingEmptySubsequences: false)
-                    .first
-                    .map(String.init)?
-                    .trimmingCharacters(in: .whitespacesAndNewlines) ?? ""
-
-                guard !source.isEmpty, !mountPoint.isEmpty, !fsType.isEmpty else {
-                    return nil
+    /// Beginner note: Finds one mount point in raw `mount` output without building every record.
+    /// Same result as record(forMountPoint:from: parseMountOutput(output)), but lines whose mount
+    /// point is plain canonical ASCII are compared as bytes and never turned into Strings.
+    func record(forMountPoint mountPoint: String, inMountOutput output: String) -> MountRecord? {
+        let target = MountPointLookupKey(normalizedPath: normalize(mountPoint))
+        var match: MountRecord?
+        Self.withUTF8Bytes(of: output) { bytes in
+            Self.scanMountLines(bytes) { fields in
+                guard fields.mountPointMatches(target, in: bytes), let record = fields.record(in: bytes) else {
+                    return true
                 }
-
-                return MountRecord(source: source, mountPoint: mountPoint, filesystemType: fsType)
+                match = record
+                return false
             }
+        }
+        return match
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -61,6 +52,11 @@ final class MountStateParser {
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     private func normalize(_ path: String) -> String {
+        Self.normalizedMountPoint(path)
+    }
+
+    /// Beginner note: Shared key for mount-point comparisons (parser lookups and snapshot indexes).
+    static func normalizedMountPoint(_ path: String) -> String {
         // Keep this lexical-only (no symlink resolution) so status probes avoid filesystem I/O.
         URL(fileURLWithPath: path).standardizedFileURL.path
     }
@@ -116,6 +112,217 @@ final class MountStateParser {
 
         return output
     }
+    /// Beginner note: Runs body over the string's UTF-8 storage; native strings are not copied.
+    private static func withUTF8Bytes(of output: String, _ body: (UnsafeBufferPointer<UInt8>) -> Void) {
+        var text = output
+        text.withUTF8(body)
+    }
+
+    /// Beginner note: Walks lines and hands the field ranges of each well-formed one to body.
+    /// body returns false to stop early (a lookup that found its match).
+    private static func scanMountLines(
+        _ bytes: UnsafeBufferPointer<UInt8>,
+        _ body: (MountLineFields) -> Bool
+    ) {
+        var lineStart = 0
+        while lineStart < bytes.count {
+            var lineEnd = lineStart
+            while lineEnd < bytes.count, bytes[lineEnd] != MountLineFields.newline {
+                lineEnd += 1
+            }
+            if let fields = MountLineFields(bytes, line: lineStart..<lineEnd), !body(fields) {
+                return
+            }
+            lineStart = lineEnd + 1
+        }
+    }
+}
+
+/// Beginner note: The normalized mount point being looked up, plus its bytes when a plain byte
+/// comparison is exact (ASCII only: String equality is Unicode-canonical, bytes are not).
+private struct MountPointLookupKey {
+    let normalizedPath: String
+    let asciiBytes: [UInt8]?
+
+    init(normalizedPath: String) {
+        self.normalizedPath = normalizedPath
+        let bytes = Array(normalizedPath.utf8)
+        self.asciiBytes = bytes.allSatisfy { $0 < 0x80 } ? bytes : nil
+    }
+}
+
+/// Beginner note: Byte ranges of one `mount` output line. Delimiters match the String parser this
+/// replaced: the last " (" opens the type block, the last " on " before it ends the source, and the
+/// type is the text up to the first "," or ")". Fields are trimmed and decoded only on demand.
+private struct MountLineFields {
+    static let newline = UInt8(ascii: "\n")
+    private static let space = UInt8(ascii: " ")
+    private static let backslash = UInt8(ascii: "\\")
+    private static let slash = UInt8(ascii: "/")
+    private static let dot = UInt8(ascii: ".")
+    private static let typeOpener = Array(" (".utf8)
+    private static let onDelimiter = Array(" on ".utf8)
+
+    let source: Range<Int>
+    let mountPoint: Range<Int>
+    let filesystemType: Range<Int>
+
+    init?(_ bytes: UnsafeBufferPointer<UInt8>, line: Range<Int>) {
+        guard let typeStart = Self.lastIndex(of: Self.typeOpener, in: bytes, range: line),
+              let onStart = Self.lastIndex(of: Self.onDelimiter, in: bytes, range: line.lowerBound..<typeStart) else {
+            return nil
+        }
+        let typeBlock = (typeStart + 2)..<line.upperBound
+        guard let typeEnd = typeBlock.first(where: { bytes[$0] == UInt8(ascii: ")") }) else {
+            return nil
+        }
+        let typeFieldEnd = (typeBlock.lowerBound..<typeEnd).first(where: { bytes[$0] == UInt8(ascii: ",") }) ?? typeEnd
+
+        source = line.lowerBound..<onStart
+        mountPoint = (onStart + 4)..<typeStart
+        filesystemType = typeBlock.lowerBound..<typeFieldEnd
+    }
+
+    /// Beginner note: Builds the record, or nil when any field is blank (like the String parser).
+    func record(in bytes: UnsafeBufferPointer<UInt8>) -> MountRecord? {
+        let source = Self.decodedField(bytes, self.source, decodeEscapes: true)
+        let mountPoint = Self.decodedField(bytes, self.mountPoint, decodeEscapes: true)
+        let filesystemType = Self.decodedField(bytes, self.filesystemType, decodeEscapes: false)
+        guard !source.isEmpty, !mountPoint.isEmpty, !filesystemType.isEmpty else {
+            return nil
+        }
+        return MountRecord(source: source, mountPoint: mountPoint, filesystemType: filesystemType)
+    }
+
+    /// Beginner note: Compares this line's mount point with the lookup key. Canonical ASCII paths
+    /// (absolute, no escapes, no "." / ".." / empty segments, no trailing "/") are already
+    /// normalized, so they are compared as bytes; anything else is decoded and normalized.
+    func mountPointMatches(_ key: MountPointLookupKey, in bytes: UnsafeBufferPointer<UInt8>) -> Bool {
+        let trimmed = Self.asciiTrimmed(bytes, mountPoint)
+        if let target = key.asciiBytes, Self.isCanonicalASCIIPath(bytes, trimmed) {
+            return trimmed.count == target.count && zip(trimmed, target).allSatisfy { bytes[$0.0] == $0.1 }
+        }
+        let decoded = Self.decodedField(bytes, mountPoint, decodeEscapes: true)
+        return !decoded.isEmpty && MountStateParser.normalizedMountPoint(decoded) == key.normalizedPath
+    }
+
+    private static func lastIndex(of needle: [UInt8], in bytes: UnsafeBufferPointer<UInt8>, range: Range<Int>) -> Int? {
+        guard range.count >= needle.count else {
+            return nil
+        }
+        var index = range.upperBound - needle.count
+        while index >= range.lowerBound {
+            if bytes[index] == needle[0], needle.indices.allSatisfy({ bytes[index + $0] == needle[$0] }) {
+                return index
+            }
+            index -= 1
+        }
+        return nil
+    }
+
+    private static func isASCIIWhitespace(_ byte: UInt8) -> Bool {
+        byte == space || (byte >= 0x09 && byte <= 0x0D)
+    }
+
+    private static func asciiTrimmed(_ bytes: UnsafeBufferPointer<UInt8>, _ range: Range<Int>) -> Range<Int> {
+        var lower = range.lowerBound
+        var upper = range.upperBound
+        while lower < upper, isASCIIWhitespace(bytes[lower]) {
+            lower += 1
+        }
+        while upper > lower, isASCIIWhitespace(bytes[upper - 1]) {
+            upper -= 1
+        }
+        return lower..<upper
+    }
+
+    private static func isCanonicalASCIIPath(_ bytes: UnsafeBufferPointer<UInt8>, _ range: Range<Int>) -> Bool {
+        guard let first = range.first, bytes[first] == slash else {
+            return false
+        }
+        if range.count > 1, bytes[range.upperBound - 1] == slash {
+            return false
+        }
+        var segmentStart = first + 1
+        for index in range.dropFirst() {
+            let byte = bytes[index]
+            guard byte >= 0x20, byte < 0x7F, byte != backslash else {
+                return false
+            }
+            if byte == slash {
+                if isDotSegmentOrEmpty(bytes, segmentStart..<index) {
+                    return false
+                }
+                segmentStart = index + 1
+            }
+        }
+        return range.count == 1 || !isDotSegmentOrEmpty(bytes, segmentStart..<range.upperBound)
+    }
+
+    private static func isDotSegmentOrEmpty(_ bytes: UnsafeBufferPointer<UInt8>, _ segment: Range<Int>) -> Bool {
+        segment.isEmpty || segment.allSatisfy({ bytes[$0] == dot }) && segment.count <= 2
+    }
+
+    /// Beginner note: Trims and (optionally) decodes one field. Fields whose edges are non-ASCII
+    /// take the String path so Unicode whitespace is trimmed exactly like before.
+    private static func decodedField(_ bytes: UnsafeBufferPointer<UInt8>, _ range: Range<Int>, decodeEscapes: Bool) -> String {
+        let trimmed = asciiTrimmed(bytes, range)
+        if let first = trimmed.first, bytes[first] >= 0x80 || bytes[trimmed.upperBound - 1] >= 0x80 {
+            let text = String(decoding: UnsafeBufferPointer(rebasing: bytes[trimmed]), as: UTF8.self)
+                .trimmingCharacters(in: .whitespacesAndNewlines)
+            return decodeEscapes ? MountStateParser().decodeEscapedMountField(text) : text
+        }
+        let slice = UnsafeBufferPointer(rebasing: bytes[trimmed])
+        guard decodeEscapes, slice.contains(backslash) else {
+            return String(decoding: slice, as: UTF8.self)
+        }
+        return String(decoding: decodedEscapes(slice), as: UTF8.self)
+    }
+
+    /// Beginner note: Byte version of decodeEscapedMountField: "\\" is a backslash, "\ooo" is the
+    /// Unicode scalar with that octal value, and any other escape is kept as written.
+    private static func decodedEscapes(_ field: UnsafeBufferPointer<UInt8>) -> [UInt8] {
+        var output: [UInt8] = []
+        output.reserveCapacity(field.count)
+        var index = 0
+        while index < field.count {
+            let byte = field[index]
+            guard byte == backslash, index + 1 < field.count else {
+                output.append(byte)
+                index += 1
+                continue
+            }
+            if field[index + 1] == backslash {
+                output.append(backslash)
+                index += 2
+                continue
+            }
+            if index + 3 < field.count,
+               let value = octalValue(field[index + 1], field[index + 2], field[index + 3]) {
+                // At most 0o777, so one or two UTF-8 bytes.
+                if value < 0x80 {
+                    output.append(UInt8(value))
+                } else {
+                    output.append(UInt8(0xC0 | (value >> 6)))
+                    output.append(UInt8(0x80 | (value & 0x3F)))
+                }
+                index += 4
+                continue
+            }
+            output.append(byte)
+            index += 1
+        }
+        return output
+    }
+
+    private static func octalValue(_ first: UInt8, _ second: UInt8, _ third: UInt8) -> Int? {
+        let zero = UInt8(ascii: "0")
+        let seven = UInt8(ascii: "7")
+        guard (zero...seven).contains(first), (zero...seven).contains(second), (zero...seven).contains(third) else {
+            return nil
+        }
+        return Int(first - zero) * 64 + Int(second - zero) * 8 + Int(third - zero)
+    }
 }
 
 private extension Character {
@@ -0,0 +1,165 @@
+// BEGINNER FILE GUIDE
+// Layer: Core service layer
+// Purpose: This file reads the kernel mount table directly, without spawning mount or df.
+// Called by: MountManager and UnmountService mount-state probes, before any process-based fallback.
+// Calls into: getfsstat on macOS, /proc/self/mountinfo on Linux.
+// Concurrency: Readers are stateless values; each call is one short synchronous system call or file read.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: One backend that lists every mounted filesystem as structured records.
+/// Probes use this instead of running /sbin/mount or /bin/df and parsing their output.
+protocol MountTableReading: Sendable {
+    /// Short name for diagnostics lines ("getfsstat", "mountinfo").
+    var backendName: String { get }
+    /// Beginner note: This can throw an error: callers should fall back to the process-based probe.
+    func readMountTable() throws -> [MountRecord]
+}
+
+/// Beginner note: Picks the backend for the OS the app runs on.
+enum MountTableReaders {
+    /// Beginner note: nil means this platform has no native backend and probes keep spawning tools.
+    static func platformDefault() -> MountTableReading? {
+        #if canImport(Darwin)
+        return DarwinMountTableReader()
+        #elseif os(Linux)
+        return MountInfoTableReader()
+        #else
+        return nil
+        #endif
+    }
+}
+
+#if canImport(Darwin)
+/// Beginner note: macOS backend built on getfsstat(2).
+/// MNT_NOWAIT returns the kernel's cached statfs data instead of asking each filesystem, so a
+/// hung sshfs mount cannot stall the probe (mount(8) uses the same flag for the same reason).
+struct DarwinMountTableReader: MountTableReading {
+    var backendName: String { "getfsstat" }
+
+    /// Beginner note: This can throw an error: callers should use do/try/catch or propagate the error.
+    func readMountTable() throws -> [MountRecord] {
+        let reported = getfsstat(nil, 0, MNT_NOWAIT)
+        guard reported >= 0 else {
+            throw Self.readError()
+        }
+
+        // Mounts can appear between the sizing call and the read; retry with room to spare.
+        var capacity = Int(reported) + 8
+        while true {
+            var buffer = [statfs](repeating: statfs(), count: capacity)
+            let count = buffer.withUnsafeMutableBufferPointer { pointer in
+                getfsstat(pointer.baseAddress, Int32(pointer.count * MemoryLayout<statfs>.stride), MNT_NOWAIT)
+            }
+            guard count >= 0 else {
+                throw Self.readError()
+            }
+            if Int(count) < capacity {
+                return buffer.prefix(Int(count)).compactMap(Self.record(from:))
+            }
+            capacity *= 2
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func record(from entry: statfs) -> MountRecord? {
+        let source = string(fromCString: entry.f_mntfromname)
+        let mountPoint = string(fromCString: entry.f_mntonname)
+        let filesystemType = string(fromCString: entry.f_fstypename)
+        guard !source.isEmpty, !mountPoint.isEmpty, !filesystemType.isEmpty else {
+            return nil
+        }
+        return MountRecord(source: source, mountPoint: mountPoint, filesystemType: filesystemType)
+    }
+
+    /// Beginner note: Decodes a fixed-size, NUL-terminated char array imported as a tuple.
+    private static func string<T>(fromCString tuple: T) -> String {
+        withUnsafeBytes(of: tuple) { raw in
+            String(decoding: raw.prefix { $0 != 0 }, as: UTF8.self)
+        }
+    }
+
+    private static func readError() -> AppError {
+        AppError.processFailure(L10n.format("Failed to read the mount table: %@", String(cString: strerror(errno))))
+    }
+}
+#endif
+
+/// Beginner note: Linux backend over /proc/self/mountinfo (see proc(5)).
+/// Each line is "id parent major:minor root mountpoint options [optional...] - fstype source superoptions";
+/// the kernel escapes space, tab, newline and backslash in paths as \ooo octal.
+struct MountInfoTableReader: MountTableReading {
+    let path: String
+
+    init(path: String = "/proc/self/mountinfo") {
+        self.path = path
+    }
+
+    var backendName: String { "mountinfo" }
+
+    /// Beginner note: This can throw an error: callers should use do/try/catch or propagate the error.
+    func readMountTable() throws -> [MountRecord] {
+        guard let data = FileManager.default.contents(atPath: path) else {
+            throw AppError.processFailure(L10n.format("Failed to read the mount table: %@", path))
+        }
+        return Self.records(fromMountInfo: data)
+    }
+
+    /// Beginner note: Works on raw bytes so escaped multi-byte UTF-8 names decode correctly.
+    static func records(fromMountInfo data: Data) -> [MountRecord] {
+        let bytes = [UInt8](data)
+        var records: [MountRecord] = []
+        for line in bytes.split(separator: UInt8(ascii: "\n"), omittingEmptySubsequences: true) {
+            let fields = line.split(separator: UInt8(ascii: " "), omittingEmptySubsequences: true)
+            // Optional fields end at a lone "-"; it follows the six fixed fields.
+            guard fields.count >= 9,
+                  let separator = fields[6...].firstIndex(where: { $0.count == 1 && $0.first == UInt8(ascii: "-") }),
+                  separator + 2 < fields.count else {
+                continue
+            }
+            let mountPoint = decodeOctalEscapes(fields[4])
+            let filesystemType = decodeOctalEscapes(fields[separator + 1])
+            let source = decodeOctalEscapes(fields[separator + 2])
+            guard !mountPoint.isEmpty, !filesystemType.isEmpty, !source.isEmpty else {
+                continue
+            }
+            records.append(MountRecord(source: source, mountPoint: mountPoint, filesystemType: filesystemType))
+        }
+        return records
+    }
+
+    /// Beginner note: Turns \ooo back into the original byte; anything else is copied as-is.
+    private static func decodeOctalEscapes(_ field: ArraySlice<UInt8>) -> String {
+        guard field.contains(UInt8(ascii: "\\")) else {
+            return String(decoding: field, as: UTF8.self)
+        }
+        var output: [UInt8] = []
+        output.reserveCapacity(field.count)
+        var index = field.startIndex
+        while index < field.endIndex {
+            let byte = field[index]
+            if byte == UInt8(ascii: "\\"), index + 3 < field.endIndex,
+               let value = octalValue(field[(index + 1)...(index + 3)]) {
+                output.append(value)
+                index += 4
+                continue
+            }
+            output.append(byte)
+            index += 1
+        }
+        return String(decoding: output, as: UTF8.self)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func octalValue(_ digits: ArraySlice<UInt8>) -> UInt8? {
+        var value = 0
+        for digit in digits {
+            guard digit >= UInt8(ascii: "0"), digit <= UInt8(ascii: "7") else {
+                return nil
+            }
+            value = value * 8 + Int(digit - UInt8(ascii: "0"))
+        }
+        return value <= 255 ? UInt8(value) : nil
+    }
+}
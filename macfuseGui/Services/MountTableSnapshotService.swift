@@ -0,0 +1,133 @@
+// BEGINNER FILE GUIDE
+// Layer: Core service layer
+// Purpose: This file shares one indexed mount-table read between every status probe that runs close together.
+// Called by: MountManager and UnmountService mount lookups; AppEnvironment creates the single instance.
+// Calls into: A MountTableReading backend (getfsstat / mountinfo).
+// Concurrency: Snapshots are immutable Sendable values; the service guards its cache with a lock.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import Foundation
+
+/// Beginner note: One immutable read of the mount table plus a normalized mount-point index.
+/// generation only changes when the table contents change, so callers can compare two
+/// snapshots cheaply to see whether anything was mounted or unmounted in between.
+struct MountTableSnapshot: Sendable {
+    let generation: UInt64
+    let capturedAtUptimeNanos: UInt64
+    let records: [MountRecord]
+    private let recordsByMountPoint: [String: MountRecord]
+
+    init(generation: UInt64, capturedAtUptimeNanos: UInt64, records: [MountRecord]) {
+        self.generation = generation
+        self.capturedAtUptimeNanos = capturedAtUptimeNanos
+        self.records = records
+        var index: [String: MountRecord] = [:]
+        index.reserveCapacity(records.count)
+        for record in records {
+            // First entry wins, matching MountStateParser.record(forMountPoint:from:).
+            let key = MountStateParser.normalizedMountPoint(record.mountPoint)
+            if index[key] == nil {
+                index[key] = record
+            }
+        }
+        self.recordsByMountPoint = index
+    }
+
+    /// Beginner note: O(1) lookup by mount point, normalized the same way as the parser's lookup.
+    func record(forMountPoint mountPoint: String) -> MountRecord? {
+        recordsByMountPoint[MountStateParser.normalizedMountPoint(mountPoint)]
+    }
+}
+
+/// Beginner note: Reads the mount table at most once per maxAge window and hands the same
+/// snapshot to every caller in that window. A refresh pass over many remotes therefore costs
+/// one read instead of one per remote. Anything that mounts or unmounts calls invalidate(),
+/// and confirmation probes pass maxAge 0, so neither ever acts on a table from before a change.
+// @unchecked Sendable is safe here because all mutable state is accessed under lock.
+final class MountTableSnapshotService: @unchecked Sendable {
+    /// Beginner note: Cumulative counters for the diagnostics snapshot and tests.
+    struct Metrics: Equatable, Sendable {
+        var reads = 0
+        var reuses = 0
+        var failures = 0
+        var invalidations = 0
+        var lastReadMicros: Int64 = 0
+    }
+
+    static let defaultMaxAge: TimeInterval = 1
+
+    let reader: MountTableReading
+    private let maxAgeNanos: UInt64
+    private let lock = NSLock()
+    private var latest: MountTableSnapshot?
+    private var latestIsValid = false
+    private var metricsStorage = Metrics()
+
+    /// Beginner note: Initializers create valid state before any other method is used.
+    init(reader: MountTableReading, maxAge: TimeInterval = MountTableSnapshotService.defaultMaxAge) {
+        self.reader = reader
+        self.maxAgeNanos = Self.nanos(maxAge)
+    }
+
+    /// Beginner note: Current snapshot, re-reading when the cached one is older than maxAge
+    /// (the service default when nil) or was invalidated.
+    /// The read runs under the lock, so callers arriving during a read wait for it and reuse it.
+    /// This can throw an error: callers should fall back to process-based probes.
+    func snapshot(maxAge: TimeInterval? = nil) throws -> MountTableSnapshot {
+        lock.lock()
+        defer { lock.unlock() }
+
+        let now = DispatchTime.now().uptimeNanoseconds
+        let limit = maxAge.map(Self.nanos) ?? maxAgeNanos
+        if latestIsValid, let latest, now &- latest.capturedAtUptimeNanos < limit {
+            metricsStorage.reuses += 1
+            return latest
+        }
+
+        let records: [MountRecord]
+        do {
+            records = try reader.readMountTable()
+        } catch {
+            metricsStorage.failures += 1
+            throw error
+        }
+        let finishedAt = DispatchTime.now().uptimeNanoseconds
+        let previousGeneration = latest?.generation ?? 0
+        let generation = latest?.records == records ? previousGeneration : previousGeneration + 1
+        let snapshot = MountTableSnapshot(generation: generation, capturedAtUptimeNanos: finishedAt, records: records)
+        latest = snapshot
+        latestIsValid = true
+        metricsStorage.reads += 1
+        metricsStorage.lastReadMicros = Int64((finishedAt &- now) / 1_000)
+        return snapshot
+    }
+
+    /// Beginner note: Forces the next snapshot() to re-read; call after anything that may mount or unmount.
+    func invalidate() {
+        lock.lock()
+        latestIsValid = false
+        metricsStorage.invalidations += 1
+        lock.unlock()
+    }
+
+    /// Beginner note: Snapshot of the counters, for diagnostics and tests.
+    func metrics() -> Metrics {
+        lock.lock()
+        defer { lock.unlock() }
+        return metricsStorage
+    }
+
+    /// Beginner note: One diagnostics line with read/reuse counters and the current generation.
+    func summaryLine() -> String {
+        lock.lock()
+        let metrics = metricsStorage
+        let generation = latest?.generation ?? 0
+        let recordCount = latest?.records.count ?? 0
+        lock.unlock()
+        return "- mount-table backend=\(reader.backendName) generation=\(generation) records=\(recordCount) reads=\(metrics.reads) reuses=\(metrics.reuses) failures=\(metrics.failures) invalidations=\(metrics.invalidations) lastReadUs=\(metrics.lastReadMicros)"
+    }
+
+    private static func nanos(_ seconds: TimeInterval) -> UInt64 {
+        UInt64(max(0, seconds) * 1_000_000_000)
+    }
+}
@@ -3,7 +3,7 @@
 // Purpose: This file performs non-UI work such as mount commands, process execution, validation, persistence, or diagnostics.
 // Called by: Called by view models to execute user actions and background recovery work.
 // Calls into: May call system APIs, external tools, Keychain, filesystem, and helper services.
-// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Concurrency: Contains async functions; children are watched from one serial event queue, so no thread blocks per child.
 // Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
 
 import Foundation
@@ -19,6 +19,8 @@ struct ProcessResult: Sendable {
     let exitCode: Int32
     let timedOut: Bool
     let duration: TimeInterval
+    // True when output beyond the runner's maxOutputBytes cap was discarded.
+    var outputTruncated: Bool = false
 }
 
 /// Beginner note: This protocol defines the minimum process execution behavior used by services.
@@ -57,23 +59,89 @@ extension ProcessRunning {
     }
 }
 
-/// Beginner note: This type groups related state and behavior for one part of the app.
-/// Read stored properties first, then follow methods top-to-bottom to understand flow.
-// @unchecked Sendable is safe here because all mutable shared state is behind processRegistryLock.
+/// Beginner note: Runs child processes without parking a thread per child.
+/// Children are started with posix_spawn (own process group, only stdio inherited), and one serial
+/// event queue multiplexes every child's stdout/stderr read sources, exit source (kqueue
+/// EVFILT_PROC) and timeout timers. Nothing blocks while a child runs, so a recovery pass over many
+/// remotes no longer ties up one GCD worker per probe.
+// @unchecked Sendable is safe here because registry state is behind processRegistryLock
+// and per-child state and readBuffer are only touched on eventQueue.
 final class ProcessRunner: ProcessRunning, @unchecked Sendable {
     private struct ProcessHandle {
         let pid: Int32
         let processGroupID: Int32?
     }
 
-    private let processRegistryLock = NSLock()
-    private let terminationQueue = DispatchQueue(
-        label: "com.visualweb.macfusegui.processrunner.termination",
+    /// Beginner note: File descriptors the parent keeps after a successful spawn.
+    private struct SpawnedChild {
+        let pid: pid_t
+        let stdoutFD: Int32
+        let stderrFD: Int32
+        let stdinFD: Int32?
+    }
+
+    /// Beginner note: Bookkeeping for one running child. Only touched on eventQueue.
+    private final class ChildProcess {
+        let commandID: UUID
+        let pid: pid_t
+        let executable: String
+        let arguments: [String]
+        let startedAt: Date
+        let continuation: CheckedContinuation<ProcessResult, Error>
+        var stdout = Data()
+        var stderr = Data()
+        var outputTruncated = false
+        var outputSources: [(source: DispatchSourceRead, isStdout: Bool)] = []
+        var stdinSource: DispatchSourceWrite?
+        var exitSource: DispatchSourceProcess?
+        var exitStatus: Int32?
+        var timedOut = false
+        var finished = false
+
+        init(
+            commandID: UUID,
+            pid: pid_t,
+            executable: String,
+            arguments: [String],
+            startedAt: Date,
+            continuation: CheckedContinuation<ProcessResult, Error>
+        ) {
+            self.commandID = commandID
+            self.pid = pid
+            self.executable = executable
+            self.arguments = arguments
+            self.startedAt = startedAt
+            self.continuation = continuation
+        }
+    }
+
+    static let defaultMaxConcurrentChildren = 64
+
+    private let maxOutputBytes: Int?
+    private let maxConcurrentChildren: Int
+    private let eventQueue = DispatchQueue(
+        label: "com.visualweb.macfusegui.processrunner.events",
         qos: .userInitiated
     )
+    private let processRegistryLock = NSLock()
     private var runningPIDs: [UUID: ProcessHandle] = [:]
     private var pendingCancellations: Set<UUID> = []
     private var terminatingCommands: Set<UUID> = []
+    // Spawn slots bound open pipes (four descriptors per child) well below the default fd limit.
+    private var activeChildren = 0
+    private var spawnWaiters: [(commandID: UUID, continuation: CheckedContinuation<Void, Error>)] = []
+    private var readBuffer = [UInt8](repeating: 0, count: 65_536)
+    // Keep timeout teardown short so caller-level watchdog budgets stay meaningful.
+    private let timeoutGracePeriod: TimeInterval = 0.6
+    private let cancellationGracePeriod: TimeInterval = 0.25
+
+    /// Beginner note: maxOutputBytes caps what is kept per stream; the rest is read and discarded
+    /// so a chatty child never blocks on a full pipe. nil keeps everything.
+    /// Callers beyond maxConcurrentChildren wait (suspended, not blocking) for a running child to finish.
+    init(maxOutputBytes: Int? = nil, maxConcurrentChildren: Int = ProcessRunner.defaultMaxConcurrentChildren) {
+        self.maxOutputBytes = maxOutputBytes.map { max(0, $0) }
+        self.maxConcurrentChildren = max(1, maxConcurrentChildren)
+    }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     func run(
@@ -85,228 +153,394 @@ final class ProcessRunner: ProcessRunning, @unchecked Sendable {
     ) async throws -> ProcessResult {
         let commandID = UUID()
         return try await withTaskCancellationHandler {
-            try await withCheckedThrowingContinuation { continuation in
-                DispatchQueue.global(qos: .userInitiated).async {
-                    do {
-                        let start = Date()
-                        let process = Process()
-                        let stdoutPipe = Pipe()
-                        let stderrPipe = Pipe()
-                        var stdinPipe: Pipe?
-                        process.executableURL = URL(fileURLWithPath: executable)
-                        process.arguments = arguments
-                        var mergedEnvironment = ProcessInfo.processInfo.environment
-                        environment.forEach { mergedEnvironment[$0.key] = $0.value }
-                        process.environment = mergedEnvironment
-                        process.standardOutput = stdoutPipe
-                        process.standardError = stderrPipe
-                        if standardInput != nil {
-                            let pipe = Pipe()
-                            stdinPipe = pipe
-                            process.standardInput = pipe
-                        }
-
-                        var didTimeout = false
-                        let terminationSemaphore = DispatchSemaphore(value: 0)
-
-                        var stdoutData = Data()
-                        var stderrData = Data()
-                        let captureLock = NSLock()
-                        var captureHandlersStopped = false
-                        var drained = false
-
-                        let stdoutReadHandle = stdoutPipe.fileHandleForReading
-                        let stderrReadHandle = stderrPipe.fileHandleForReading
-
-                        /// Beginner note: This method is one step in the feature workflow for this file.
-                        func appendBytes(_ chunk: Data, toStdout: Bool) {
-                            guard !chunk.isEmpty else { return }
-                            if toStdout {
-                                stdoutData.append(chunk)
-                            } else {
-                                stderrData.append(chunk)
-                            }
-                        }
-
-                        /// Beginner note: This method is one step in the feature workflow for this file.
-                        func configureNonBlockingRead(_ handle: FileHandle) {
-                            let fd = handle.fileDescriptor
-                            let currentFlags = fcntl(fd, F_GETFL)
-                            guard currentFlags >= 0, (currentFlags & O_NONBLOCK) == 0 else {
-                                return
-                            }
-                            _ = fcntl(fd, F_SETFL, currentFlags | O_NONBLOCK)
-                        }
-
-                        /// Beginner note: This method is one step in the feature workflow for this file.
-                        /// It drains currently available bytes without ever calling NSFileHandle.availableData,
-                        /// which can raise an Objective-C exception from the fd monitoring queue during teardown.
-                        @discardableResult
-                        func drainReadableHandle(_ handle: FileHandle, toStdout: Bool) -> Bool {
-                            captureLock.lock()
-                            defer { captureLock.unlock() }
-
-                            var buffer = [UInt8](repeating: 0, count: 16_384)
-                            while true {
-                                errno = 0
-                                let bytesRead = Darwin.read(handle.fileDescriptor, &buffer, buffer.count)
-                                if bytesRead > 0 {
-                                    let chunk = Data(buffer[0..<Int(bytesRead)])
-                                    appendBytes(chunk, toStdout: toStdout)
-                                    continue
-                                }
-                                if bytesRead == 0 {
-                                    return true
-                                }
-                                if errno == EINTR {
-                                    continue
-                                }
-                                if errno == EAGAIN || errno == EWOULDBLOCK {
-                                    return false
-                                }
-                                if errno == EBADF {
-                                    return true
-                                }
-                                return false
-                            }
-                        }
-
-                        /// Beginner note: This method is one step in the feature workflow for this file.
-                        func stopCaptureHandlers() {
-                            captureLock.lock()
-                            if captureHandlersStopped {
-                                captureLock.unlock()
-                                return
-                            }
-                            captureHandlersStopped = true
-                            captureLock.unlock()
-
-                            stdoutReadHandle.readabilityHandler = nil
-                            stderrReadHandle.readabilityHandler = nil
-                        }
-
-                        /// Beginner note: This method is one step in the feature workflow for this file.
-                        func drainRemainingOutputOnceNonBlocking() {
-                            captureLock.lock()
-                            if drained {
-                                captureLock.unlock()
-                                return
-                            }
-                            drained = true
-                            captureLock.unlock()
-
-                            drainReadableHandle(stdoutReadHandle, toStdout: true)
-                            drainReadableHandle(stderrReadHandle, toStdout: false)
-                        }
-
-                        configureNonBlockingRead(stdoutReadHandle)
-                        configureNonBlockingRead(stderrReadHandle)
-
-                        stdoutReadHandle.readabilityHandler = { handle in
-                            if drainReadableHandle(handle, toStdout: true) {
-                                handle.readabilityHandler = nil
-                            }
-                        }
-
-                        stderrReadHandle.readabilityHandler = { handle in
-                            if drainReadableHandle(handle, toStdout: false) {
-                                handle.readabilityHandler = nil
-                            }
-                        }
-
-                        process.terminationHandler = { _ in
-                            terminationSemaphore.signal()
-                        }
-
-                        try process.run()
-                        let pid = process.processIdentifier
-                        // Best effort only: Process does not provide pre-exec hooks to set process group
-                        // before exec, so group assignment can race for very short-lived children.
-                        var processGroupID: Int32?
-                        if setpgid(pid, pid) == 0 {
-                            processGroupID = pid
-                        }
-                        self.registerRunningProcess(
-                            commandID: commandID,
-                            pid: pid,
-                            processGroupID: processGroupID
-                        )
-
-                        if let standardInput,
-                           let inputData = standardInput.data(using: .utf8),
-                           let stdinPipe {
-                            stdinPipe.fileHandleForWriting.write(inputData)
-                            try? stdinPipe.fileHandleForWriting.close()
-                        }
-
-                        let waitResult = terminationSemaphore.wait(timeout: .now() + timeout)
-                        if waitResult == .timedOut {
-                            didTimeout = true
-
-                            // Shut down async monitoring before terminate/SIGKILL so teardown only uses
-                            // explicit non-blocking reads and never races through NSFileHandle monitoring.
-                            stopCaptureHandlers()
-                            let timeoutHandle = self.beginTermination(
-                                commandID: commandID,
-                                fallback: ProcessHandle(pid: pid, processGroupID: processGroupID)
-                            )
-
-                            if process.isRunning, let timeoutHandle {
-                                self.sendTerminateSignal(to: timeoutHandle)
-                                if timeoutHandle.pid == process.processIdentifier {
-                                    process.terminate()
-                                }
-                            }
-
-                            // Keep timeout teardown short so caller-level watchdog budgets stay meaningful.
-                            let graceResult = terminationSemaphore.wait(timeout: .now() + 0.6)
-                            if graceResult == .timedOut, process.isRunning, let timeoutHandle {
-                                self.sendKillSignal(to: timeoutHandle)
-                                if timeoutHandle.pid == process.processIdentifier {
-                                    _ = kill(process.processIdentifier, SIGKILL)
-                                }
-                                _ = terminationSemaphore.wait(timeout: .now() + 0.6)
-                            }
-                        }
-
-                        stopCaptureHandlers()
-                        drainRemainingOutputOnceNonBlocking()
-
-                        captureLock.lock()
-                        let finalStdout = stdoutData
-                        let finalStderr = stderrData
-                        captureLock.unlock()
-
-                        let stdout = String(data: finalStdout, encoding: .utf8) ?? ""
-                        let stderr = String(data: finalStderr, encoding: .utf8) ?? ""
-                        let stillRunning = process.isRunning
-
-                        let result = ProcessResult(
-                            executable: executable,
-                            arguments: arguments,
-                            stdout: stdout,
-                            stderr: stderr,
-                            exitCode: stillRunning ? -1 : process.terminationStatus,
-                            timedOut: didTimeout || stillRunning,
-                            duration: Date().timeIntervalSince(start)
-                        )
-                        self.unregisterRunningProcess(commandID: commandID)
-                        continuation.resume(returning: result)
-                    } catch {
-                        self.unregisterRunningProcess(commandID: commandID)
-                        continuation.resume(
-                            throwing: AppError.processFailure(
-                                L10n.format("Failed to start process: %@", error.localizedDescription)
-                            )
-                        )
-                    }
+            do {
+                try await withCheckedThrowingContinuation { waiter in
+                    self.acquireSpawnSlot(commandID: commandID, waiter)
+                }
+            } catch {
+                // Cancelled before a slot was handed over: no slot is held and no child is started.
+                self.unregisterRunningProcess(commandID: commandID)
+                throw error
+            }
+            return try await withCheckedThrowingContinuation { continuation in
+                let startedAt = Date()
+                let spawned: SpawnedChild
+                do {
+                    spawned = try Self.spawn(
+                        executable: executable,
+                        arguments: arguments,
+                        environment: environment,
+                        withStandardInput: standardInput != nil
+                    )
+                } catch {
+                    self.unregisterRunningProcess(commandID: commandID)
+                    self.releaseSpawnSlot()
+                    continuation.resume(throwing: error)
+                    return
+                }
+
+                let child = ChildProcess(
+                    commandID: commandID,
+                    pid: spawned.pid,
+                    executable: executable,
+                    arguments: arguments,
+                    startedAt: startedAt,
+                    continuation: continuation
+                )
+                // POSIX_SPAWN_SETPGROUP made the child its own group leader before exec.
+                self.registerRunningProcess(commandID: commandID, pid: spawned.pid, processGroupID: spawned.pid)
+                self.eventQueue.async {
+                    self.attach(child, spawned: spawned, standardInput: standardInput, timeout: timeout)
                 }
             }
         } onCancel: {
-            self.cancelRunningProcess(commandID: commandID)
+            if !self.cancelSpawnWait(commandID: commandID) {
+                self.cancelRunningProcess(commandID: commandID)
+            }
+        }
+    }
+
+    /// Beginner note: This can throw an error: callers should use do/try/catch or propagate the error.
+    private static func spawn(
+        executable: String,
+        arguments: [String],
+        environment: [String: String],
+        withStandardInput: Bool
+    ) throws -> SpawnedChild {
+        var parentFDs: [Int32] = []
+        var childFDs: [Int32] = []
+        defer { childFDs.forEach { close($0) } }
+
+        func makePipe() throws -> (read: Int32, write: Int32) {
+            var fds: [Int32] = [-1, -1]
+            guard pipe(&fds) == 0 else {
+                throw startError(code: errno)
+            }
+            _ = fcntl(fds[0], F_SETFD, FD_CLOEXEC)
+            _ = fcntl(fds[1], F_SETFD, FD_CLOEXEC)
+            return (fds[0], fds[1])
+        }
+
+        do {
+            let stdoutPipe = try makePipe()
+            parentFDs.append(stdoutPipe.read)
+            childFDs.append(stdoutPipe.write)
+            let stderrPipe = try makePipe()
+            parentFDs.append(stderrPipe.read)
+            childFDs.append(stderrPipe.write)
+            let stdinPipe = withStandardInput ? try makePipe() : nil
+            if let stdinPipe {
+                parentFDs.append(stdinPipe.write)
+                childFDs.append(stdinPipe.read)
+            }
+
+            var fileActions: posix_spawn_file_actions_t?
+            posix_spawn_file_actions_init(&fileActions)
+            defer { posix_spawn_file_actions_destroy(&fileActions) }
+            if let stdinPipe {
+                posix_spawn_file_actions_adddup2(&fileActions, stdinPipe.read, STDIN_FILENO)
+            } else {
+                posix_spawn_file_actions_addopen(&fileActions, STDIN_FILENO, "/dev/null", O_RDONLY, 0)
+            }
+            posix_spawn_file_actions_adddup2(&fileActions, stdoutPipe.write, STDOUT_FILENO)
+            posix_spawn_file_actions_adddup2(&fileActions, stderrPipe.write, STDERR_FILENO)
+
+            var attributes: posix_spawnattr_t?
+            posix_spawnattr_init(&attributes)
+            defer { posix_spawnattr_destroy(&attributes) }
+            // Own process group so timeouts and cancellation can signal the whole tree;
+            // CLOEXEC_DEFAULT keeps every other descriptor (including other children's pipes) out.
+            posix_spawnattr_setflags(
+                &attributes,
+                Int16(POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_CLOEXEC_DEFAULT)
+            )
+            posix_spawnattr_setpgroup(&attributes, 0)
+            var noSignals = sigset_t()
+            sigemptyset(&noSignals)
+            posix_spawnattr_setsigmask(&attributes, &noSignals)
+            var allSignals = sigset_t()
+            sigfillset(&allSignals)
+            posix_spawnattr_setsigdefault(&attributes, &allSignals)
+
+            var mergedEnvironment = ProcessInfo.processInfo.environment
+            environment.forEach { mergedEnvironment[$0.key] = $0.value }
+            let argv: [UnsafeMutablePointer<CChar>?] = ([executable] + arguments).map { strdup($0) } + [nil]
+            let envp: [UnsafeMutablePointer<CChar>?] = mergedEnvironment.map { strdup("\($0.key)=\($0.value)") } + [nil]
+            defer {
+                argv.forEach { free($0) }
+                envp.forEach { free($0) }
+            }
+
+            var pid: pid_t = 0
+            let spawnResult = posix_spawn(&pid, executable, &fileActions, &attributes, argv, envp)
+            guard spawnResult == 0 else {
+                throw startError(code: spawnResult)
+            }
+
+            for fd in parentFDs {
+                _ = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK)
+            }
+            if let stdinPipe {
+                // A child that exits without reading stdin must not SIGPIPE the app.
+                _ = fcntl(stdinPipe.write, F_SETNOSIGPIPE, 1)
+            }
+            return SpawnedChild(
+                pid: pid,
+                stdoutFD: stdoutPipe.read,
+                stderrFD: stderrPipe.read,
+                stdinFD: stdinPipe?.write
+            )
+        } catch {
+            parentFDs.forEach { close($0) }
+            throw error
+        }
+    }
+
+    private static func startError(code: Int32) -> AppError {
+        AppError.processFailure(L10n.format("Failed to start process: %@", String(cString: strerror(code))))
+    }
+
+    /// Beginner note: Wires the child's descriptors and exit notification into the event queue.
+    private func attach(_ child: ChildProcess, spawned: SpawnedChild, standardInput: String?, timeout: TimeInterval) {
+        for (fd, isStdout) in [(spawned.stdoutFD, true), (spawned.stderrFD, false)] {
+            let source = DispatchSource.makeReadSource(fileDescriptor: fd, queue: eventQueue)
+            source.setEventHandler {
+                if self.drainOutput(fd: fd, into: child, isStdout: isStdout) {
+                    source.cancel()
+                }
+            }
+            source.setCancelHandler {
+                close(fd)
+            }
+            child.outputSources.append((source, isStdout))
+            source.resume()
+        }
+
+        if let stdinFD = spawned.stdinFD {
+            attachStandardInput(Array((standardInput ?? "").utf8), fd: stdinFD, to: child)
+        }
+
+        let exitSource = DispatchSource.makeProcessSource(identifier: child.pid, eventMask: .exit, queue: eventQueue)
+        exitSource.setEventHandler {
+            self.reap(child)
+        }
+        child.exitSource = exitSource
+        exitSource.resume()
+        // The child may have exited before the source was registered.
+        reap(child)
+
+        eventQueue.asyncAfter(deadline: .now() + max(0, timeout)) { [weak self, weak child] in
+            guard let self, let child, !child.finished else {
+                return
+            }
+            self.handleTimeout(child)
+        }
+    }
+
+    /// Beginner note: Feeds stdin from the event queue as the pipe accepts it, then closes it.
+    private func attachStandardInput(_ bytes: [UInt8], fd: Int32, to child: ChildProcess) {
+        guard !bytes.isEmpty else {
+            close(fd)
+            return
+        }
+        var offset = 0
+        let source = DispatchSource.makeWriteSource(fileDescriptor: fd, queue: eventQueue)
+        source.setEventHandler {
+            while offset < bytes.count {
+                let written = bytes[offset...].withUnsafeBytes { write(fd, $0.baseAddress, $0.count) }
+                if written > 0 {
+                    offset += written
+                    continue
+                }
+                if written < 0 && errno == EINTR {
+                    continue
+                }
+                if written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    return
+                }
+                break
+            }
+            source.cancel()
+        }
+        source.setCancelHandler {
+            close(fd)
+        }
+        child.stdinSource = source
+        source.resume()
+    }
+
+    /// Beginner note: Reads everything currently buffered; returns true at EOF (or a dead descriptor).
+    @discardableResult
+    private func drainOutput(fd: Int32, into child: ChildProcess, isStdout: Bool) -> Bool {
+        while true {
+            let bytesRead = readBuffer.withUnsafeMutableBytes { read(fd, $0.baseAddress, $0.count) }
+            if bytesRead > 0 {
+                append(readBuffer[0..<bytesRead], to: child, isStdout: isStdout)
+                continue
+            }
+            if bytesRead == 0 {
+                return true
+            }
+            if errno == EINTR {
+                continue
+            }
+            return !(errno == EAGAIN || errno == EWOULDBLOCK)
+        }
+    }
+
+    private func append(_ chunk: ArraySlice<UInt8>, to child: ChildProcess, isStdout: Bool) {
+        var kept = chunk
+        if let maxOutputBytes {
+            let stored = isStdout ? child.stdout.count : child.stderr.count
+            let room = max(0, maxOutputBytes - stored)
+            if chunk.count > room {
+                child.outputTruncated = true
+                kept = chunk.prefix(room)
+            }
+        }
+        guard !kept.isEmpty else {
+            return
+        }
+        if isStdout {
+            child.stdout.append(contentsOf: kept)
+        } else {
+            child.stderr.append(contentsOf: kept)
+        }
+    }
+
+    /// Beginner note: Collects the exit status once the child is gone; a no-op while it still runs.
+    private func reap(_ child: ChildProcess) {
+        guard child.exitStatus == nil else {
+            return
+        }
+        var status: Int32 = 0
+        var result = waitpid(child.pid, &status, WNOHANG)
+        while result < 0 && errno == EINTR {
+            result = waitpid(child.pid, &status, WNOHANG)
+        }
+        guard result != 0 else {
+            return
+        }
+        child.exitStatus = result == child.pid ? Self.terminationStatus(status) : -1
+        child.exitSource?.cancel()
+        child.exitSource = nil
+        if !child.finished {
+            finish(child)
+        }
+    }
+
+    /// Beginner note: Exit code for a normal exit, signal number for a signal (same as Process).
+    private static func terminationStatus(_ status: Int32) -> Int32 {
+        let signal = status & 0x7F
+        return signal == 0 ? (status >> 8) & 0xFF : signal
+    }
+
+    /// Beginner note: SIGTERM, then SIGKILL after a short grace, then give up waiting.
+    /// A child that survives SIGKILL (uninterruptible I/O) is reported as still running; its exit
+    /// source stays armed and reaps it whenever it finally exits.
+    private func handleTimeout(_ child: ChildProcess) {
+        child.timedOut = true
+        if let handle = beginTermination(
+            commandID: child.commandID,
+            fallback: ProcessHandle(pid: child.pid, processGroupID: child.pid)
+        ) {
+            sendTerminateSignal(to: handle)
+        }
+
+        eventQueue.asyncAfter(deadline: .now() + timeoutGracePeriod) { [weak self, weak child] in
+            guard let self, let child, !child.finished else {
+                return
+            }
+            // Still unreaped here, so the pid and group cannot have been reused.
+            self.sendKillSignal(to: ProcessHandle(pid: child.pid, processGroupID: child.pid))
+            self.eventQueue.asyncAfter(deadline: .now() + self.timeoutGracePeriod) { [weak self, weak child] in
+                guard let self, let child, !child.finished else {
+                    return
+                }
+                self.finish(child)
+            }
         }
     }
 
+    /// Beginner note: Takes whatever output is already buffered and returns the result.
+    /// It never waits for EOF: detached descendants may hold the pipes open indefinitely.
+    private func finish(_ child: ChildProcess) {
+        child.finished = true
+        for output in child.outputSources where !output.source.isCancelled {
+            drainOutput(fd: Int32(output.source.handle), into: child, isStdout: output.isStdout)
+            output.source.cancel()
+        }
+        child.outputSources.removeAll()
+        child.stdinSource?.cancel()
+        child.stdinSource = nil
+
+        let result = ProcessResult(
+            executable: child.executable,
+            arguments: child.arguments,
+            stdout: Self.decode(child.stdout, truncated: child.outputTruncated),
+            stderr: Self.decode(child.stderr, truncated: child.outputTruncated),
+            exitCode: child.exitStatus ?? -1,
+            timedOut: child.timedOut || child.exitStatus == nil,
+            duration: Date().timeIntervalSince(child.startedAt),
+            outputTruncated: child.outputTruncated
+        )
+        unregisterRunningProcess(commandID: child.commandID)
+        releaseSpawnSlot()
+        child.continuation.resume(returning: result)
+    }
+
+    /// Beginner note: Resumes the waiter now if a slot is free, otherwise when one is released.
+    /// An already cancelled caller is refused here, because its cancellation handler may have run
+    /// before it was queued.
+    private func acquireSpawnSlot(commandID: UUID, _ waiter: CheckedContinuation<Void, Error>) {
+        processRegistryLock.lock()
+        if Task.isCancelled {
+            processRegistryLock.unlock()
+            waiter.resume(throwing: CancellationError())
+            return
+        }
+        guard activeChildren < maxConcurrentChildren else {
+            spawnWaiters.append((commandID, waiter))
+            processRegistryLock.unlock()
+            return
+        }
+        activeChildren += 1
+        processRegistryLock.unlock()
+        waiter.resume()
+    }
+
+    /// Beginner note: Takes a cancelled caller out of the slot queue and fails its wait right away.
+    /// Returns false when it was not queued (it already holds a slot, or was never queued).
+    private func cancelSpawnWait(commandID: UUID) -> Bool {
+        processRegistryLock.lock()
+        guard let index = spawnWaiters.firstIndex(where: { $0.commandID == commandID }) else {
+            processRegistryLock.unlock()
+            return false
+        }
+        let waiter = spawnWaiters.remove(at: index)
+        processRegistryLock.unlock()
+        waiter.continuation.resume(throwing: CancellationError())
+        return true
+    }
+
+    /// Beginner note: Hands the slot straight to the oldest waiter, if any.
+    private func releaseSpawnSlot() {
+        processRegistryLock.lock()
+        guard !spawnWaiters.isEmpty else {
+            activeChildren -= 1
+            processRegistryLock.unlock()
+            return
+        }
+        let next = spawnWaiters.removeFirst()
+        processRegistryLock.unlock()
+        next.continuation.resume()
+    }
+
+    private static func decode(_ data: Data, truncated: Bool) -> String {
+        // A cap can cut a multi-byte character in half; keep the rest readable in that case.
+        truncated ? String(decoding: data, as: UTF8.self) : String(data: data, encoding: .utf8) ?? ""
+    }
+
     private func registerRunningProcess(commandID: UUID, pid: Int32, processGroupID: Int32?) {
         processRegistryLock.lock()
         runningPIDs[commandID] = ProcessHandle(pid: pid, processGroupID: processGroupID)
@@ -317,9 +551,8 @@ final class ProcessRunner: ProcessRunning, @unchecked Sendable {
         processRegistryLock.unlock()
 
         if cancelImmediately {
-            let handle = ProcessHandle(pid: pid, processGroupID: processGroupID)
-            terminationQueue.async { [weak self] in
-                self?.terminateProcess(handle)
+            eventQueue.async { [weak self] in
+                self?.terminateProcess(commandID: commandID)
             }
         }
     }
@@ -333,24 +566,19 @@ final class ProcessRunner: ProcessRunning, @unchecked Sendable {
     }
 
     private func cancelRunningProcess(commandID: UUID) {
-        let handleToTerminate: ProcessHandle?
+        let shouldTerminate: Bool
         processRegistryLock.lock()
-        if let processHandle = runningPIDs[commandID] {
-            if terminatingCommands.contains(commandID) {
-                handleToTerminate = nil
-            } else {
-                terminatingCommands.insert(commandID)
-                handleToTerminate = processHandle
-            }
+        if runningPIDs[commandID] != nil {
+            shouldTerminate = terminatingCommands.insert(commandID).inserted
         } else {
             pendingCancellations.insert(commandID)
-            handleToTerminate = nil
+            shouldTerminate = false
         }
         processRegistryLock.unlock()
 
-        if let handleToTerminate {
-            terminationQueue.async { [weak self] in
-                self?.terminateProcess(handleToTerminate)
+        if shouldTerminate {
+            eventQueue.async { [weak self] in
+                self?.terminateProcess(commandID: commandID)
             }
         }
     }
@@ -388,12 +616,25 @@ final class ProcessRunner: ProcessRunning, @unchecked Sendable {
         _ = kill(handle.pid, SIGKILL)
     }
 
-    private func terminateProcess(_ handle: ProcessHandle) {
+    private func registeredHandle(commandID: UUID) -> ProcessHandle? {
+        processRegistryLock.lock()
+        defer { processRegistryLock.unlock() }
+        return runningPIDs[commandID]
+    }
+
+    /// Beginner note: Runs on eventQueue, which is also where children are reaped, so a handle that
+    /// is still registered here cannot belong to a reused pid.
+    /// SIGKILL follows after a short grace period if the child has not exited by then.
+    private func terminateProcess(commandID: UUID) {
+        guard let handle = registeredHandle(commandID: commandID) else {
+            return
+        }
         sendTerminateSignal(to: handle)
-        // By design this is a short blocking grace period in a termination-only path.
-        // It gives child processes a chance to exit cleanly before escalating to SIGKILL.
-        // This runs on a dedicated queue so cancellation handlers never block cooperative threads.
-        usleep(250_000)
-        sendKillSignal(to: handle)
+        eventQueue.asyncAfter(deadline: .now() + cancellationGracePeriod) { [weak self] in
+            guard let self, let handle = self.registeredHandle(commandID: commandID) else {
+                return
+            }
+            self.sendKillSignal(to: handle)
+        }
     }
 }
@@ -33,11 +33,27 @@ final class RemoteDirectoryBrowserService {
         await manager.closeSession(sessionID)
     }
 
+    /// Beginner note: Forgets saved browser listings for a deleted or re-pointed remote.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func forgetCachedListings(remoteID: UUID) async {
+        await manager.forgetCachedListings(remoteID: remoteID)
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
-    func listDirectories(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot {
+    func listDirectories(
+        sessionID: RemoteBrowserSessionID,
+        path: String,
+        requestID: UInt64,
+        onPartial: RemoteBrowserPartialSnapshotHandler? = nil
+    ) async -> RemoteBrowserSnapshot {
         let normalized = BrowserPathNormalizer.normalize(path: path)
-        let snapshot = await manager.listDirectories(sessionID: sessionID, path: normalized, requestID: requestID)
+        let snapshot = await manager.listDirectories(
+            sessionID: sessionID,
+            path: normalized,
+            requestID: requestID,
+            onPartial: onPartial
+        )
         diagnostics.append(
             level: .debug,
             category: "remote-browser",
@@ -46,6 +62,39 @@ final class RemoteDirectoryBrowserService {
         return snapshot
     }
 
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func listDirectories(
+        sessionID: RemoteBrowserSessionID,
+        paths: [String],
+        requestID: UInt64
+    ) async -> [RemoteBrowserSnapshot] {
+        let normalized = paths.map { BrowserPathNormalizer.normalize(path: $0) }
+        let snapshots = await manager.listDirectories(sessionID: sessionID, paths: normalized, requestID: requestID)
+        diagnostics.append(
+            level: .debug,
+            category: "remote-browser",
+            message: "Batch snapshot requestID=\(requestID) session=\(sessionID.uuidString) paths=\(normalized.count) returned=\(snapshots.count) stale=\(snapshots.filter(\.isStale).count)"
+        )
+        return snapshots
+    }
+
+    /// Beginner note: Queues background listings of likely-next folders; returns without waiting for them.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func prefetchDirectories(sessionID: RemoteBrowserSessionID, paths: [String]) async {
+        await manager.prefetch(sessionID: sessionID, paths: paths.map { BrowserPathNormalizer.normalize(path: $0) })
+    }
+
+    /// Beginner note: Saved rows for a path, marked stale, or nil when nothing was saved.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func warmStartSnapshot(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot? {
+        await manager.warmStartSnapshot(
+            sessionID: sessionID,
+            path: BrowserPathNormalizer.normalize(path: path),
+            requestID: requestID
+        )
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     func goUp(sessionID: RemoteBrowserSessionID, currentPath: String, requestID: UInt64) async -> RemoteBrowserSnapshot {
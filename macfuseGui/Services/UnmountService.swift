@@ -28,6 +28,8 @@ final class UnmountService {
     private let runner: ProcessRunning
     private let diagnostics: DiagnosticsService
     private let mountStateParser: MountStateParser
+    // Shared in-process mount table; when nil (or a read fails) state checks spawn /bin/df and /sbin/mount.
+    private let mountSnapshots: MountTableSnapshotService?
     // Hard cap for a single unmount attempt. We intentionally keep this low so
     // disconnect/connect flows never "hang" for long periods.
     private let totalUnmountTimeout: TimeInterval
@@ -44,12 +46,14 @@ final class UnmountService {
         runner: ProcessRunning,
         diagnostics: DiagnosticsService,
         mountStateParser: MountStateParser,
+        mountSnapshots: MountTableSnapshotService? = nil,
         totalUnmountTimeout: TimeInterval = 10,
         perCommandMaxTimeout: TimeInterval = 3
     ) {
         self.runner = runner
         self.diagnostics = diagnostics
         self.mountStateParser = mountStateParser
+        self.mountSnapshots = mountSnapshots
         self.totalUnmountTimeout = totalUnmountTimeout
         self.perCommandMaxTimeout = perCommandMaxTimeout
     }
@@ -245,6 +249,7 @@ final class UnmountService {
                 arguments: command.args,
                 timeout: timeout
             )
+            mountSnapshots?.invalidate()
 
             let stderr = result.stderr.trimmingCharacters(in: .whitespacesAndNewlines)
             let stdout = result.stdout.trimmingCharacters(in: .whitespacesAndNewlines)
@@ -345,6 +350,7 @@ final class UnmountService {
                 timeout: 3
             )
         }
+        mountSnapshots?.invalidate()
 
         try? await Task.sleep(nanoseconds: 350_000_000)
     }
@@ -439,8 +445,7 @@ final class UnmountService {
             return nil
         }
 
-        let records = mountStateParser.parseMountOutput(result.stdout)
-        return mountStateParser.record(forMountPoint: mountPoint, from: records)
+        return mountStateParser.record(forMountPoint: mountPoint, inMountOutput: result.stdout)
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -469,8 +474,7 @@ final class UnmountService {
         )
 
         if result.exitCode == 0 {
-            let records = mountStateParser.parseMountOutput(result.stdout)
-            return mountStateParser.record(forMountPoint: mountPoint, from: records) != nil
+            return mountStateParser.record(forMountPoint: mountPoint, inMountOutput: result.stdout) != nil
         }
 
         // Conservative fallback: assume still mounted if we cannot confirm otherwise.
@@ -488,6 +492,23 @@ final class UnmountService {
     }
 
     private func currentMountRecordViaDF(for mountPoint: String, deadline: Date? = nil) async throws -> DFMountLookupResult {
+        // The kernel table answers both "mounted" and "not mounted" without spawning df or mount.
+        // Unmount verifies its own commands, so it always takes a fresh read.
+        if let mountSnapshots {
+            do {
+                let snapshot = try mountSnapshots.snapshot(maxAge: 0)
+                if let record = snapshot.record(forMountPoint: mountPoint) {
+                    return .mounted(record)
+                }
+                return .notMounted
+            } catch {
+                diagnostics.append(
+                    level: .warning,
+                    category: "unmount",
+                    message: "Native mount-table read failed backend=\(mountSnapshots.reader.backendName) path=\(mountPoint): \(error.localizedDescription); falling back to df."
+                )
+            }
+        }
         let timeout = try effectiveTimeout(
             base: dfFallbackTimeout,
             deadline: deadline,
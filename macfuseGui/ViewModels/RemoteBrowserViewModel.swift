@@ -70,9 +70,19 @@ final class RemoteBrowserViewModel: ObservableObject {
     private let onPathMemoryChanged: (([String], [String]) -> Void)?
     // Monotonic request ID prevents stale responses from clobbering newer navigation.
     private var latestRequestID: UInt64 = 0
+    // Rows already shown from streamed partial snapshots of the latest request.
+    private var latestPartialEntryCount = 0
     private var healthTask: Task<Void, Never>?
     private var degradedRefreshTask: Task<Void, Never>?
+    private var warmUpTask: Task<Void, Never>?
+    private var prefetchTask: Task<Void, Never>?
+    // In-flight navigation load; a newer navigation cancels it so the native call aborts early.
+    private var loadTask: Task<RemoteBrowserSnapshot, Never>?
     private var requestInFlight = false
+    // Upper bound for one background batch; the bridge multiplexes these over a few SFTP channels.
+    private static let warmUpPathLimit = 8
+    // Ranked child folders offered to the session per navigation; it lists only the top few.
+    private static let prefetchCandidateLimit = 8
 
     /// Beginner note: Initializers create valid state before any other method is used.
     init(
@@ -105,6 +115,9 @@ final class RemoteBrowserViewModel: ObservableObject {
     deinit {
         healthTask?.cancel()
         degradedRefreshTask?.cancel()
+        warmUpTask?.cancel()
+        prefetchTask?.cancel()
+        loadTask?.cancel()
     }
 
     var breadcrumbs: [RemotePathBreadcrumb] {
@@ -213,9 +226,11 @@ final class RemoteBrowserViewModel: ObservableObject {
     func loadInitial() async {
         // First load also starts background health polling + degraded auto-retry loop.
         viewState = .loadingFirstPage
+        await showWarmStartListing()
         await loadPath(currentPath, reason: "initial")
         startHealthLoop()
         startDegradedRefreshLoop()
+        startWarmUp()
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -259,7 +274,7 @@ final class RemoteBrowserViewModel: ObservableObject {
             requestID: requestID
         )
         apply(snapshot: snapshot, reason: "up")
-        requestInFlight = false
+        finishRequest(requestID)
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -300,10 +315,14 @@ final class RemoteBrowserViewModel: ObservableObject {
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     func closeSession() async {
+        loadTask?.cancel()
+        loadTask = nil
         healthTask?.cancel()
         healthTask = nil
         degradedRefreshTask?.cancel()
         degradedRefreshTask = nil
+        prefetchTask?.cancel()
+        prefetchTask = nil
         await remotesViewModel.stopBrowserSession(id: sessionID)
     }
 
@@ -314,7 +333,11 @@ final class RemoteBrowserViewModel: ObservableObject {
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
     private func loadPath(_ path: String, reason: String) async {
-        guard !requestInFlight else {
+        // A newer navigation supersedes an in-flight load instead of being dropped; cancelling the
+        // old task aborts its native listing so it stops holding the remote's executor.
+        if let loadTask {
+            loadTask.cancel()
+        } else if requestInFlight {
             return
         }
 
@@ -329,14 +352,106 @@ final class RemoteBrowserViewModel: ObservableObject {
         }
 
         requestInFlight = true
-        let snapshot = await remotesViewModel.loadBrowserPath(
+        latestPartialEntryCount = 0
+        let task = Task { @MainActor [remotesViewModel, sessionID] in
+            await remotesViewModel.loadBrowserPath(
+                sessionID: sessionID,
+                path: normalized,
+                requestID: requestID,
+                onPartial: { [weak self] partial in
+                    Task { @MainActor [weak self] in
+                        self?.applyPartial(snapshot: partial)
+                    }
+                }
+            )
+        }
+        loadTask = task
+        let snapshot = await task.value
+        // apply(...) enforces request-ordering and state transitions in one place.
+        apply(snapshot: snapshot, reason: reason)
+        if requestID == latestRequestID {
+            loadTask = nil
+        }
+        finishRequest(requestID)
+    }
+
+    /// Beginner note: Shows the saved listing for the start path (marked stale) before the session
+    /// has connected, so reopening the browser is not a blank "Connecting…" screen.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    private func showWarmStartListing() async {
+        guard entries.isEmpty, !requestInFlight else {
+            return
+        }
+
+        latestRequestID += 1
+        let requestID = latestRequestID
+        guard let snapshot = await remotesViewModel.warmStartBrowserPath(
             sessionID: sessionID,
-            path: normalized,
+            path: currentPath,
             requestID: requestID
+        ) else {
+            return
+        }
+        apply(snapshot: snapshot, reason: "warm-start")
+    }
+
+    /// Beginner note: Only the newest request clears the in-flight flag; a superseded one
+    /// finishing late must not unlock the UI while its replacement is still loading.
+    private func finishRequest(_ requestID: UInt64) {
+        if requestID == latestRequestID {
+            requestInFlight = false
+        }
+    }
+
+    /// Beginner note: After the first page, list breadcrumb ancestors and favorites in one batch
+    /// so going up or jumping to a favorite has cached rows to fall back on.
+    private func startWarmUp() {
+        guard viewState == .ready, warmUpTask == nil else {
+            return
+        }
+
+        let current = BrowserPathNormalizer.normalize(path: currentPath)
+        var paths: [String] = []
+        for candidate in breadcrumbs.map(\.fullPath).reversed() + favorites {
+            let normalized = BrowserPathNormalizer.normalize(path: candidate)
+            if normalized != current, !paths.contains(normalized) {
+                paths.append(normalized)
+            }
+        }
+        paths = Array(paths.prefix(Self.warmUpPathLimit))
+        guard !paths.isEmpty else {
+            return
+        }
+
+        // Request ID 0 never matches latestRequestID, so these snapshots can never reach apply(...).
+        warmUpTask = Task { @MainActor [weak self] in
+            guard let self else {
+                return
+            }
+            _ = await self.remotesViewModel.loadBrowserPaths(sessionID: self.sessionID, paths: paths, requestID: 0)
+        }
+    }
+
+    /// Beginner note: Offers the session the child folders the user is most likely to open next
+    /// (recents and favorites first, then the visible sort order) for background listing.
+    private func schedulePrefetch() {
+        let paths = BrowserPrefetchPlanner.candidates(
+            children: visibleEntries,
+            recents: recents,
+            favorites: favorites,
+            limit: Self.prefetchCandidateLimit
         )
-        // apply(...) enforces request-ordering and state transitions in one place.
-        apply(snapshot: snapshot, reason: reason)
-        requestInFlight = false
+        guard !paths.isEmpty else {
+            return
+        }
+
+        prefetchTask?.cancel()
+        prefetchTask = Task { @MainActor [weak self] in
+            guard let self else {
+                return
+            }
+            await self.remotesViewModel.prefetchBrowserPaths(sessionID: self.sessionID, paths: paths)
+        }
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -355,7 +470,22 @@ final class RemoteBrowserViewModel: ObservableObject {
             requestID: requestID
         )
         apply(snapshot: snapshot, reason: reason)
-        requestInFlight = false
+        finishRequest(requestID)
+    }
+
+    /// Beginner note: Partial snapshots only add rows for the in-flight request.
+    /// Health, banners and recents are left to the final snapshot in apply(...).
+    private func applyPartial(snapshot: RemoteBrowserSnapshot) {
+        guard requestInFlight,
+              snapshot.isPartial,
+              snapshot.requestID == latestRequestID,
+              snapshot.entries.count > latestPartialEntryCount else {
+            return
+        }
+
+        latestPartialEntryCount = snapshot.entries.count
+        currentPath = BrowserPathNormalizer.normalize(path: snapshot.path)
+        entries = snapshot.entries
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -395,6 +525,7 @@ final class RemoteBrowserViewModel: ObservableObject {
             viewState = .ready
             // Browsed paths become recents only on healthy ready state.
             addRecentPath(currentPath)
+            schedulePrefetch()
         }
 
         if reason == "open" || reason == "navigate" || reason == "root" || reason == "up" {
@@ -238,6 +238,11 @@ final class RemotesViewModel: ObservableObject {
     private var networkRestoreDebounceTask: Task<Void, Never>?
     private var networkLossCleanupTask: Task<Void, Never>?
     private var recoveryMonitoringStarted = false
+    // Kernel mount-table notifications; while active, healthy periodic probes are only a safety net.
+    private let mountChangeWatcher: MountChangeWatching?
+    private var mountChangeWatcherActive = false
+    private var pendingMountChange: MountChangeEvent?
+    private var mountChangeDebounceTask: Task<Void, Never>?
     private var shutdownInProgress = false
     private var recoveryIndicatorReason: String?
     // Watchdogs make sure UI never sits in connecting/disconnecting forever.
@@ -247,6 +252,8 @@ final class RemotesViewModel: ObservableObject {
     // When everything looks healthy, periodic probes are intentionally less frequent.
     private let healthyPeriodicProbeInterval: TimeInterval
     private let periodicRecoveryPassInterval: TimeInterval
+    private let watchedHealthyPeriodicProbeInterval: TimeInterval
+    private let mountChangeDebounceSeconds: TimeInterval
     private let networkRestoredDebounceSeconds: TimeInterval = 1.5
     private let networkLossCleanupDebounceSeconds: TimeInterval = 0.5
     private var operationWatchdogTasks: [UUID: Task<Void, Never>] = [:]
@@ -275,6 +282,7 @@ final class RemotesViewModel: ObservableObject {
         remoteDirectoryBrowserService: RemoteDirectoryBrowserService,
         diagnostics: DiagnosticsService,
         launchAtLoginService: LaunchAtLoginService,
+        mountChangeWatcher: MountChangeWatching? = nil,
         runtimeConfiguration: RuntimeConfiguration = RuntimeConfiguration()
     ) {
         self.remoteStore = remoteStore
@@ -286,6 +294,7 @@ final class RemotesViewModel: ObservableObject {
         self.remoteDirectoryBrowserService = remoteDirectoryBrowserService
         self.diagnostics = diagnostics
         self.launchAtLoginService = launchAtLoginService
+        self.mountChangeWatcher = mountChangeWatcher
         self.connectWatchdogTimeout = runtimeConfiguration.remotes.connectWatchdogTimeout
         self.disconnectWatchdogTimeout = runtimeConfiguration.remotes.disconnectWatchdogTimeout
         self.refreshWatchdogTimeout = runtimeConfiguration.remotes.refreshWatchdogTimeout
@@ -293,12 +302,17 @@ final class RemotesViewModel: ObservableObject {
         // Keep queue identity deterministic in logs/tests and configurable via runtime configuration.
         self.networkMonitorQueue = DispatchQueue(label: runtimeConfiguration.remotes.networkMonitorQueueLabel)
         self.periodicRecoveryPassInterval = runtimeConfiguration.remotes.periodicRecoveryPassInterval
+        self.watchedHealthyPeriodicProbeInterval = runtimeConfiguration.remotes.watchedHealthyPeriodicProbeInterval
+        self.mountChangeDebounceSeconds = runtimeConfiguration.remotes.mountChangeDebounceInterval
     }
 
     /// Beginner note: Deinitializer runs during teardown to stop background work and free resources.
     deinit {
         recoveryTimer?.invalidate()
         recoveryTimer = nil
+        mountChangeWatcher?.stop()
+        mountChangeDebounceTask?.cancel()
+        mountChangeDebounceTask = nil
 
         networkMonitor?.cancel()
         networkMonitor = nil
@@ -581,6 +595,15 @@ final class RemotesViewModel: ObservableObject {
                 throw error
             }
 
+            if let previousRemote,
+               BrowserListingCacheKey(remote: previousRemote) != BrowserListingCacheKey(remote: remote) {
+                // Same remote ID now points at another server/account; its saved listings no longer apply.
+                let browserService = remoteDirectoryBrowserService
+                Task {
+                    await browserService.forgetCachedListings(remoteID: remote.id)
+                }
+            }
+
             // Reload to keep list sorting and selection logic centralized in one path.
             load()
             diagnostics.append(level: .info, category: "store", message: "Saved remote \(remote.displayName)")
@@ -781,6 +804,8 @@ final class RemotesViewModel: ObservableObject {
                     )
                 }
                 cachePassword(nil, for: remoteID)
+                // Saved browser listings would otherwise outlive the remote on disk.
+                await remoteDirectoryBrowserService.forgetCachedListings(remoteID: remoteID)
                 remotes.removeAll { $0.id == remoteID }
                 removeStatus(for: remoteID)
                 if selectedRemoteID == remoteID {
@@ -1613,6 +1638,7 @@ final class RemotesViewModel: ObservableObject {
 
         registerWorkspaceObservers()
         startNetworkMonitor()
+        startMountChangeWatcher()
         startRecoveryTimer()
 
         diagnostics.append(level: .info, category: "recovery", message: "Connection recovery monitoring started.")
@@ -1665,6 +1691,8 @@ final class RemotesViewModel: ObservableObject {
 
         let monitor = NWPathMonitor()
         monitor.pathUpdateHandler = { [weak self] path in
+            // Any path change (including Wi-Fi to Ethernet while staying reachable) can change DNS answers.
+            LibSSH2SFTPTransport.flushResolverCache()
             Task { @MainActor [weak self] in
                 self?.handleNetworkStatusChange(isReachable: path.status == .satisfied)
             }
@@ -1673,6 +1701,118 @@ final class RemotesViewModel: ObservableObject {
         networkMonitor = monitor
     }
 
+    /// Beginner note: Subscribes to kernel mount-table changes. If the backend cannot start,
+    /// status keeps relying on the regular periodic probes.
+    private func startMountChangeWatcher() {
+        guard let mountChangeWatcher, !mountChangeWatcherActive else {
+            return
+        }
+
+        do {
+            try mountChangeWatcher.start { [weak self] event in
+                Task { @MainActor [weak self] in
+                    self?.handleMountChange(event)
+                }
+            }
+            mountChangeWatcherActive = true
+            diagnostics.append(
+                level: .info,
+                category: "recovery",
+                message: "Mount change watcher started backend=\(mountChangeWatcher.backendName). Healthy probe safety net every \(Int(effectiveHealthyPeriodicProbeInterval))s."
+            )
+        } catch {
+            diagnostics.append(
+                level: .warning,
+                category: "recovery",
+                message: "Mount change watcher unavailable backend=\(mountChangeWatcher.backendName): \(error.localizedDescription). Using periodic probes."
+            )
+        }
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func stopMountChangeWatcher() {
+        mountChangeWatcher?.stop()
+        mountChangeWatcherActive = false
+        mountChangeDebounceTask?.cancel()
+        mountChangeDebounceTask = nil
+        pendingMountChange = nil
+    }
+
+    /// Beginner note: Coalesces bursts (one mount usually raises several kernel events) into one
+    /// mount-table comparison after a short debounce.
+    private func handleMountChange(_ event: MountChangeEvent) {
+        guard !shutdownInProgress, mountChangeWatcherActive else {
+            return
+        }
+        if pendingMountChange == nil {
+            pendingMountChange = event
+        } else {
+            pendingMountChange?.merge(event)
+        }
+        guard mountChangeDebounceTask == nil else {
+            return
+        }
+
+        let debounceNanos = UInt64(max(0, mountChangeDebounceSeconds) * 1_000_000_000)
+        mountChangeDebounceTask = Task { @MainActor [weak self] in
+            try? await Task.sleep(nanoseconds: debounceNanos)
+            guard let self, !Task.isCancelled else {
+                return
+            }
+            self.mountChangeDebounceTask = nil
+            await self.processPendingMountChange()
+        }
+    }
+
+    /// Beginner note: Asks MountManager which remotes the change affects and refreshes only those.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    private func processPendingMountChange() async {
+        guard let event = pendingMountChange else {
+            return
+        }
+        pendingMountChange = nil
+        // Sleep/wake has its own staged recovery; the wake pass re-reads everything anyway.
+        guard !shutdownInProgress, !systemSleeping, !wakePreflightInProgress else {
+            return
+        }
+
+        let flagged = await mountManager.mountTableDidChange(event, remotes: remotes)
+        guard !flagged.isEmpty else {
+            return
+        }
+
+        let desiredIDs = Set(flagged.filter { desiredConnections.contains($0) })
+        let otherIDs = flagged.filter { !desiredConnections.contains($0) }
+        diagnostics.append(
+            level: .debug,
+            category: "recovery",
+            message: "Mount change (\(event.flags.label)) flagged \(flagged.count) remote(s); desired=\(desiredIDs.count)."
+        )
+
+        if !desiredIDs.isEmpty {
+            await performRecoveryPass(trigger: "mount-change", onlyRemoteIDs: desiredIDs)
+        }
+        for remoteID in otherIDs {
+            await runOperation(
+                remoteID: remoteID,
+                intent: .refresh,
+                trigger: .recovery,
+                conflictPolicy: .skipIfBusy,
+                timeout: refreshWatchdogTimeout
+            ) { [weak self] operationID in
+                await self?.performRefreshStatus(remoteID: remoteID, operationID: operationID)
+            }
+        }
+    }
+
+    /// Beginner note: Healthy-remote probe spacing. Kernel change events cover mounts coming and
+    /// going, so with the watcher running the periodic probe only backs up what events cannot see.
+    private var effectiveHealthyPeriodicProbeInterval: TimeInterval {
+        mountChangeWatcherActive
+            ? max(healthyPeriodicProbeInterval, watchedHealthyPeriodicProbeInterval)
+            : healthyPeriodicProbeInterval
+    }
+
     /// Beginner note: This method is one step in the feature workflow for this file.
     private func startRecoveryTimer() {
         guard recoveryTimer == nil else {
@@ -2036,7 +2176,7 @@ final class RemotesViewModel: ObservableObject {
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
-    private func performRecoveryPass(trigger: String) async {
+    private func performRecoveryPass(trigger: String, onlyRemoteIDs: Set<UUID>? = nil) async {
         refreshRecoveryIndicator()
         guard !systemSleeping else {
             if Date().timeIntervalSince(lastSleepSkipLogAt) >= 60 {
@@ -2089,7 +2229,9 @@ final class RemotesViewModel: ObservableObject {
             return
         }
 
-        let targetRemotes = remotes.filter { desiredConnections.contains($0.id) }
+        let targetRemotes = remotes.filter {
+            desiredConnections.contains($0.id) && (onlyRemoteIDs?.contains($0.id) ?? true)
+        }
         guard !targetRemotes.isEmpty else {
             return
         }
@@ -2202,7 +2344,7 @@ final class RemotesViewModel: ObservableObject {
             return false
         }
 
-        return Date().timeIntervalSince(lastPeriodicRecoveryProbeAt) < healthyPeriodicProbeInterval
+        return Date().timeIntervalSince(lastPeriodicRecoveryProbeAt) < effectiveHealthyPeriodicProbeInterval
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -2221,7 +2363,7 @@ final class RemotesViewModel: ObservableObject {
         }
 
         let lastRefreshAt = lastRecoveryRefreshAt[remoteID] ?? .distantPast
-        return Date().timeIntervalSince(lastRefreshAt) >= healthyPeriodicProbeInterval
+        return Date().timeIntervalSince(lastRefreshAt) >= effectiveHealthyPeriodicProbeInterval
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -3157,8 +3299,40 @@ final class RemotesViewModel: ObservableObject {
 
     /// Beginner note: This method is one step in the feature workflow for this file.
     /// This is async: it can suspend and resume later without blocking a thread.
-    func loadBrowserPath(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot {
-        await remoteDirectoryBrowserService.listDirectories(sessionID: sessionID, path: path, requestID: requestID)
+    func loadBrowserPath(
+        sessionID: RemoteBrowserSessionID,
+        path: String,
+        requestID: UInt64,
+        onPartial: RemoteBrowserPartialSnapshotHandler? = nil
+    ) async -> RemoteBrowserSnapshot {
+        await remoteDirectoryBrowserService.listDirectories(
+            sessionID: sessionID,
+            path: path,
+            requestID: requestID,
+            onPartial: onPartial
+        )
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func loadBrowserPaths(
+        sessionID: RemoteBrowserSessionID,
+        paths: [String],
+        requestID: UInt64
+    ) async -> [RemoteBrowserSnapshot] {
+        await remoteDirectoryBrowserService.listDirectories(sessionID: sessionID, paths: paths, requestID: requestID)
+    }
+
+    /// Beginner note: Hands likely-next folders to the session for low-priority background listing.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func prefetchBrowserPaths(sessionID: RemoteBrowserSessionID, paths: [String]) async {
+        await remoteDirectoryBrowserService.prefetchDirectories(sessionID: sessionID, paths: paths)
+    }
+
+    /// Beginner note: Saved rows shown instantly while the browser session connects.
+    /// This is async: it can suspend and resume later without blocking a thread.
+    func warmStartBrowserPath(sessionID: RemoteBrowserSessionID, path: String, requestID: UInt64) async -> RemoteBrowserSnapshot? {
+        await remoteDirectoryBrowserService.warmStartSnapshot(sessionID: sessionID, path: path, requestID: requestID)
     }
 
     /// Beginner note: This method is one step in the feature workflow for this file.
@@ -3375,6 +3549,7 @@ final class RemotesViewModel: ObservableObject {
 
         recoveryTimer?.invalidate()
         recoveryTimer = nil
+        stopMountChangeWatcher()
 
         recoveryBurstTask?.cancel()
         recoveryBurstTask = nil
@@ -0,0 +1,130 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserDirectoryCache directly and through LibSSH2SessionActor.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserDirectoryCacheTests: XCTestCase {
+    /// Beginner note: Over budget, the least recently used listing goes first; reads refresh recency.
+    func testEvictsLeastRecentlyUsedListingWhenOverBudget() {
+        let listing = Self.items(base: "/srv/project-with-a-long-name", count: 20)
+        let listingBytes = BrowserDirectoryCache.estimatedBytes(path: "/srv/a", entries: listing)
+        var cache = BrowserDirectoryCache(byteBudget: listingBytes * 3)
+
+        cache["/srv/a"] = listing
+        cache["/srv/b"] = listing
+        cache["/srv/c"] = listing
+        XCTAssertNotNil(cache["/srv/a"])
+        cache["/srv/d"] = listing
+
+        XCTAssertTrue(cache.contains("/srv/a"))
+        XCTAssertFalse(cache.contains("/srv/b"))
+        XCTAssertTrue(cache.contains("/srv/c"))
+        XCTAssertTrue(cache.contains("/srv/d"))
+        XCTAssertEqual(cache.metrics.evictions, 1)
+        XCTAssertEqual(cache.metrics.evictedBytes, listingBytes)
+        XCTAssertLessThanOrEqual(cache.metrics.totalBytes, cache.byteBudget)
+
+        cache["/srv/c"] = nil
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertEqual(cache.metrics.totalBytes, listingBytes * 2)
+        XCTAssertNil(cache["/missing"])
+        XCTAssertEqual(cache.metrics.misses, 1)
+    }
+
+    /// Beginner note: A single listing larger than the budget is still kept so fallbacks have something to show.
+    func testNewestListingSurvivesEvenWhenLargerThanBudget() {
+        var cache = BrowserDirectoryCache(byteBudget: 64)
+        cache["/srv/a"] = Self.items(base: "/srv/a", count: 5)
+        cache["/srv/b"] = Self.items(base: "/srv/b", count: 5)
+
+        XCTAssertFalse(cache.contains("/srv/a"))
+        XCTAssertEqual(cache["/srv/b"]?.count, 5)
+        XCTAssertEqual(cache.count, 1)
+    }
+
+    /// Beginner note: Evicted paths still fall back to the last successful listing, as before.
+    func testSessionFallbackSurvivesEviction() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv/a"] = Self.items(base: "/srv/a", count: 10)
+        transport.listings["/srv/b"] = Self.items(base: "/srv/b", count: 10)
+        let session = makeSession(transport: transport, cacheByteBudget: 1)
+
+        _ = await session.list(path: "/srv/a", requestID: 1)
+        _ = await session.list(path: "/srv/b", requestID: 2)
+        transport.listings["/srv/b"] = nil
+        let fallback = await session.list(path: "/srv/b", requestID: 3)
+        let metrics = await session.cacheMetrics()
+        let summary = await session.summaryLine()
+        await session.close()
+
+        XCTAssertTrue(fallback.fromCache)
+        XCTAssertEqual(fallback.entries.count, 10)
+        XCTAssertEqual(metrics.entryCount, 1)
+        XCTAssertEqual(metrics.evictions, 1)
+        XCTAssertTrue(summary.contains("cache=1dirs/"), summary)
+    }
+
+    /// Beginner note: Benchmark: memory footprint after browsing 10k directories stays within the budget.
+    func testBenchmarkCacheFootprintAfterBrowsingTenThousandDirectories() {
+        let budget = 4 * 1024 * 1024
+        let listing = Self.items(base: "/home/dev/projects/service", count: 40)
+        let unboundedBytes = (0..<10_000).reduce(0) { total, index in
+            total + BrowserDirectoryCache.estimatedBytes(path: "/home/dev/projects/service/\(index)", entries: listing)
+        }
+        var finalMetrics = BrowserDirectoryCache.Metrics()
+
+        measure {
+            var cache = BrowserDirectoryCache(byteBudget: budget)
+            for index in 0..<10_000 {
+                let path = "/home/dev/projects/service/\(index)"
+                cache[path] = listing
+                // Revisit a parent now and then, like a user walking back up the tree.
+                if index % 10 == 0 {
+                    _ = cache["/home/dev/projects/service/\(index / 2)"]
+                }
+            }
+            finalMetrics = cache.metrics
+        }
+
+        XCTAssertLessThanOrEqual(finalMetrics.totalBytes, budget)
+        XCTAssertGreaterThan(finalMetrics.evictions, 0)
+        XCTAssertLessThan(finalMetrics.totalBytes, unboundedBytes)
+        XCTAssertEqual(finalMetrics.entryCount + finalMetrics.evictions, 10_000)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func makeSession(transport: ScriptedBrowserTransport, cacheByteBudget: Int) -> LibSSH2SessionActor {
+        LibSSH2SessionActor(
+            id: UUID(),
+            remote: RemoteConfig(
+                displayName: "Test",
+                host: "example.invalid",
+                username: "dev",
+                authMode: .privateKey,
+                privateKeyPath: "/tmp/id_test",
+                remoteDirectory: "/srv",
+                localMountPoint: "/tmp/mnt-test"
+            ),
+            password: nil,
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            requestRetrySchedule: [],
+            recoveryRetrySchedule: [],
+            keepAliveIntervalNanoseconds: 60_000_000_000,
+            cacheByteBudget: cacheByteBudget
+        )
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func items(base: String, count: Int) -> [RemoteDirectoryItem] {
+        LibSSH2SessionActorTests.items(base: base, names: (0..<count).map { "folder-\($0)" })
+    }
+}
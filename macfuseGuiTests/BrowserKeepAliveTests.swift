@@ -0,0 +1,113 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserKeepAliveTracker directly and LibSSH2SessionActor keepalive through a scripted transport.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserKeepAliveTests: XCTestCase {
+    /// Beginner note: Only consecutive unanswered SSH keepalives demote; an answer resets the streak.
+    func testTrackerDemotesAfterConsecutiveUnansweredKeepAlives() {
+        var tracker = BrowserKeepAliveTracker(demoteAfterProbes: 2)
+        let answered = BrowserKeepAliveResult(modeUsed: .sshProtocol, sftpProbed: false, replySeen: true, latencyMs: 10)
+        let unanswered = BrowserKeepAliveResult(modeUsed: .sshProtocol, sftpProbed: true, replySeen: false, latencyMs: 40)
+
+        XCTAssertFalse(tracker.recordSuccess(unanswered))
+        XCTAssertFalse(tracker.recordSuccess(answered))
+        XCTAssertFalse(tracker.recordSuccess(unanswered))
+        tracker.recordFailure(mode: .sshProtocol)
+        XCTAssertEqual(tracker.mode, .sshProtocol)
+        XCTAssertTrue(tracker.recordSuccess(unanswered))
+        XCTAssertEqual(tracker.mode, .sftpStat)
+
+        let ssh = tracker.stats[.sshProtocol]
+        XCTAssertEqual(ssh?.attempts, 5)
+        XCTAssertEqual(ssh?.replies, 1)
+        XCTAssertEqual(ssh?.sftpProbes, 3)
+        XCTAssertEqual(ssh?.failures, 1)
+        XCTAssertEqual(ssh?.averageLatencyMs, 32)
+        XCTAssertEqual(tracker.summary, "stat,ssh:n5/reply1/probe3/fail1/avg32ms")
+    }
+
+    /// Beginner note: A server that ignores SSH keepalives moves to stat pings, and the next
+    /// session for the same server starts there.
+    func testSessionLearnsStatModeForServerIgnoringSSHKeepAlives() async {
+        let transport = ScriptedBrowserTransport()
+        transport.answersSSHKeepAlive = false
+        let memory = BrowserKeepAliveModeMemory()
+        let session = makeSession(transport: transport, memory: memory)
+
+        let learned = await waitForTracker(session) { $0.mode == .sftpStat && ($0.stats[.sftpStat]?.attempts ?? 0) >= 1 }
+        let summary = await session.summaryLine()
+        await session.close()
+
+        XCTAssertEqual(Array(transport.keepAliveModes.prefix(4)), [.sshProtocol, .sshProtocol, .sshProtocol, .sftpStat])
+        XCTAssertEqual(learned.stats[.sshProtocol]?.sftpProbes, 3)
+        XCTAssertEqual(memory.mode(for: Self.remote), .sftpStat)
+        XCTAssertTrue(summary.contains("keepalive=stat,ssh:n3/reply0/probe3"), summary)
+
+        let next = makeSession(transport: ScriptedBrowserTransport(), memory: memory)
+        let initial = await next.keepAliveStatistics()
+        await next.close()
+        XCTAssertEqual(initial.mode, .sftpStat)
+    }
+
+    /// Beginner note: A server that answers keeps SSH keepalives and never costs a stat.
+    func testAnsweringServerStaysOnSSHKeepAlives() async {
+        let transport = ScriptedBrowserTransport()
+        let session = makeSession(transport: transport, memory: BrowserKeepAliveModeMemory())
+
+        let tracker = await waitForTracker(session) { ($0.stats[.sshProtocol]?.attempts ?? 0) >= 4 }
+        await session.close()
+
+        XCTAssertEqual(tracker.mode, .sshProtocol)
+        XCTAssertEqual(tracker.stats[.sshProtocol]?.sftpProbes, 0)
+        XCTAssertEqual(transport.pingCallCount, 0)
+    }
+
+    /// Beginner note: Polls until the keepalive tracker satisfies the condition or two seconds pass.
+    private func waitForTracker(
+        _ session: LibSSH2SessionActor,
+        until condition: (BrowserKeepAliveTracker) -> Bool
+    ) async -> BrowserKeepAliveTracker {
+        for _ in 0..<200 {
+            let tracker = await session.keepAliveStatistics()
+            if condition(tracker) {
+                return tracker
+            }
+            try? await Task.sleep(nanoseconds: 10_000_000)
+        }
+        return await session.keepAliveStatistics()
+    }
+
+    private static let remote = RemoteConfig(
+        displayName: "Test",
+        host: "example.invalid",
+        username: "dev",
+        authMode: .privateKey,
+        privateKeyPath: "/tmp/id_test",
+        remoteDirectory: "/srv",
+        localMountPoint: "/tmp/mnt-test"
+    )
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func makeSession(transport: ScriptedBrowserTransport, memory: BrowserKeepAliveModeMemory) -> LibSSH2SessionActor {
+        LibSSH2SessionActor(
+            id: UUID(),
+            remote: Self.remote,
+            password: nil,
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            requestRetrySchedule: [],
+            recoveryRetrySchedule: [],
+            keepAliveIntervalNanoseconds: 10_000_000,
+            keepAliveModeMemory: memory
+        )
+    }
+}
@@ -0,0 +1,277 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserListingDiskCache against a temporary directory and LibSSH2SessionActor warm starts.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserListingDiskCacheTests: XCTestCase {
+    private var directoryURL: URL!
+
+    override func setUpWithError() throws {
+        directoryURL = FileManager.default.temporaryDirectory
+            .appendingPathComponent("BrowserListingDiskCacheTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directoryURL)
+    }
+
+    /// Beginner note: Listings written by one instance load in the next, including "~" aliases and validators.
+    func testListingsSurviveReloadWithAliases() {
+        let key = Self.key()
+        let listedAt = Date(timeIntervalSince1970: 1_700_000_000)
+        let entries = [
+            RemoteDirectoryItem(name: "src", fullPath: "/home/dev/src", isDirectory: true, modifiedAt: listedAt, sizeBytes: 4096),
+            RemoteDirectoryItem(name: "docs", fullPath: "/srv/shared/docs", isDirectory: true, modifiedAt: nil, sizeBytes: nil)
+        ]
+        let validator = BrowserDirectoryValidator(modifiedAtUnix: 1_699_999_000, sizeBytes: nil, capturedAtUnix: 1_700_000_000)
+        let writer = makeCache()
+        writer.store(key: key, path: "/home/dev", requestedPath: "~", entries: entries, listedAt: listedAt, validator: validator)
+        writer.store(key: key, path: "/tmp", entries: [], listedAt: listedAt)
+        writer.flushAndWait()
+
+        let reader = makeCache()
+        let canonical = reader.listing(key: key, path: "/home/dev/")
+        let aliased = reader.listing(key: key, path: "~")
+
+        XCTAssertEqual(canonical, BrowserCachedListing(path: "/home/dev", entries: entries, listedAt: listedAt, validator: validator))
+        XCTAssertNil(reader.listing(key: key, path: "/tmp")?.validator)
+        XCTAssertEqual(aliased?.path, "/home/dev")
+        XCTAssertNil(reader.listing(key: Self.key(), path: "/home/dev"))
+    }
+
+    /// Beginner note: A flipped byte drops only the damaged listing; a bad header loads as empty.
+    func testCorruptRecordsAreDroppedWithoutLosingOthers() throws {
+        let key = Self.key()
+        let writer = makeCache()
+        writer.store(key: key, path: "/a", entries: Self.items(base: "/a", count: 3), listedAt: Date(timeIntervalSince1970: 2))
+        writer.store(key: key, path: "/b", entries: Self.items(base: "/b", count: 3), listedAt: Date(timeIntervalSince1970: 1))
+        writer.flushAndWait()
+
+        let url = writer.fileURL(key: key)
+        let original = [UInt8](try Data(contentsOf: url))
+        var bytes = original
+        // Newest listing ("/a") is written first; corrupt the last byte of its first entry name.
+        let nameRange = try XCTUnwrap(Self.range(of: Array("folder-0".utf8), in: bytes))
+        bytes[nameRange.upperBound - 1] ^= 0xFF
+        try Data(bytes).write(to: url)
+
+        let reader = makeCache()
+        XCTAssertNil(reader.listing(key: key, path: "/a"))
+        XCTAssertEqual(reader.listing(key: key, path: "/b")?.entries.count, 3)
+
+        // Torn write in the last record: earlier records are still readable.
+        try Data(original.prefix(original.count - 5)).write(to: url)
+        let truncated = makeCache()
+        XCTAssertEqual(truncated.listing(key: key, path: "/a")?.entries.count, 3)
+        XCTAssertNil(truncated.listing(key: key, path: "/b"))
+
+        try Data("not a cache file".utf8).write(to: url)
+        XCTAssertNil(makeCache().listing(key: key, path: "/a"))
+    }
+
+    /// Beginner note: The byte limit keeps the most recently listed directories.
+    func testByteLimitKeepsNewestListings() throws {
+        let key = Self.key()
+        let listing = Self.items(base: "/p", count: 50)
+        let frameBytes = BrowserListingDiskCache.encodeListing(
+            BrowserCachedListing(path: "/p/0", entries: listing, listedAt: Date())
+        ).count
+        let writer = makeCache(byteLimit: 12 + frameBytes * 3)
+        for index in 0..<10 {
+            writer.store(
+                key: key,
+                path: "/p/\(index)",
+                entries: Self.items(base: "/p/\(index)", count: 50),
+                listedAt: Date(timeIntervalSince1970: TimeInterval(index))
+            )
+        }
+        writer.flushAndWait()
+
+        let size = try XCTUnwrap(try FileManager.default.attributesOfItem(atPath: writer.fileURL(key: key).path)[.size] as? Int)
+        XCTAssertLessThanOrEqual(size, writer.byteLimit)
+        let reader = makeCache()
+        let kept = (0..<10).filter { reader.listing(key: key, path: "/p/\($0)") != nil }
+        XCTAssertEqual(kept, [7, 8, 9])
+    }
+
+    /// Beginner note: Memory is held to the same byte limit as the file, least recently used first:
+    /// a listing read since it was stored survives, and an alias to an evicted listing goes with it.
+    func testInMemoryListingsStayWithinByteLimitByRecentUse() {
+        let key = Self.key()
+        let frameBytes = BrowserListingDiskCache.encodeListing(
+            BrowserCachedListing(path: "/p/0", entries: Self.items(base: "/p/0", count: 50), listedAt: Date())
+        ).count
+        let cache = makeCache(byteLimit: 12 + frameBytes * 3 + 64)
+        for index in 0..<3 {
+            cache.store(
+                key: key,
+                path: "/p/\(index)",
+                requestedPath: "~\(index)",
+                entries: Self.items(base: "/p/\(index)", count: 50),
+                listedAt: Date(timeIntervalSince1970: TimeInterval(index))
+            )
+        }
+        XCTAssertNotNil(cache.listing(key: key, path: "/p/0"))
+
+        for index in 3..<5 {
+            cache.store(
+                key: key,
+                path: "/p/\(index)",
+                entries: Self.items(base: "/p/\(index)", count: 50),
+                listedAt: Date(timeIntervalSince1970: TimeInterval(index))
+            )
+        }
+
+        let kept = (0..<5).filter { cache.listing(key: key, path: "/p/\($0)") != nil }
+        XCTAssertEqual(kept, [0, 3, 4], "the read listing must outlive older-used ones")
+        XCTAssertEqual(cache.listing(key: key, path: "~0")?.path, "/p/0")
+        XCTAssertNil(cache.listing(key: key, path: "~1"), "an alias must not outlive its listing")
+        XCTAssertNil(cache.listing(key: key, path: "~2"))
+    }
+
+    /// Beginner note: A new session renders the saved listing as stale without calling the transport.
+    func testSessionWarmStartServesSavedListingBeforeConnecting() async {
+        let remote = Self.remote()
+        let store = makeCache()
+        store.store(key: BrowserListingCacheKey(remote: remote), path: "/srv", entries: Self.items(base: "/srv", count: 4))
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", count: 5)
+        let session = LibSSH2SessionActor(
+            id: UUID(),
+            remote: remote,
+            password: nil,
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            requestRetrySchedule: [],
+            recoveryRetrySchedule: [],
+            keepAliveIntervalNanoseconds: 60_000_000_000,
+            listingStore: store
+        )
+
+        let warm = await session.warmStartSnapshot(path: "/srv/", requestID: 1)
+        XCTAssertEqual(transport.listCallCount, 0)
+        XCTAssertEqual(warm?.entries.count, 4)
+        XCTAssertEqual(warm?.isStale, true)
+        XCTAssertEqual(warm?.fromCache, true)
+        let missing = await session.warmStartSnapshot(path: "/elsewhere", requestID: 2)
+        XCTAssertNil(missing)
+
+        let fresh = await session.list(path: "/srv", requestID: 3)
+        await session.close()
+
+        XCTAssertFalse(fresh.isStale)
+        XCTAssertEqual(fresh.entries.count, 5)
+        XCTAssertEqual(store.listing(key: BrowserListingCacheKey(remote: remote), path: "/srv")?.entries.count, 5)
+    }
+
+    /// Beginner note: Editing a remote's host, port or user must not serve the old server's rows,
+    /// and removeAll must purge every file the remote ever wrote.
+    func testEndpointChangeMissesOldListingsAndRemoveAllPurgesFiles() throws {
+        let remoteID = UUID()
+        let original = BrowserListingCacheKey(remoteID: remoteID, host: "Old.Example", port: 22, username: "dev")
+        let sameEndpoint = BrowserListingCacheKey(remoteID: remoteID, host: "old.example ", port: 22, username: "dev")
+        let edited = BrowserListingCacheKey(remoteID: remoteID, host: "new.example", port: 22, username: "dev")
+        let otherPort = BrowserListingCacheKey(remoteID: remoteID, host: "old.example", port: 2222, username: "dev")
+        let otherRemote = Self.key()
+        let writer = makeCache()
+        writer.store(key: original, path: "/srv", entries: Self.items(base: "/srv", count: 2))
+        writer.store(key: edited, path: "/srv", entries: Self.items(base: "/srv", count: 5))
+        writer.store(key: otherRemote, path: "/srv", entries: Self.items(base: "/srv", count: 1))
+        writer.flushAndWait()
+        XCTAssertNotEqual(writer.fileURL(key: original), writer.fileURL(key: edited))
+
+        let reader = makeCache()
+        XCTAssertEqual(reader.listing(key: sameEndpoint, path: "/srv")?.entries.count, 2)
+        XCTAssertEqual(reader.listing(key: edited, path: "/srv")?.entries.count, 5)
+        XCTAssertNil(reader.listing(key: otherPort, path: "/srv"))
+
+        // A file from before the endpoint was part of the name is purged too.
+        let legacyURL = directoryURL.appendingPathComponent("\(remoteID.uuidString).cache", isDirectory: false)
+        try Data("legacy".utf8).write(to: legacyURL)
+
+        reader.removeAll(remoteID: remoteID)
+        reader.flushAndWait()
+
+        let fileManager = FileManager.default
+        XCTAssertFalse(fileManager.fileExists(atPath: reader.fileURL(key: original).path))
+        XCTAssertFalse(fileManager.fileExists(atPath: reader.fileURL(key: edited).path))
+        XCTAssertFalse(fileManager.fileExists(atPath: legacyURL.path))
+        XCTAssertTrue(fileManager.fileExists(atPath: reader.fileURL(key: otherRemote).path))
+        XCTAssertNil(reader.listing(key: original, path: "/srv"))
+        XCTAssertNil(makeCache().listing(key: edited, path: "/srv"))
+        XCTAssertEqual(makeCache().listing(key: otherRemote, path: "/srv")?.entries.count, 1)
+    }
+
+    /// Beginner note: Closing a session queues the cache write instead of waiting for it; the write
+    /// still lands, and forgetting the remote removes it again.
+    func testSessionClosePersistsListingsAndForgetPurgesThem() async throws {
+        let remote = Self.remote()
+        let key = BrowserListingCacheKey(remote: remote)
+        let store = makeCache()
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", count: 3)
+        let manager = RemoteBrowserSessionManager(
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            listingStore: store
+        )
+
+        let sessionID = await manager.openSession(remote: remote, password: nil)
+        _ = await manager.listDirectories(sessionID: sessionID, path: "/srv", requestID: 1)
+        await manager.closeSession(sessionID)
+        store.flushAndWait()
+
+        XCTAssertEqual(makeCache().listing(key: key, path: "/srv")?.entries.count, 3)
+
+        await manager.forgetCachedListings(remoteID: remote.id)
+        store.flushAndWait()
+        XCTAssertFalse(FileManager.default.fileExists(atPath: store.fileURL(key: key).path))
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func makeCache(byteLimit: Int = BrowserListingDiskCache.defaultByteLimit) -> BrowserListingDiskCache {
+        BrowserListingDiskCache(directoryURL: directoryURL, byteLimit: byteLimit, writeDelay: 60)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func remote() -> RemoteConfig {
+        RemoteConfig(
+            displayName: "Test",
+            host: "example.invalid",
+            username: "dev",
+            authMode: .privateKey,
+            privateKeyPath: "/tmp/id_test",
+            remoteDirectory: "/srv",
+            localMountPoint: "/tmp/mnt-test"
+        )
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func key() -> BrowserListingCacheKey {
+        BrowserListingCacheKey(remoteID: UUID(), host: "example.invalid", port: 22, username: "dev")
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func items(base: String, count: Int) -> [RemoteDirectoryItem] {
+        LibSSH2SessionActorTests.items(base: base, names: (0..<count).map { "folder-\($0)" })
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func range(of needle: [UInt8], in haystack: [UInt8]) -> Range<Int>? {
+        guard needle.count <= haystack.count else {
+            return nil
+        }
+        for start in 0...(haystack.count - needle.count) where Array(haystack[start..<(start + needle.count)]) == needle {
+            return start..<(start + needle.count)
+        }
+        return nil
+    }
+}
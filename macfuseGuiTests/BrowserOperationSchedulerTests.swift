@@ -0,0 +1,107 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserOperationScheduler with blocking jobs that stand in for native libssh2 calls.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserOperationSchedulerTests: XCTestCase {
+    /// Beginner note: Work queued behind a busy executor runs by class, not by arrival order.
+    func testQueuedWorkRunsByPriorityClass() async throws {
+        let scheduler = BrowserOperationScheduler(
+            executors: BrowserRemoteExecutorPool(labelPrefix: "test.scheduler.priority"),
+            starvationLimits: [:]
+        )
+        let remoteID = UUID()
+        let gate = DispatchSemaphore(value: 0)
+        let order = OrderRecorder()
+
+        scheduler.enqueue(remoteID: remoteID, priority: .background) { gate.wait() }
+        for priority in [BrowserOperationPriority.background, .keepalive, .recovery, .interactive, .keepalive] {
+            scheduler.enqueue(remoteID: remoteID, priority: priority) { order.append(priority) }
+        }
+        let queued = scheduler.metrics()
+        gate.signal()
+        try await scheduler.run(remoteID: remoteID, priority: .background) {}
+
+        XCTAssertEqual(order.values, [.interactive, .recovery, .keepalive, .keepalive, .background])
+        XCTAssertEqual(queued[.keepalive]?.queued, 2)
+        XCTAssertEqual(queued[.keepalive]?.maxQueued, 2)
+        XCTAssertEqual(queued[.background]?.queued, 1)
+        let drained = scheduler.metrics()
+        XCTAssertEqual(drained.values.map(\.queued), [0, 0, 0, 0])
+        XCTAssertEqual(drained[.background]?.dispatched, 3)
+        XCTAssertTrue(scheduler.summaryLine().contains("interactive=q0/max1/n1/"), scheduler.summaryLine())
+    }
+
+    /// Beginner note: A background job that waited past its limit runs before newer interactive work.
+    func testAgedLowPriorityWorkIsNotStarved() async throws {
+        let scheduler = BrowserOperationScheduler(
+            executors: BrowserRemoteExecutorPool(labelPrefix: "test.scheduler.aging"),
+            starvationLimits: [.background: 0.05]
+        )
+        let remoteID = UUID()
+        let order = OrderRecorder()
+
+        scheduler.enqueue(remoteID: remoteID, priority: .interactive) { Thread.sleep(forTimeInterval: 0.15) }
+        scheduler.enqueue(remoteID: remoteID, priority: .background) { order.append(.background) }
+        scheduler.enqueue(remoteID: remoteID, priority: .interactive) { order.append(.interactive) }
+        try await BrowserOperationPriority.$current.withValue(.interactive) {
+            try await scheduler.run(remoteID: remoteID) { order.append(.interactive) }
+        }
+
+        XCTAssertEqual(order.values, [.background, .interactive, .interactive])
+        let metrics = scheduler.metrics()
+        XCTAssertEqual(metrics[.background]?.promoted, 1)
+        XCTAssertGreaterThanOrEqual(metrics[.background]?.maxWaitMicros ?? 0, 50_000)
+    }
+
+    /// Beginner note: A remote is forgotten once its queues drain, so the map shrinks back to empty.
+    func testDrainedRemotesAreRemoved() async throws {
+        let pool = BrowserRemoteExecutorPool(labelPrefix: "test.scheduler.shrink")
+        let scheduler = BrowserOperationScheduler(executors: pool, starvationLimits: [:])
+        let remoteIDs = (0..<4).map { _ in UUID() }
+        let gate = DispatchSemaphore(value: 0)
+
+        for remoteID in remoteIDs {
+            scheduler.enqueue(remoteID: remoteID, priority: .interactive) { _ = gate.wait(timeout: .now() + 30) }
+            scheduler.enqueue(remoteID: remoteID, priority: .background) {}
+        }
+        XCTAssertEqual(Set(scheduler.activeRemoteIDs()), Set(remoteIDs))
+
+        for _ in remoteIDs {
+            gate.signal()
+        }
+        for remoteID in remoteIDs {
+            try await scheduler.run(remoteID: remoteID, priority: .background) {}
+            // The idle check runs on the executor right after the last operation; wait for it there.
+            pool.sync(remoteID: remoteID) {}
+        }
+        XCTAssertTrue(scheduler.activeRemoteIDs().isEmpty)
+        XCTAssertTrue(pool.remoteIDs().isEmpty)
+    }
+}
+
+/// Beginner note: Thread-safe log of which class ran, in execution order.
+private final class OrderRecorder: @unchecked Sendable {
+    private let lock = NSLock()
+    private var storage: [BrowserOperationPriority] = []
+
+    var values: [BrowserOperationPriority] {
+        lock.lock()
+        defer { lock.unlock() }
+        return storage
+    }
+
+    func append(_ priority: BrowserOperationPriority) {
+        lock.lock()
+        storage.append(priority)
+        lock.unlock()
+    }
+}
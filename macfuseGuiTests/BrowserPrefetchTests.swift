@@ -0,0 +1,123 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserPrefetchPlanner and LibSSH2SessionActor prefetch through a scripted transport.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserPrefetchTests: XCTestCase {
+    /// Beginner note: Children leading to recents rank first, then favorites, then display order.
+    func testPlannerRanksRecentsThenFavoritesThenSortOrder() {
+        let children = LibSSH2SessionActorTests.items(base: "/srv", names: ["alpha", "beta", "gamma", "delta", "omega"])
+
+        let ranked = BrowserPrefetchPlanner.candidates(
+            children: children,
+            recents: ["/srv/gamma/deep/path", "/elsewhere"],
+            favorites: ["/srv/Delta", "/srv/gamma"],
+            limit: 4
+        )
+
+        XCTAssertEqual(ranked, ["/srv/gamma", "/srv/delta", "/srv/alpha", "/srv/beta"])
+        XCTAssertEqual(BrowserPrefetchPlanner.candidates(children: children, recents: [], favorites: [], limit: 0), [])
+    }
+
+    /// Beginner note: Opening a prefetched folder needs no transport call and counts as a hit.
+    func testOpeningPrefetchedFolderSkipsTransportAndCountsHit() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = LibSSH2SessionActorTests.items(base: "/srv", names: ["a", "b"])
+        transport.listings["/srv/a"] = LibSSH2SessionActorTests.items(base: "/srv/a", names: ["x"])
+        transport.listings["/srv/b"] = LibSSH2SessionActorTests.items(base: "/srv/b", names: ["y", "z"])
+        let session = makeSession(transport: transport, policy: BrowserPrefetchPolicy(idleDelayNanoseconds: 0))
+
+        _ = await session.list(path: "/srv", requestID: 1)
+        await session.prefetch(paths: ["/srv/a", "/srv/b", "/srv"])
+        let prefetched = await waitForStats(session) { $0.completed == 2 }
+        XCTAssertEqual(prefetched.completed, 2)
+        XCTAssertEqual(transport.listCallCount, 3)
+
+        let opened = await session.list(path: "/srv/b", requestID: 2)
+        let stats = await session.prefetchStatistics()
+        let summary = await session.summaryLine()
+        await session.close()
+
+        XCTAssertEqual(transport.listCallCount, 3)
+        XCTAssertFalse(opened.isStale)
+        XCTAssertEqual(opened.requestID, 2)
+        XCTAssertEqual(opened.entries.map(\.name), ["y", "z"])
+        XCTAssertEqual(stats.hits, 1)
+        XCTAssertEqual(stats.hitRate, 0.5, accuracy: 0.001)
+        XCTAssertTrue(summary.contains("prefetch=1/2(50%)"), summary)
+    }
+
+    /// Beginner note: A user listing cancels the round, and the operation budget caps later rounds.
+    func testNavigationCancelsPrefetchAndBudgetCapsOperations() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv/a"] = LibSSH2SessionActorTests.items(base: "/srv/a", names: ["x"])
+        transport.listings["/srv/b"] = LibSSH2SessionActorTests.items(base: "/srv/b", names: ["y"])
+        transport.listings["/srv/c"] = LibSSH2SessionActorTests.items(base: "/srv/c", names: ["z"])
+        transport.listDelayNanoseconds = 300_000_000
+        let session = makeSession(
+            transport: transport,
+            policy: BrowserPrefetchPolicy(operationBudget: 2, idleDelayNanoseconds: 0)
+        )
+
+        await session.prefetch(paths: ["/srv/a", "/srv/b"])
+        try? await Task.sleep(nanoseconds: 50_000_000)
+        let navigated = await session.list(path: "/srv/c", requestID: 1)
+        let cancelled = await waitForStats(session) { $0.cancelled == 1 }
+        XCTAssertEqual(navigated.entries.map(\.name), ["z"])
+        XCTAssertEqual(cancelled.completed, 0)
+
+        transport.listDelayNanoseconds = 0
+        await session.prefetch(paths: ["/srv/a", "/srv/b"])
+        let capped = await waitForStats(session) { $0.budgetExhausted == 1 }
+        await session.close()
+
+        XCTAssertEqual(capped.completed, 1)
+        XCTAssertEqual(capped.scheduled, 2)
+    }
+
+    /// Beginner note: Polls until the prefetch counters satisfy the condition or two seconds pass.
+    private func waitForStats(
+        _ session: LibSSH2SessionActor,
+        until condition: (BrowserPrefetchStats) -> Bool
+    ) async -> BrowserPrefetchStats {
+        for _ in 0..<200 {
+            let stats = await session.prefetchStatistics()
+            if condition(stats) {
+                return stats
+            }
+            try? await Task.sleep(nanoseconds: 10_000_000)
+        }
+        return await session.prefetchStatistics()
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func makeSession(transport: ScriptedBrowserTransport, policy: BrowserPrefetchPolicy) -> LibSSH2SessionActor {
+        LibSSH2SessionActor(
+            id: UUID(),
+            remote: RemoteConfig(
+                displayName: "Test",
+                host: "example.invalid",
+                username: "dev",
+                authMode: .privateKey,
+                privateKeyPath: "/tmp/id_test",
+                remoteDirectory: "/srv",
+                localMountPoint: "/tmp/mnt-test"
+            ),
+            password: nil,
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            requestRetrySchedule: [],
+            recoveryRetrySchedule: [],
+            keepAliveIntervalNanoseconds: 60_000_000_000,
+            prefetchPolicy: policy
+        )
+    }
+}
@@ -0,0 +1,106 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserRTTEstimator directly with synthetic round-trip samples.
+// Concurrency: Synchronous tests; the estimator is a plain value type.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserRTTEstimatorTests: XCTestCase {
+    private let policy = BrowserAdaptiveTimeoutPolicy()
+
+    /// Beginner note: Without a sample the configured initial budgets apply, widened by backoff.
+    func testInitialBudgetsUntilFirstSample() {
+        var estimator = BrowserRTTEstimator()
+        XCTAssertEqual(estimator.listProgressTimeoutMs(policy: policy), 8_000)
+        XCTAssertEqual(estimator.listBudgetMs(policy: policy), 8_000)
+        XCTAssertEqual(estimator.pingTimeoutMs(policy: policy), 2_000)
+
+        estimator.backOff(policy: policy)
+        XCTAssertEqual(estimator.listProgressTimeoutMs(policy: policy), 16_000)
+        XCTAssertEqual(estimator.pingTimeoutMs(policy: policy), 4_000)
+        XCTAssertNil(estimator.retransmissionTimeoutMicros(policy: policy))
+    }
+
+    /// Beginner note: SRTT/RTTVAR follow RFC 6298 and the budgets scale with the resulting RTO.
+    func testSamplesDriveSmoothedRTTAndBudgets() {
+        var estimator = BrowserRTTEstimator()
+        estimator.record(sampleMicros: 100_000)
+        XCTAssertEqual(estimator.smoothedMicros, 100_000)
+        XCTAssertEqual(estimator.varianceMicros, 50_000)
+        XCTAssertEqual(estimator.listProgressTimeoutMs(policy: policy), 2_400)
+        XCTAssertEqual(estimator.pingTimeoutMs(policy: policy), 900)
+
+        estimator.record(sampleMicros: 100_000)
+        XCTAssertEqual(estimator.varianceMicros, 37_500)
+        XCTAssertEqual(estimator.summary(policy: policy), "rtt=100.0±37.5ms/n2 list=8000ms idle=2000ms ping=750ms")
+
+        estimator.record(sampleMicros: 300_000)
+        XCTAssertEqual(estimator.smoothedMicros, 125_000)
+        XCTAssertEqual(estimator.varianceMicros, 78_125)
+    }
+
+    /// Beginner note: A fast LAN is held at the floors and a very slow link at the ceilings.
+    func testBudgetsStayWithinFloorsAndCeilings() {
+        var lan = BrowserRTTEstimator()
+        for _ in 0..<20 {
+            lan.record(sampleMicros: 300)
+        }
+        XCTAssertEqual(lan.listProgressTimeoutMs(policy: policy), policy.listFloorMs)
+        // Only the inactivity budget shrinks on a LAN; a whole listing still starts with 8 s.
+        XCTAssertEqual(lan.listBudgetMs(policy: policy), 8_000)
+        XCTAssertEqual(lan.pingTimeoutMs(policy: policy), policy.pingFloorMs)
+
+        var satellite = BrowserRTTEstimator()
+        satellite.record(sampleMicros: 2_000_000)
+        XCTAssertEqual(satellite.listProgressTimeoutMs(policy: policy), policy.listCeilingMs)
+        XCTAssertEqual(satellite.listBudgetMs(policy: policy), policy.listCeilingMs)
+        XCTAssertEqual(satellite.pingTimeoutMs(policy: policy), policy.pingCeilingMs)
+    }
+
+    /// Beginner note: Failures double the budget up to the cap; the next good sample resets it.
+    func testBackoffIsCappedAndClearedBySample() {
+        var estimator = BrowserRTTEstimator()
+        estimator.record(sampleMicros: 100_000)
+        estimator.record(sampleMicros: 100_000)
+
+        estimator.backOff(policy: policy)
+        XCTAssertEqual(estimator.listProgressTimeoutMs(policy: policy), 4_000)
+        XCTAssertTrue(estimator.summary(policy: policy).hasSuffix("backoff=x2"))
+        for _ in 0..<3 {
+            estimator.backOff(policy: policy)
+        }
+        XCTAssertEqual(estimator.backoff, policy.maximumBackoff)
+        XCTAssertEqual(estimator.listProgressTimeoutMs(policy: policy), 8_000)
+        XCTAssertEqual(estimator.pingTimeoutMs(policy: policy), 3_000)
+
+        estimator.record(sampleMicros: 100_000)
+        XCTAssertEqual(estimator.backoff, 1)
+    }
+
+    /// Beginner note: The sample is the cheapest per-round-trip small request; readdir and cached realpath are ignored.
+    func testSampleComesFromSmallRequestStages() {
+        let timing = BrowserStageTiming(
+            realpathMicros: 9_000,
+            opendirMicros: 4_000,
+            readdirMicros: 1_000,
+            statMicros: 12_000,
+            realpathRoundTrips: 3,
+            opendirRoundTrips: 1,
+            readdirRoundTrips: 10,
+            statRoundTrips: 2
+        )
+        XCTAssertEqual(BrowserRTTEstimator.sampleMicros(from: timing), 3_000)
+
+        var cached = timing
+        cached.realpathCached = true
+        XCTAssertEqual(BrowserRTTEstimator.sampleMicros(from: cached), 4_000)
+
+        XCTAssertNil(BrowserRTTEstimator.sampleMicros(from: BrowserStageTiming(readdirMicros: 5_000, readdirRoundTrips: 2)))
+    }
+}
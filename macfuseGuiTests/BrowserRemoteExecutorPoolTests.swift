@@ -0,0 +1,179 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives BrowserRemoteExecutorPool with blocking jobs that stand in for native libssh2 calls.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class BrowserRemoteExecutorPoolTests: XCTestCase {
+    private let healthyRemoteCount = 7
+    private let jobsPerRemote = 20
+
+    /// Beginner note: Load test with 8 remotes: while the blackholed one is stuck, all 7 healthy
+    /// remotes are running at the same time and finish all of their work.
+    func testBlackholedRemoteDoesNotBlockOtherRemotes() async throws {
+        let pool = BrowserRemoteExecutorPool(labelPrefix: "test.executor.load")
+        let blackholeID = UUID()
+        let releaseBlackhole = DispatchSemaphore(value: 0)
+        let blackholeDone = CompletionFlag()
+        // Stand-in for a list call on a host that never answers: blocks until the test releases it.
+        pool.async(remoteID: blackholeID) {
+            _ = releaseBlackhole.wait(timeout: .now() + 60)
+            blackholeDone.set()
+        }
+
+        // Every healthy remote's first job waits here until all of them have arrived, which only
+        // happens if they are all on a worker thread at once.
+        let rendezvous = Rendezvous(parties: healthyRemoteCount)
+        let tracker = OverlapTracker()
+        try await withThrowingTaskGroup(of: Bool.self) { group in
+            for _ in 0..<healthyRemoteCount {
+                let remoteID = UUID()
+                group.addTask { [jobsPerRemote] in
+                    let metEveryone = try await pool.run(remoteID: remoteID) {
+                        tracker.enter()
+                        defer { tracker.leave() }
+                        return rendezvous.arriveAndWait(timeout: 30)
+                    }
+                    for _ in 1..<jobsPerRemote {
+                        try await pool.run(remoteID: remoteID) {}
+                    }
+                    return metEveryone
+                }
+            }
+            for try await metEveryone in group {
+                XCTAssertTrue(metEveryone, "a healthy remote was held back while others waited")
+            }
+        }
+
+        XCTAssertEqual(tracker.maxConcurrent, healthyRemoteCount)
+        XCTAssertFalse(blackholeDone.isSet, "healthy work must finish while the blackholed call is still stuck")
+
+        // Release and drain the blackholed executor so the stand-in does not outlive the test.
+        releaseBlackhole.signal()
+        try await pool.run(remoteID: blackholeID) {}
+        XCTAssertTrue(blackholeDone.isSet)
+    }
+
+    /// Beginner note: A remote's executor is dropped once its last queued job has finished, and
+    /// stays while work is still waiting on it.
+    func testIdleRemoteExecutorIsEvicted() async throws {
+        let pool = BrowserRemoteExecutorPool(labelPrefix: "test.executor.evict")
+        let remoteID = UUID()
+
+        XCTAssertEqual(pool.sync(remoteID: remoteID) { pool.currentRemoteID() }, remoteID)
+        XCTAssertTrue(pool.remoteIDs().isEmpty)
+
+        let gate = DispatchSemaphore(value: 0)
+        pool.async(remoteID: remoteID) {
+            _ = gate.wait(timeout: .now() + 30)
+        }
+        pool.async(remoteID: remoteID) {}
+        XCTAssertEqual(pool.remoteIDs(), [remoteID])
+
+        gate.signal()
+        // Serial queue: this runs after both jobs above, and the pool is empty once it returns.
+        try await pool.run(remoteID: remoteID) {}
+        XCTAssertTrue(pool.remoteIDs().isEmpty)
+    }
+
+    /// Beginner note: Jobs for one remote still run one at a time on that remote's executor.
+    func testJobsForOneRemoteStaySerialAndConfined() async throws {
+        let pool = BrowserRemoteExecutorPool(labelPrefix: "test.executor.serial")
+        let remoteID = UUID()
+        let tracker = OverlapTracker()
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for _ in 0..<16 {
+                group.addTask {
+                    try await pool.run(remoteID: remoteID) {
+                        XCTAssertEqual(pool.currentRemoteID(), remoteID)
+                        tracker.enter()
+                        Thread.sleep(forTimeInterval: 0.002)
+                        tracker.leave()
+                    }
+                }
+            }
+            try await group.waitForAll()
+        }
+
+        XCTAssertEqual(tracker.maxConcurrent, 1)
+        XCTAssertNil(pool.currentRemoteID())
+    }
+}
+
+/// Beginner note: Records the highest number of jobs that were inside a section at once.
+private final class OverlapTracker: @unchecked Sendable {
+    private let lock = NSLock()
+    private var current = 0
+    private var peak = 0
+
+    var maxConcurrent: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return peak
+    }
+
+    func enter() {
+        lock.lock()
+        current += 1
+        peak = max(peak, current)
+        lock.unlock()
+    }
+
+    func leave() {
+        lock.lock()
+        current -= 1
+        lock.unlock()
+    }
+}
+
+/// Beginner note: Blocks each arriving thread until the given number of parties have arrived.
+private final class Rendezvous: @unchecked Sendable {
+    private let condition = NSCondition()
+    private let parties: Int
+    private var arrived = 0
+
+    init(parties: Int) {
+        self.parties = parties
+    }
+
+    /// Beginner note: Returns false if the deadline passed before everyone arrived.
+    func arriveAndWait(timeout: TimeInterval) -> Bool {
+        let deadline = Date().addingTimeInterval(timeout)
+        condition.lock()
+        defer { condition.unlock() }
+        arrived += 1
+        condition.broadcast()
+        while arrived < parties {
+            if !condition.wait(until: deadline) {
+                return arrived >= parties
+            }
+        }
+        return true
+    }
+}
+
+/// Beginner note: Set once from any thread; read by the test to check ordering without timing.
+private final class CompletionFlag: @unchecked Sendable {
+    private let lock = NSLock()
+    private var value = false
+
+    var isSet: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return value
+    }
+
+    func set() {
+        lock.lock()
+        value = true
+        lock.unlock()
+    }
+}
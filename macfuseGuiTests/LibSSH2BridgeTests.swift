@@ -0,0 +1,751 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Calls the native libssh2 bridge helpers that do not need a live SSH server.
+// Concurrency: Runs with standard synchronous execution unless specific methods use async/await.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class LibSSH2BridgeTests: XCTestCase {
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func testBridgeVersionReportsFlatListLayout() {
+        XCTAssertGreaterThanOrEqual(macfusegui_libssh2_bridge_version(), 3)
+    }
+
+    #if DEBUG
+    /// Beginner note: Flat results must decode to the same items the old per-entry layout produced.
+    func testFlatResultConvertsToDirectoryItems() {
+        var cResult = macfusegui_libssh2_flat_list_result()
+        defer {
+            macfusegui_libssh2_free_flat_list_result(&cResult)
+        }
+
+        XCTAssertEqual(macfusegui_libssh2_fill_synthetic_flat_result(3, &cResult), 0)
+        let items = LibSSH2SFTPTransport.convertEntries(from: cResult, resolvedPath: "/srv/build")
+
+        XCTAssertEqual(items.map(\.name), ["build-artifact-00000000", "build-artifact-00000001", "build-artifact-00000002"])
+        XCTAssertEqual(items.first?.fullPath, "/srv/build/build-artifact-00000000")
+        XCTAssertTrue(items.allSatisfy(\.isDirectory))
+        XCTAssertEqual(items.first?.sizeBytes, 4096)
+    }
+
+    /// Beginner note: Entry array and name blob grow geometrically, so allocations stay logarithmic.
+    func testFlatResultAllocationCountIsLogarithmic() {
+        for count in [1_000, 10_000, 100_000] {
+            var cResult = macfusegui_libssh2_flat_list_result()
+            XCTAssertEqual(macfusegui_libssh2_fill_synthetic_flat_result(Int32(count), &cResult), 0)
+            XCTAssertEqual(Int(cResult.entry_count), count)
+            XCTAssertLessThan(Int(cResult.allocation_count), 40, "entries=\(count) allocations=\(cResult.allocation_count)")
+            macfusegui_libssh2_free_flat_list_result(&cResult)
+            XCTAssertNil(cResult.entries)
+            XCTAssertNil(cResult.name_blob)
+        }
+    }
+    #endif
+
+    /// Beginner note: The reactor must keep working for fds above select()'s FD_SETSIZE (1024).
+    func testReactorWaitsOnDescriptorsAboveFDSetSize() throws {
+        var limit = rlimit()
+        XCTAssertEqual(getrlimit(RLIMIT_NOFILE, &limit), 0)
+        if limit.rlim_cur < 2_100 {
+            limit.rlim_cur = min(2_100, limit.rlim_max)
+            _ = setrlimit(RLIMIT_NOFILE, &limit)
+        }
+
+        var pair: [Int32] = [-1, -1]
+        XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, &pair), 0)
+        let readerFD = dup2(pair[0], 2_000)
+        let writerFD = dup2(pair[1], 2_001)
+        close(pair[0])
+        close(pair[1])
+        try XCTSkipIf(readerFD < 0 || writerFD < 0, "RLIMIT_NOFILE too low to place fds above FD_SETSIZE")
+        defer {
+            close(readerFD)
+            close(writerFD)
+        }
+
+        let reactor = macfusegui_libssh2_reactor_create()
+        defer {
+            macfusegui_libssh2_reactor_destroy(reactor)
+        }
+        XCTAssertNotNil(reactor)
+
+        var interest = macfusegui_libssh2_wait_interest(fd: readerFD, events: Int16(MACFUSEGUI_LIBSSH2_WAIT_READ), ready: 0)
+        XCTAssertEqual(macfusegui_libssh2_reactor_wait(reactor, &interest, 1, 20), 0)
+
+        var byte: UInt8 = 0x2a
+        XCTAssertEqual(write(writerFD, &byte, 1), 1)
+        XCTAssertEqual(macfusegui_libssh2_reactor_wait(reactor, &interest, 1, 1_000), 1)
+        XCTAssertEqual(interest.ready, Int16(MACFUSEGUI_LIBSSH2_WAIT_READ))
+    }
+
+    /// Beginner note: A hangup on a socket that is only waiting to write must end the wait as ready,
+    /// not be reported as a timeout after the full deadline.
+    func testReactorReportsHangupOutsideRequestedEvents() {
+        var pair: [Int32] = [-1, -1]
+        XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, &pair), 0)
+        defer {
+            close(pair[0])
+        }
+        _ = fcntl(pair[0], F_SETFL, fcntl(pair[0], F_GETFL) | O_NONBLOCK)
+        // Fill the send buffer so the socket is not writable, then hang up the peer.
+        var chunk = [UInt8](repeating: 0x2a, count: 4_096)
+        while write(pair[0], &chunk, chunk.count) > 0 {}
+        close(pair[1])
+
+        let reactor = macfusegui_libssh2_reactor_create()
+        defer {
+            macfusegui_libssh2_reactor_destroy(reactor)
+        }
+        var interest = macfusegui_libssh2_wait_interest(fd: pair[0], events: Int16(MACFUSEGUI_LIBSSH2_WAIT_WRITE), ready: 0)
+        XCTAssertEqual(macfusegui_libssh2_reactor_wait(reactor, &interest, 1, 5_000), 1)
+        XCTAssertNotEqual(interest.ready & Int16(MACFUSEGUI_LIBSSH2_WAIT_ERROR), 0)
+        XCTAssertNotEqual(interest.ready & Int16(MACFUSEGUI_LIBSSH2_WAIT_WRITE), 0)
+    }
+
+    /// Beginner note: Happy Eyeballs must fall back to IPv4 after one attempt delay
+    /// when the preferred IPv6 loopback listener is blackholed (full accept backlog).
+    func testConnectRaceFallsBackToIPv4WhenIPv6IsBlackholed() throws {
+        let ipv6Listener = try XCTUnwrap(Self.makeLoopbackListener(port: 0, ipv6: true, backlog: 0), "IPv6 loopback unavailable")
+        let port = try XCTUnwrap(Self.localPort(of: ipv6Listener))
+        let ipv4Listener = try XCTUnwrap(Self.makeLoopbackListener(port: port, ipv6: false, backlog: 8))
+        var fillers: [Int32] = []
+        defer {
+            fillers.forEach { close($0) }
+            close(ipv6Listener)
+            close(ipv4Listener)
+        }
+
+        // Nobody accepts on the IPv6 listener, so once its backlog is full new SYNs are dropped.
+        while fillers.count < 16 {
+            let filler = Self.startLoopbackConnect(port: port)
+            fillers.append(filler)
+            var pollFD = pollfd(fd: filler, events: Int16(POLLOUT), revents: 0)
+            if poll(&pollFD, 1, 200) == 0 {
+                break
+            }
+        }
+
+        var report = macfusegui_libssh2_connect_report()
+        let hosts = ["::1", "127.0.0.1"].map { strdup($0) }
+        defer {
+            hosts.forEach { free($0) }
+        }
+        let fd = hosts.map { UnsafePointer($0) }.withUnsafeBufferPointer { buffer in
+            macfusegui_libssh2_connect_numeric_candidates(buffer.baseAddress, 2, Int32(port), 3_000, 250, &report)
+        }
+        if fd >= 0 {
+            close(fd)
+        }
+
+        XCTAssertGreaterThanOrEqual(fd, 0)
+        XCTAssertEqual(report.family, 4)
+        XCTAssertEqual(report.attempts_started, 2)
+        XCTAssertLessThan(report.elapsed_ms, 1_500, "IPv4 should start after the 250ms attempt delay, not the full timeout")
+        XCTAssertEqual(LibSSH2SFTPTransport.addressFamilyLabel(report.family), "IPv4")
+    }
+
+    /// Beginner note: A refused address hands over to the next one at once (RFC 8305 section 5);
+    /// the race must not sit out the attempt delay first.
+    func testConnectRaceMovesOnAsSoonAsFirstAddressRefuses() throws {
+        let ipv4Listener = try XCTUnwrap(Self.makeLoopbackListener(port: 0, ipv6: false, backlog: 8))
+        defer {
+            close(ipv4Listener)
+        }
+        let port = try XCTUnwrap(Self.localPort(of: ipv4Listener))
+        let attemptDelayMs: Int32 = 5_000
+
+        // Nothing listens on [::1]:port, so the first attempt is refused (or fails outright without IPv6).
+        var report = macfusegui_libssh2_connect_report()
+        let hosts = ["::1", "127.0.0.1"].map { strdup($0) }
+        defer {
+            hosts.forEach { free($0) }
+        }
+        let fd = hosts.map { UnsafePointer($0) }.withUnsafeBufferPointer { buffer in
+            macfusegui_libssh2_connect_numeric_candidates(buffer.baseAddress, 2, Int32(port), 2 * attemptDelayMs, attemptDelayMs, &report)
+        }
+        if fd >= 0 {
+            close(fd)
+        }
+
+        XCTAssertGreaterThanOrEqual(fd, 0)
+        XCTAssertEqual(report.family, 4)
+        XCTAssertEqual(report.attempts_started, 2)
+        XCTAssertLessThan(report.elapsed_ms, attemptDelayMs, "the second address waited for the attempt delay after the first was refused")
+    }
+
+    /// Beginner note: Dead-peer tuning must reach the kernel, and a peer that swallows traffic
+    /// (a local proxy that reads and never answers) must fail the open by deadline, not hang.
+    func testSocketOptionsApplyOnConnectionToSilentlyDroppingProxy() throws {
+        // Port 0 lets the kernel pick a free port, so parallel runs cannot collide.
+        let listener = try XCTUnwrap(Self.makeLoopbackListener(port: 0, ipv6: false, backlog: 8))
+        let port = try XCTUnwrap(Self.localPort(of: listener))
+        let proxy = Thread {
+            while true {
+                let accepted = accept(listener, nil, nil)
+                if accepted < 0 {
+                    return
+                }
+                var buffer = [UInt8](repeating: 0, count: 4096)
+                while read(accepted, &buffer, buffer.count) > 0 {}
+                close(accepted)
+            }
+        }
+        proxy.start()
+        defer {
+            shutdown(listener, SHUT_RDWR)
+            close(listener)
+        }
+
+        var report = macfusegui_libssh2_connect_report()
+        let host = strdup("127.0.0.1")
+        defer {
+            free(host)
+        }
+        var hosts = [UnsafePointer(host)]
+        let fd = macfusegui_libssh2_connect_numeric_candidates(&hosts, 1, Int32(port), 1_000, 250, &report)
+        XCTAssertGreaterThanOrEqual(fd, 0)
+        defer {
+            close(fd)
+        }
+
+        var options = BrowserSocketOptions(keepAliveIdleSeconds: 7, keepAliveIntervalSeconds: 2, keepAliveCount: 4, userTimeoutMs: 3_000).cValue
+        let applied = macfusegui_libssh2_apply_socket_options(fd, &options)
+        XCTAssertEqual(LibSSH2SFTPTransport.socketOptionsLabel(applied), "keepidle,keepintvl,keepcnt,usertimeout,nodelay")
+        XCTAssertEqual(Self.tcpOption(fd, TCP_KEEPALIVE), 7)
+        XCTAssertEqual(Self.tcpOption(fd, TCP_KEEPINTVL), 2)
+        XCTAssertEqual(Self.tcpOption(fd, TCP_KEEPCNT), 4)
+        XCTAssertEqual(Self.tcpOption(fd, TCP_RXT_CONNDROPTIME), 3)
+        XCTAssertNotEqual(Self.tcpOption(fd, TCP_NODELAY), 0)
+
+        var handle: UnsafeMutablePointer<macfusegui_libssh2_session_handle>?
+        var errorPtr: UnsafeMutablePointer<CChar>?
+        let startedAt = Date()
+        let status = macfusegui_libssh2_open_session_with_options("127.0.0.1", Int32(port), "dev", nil, nil, 1, &options, &handle, &errorPtr)
+        let elapsed = Date().timeIntervalSince(startedAt)
+        let message = errorPtr.map { String(cString: $0) } ?? ""
+        if let errorPtr {
+            macfusegui_libssh2_free_error(errorPtr)
+        }
+
+        XCTAssertNotEqual(status, 0)
+        XCTAssertNil(handle)
+        XCTAssertTrue(message.contains("SSH handshake"), message)
+        XCTAssertLessThan(elapsed, 2.5)
+    }
+
+    /// Beginner note: Repeat lookups are served from the resolver cache; failures are cached too.
+    func testResolverCacheCountsHitsMissesAndNegativeHits() throws {
+        let resolver = try XCTUnwrap(macfusegui_libssh2_resolver_create(60_000, 5_000))
+        defer {
+            macfusegui_libssh2_resolver_destroy(resolver)
+        }
+        var addressCount: Int32 = 0
+
+        XCTAssertEqual(macfusegui_libssh2_resolver_lookup(resolver, "localhost", 22, &addressCount), 0)
+        XCTAssertGreaterThan(addressCount, 0)
+        XCTAssertEqual(macfusegui_libssh2_resolver_lookup(resolver, "localhost", 22, &addressCount), 0)
+        XCTAssertNotEqual(macfusegui_libssh2_resolver_lookup(resolver, "macfusegui-test.invalid", 22, &addressCount), 0)
+        XCTAssertNotEqual(macfusegui_libssh2_resolver_lookup(resolver, "macfusegui-test.invalid", 22, &addressCount), 0)
+        XCTAssertEqual(addressCount, 0)
+
+        let stats = Self.resolverStats(resolver)
+        XCTAssertEqual(stats.misses, 2)
+        XCTAssertEqual(stats.hits, 1)
+        XCTAssertEqual(stats.negative_hits, 1)
+        XCTAssertEqual(stats.entry_count, 2)
+
+        macfusegui_libssh2_resolver_flush(resolver)
+        XCTAssertEqual(Self.resolverStats(resolver).entry_count, 0)
+    }
+
+    /// Beginner note: Answers older than the positive TTL go back to the resolver.
+    func testResolverCacheExpiresAfterTTL() throws {
+        let resolver = try XCTUnwrap(macfusegui_libssh2_resolver_create(20, 20))
+        defer {
+            macfusegui_libssh2_resolver_destroy(resolver)
+        }
+        var addressCount: Int32 = 0
+
+        XCTAssertEqual(macfusegui_libssh2_resolver_lookup(resolver, "localhost", 22, &addressCount), 0)
+        let before = Self.resolverStats(resolver)
+        Thread.sleep(forTimeInterval: 0.05)
+        XCTAssertEqual(macfusegui_libssh2_resolver_lookup(resolver, "localhost", 22, &addressCount), 0)
+        let after = Self.resolverStats(resolver)
+
+        XCTAssertEqual(after.misses - before.misses, 1)
+        XCTAssertEqual(after.hits - before.hits, 0)
+    }
+
+    /// Beginner note: A burst of lookups for one host sends a single query; every other caller
+    /// either waits for that answer or reads it from the cache.
+    func testConcurrentLookupsForOneHostShareOneQuery() throws {
+        let resolver = try XCTUnwrap(macfusegui_libssh2_resolver_create(60_000, 5_000))
+        defer {
+            macfusegui_libssh2_resolver_destroy(resolver)
+        }
+        let callers = 16
+        let failures = FailureCounter()
+
+        DispatchQueue.concurrentPerform(iterations: callers) { _ in
+            var addressCount: Int32 = 0
+            if macfusegui_libssh2_resolver_lookup(resolver, "localhost", 22, &addressCount) != 0 || addressCount == 0 {
+                failures.increment()
+            }
+        }
+
+        let stats = Self.resolverStats(resolver)
+        XCTAssertEqual(failures.count, 0)
+        XCTAssertEqual(stats.misses, 1)
+        XCTAssertEqual(stats.hits + stats.coalesced, UInt64(callers - 1))
+        XCTAssertEqual(stats.entry_count, 1)
+    }
+
+    /// Beginner note: Cancel is sticky and idempotent; a missing token never reads as cancelled.
+    func testCancelTokenIsStickyAndIdempotent() {
+        let cancellation = BrowserListCancellation()
+        XCTAssertNotNil(cancellation.token)
+        XCTAssertFalse(cancellation.isCancelled)
+
+        cancellation.cancel()
+        cancellation.cancel()
+
+        XCTAssertTrue(cancellation.isCancelled)
+        XCTAssertEqual(macfusegui_libssh2_cancel_token_is_cancelled(nil), 0)
+    }
+
+    #if DEBUG
+    /// Beginner note: Cancelling while a call is parked in the socket wait wakes it through the
+    /// token's self-pipe within the drain grace window, and the socket is untouched: a later wait
+    /// on it still sees the next byte the peer sends.
+    func testCancelWakesBlockedSocketWaitAndLeavesSocketUsable() throws {
+        var fds: [Int32] = [-1, -1]
+        XCTAssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, &fds), 0)
+        defer {
+            close(fds[0])
+            close(fds[1])
+        }
+        let cancellation = BrowserListCancellation()
+        let waiting = DispatchSemaphore(value: 0)
+        let finished = DispatchSemaphore(value: 0)
+        let outcome = WaitOutcome()
+
+        let waiter = Thread { [fd = fds[0]] in
+            waiting.signal()
+            // Nothing is ever written before the cancel, so only the token can end this wait early.
+            outcome.record(status: macfusegui_libssh2_wait_readable_for_test(fd, 30_000, cancellation.token))
+            finished.signal()
+        }
+        waiter.start()
+        waiting.wait()
+        Thread.sleep(forTimeInterval: 0.1)
+        let cancelledAt = DispatchTime.now()
+        cancellation.cancel()
+
+        XCTAssertEqual(finished.wait(timeout: .now() + 10), .success, "blocked wait ignored the cancel")
+        let (status, returnedAt) = outcome.value
+        XCTAssertEqual(status, MACFUSEGUI_LIBSSH2_STATUS_CANCELLED)
+        let afterCancelMs = (returnedAt.uptimeNanoseconds - cancelledAt.uptimeNanoseconds) / 1_000_000
+        XCTAssertLessThan(afterCancelMs, UInt64(MACFUSEGUI_LIBSSH2_CANCEL_DRAIN_MS))
+
+        var byte: UInt8 = 0x2a
+        XCTAssertEqual(write(fds[1], &byte, 1), 1)
+        XCTAssertEqual(macfusegui_libssh2_wait_readable_for_test(fds[0], 5_000, nil), 0)
+        var received: UInt8 = 0
+        XCTAssertEqual(read(fds[0], &received, 1), 1)
+        XCTAssertEqual(received, 0x2a)
+    }
+    #endif
+
+    /// Beginner note: Only direct, non-link children of a fully listed cached parent derive;
+    /// deeper paths, links, "..", "~" and forgotten paths need realpath.
+    func testCanonicalPathCacheDerivesOnlyNonLinkChildrenOfListedParents() {
+        var handle = macfusegui_libssh2_session_handle()
+        defer {
+            macfusegui_libssh2_session_forget_canonical_paths(&handle)
+        }
+
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev"))
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/home/dev", "/Users/dev")
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/Users/dev", "/Users/dev")
+
+        XCTAssertEqual(Self.canonicalPath(&handle, "/home/dev"), "/Users/dev")
+        XCTAssertEqual(Self.canonicalPath(&handle, "/home/dev/"), "/Users/dev")
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev/src"), "children are unknown until the parent is listed")
+
+        Self.rememberLinks(&handle, "/Users/dev", ["shared"])
+        XCTAssertEqual(Self.canonicalPath(&handle, "/home/dev/src"), "/Users/dev/src")
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev/shared"), "symlinks resolve through realpath")
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev/src/app"))
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev/../etc"))
+        XCTAssertNil(Self.canonicalPath(&handle, "~"))
+        XCTAssertNil(Self.canonicalPath(&handle, "/opt"))
+
+        macfusegui_libssh2_session_forget_canonical_paths(&handle)
+        XCTAssertNil(Self.canonicalPath(&handle, "/home/dev/src"))
+    }
+
+    /// Beginner note: A missing path evicts itself, its descendants and spellings resolving into it.
+    func testForgettingMissingPathKeepsUnrelatedEntries() {
+        var handle = macfusegui_libssh2_session_handle()
+        defer {
+            macfusegui_libssh2_session_forget_canonical_paths(&handle)
+        }
+
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "~", "/Users/dev")
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/Users/dev", "/Users/dev")
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/Users/dev/src", "/Users/dev/src")
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/Users/devtools", "/Users/devtools")
+        macfusegui_libssh2_session_remember_canonical_path(&handle, "/opt", "/opt")
+
+        macfusegui_libssh2_session_forget_canonical_subtree(&handle, "/Users/dev/")
+
+        XCTAssertNil(Self.canonicalPath(&handle, "~"))
+        XCTAssertNil(Self.canonicalPath(&handle, "/Users/dev"))
+        XCTAssertNil(Self.canonicalPath(&handle, "/Users/dev/src"))
+        XCTAssertEqual(Self.canonicalPath(&handle, "/Users/devtools"), "/Users/devtools")
+        XCTAssertEqual(Self.canonicalPath(&handle, "/opt"), "/opt")
+    }
+
+    /// Beginner note: Validators match only on equal attributes captured after the mtime settled.
+    func testDirectoryValidatorRequiresSettledMatchingAttributes() {
+        let cached = BrowserDirectoryValidator(modifiedAtUnix: 1_000, sizeBytes: 4096, capturedAtUnix: 1_010)
+        var current = cached
+        current.capturedAtUnix = 2_000
+        XCTAssertTrue(Self.validatorMatches(cached, current))
+
+        var touched = current
+        touched.modifiedAtUnix = 1_001
+        XCTAssertFalse(Self.validatorMatches(cached, touched))
+
+        var resized = current
+        resized.sizeBytes = 8192
+        XCTAssertFalse(Self.validatorMatches(cached, resized))
+
+        // Servers that omit the size are compared on mtime alone.
+        var sizeless = current
+        sizeless.sizeBytes = nil
+        XCTAssertTrue(Self.validatorMatches(cached, sizeless))
+
+        // Captured within the same coarse mtime window: a later change could keep the same mtime.
+        let unsettled = BrowserDirectoryValidator(modifiedAtUnix: 1_000, sizeBytes: 4096, capturedAtUnix: 1_001)
+        XCTAssertFalse(Self.validatorMatches(unsettled, current))
+    }
+
+    /// Beginner note: The settle check uses the server's clock, so a skewed client clock cannot make a
+    /// directory modified "just now" on the server look settled.
+    func testDirectoryValidatorReferenceFollowsServerClockUnderSkew() {
+        let serverNow: Int64 = 1_000_000
+        let current = BrowserDirectoryValidator(modifiedAtUnix: serverNow, sizeBytes: 4096, capturedAtUnix: serverNow + 60)
+
+        // Client clock an hour ahead; the newest server timestamp seen is the directory's own mtime.
+        let clientAhead = Self.validatorWithReference(modifiedAtUnix: serverNow, newestServerUnix: serverNow, clientNowUnix: serverNow + 3_600)
+        XCTAssertEqual(clientAhead.capturedAtUnix, serverNow)
+        XCTAssertFalse(Self.validatorMatches(clientAhead, current))
+
+        // Same skew, but an entry (or the directory atime) shows the server clock moved on.
+        let serverMovedOn = Self.validatorWithReference(modifiedAtUnix: serverNow, newestServerUnix: serverNow + 5, clientNowUnix: serverNow + 3_600)
+        XCTAssertEqual(serverMovedOn.capturedAtUnix, serverNow + 5)
+        XCTAssertTrue(Self.validatorMatches(serverMovedOn, current))
+
+        // Client clock an hour behind: a future-looking server timestamp is capped at the client clock.
+        let clientBehind = Self.validatorWithReference(modifiedAtUnix: serverNow, newestServerUnix: serverNow + 30, clientNowUnix: serverNow - 3_600)
+        XCTAssertEqual(clientBehind.capturedAtUnix, serverNow)
+        XCTAssertFalse(Self.validatorMatches(clientBehind, current))
+
+        // A listing with no server timestamps beyond the mtime stays unsettled.
+        let noReference = Self.validatorWithReference(modifiedAtUnix: serverNow - 100, newestServerUnix: Int64.min, clientNowUnix: serverNow)
+        XCTAssertEqual(noReference.capturedAtUnix, serverNow - 100)
+        XCTAssertFalse(Self.validatorMatches(noReference, current))
+    }
+
+    /// Beginner note: A large listing on a slow link outlives the whole-listing budget while batches
+    /// keep arriving, and still fails one inactivity budget after the server stalls.
+    func testListDeadlineExtendsWithProgressForSlowLargeListing() {
+        let budgetMs: Int32 = 8_000
+        let progressTimeoutMs: Int32 = 1_500
+        var deadline = macfusegui_libssh2_list_deadline()
+        macfusegui_libssh2_list_deadline_start(&deadline, 0, budgetMs, progressTimeoutMs)
+        XCTAssertEqual(deadline.deadline_ms, 8_000)
+
+        // Slow filesystem: the first batch takes 5 s, well past the 1.5 s inactivity budget.
+        XCTAssertEqual(macfusegui_libssh2_list_deadline_progress(&deadline, 5_000), 8_000)
+
+        // 50 000 entries streamed as a batch every 1.2 s for a minute never hit the deadline.
+        var now: Int64 = 5_000
+        while now < 65_000 {
+            now += 1_200
+            XCTAssertLessThan(now, deadline.deadline_ms)
+            _ = macfusegui_libssh2_list_deadline_progress(&deadline, now)
+        }
+        XCTAssertEqual(deadline.deadline_ms, now + Int64(progressTimeoutMs))
+
+        // Without a progress budget the whole-listing budget is a hard cap, as before.
+        var fixed = macfusegui_libssh2_list_deadline()
+        macfusegui_libssh2_list_deadline_start(&fixed, 0, budgetMs, 0)
+        XCTAssertEqual(macfusegui_libssh2_list_deadline_progress(&fixed, 7_000), 8_000)
+    }
+
+    /// Beginner note: A keepalive on a handle without a session fails fast and reports the requested mode.
+    func testKeepAliveRejectsClosedSessionWithoutProbing() {
+        var handle = macfusegui_libssh2_session_handle()
+        handle.sock = -1
+        var outcome = macfusegui_libssh2_keepalive_outcome()
+        var errorPtr: UnsafeMutablePointer<CChar>?
+
+        let status = macfusegui_libssh2_keepalive_session(&handle, "/srv", 2, MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SSH, &outcome, &errorPtr)
+        defer {
+            if let errorPtr {
+                macfusegui_libssh2_free_error(errorPtr)
+            }
+        }
+
+        XCTAssertEqual(status, -40)
+        XCTAssertEqual(outcome.mode_used, MACFUSEGUI_LIBSSH2_KEEPALIVE_MODE_SSH)
+        XCTAssertEqual(outcome.sftp_probed, 0)
+        XCTAssertEqual(outcome.reply_seen, 0)
+        XCTAssertNotNil(errorPtr)
+        XCTAssertEqual(macfusegui_libssh2_ping_session(&handle, "/srv", 2, nil), -40)
+    }
+
+    /// Beginner note: Async closes go through the teardown thread; a zero-capacity queue closes inline.
+    func testReaperTearsDownHandedOffSessionsAndCountsInlineFallback() {
+        var before = macfusegui_libssh2_reaper_stats()
+        macfusegui_libssh2_reaper_get_stats(&before)
+        defer {
+            macfusegui_libssh2_reaper_configure(8)
+        }
+
+        macfusegui_libssh2_reaper_configure(0)
+        macfusegui_libssh2_close_session_async(Self.makeDetachedHandle())
+        macfusegui_libssh2_reaper_configure(8)
+        for _ in 0..<5 {
+            macfusegui_libssh2_close_session_async(Self.makeDetachedHandle())
+        }
+        macfusegui_libssh2_close_session_async(nil)
+        XCTAssertEqual(macfusegui_libssh2_reaper_drain(2_000), 0)
+
+        var after = macfusegui_libssh2_reaper_stats()
+        macfusegui_libssh2_reaper_get_stats(&after)
+        XCTAssertEqual(after.enqueued - before.enqueued, 5)
+        XCTAssertEqual(after.reaped - before.reaped, 5)
+        XCTAssertEqual(after.inline_closes - before.inline_closes, 1)
+        XCTAssertEqual(after.queue_depth, 0)
+        XCTAssertGreaterThanOrEqual(after.max_queue_depth, 1)
+        XCTAssertEqual(after.capacity, 8)
+    }
+
+    #if DEBUG
+    /// Beginner note: Benchmarks for native build + Swift conversion at 1k/10k/100k entries.
+    func testBenchmarkFlatListing1k() {
+        measureFlatListing(entryCount: 1_000)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func testBenchmarkFlatListing10k() {
+        measureFlatListing(entryCount: 10_000)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    func testBenchmarkFlatListing100k() {
+        measureFlatListing(entryCount: 100_000)
+    }
+    #endif
+
+    /// Beginner note: Runs the bridge's validator comparison on Swift values.
+    private static func validatorMatches(_ cached: BrowserDirectoryValidator, _ current: BrowserDirectoryValidator) -> Bool {
+        var cachedValue = cached.cValue
+        var currentValue = current.cValue
+        return macfusegui_libssh2_directory_validator_matches(&cachedValue, &currentValue) != 0
+    }
+
+    /// Beginner note: Validator for a directory whose listing saw newestServerUnix as its newest server timestamp.
+    private static func validatorWithReference(
+        modifiedAtUnix: Int64,
+        newestServerUnix: Int64,
+        clientNowUnix: Int64
+    ) -> BrowserDirectoryValidator {
+        var value = BrowserDirectoryValidator(modifiedAtUnix: modifiedAtUnix, sizeBytes: 4096, capturedAtUnix: 0).cValue
+        macfusegui_libssh2_directory_validator_set_reference(&value, newestServerUnix, clientNowUnix)
+        return BrowserDirectoryValidator(value)
+    }
+
+    /// Beginner note: Records which entries of a listed directory are symlinks.
+    private static func rememberLinks(_ handle: inout macfusegui_libssh2_session_handle, _ path: String, _ links: [String]) {
+        let copies = links.map { strdup($0) }
+        defer {
+            copies.forEach { free($0) }
+        }
+        var pointers = copies.map { UnsafePointer<CChar>($0) }
+        macfusegui_libssh2_session_remember_directory_links(&handle, path, &pointers, Int32(pointers.count))
+    }
+
+    /// Beginner note: Returns the cached canonical form of path, or nil on a miss.
+    private static func canonicalPath(_ handle: inout macfusegui_libssh2_session_handle, _ path: String) -> String? {
+        var buffer = [CChar](repeating: 0, count: 4096)
+        let length = macfusegui_libssh2_session_canonical_path(&handle, path, &buffer, Int32(buffer.count))
+        return length < 0 ? nil : String(cString: buffer)
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private static func resolverStats(_ resolver: OpaquePointer) -> macfusegui_libssh2_resolver_stats {
+        var stats = macfusegui_libssh2_resolver_stats()
+        macfusegui_libssh2_resolver_get_stats(resolver, &stats)
+        return stats
+    }
+
+    /// Beginner note: malloc-backed handle with no session or socket, since close_session frees it.
+    private static func makeDetachedHandle() -> UnsafeMutablePointer<macfusegui_libssh2_session_handle> {
+        let handle = calloc(1, MemoryLayout<macfusegui_libssh2_session_handle>.size)!
+            .assumingMemoryBound(to: macfusegui_libssh2_session_handle.self)
+        handle.pointee.sock = -1
+        return handle
+    }
+
+    /// Beginner note: Reads one integer IPPROTO_TCP option back from the kernel.
+    private static func tcpOption(_ fd: Int32, _ option: Int32) -> Int32 {
+        var value: Int32 = 0
+        var length = socklen_t(MemoryLayout<Int32>.size)
+        _ = getsockopt(fd, IPPROTO_TCP, option, &value, &length)
+        return value
+    }
+
+    /// Beginner note: Binds a listener on ::1 or 127.0.0.1; returns nil when the family is unavailable.
+    /// Beginner note: Port the kernel assigned to a socket bound to port 0.
+    private static func localPort(of fd: Int32) -> UInt16? {
+        var address = sockaddr_storage()
+        var length = socklen_t(MemoryLayout<sockaddr_storage>.size)
+        let result = withUnsafeMutablePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                getsockname(fd, $0, &length)
+            }
+        }
+        guard result == 0 else {
+            return nil
+        }
+        return withUnsafePointer(to: &address) { pointer -> UInt16? in
+            switch Int32(pointer.pointee.ss_family) {
+            case AF_INET:
+                return pointer.withMemoryRebound(to: sockaddr_in.self, capacity: 1) { UInt16(bigEndian: $0.pointee.sin_port) }
+            case AF_INET6:
+                return pointer.withMemoryRebound(to: sockaddr_in6.self, capacity: 1) { UInt16(bigEndian: $0.pointee.sin6_port) }
+            default:
+                return nil
+            }
+        }
+    }
+
+    private static func makeLoopbackListener(port: UInt16, ipv6: Bool, backlog: Int32) -> Int32? {
+        let fd = socket(ipv6 ? AF_INET6 : AF_INET, SOCK_STREAM, 0)
+        guard fd >= 0 else {
+            return nil
+        }
+        var one: Int32 = 1
+        _ = setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, socklen_t(MemoryLayout<Int32>.size))
+
+        let bound: Int32
+        if ipv6 {
+            _ = setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &one, socklen_t(MemoryLayout<Int32>.size))
+            var address = sockaddr_in6()
+            address.sin6_len = UInt8(MemoryLayout<sockaddr_in6>.size)
+            address.sin6_family = sa_family_t(AF_INET6)
+            address.sin6_port = port.bigEndian
+            address.sin6_addr = in6addr_loopback
+            bound = withUnsafePointer(to: &address) {
+                $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                    bind(fd, $0, socklen_t(MemoryLayout<sockaddr_in6>.size))
+                }
+            }
+        } else {
+            var address = sockaddr_in()
+            address.sin_len = UInt8(MemoryLayout<sockaddr_in>.size)
+            address.sin_family = sa_family_t(AF_INET)
+            address.sin_port = port.bigEndian
+            address.sin_addr.s_addr = in_addr_t(INADDR_LOOPBACK).bigEndian
+            bound = withUnsafePointer(to: &address) {
+                $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                    bind(fd, $0, socklen_t(MemoryLayout<sockaddr_in>.size))
+                }
+            }
+        }
+
+        guard bound == 0, listen(fd, backlog) == 0 else {
+            close(fd)
+            return nil
+        }
+        return fd
+    }
+
+    /// Beginner note: Starts a non-blocking connect to [::1]:port and returns the socket.
+    private static func startLoopbackConnect(port: UInt16) -> Int32 {
+        let fd = socket(AF_INET6, SOCK_STREAM, 0)
+        _ = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK)
+        var address = sockaddr_in6()
+        address.sin6_len = UInt8(MemoryLayout<sockaddr_in6>.size)
+        address.sin6_family = sa_family_t(AF_INET6)
+        address.sin6_port = port.bigEndian
+        address.sin6_addr = in6addr_loopback
+        _ = withUnsafePointer(to: &address) {
+            $0.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                connect(fd, $0, socklen_t(MemoryLayout<sockaddr_in6>.size))
+            }
+        }
+        return fd
+    }
+
+    #if DEBUG
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func measureFlatListing(entryCount: Int) {
+        measure {
+            var cResult = macfusegui_libssh2_flat_list_result()
+            _ = macfusegui_libssh2_fill_synthetic_flat_result(Int32(entryCount), &cResult)
+            let items = LibSSH2SFTPTransport.convertEntries(from: cResult, resolvedPath: "/srv/build")
+            XCTAssertEqual(items.count, entryCount)
+            macfusegui_libssh2_free_flat_list_result(&cResult)
+        }
+    }
+    #endif
+}
+
+/// Beginner note: Thread-safe counter for results checked inside concurrentPerform.
+private final class FailureCounter: @unchecked Sendable {
+    private let lock = NSLock()
+    private var value = 0
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return value
+    }
+
+    func increment() {
+        lock.lock()
+        value += 1
+        lock.unlock()
+    }
+}
+
+/// Beginner note: Status and return time of a wait that ran on another thread.
+private final class WaitOutcome: @unchecked Sendable {
+    private let lock = NSLock()
+    private var status: Int32 = 0
+    private var returnedAt = DispatchTime.now()
+
+    var value: (Int32, DispatchTime) {
+        lock.lock()
+        defer { lock.unlock() }
+        return (status, returnedAt)
+    }
+
+    func record(status: Int32) {
+        lock.lock()
+        self.status = status
+        returnedAt = DispatchTime.now()
+        lock.unlock()
+    }
+}
@@ -0,0 +1,400 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives LibSSH2SessionActor through a scripted in-memory BrowserTransport.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class LibSSH2SessionActorTests: XCTestCase {
+    /// Beginner note: Streamed batches must surface as cumulative partial snapshots before the final one.
+    func testStreamingListEmitsCumulativePartialSnapshots() async {
+        let transport = ScriptedBrowserTransport()
+        transport.batchSize = 2
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a", "b", "c", "d", "e"])
+        let session = makeSession(transport: transport)
+        let partials = SnapshotCollector()
+
+        let snapshot = await session.list(path: "/srv", requestID: 7, onPartial: { partials.append($0) })
+        await session.close()
+
+        XCTAssertFalse(snapshot.isPartial)
+        XCTAssertEqual(snapshot.entries.count, 5)
+        XCTAssertEqual(partials.snapshots.map(\.entries.count), [2, 4, 5])
+        XCTAssertTrue(partials.snapshots.allSatisfy { $0.isPartial && $0.requestID == 7 && $0.isStale })
+    }
+
+    /// Beginner note: Rows from a pass that was restarted on a new session are dropped, and a
+    /// replayed batch does not duplicate rows.
+    func testRestartedStreamDropsAbortedRowsAndDeduplicates() async {
+        let transport = ScriptedBrowserTransport()
+        transport.batchSize = 2
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a", "b", "c", "d", "e"])
+        transport.abortedPassEntries = Self.items(base: "/srv", names: ["gone-1", "gone-2", "gone-3"])
+        transport.replaysPages = true
+        let session = makeSession(transport: transport)
+        let partials = SnapshotCollector()
+
+        let snapshot = await session.list(path: "/srv", requestID: 9, onPartial: { partials.append($0) })
+        await session.close()
+
+        XCTAssertEqual(snapshot.entries.map(\.name), ["a", "b", "c", "d", "e"])
+        XCTAssertEqual(partials.snapshots.map(\.entries.count), [3, 2, 4, 5])
+        XCTAssertEqual(partials.snapshots.last?.entries.map(\.name), ["a", "b", "c", "d", "e"])
+    }
+
+    /// Beginner note: Batch listing returns one snapshot per path and warms the cache for later fallbacks.
+    func testListManyReturnsPerPathSnapshotsAndWarmsCache() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a"])
+        transport.listings["/srv/a"] = Self.items(base: "/srv/a", names: ["x", "y"])
+        let session = makeSession(transport: transport)
+
+        let snapshots = await session.listMany(paths: ["/srv", "/srv/a/", "/missing"], requestID: 3)
+
+        XCTAssertEqual(snapshots.map(\.path), ["/srv", "/srv/a", "/missing"])
+        XCTAssertEqual(snapshots.map(\.entries.count), [1, 2, 0])
+        XCTAssertEqual(snapshots.map(\.isStale), [false, false, true])
+        let health = await session.currentHealth()
+        XCTAssertNotEqual(health.state, .failed)
+
+        transport.listings["/srv/a"] = nil
+        let fallback = await session.list(path: "/srv/a", requestID: 4)
+        await session.close()
+
+        XCTAssertTrue(fallback.fromCache)
+        XCTAssertEqual(fallback.entries.map(\.name), ["x", "y"])
+    }
+
+    /// Beginner note: Concurrent lists of one path share a single transport call, and each caller
+    /// still gets the result under its own requestID.
+    func testConcurrentListsForSamePathShareOneTransportCall() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a", "b"])
+        transport.listDelayNanoseconds = 200_000_000
+        let session = makeSession(transport: transport)
+
+        async let first = session.list(path: "/srv", requestID: 1)
+        async let second = session.list(path: "/srv/", requestID: 2)
+        async let third = session.retryCurrentPath(requestID: 3)
+        let snapshots = await [first, second, third]
+        let summary = await session.summaryLine()
+        await session.close()
+
+        XCTAssertEqual(transport.listCallCount, 1)
+        XCTAssertEqual(Set(snapshots.map(\.requestID)), [1, 2, 3])
+        XCTAssertTrue(snapshots.allSatisfy { $0.entries.map(\.name) == ["a", "b"] && !$0.isStale })
+        XCTAssertTrue(summary.contains("sharedLists=1 coalescedLists=2"), summary)
+    }
+
+    /// Beginner note: Navigating A -> B -> A while A's cancelled call is still draining must start a
+    /// fresh listing of A, not hand back the cancelled call's stale snapshot.
+    func testReturningToPathWhileCancelledListingDrainsStartsFreshListing() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv/a"] = Self.items(base: "/srv/a", names: ["a1", "a2"])
+        transport.listings["/srv/b"] = Self.items(base: "/srv/b", names: ["b1"])
+        transport.listDelayNanoseconds = 300_000_000
+        transport.listDelayIgnoresCancellation = true
+        let session = makeSession(transport: transport)
+
+        let firstA = Task { await session.list(path: "/srv/a", requestID: 1) }
+        try? await Task.sleep(nanoseconds: 30_000_000)
+        firstA.cancel()
+        let toB = Task { await session.list(path: "/srv/b", requestID: 2) }
+        try? await Task.sleep(nanoseconds: 30_000_000)
+        toB.cancel()
+        let backToA = await session.list(path: "/srv/a", requestID: 3)
+        _ = await firstA.value
+        _ = await toB.value
+        await session.close()
+
+        XCTAssertEqual(backToA.requestID, 3)
+        XCTAssertEqual(backToA.path, "/srv/a")
+        XCTAssertFalse(backToA.isStale)
+        XCTAssertFalse(backToA.fromCache)
+        XCTAssertEqual(backToA.entries.map(\.name), ["a1", "a2"])
+        XCTAssertEqual(transport.listCallCount, 3)
+    }
+
+    /// Beginner note: A superseded (cancelled) list must not count as a failure or retry,
+    /// and the session must serve the next request normally.
+    func testCancelledListLeavesHealthAndSessionUsable() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a"])
+        transport.listDelayNanoseconds = 5_000_000_000
+        let session = makeSession(transport: transport)
+
+        let task = Task { await session.list(path: "/srv", requestID: 1) }
+        try? await Task.sleep(nanoseconds: 50_000_000)
+        task.cancel()
+        let cancelled = await task.value
+        let health = await session.currentHealth()
+
+        XCTAssertNil(cancelled.message)
+        XCTAssertTrue(cancelled.isStale)
+        XCTAssertNil(health.lastError)
+        XCTAssertNotEqual(health.state, .failed)
+        XCTAssertEqual(transport.listCallCount, 1)
+
+        transport.listDelayNanoseconds = 0
+        let next = await session.list(path: "/srv", requestID: 2)
+        await session.close()
+
+        XCTAssertFalse(next.isStale)
+        XCTAssertEqual(next.entries.map(\.name), ["a"])
+    }
+
+    /// Beginner note: The transport's stage breakdown must reach the session summary line.
+    func testSummaryLineReportsLastStageTiming() async {
+        let transport = ScriptedBrowserTransport()
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a"])
+        transport.stageTiming = BrowserStageTiming(
+            resolveMicros: 120,
+            connectMicros: 12_000,
+            handshakeMicros: 40_000,
+            authMicros: 25_000,
+            sftpInitMicros: 8_000,
+            realpathMicros: 4_200,
+            opendirMicros: 3_900,
+            readdirMicros: 10_100,
+            handshakeRoundTrips: 3,
+            authRoundTrips: 2,
+            sftpInitRoundTrips: 1,
+            realpathRoundTrips: 1,
+            opendirRoundTrips: 1,
+            readdirRoundTrips: 2,
+            connectAttempts: 1,
+            resolveCached: true
+        )
+        let session = makeSession(transport: transport)
+
+        let before = await session.summaryLine()
+        _ = await session.list(path: "/srv", requestID: 1)
+        let after = await session.summaryLine()
+        await session.close()
+
+        XCTAssertTrue(before.contains("stages=-"))
+        XCTAssertTrue(after.contains("resolve=0.1ms(cached)"), after)
+        XCTAssertTrue(after.contains("handshake=40.0ms/3rt"), after)
+        XCTAssertTrue(after.contains("realpath=4.2ms/1rt,opendir=3.9ms/1rt,readdir=10.1ms/2rt"), after)
+
+        var reused = BrowserStageTiming(realpathMicros: 900, realpathRoundTrips: 1)
+        XCTAssertFalse(reused.includesSessionOpen)
+        XCTAssertFalse(reused.summary.contains("handshake="))
+        reused.adoptOpenStages(from: transport.stageTiming!)
+        XCTAssertTrue(reused.summary.hasPrefix("resolve="))
+    }
+
+    /// Beginner note: A refresh sends the cached validator; an unchanged directory keeps the cached
+    /// rows as a fresh listing, and a changed one is relisted in full.
+    func testRefreshRevalidatesUnchangedDirectoryWithoutRelisting() async {
+        let transport = ScriptedBrowserTransport()
+        let validator = BrowserDirectoryValidator(modifiedAtUnix: 1_700_000_000, sizeBytes: 4096, capturedAtUnix: 1_700_000_100)
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["a", "b"])
+        transport.validators["/srv"] = validator
+        let session = makeSession(transport: transport)
+
+        _ = await session.list(path: "/srv", requestID: 1)
+        // Served listing changes, but the directory attributes do not: the cached rows must win.
+        transport.listings["/srv"] = Self.items(base: "/srv", names: ["zzz"])
+        let revalidated = await session.list(path: "/srv", requestID: 2)
+
+        var changed = validator
+        changed.modifiedAtUnix += 5
+        transport.validators["/srv"] = changed
+        let relisted = await session.list(path: "/srv", requestID: 3)
+        await session.close()
+
+        XCTAssertEqual(transport.receivedValidators, [nil, validator, validator])
+        XCTAssertFalse(revalidated.isStale)
+        XCTAssertEqual(revalidated.requestID, 2)
+        XCTAssertEqual(revalidated.entries.map(\.name), ["a", "b"])
+        XCTAssertEqual(relisted.entries.map(\.name), ["zzz"])
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    private func makeSession(transport: ScriptedBrowserTransport) -> LibSSH2SessionActor {
+        LibSSH2SessionActor(
+            id: UUID(),
+            remote: RemoteConfig(
+                displayName: "Test",
+                host: "example.invalid",
+                username: "dev",
+                authMode: .privateKey,
+                privateKeyPath: "/tmp/id_test",
+                remoteDirectory: "/srv",
+                localMountPoint: "/tmp/mnt-test"
+            ),
+            password: nil,
+            transport: transport,
+            diagnostics: DiagnosticsService(),
+            requestRetrySchedule: [],
+            recoveryRetrySchedule: [],
+            keepAliveIntervalNanoseconds: 60_000_000_000
+        )
+    }
+
+    /// Beginner note: This method is one step in the feature workflow for this file.
+    static func items(base: String, names: [String]) -> [RemoteDirectoryItem] {
+        names.map {
+            RemoteDirectoryItem(
+                name: $0,
+                fullPath: BrowserPathNormalizer.join(base: base, child: $0),
+                isDirectory: true,
+                modifiedAt: nil,
+                sizeBytes: nil
+            )
+        }
+    }
+}
+
+/// Beginner note: In-memory transport that serves fixed listings and records calls.
+final class ScriptedBrowserTransport: BrowserTransport, @unchecked Sendable {
+    private let lock = NSLock()
+    var listings: [String: [RemoteDirectoryItem]] = [:]
+    var batchSize = 0
+    // Streamed as generation 0 before the real rows, which then arrive as generation 1 (a reopened session).
+    var abortedPassEntries: [RemoteDirectoryItem] = []
+    // Sends every real batch after the first twice, as a transport retrying a page would.
+    var replaysPages = false
+    var listDelayNanoseconds: UInt64 = 0
+    // Models a native call that keeps running until its reply arrives, even after cancellation.
+    var listDelayIgnoresCancellation = false
+    var stageTiming: BrowserStageTiming?
+    // Current directory attributes per path; a request carrying an equal validator is answered notModified.
+    var validators: [String: BrowserDirectoryValidator] = [:]
+    // Whether the fake server answers SSH keepalives; when false the keepalive falls back to a stat.
+    var answersSSHKeepAlive = true
+    private(set) var listCallCount = 0
+    private(set) var pingCallCount = 0
+    private(set) var keepAliveModes: [BrowserKeepAliveMode] = []
+    private(set) var receivedValidators: [BrowserDirectoryValidator?] = []
+
+    func listDirectories(remote: RemoteConfig, path: String, password: String?) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password, onBatch: nil)
+    }
+
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?
+    ) async throws -> BrowserTransportListResult {
+        try await listDirectories(remote: remote, path: path, password: password, onBatch: onBatch, ifModified: nil)
+    }
+
+    func listDirectories(
+        remote: RemoteConfig,
+        path: String,
+        password: String?,
+        onBatch: BrowserTransportBatchHandler?,
+        ifModified validator: BrowserDirectoryValidator?
+    ) async throws -> BrowserTransportListResult {
+        let normalized = BrowserPathNormalizer.normalize(path: path)
+        lock.lock()
+        listCallCount += 1
+        receivedValidators.append(validator)
+        let current = validators[normalized]
+        let entries = listings[normalized]
+        let delay = listDelayNanoseconds
+        let ignoresCancellation = listDelayIgnoresCancellation
+        let batchSize = batchSize
+        let abortedPassEntries = abortedPassEntries
+        let replaysPages = replaysPages
+        let stageTiming = stageTiming
+        lock.unlock()
+
+        if delay > 0, ignoresCancellation {
+            await withCheckedContinuation { continuation in
+                DispatchQueue.global().asyncAfter(deadline: .now() + .nanoseconds(Int(delay))) {
+                    continuation.resume()
+                }
+            }
+            try Task.checkCancellation()
+        } else if delay > 0 {
+            try await Task.sleep(nanoseconds: delay)
+        }
+        guard let entries else {
+            throw AppError.remoteBrowserError("No such directory: \(normalized)")
+        }
+        if let validator, validator == current {
+            return BrowserTransportListResult(
+                resolvedPath: normalized,
+                entries: [],
+                latencyMs: 1,
+                reopenedSession: false,
+                directoryValidator: current,
+                notModified: true
+            )
+        }
+
+        if let onBatch, batchSize > 0 {
+            let generation = abortedPassEntries.isEmpty ? 0 : 1
+            if !abortedPassEntries.isEmpty {
+                onBatch(BrowserTransportListBatch(resolvedPath: normalized, startIndex: 0, entries: abortedPassEntries))
+            }
+            var start = 0
+            while start < entries.count {
+                let end = min(entries.count, start + batchSize)
+                let batch = BrowserTransportListBatch(
+                    resolvedPath: normalized,
+                    startIndex: start,
+                    entries: Array(entries[start..<end]),
+                    generation: generation
+                )
+                onBatch(batch)
+                if start > 0, replaysPages {
+                    onBatch(batch)
+                }
+                start = end
+            }
+        }
+
+        return BrowserTransportListResult(
+            resolvedPath: normalized,
+            entries: entries,
+            latencyMs: 1,
+            reopenedSession: false,
+            firstEntryLatencyMs: entries.isEmpty ? nil : 0,
+            stageTiming: stageTiming,
+            directoryValidator: current
+        )
+    }
+
+    func ping(remote: RemoteConfig, path: String, password: String?) async throws {
+        lock.lock()
+        pingCallCount += 1
+        lock.unlock()
+    }
+
+    func keepAlive(remote: RemoteConfig, path: String, password: String?, mode: BrowserKeepAliveMode) async throws -> BrowserKeepAliveResult {
+        lock.lock()
+        keepAliveModes.append(mode)
+        let replySeen = mode == .sshProtocol && answersSSHKeepAlive
+        lock.unlock()
+        return BrowserKeepAliveResult(modeUsed: mode, sftpProbed: !replySeen, replySeen: replySeen, latencyMs: 2)
+    }
+}
+
+/// Beginner note: Thread-safe sink for partial snapshots delivered from the transport queue.
+final class SnapshotCollector: @unchecked Sendable {
+    private let lock = NSLock()
+    private var storage: [RemoteBrowserSnapshot] = []
+
+    var snapshots: [RemoteBrowserSnapshot] {
+        lock.lock()
+        defer { lock.unlock() }
+        return storage
+    }
+
+    func append(_ snapshot: RemoteBrowserSnapshot) {
+        lock.lock()
+        storage.append(snapshot)
+        lock.unlock()
+    }
+}
@@ -0,0 +1,224 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives MountManager.mountTableDidChange with a scripted table and the kqueue watcher through an injected EVFILT_USER source.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class MountChangeWatcherTests: XCTestCase {
+    private static let root = MountRecord(source: "/dev/disk3s1", mountPoint: "/", filesystemType: "apfs")
+
+    /// Beginner note: Only remotes whose table presence disagrees with their cached state are flagged,
+    /// and the event-to-decision latency is recorded.
+    func testMountChangeFlagsOnlyRemotesWhosePresenceChanged() async {
+        let appeared = makeRemote(name: "Appeared", mountPoint: "/tmp/macfusegui-tests/appeared")
+        let untouched = makeRemote(name: "Untouched", mountPoint: "/tmp/macfusegui-tests/untouched")
+        let reader = SwitchableMountTableReader(records: [Self.root])
+        let snapshots = MountTableSnapshotService(reader: reader, maxAge: 60)
+        let manager = makeManager(mountSnapshots: snapshots)
+
+        // Warm the shared snapshot so the change handler must bypass it.
+        XCTAssertNoThrow(try snapshots.snapshot())
+        reader.records = [
+            Self.root,
+            MountRecord(source: "dev@host:/srv", mountPoint: appeared.localMountPoint, filesystemType: "macfuse")
+        ]
+
+        let event = MountChangeEvent(flags: .mounted)
+        let flagged = await manager.mountTableDidChange(event, remotes: [appeared, untouched])
+        let reactedAt = DispatchTime.now().uptimeNanoseconds
+
+        XCTAssertEqual(flagged, [appeared.id])
+        XCTAssertEqual(reader.readCount, 2)
+        let stats = await manager.mountChangeStatistics()
+        XCTAssertEqual(stats.events, 1)
+        XCTAssertEqual(stats.remotesFlagged, 1)
+        XCTAssertEqual(stats.lastFlags, .mounted)
+        XCTAssertLessThanOrEqual(stats.lastDetectionLatencyMicros, Int64((reactedAt - event.detectedAtUptimeNanos) / 1_000))
+        XCTAssertLessThan(stats.lastDetectionLatencyMicros, 100_000, "deciding what to refresh must not wait on process probes")
+
+        let summary = await manager.refreshProbeDiagnosticsSummary(remotes: [appeared])
+        XCTAssertTrue(summary.contains("- mount-change events=1 remotesFlagged=1 lastFlags=mounted"), summary)
+    }
+
+    /// Beginner note: Without a native table the handler cannot compare, so every remote is refreshed.
+    func testMountChangeWithoutNativeTableFlagsEveryRemote() async {
+        let first = makeRemote(name: "First", mountPoint: "/tmp/macfusegui-tests/first")
+        let second = makeRemote(name: "Second", mountPoint: "/tmp/macfusegui-tests/second")
+        let manager = makeManager(mountSnapshots: nil)
+
+        let flagged = await manager.mountTableDidChange(MountChangeEvent(flags: .changed), remotes: [first, second])
+
+        XCTAssertEqual(Set(flagged), [first.id, second.id])
+    }
+
+    /// Beginner note: Events merged during the debounce keep every flag and the earliest timestamp.
+    func testMergedEventsKeepEarliestDetectionTime() {
+        var event = MountChangeEvent(flags: .mounted, detectedAtUptimeNanos: 200)
+        event.merge(MountChangeEvent(flags: .dead, detectedAtUptimeNanos: 100))
+        event.merge(MountChangeEvent(flags: .changed, detectedAtUptimeNanos: 300))
+
+        XCTAssertEqual(event.flags, [.mounted, .dead, .changed])
+        XCTAssertEqual(event.detectedAtUptimeNanos, 100)
+        XCTAssertEqual(event.flags.label, "mounted,changed,dead")
+    }
+
+    #if canImport(Darwin)
+    /// Beginner note: Drives the real kqueue and dispatch path through an EVFILT_USER source: each
+    /// posted VQ_* mask arrives once as the mapped flags, and nothing is delivered after stop().
+    func testKqueueWatcherDeliversInjectedVolumeEvents() async throws {
+        let watcher = KqueueMountChangeWatcher(eventSource: .user(ident: 0x6d6e74))
+        XCTAssertFalse(watcher.post(vqFlags: UInt32(VQ_MOUNT)), "posting before start must be refused")
+
+        let received = EventRecorder()
+        try watcher.start { event in
+            received.append(event)
+        }
+        XCTAssertEqual(watcher.backendName, "kqueue-user")
+
+        let postedAt = DispatchTime.now().uptimeNanoseconds
+        XCTAssertTrue(watcher.post(vqFlags: UInt32(VQ_MOUNT)))
+        let mounted = try await waitForEvents(received, count: 1)
+        XCTAssertEqual(mounted.first?.flags, .mounted)
+        XCTAssertGreaterThanOrEqual(mounted.first?.detectedAtUptimeNanos ?? 0, postedAt)
+
+        XCTAssertTrue(watcher.post(vqFlags: UInt32(VQ_NOTRESP) | UInt32(VQ_DEAD)))
+        let failing = try await waitForEvents(received, count: 2)
+        XCTAssertEqual(failing.last?.flags, [.notResponding, .dead])
+
+        XCTAssertTrue(watcher.post(vqFlags: UInt32(VQ_LOWDISK)))
+        let other = try await waitForEvents(received, count: 3)
+        XCTAssertEqual(other.last?.flags, .changed)
+
+        watcher.stop()
+        XCTAssertFalse(watcher.post(vqFlags: UInt32(VQ_UNMOUNT)), "a stopped watcher must not accept events")
+        try await Task.sleep(nanoseconds: 50_000_000)
+        XCTAssertEqual(received.events.count, 3)
+    }
+
+    private func waitForEvents(_ recorder: EventRecorder, count: Int) async throws -> [MountChangeEvent] {
+        let deadline = Date().addingTimeInterval(5)
+        while recorder.events.count < count, Date() < deadline {
+            try await Task.sleep(nanoseconds: 5_000_000)
+        }
+        let events = recorder.events
+        XCTAssertEqual(events.count, count, "watcher did not deliver the posted event")
+        return events
+    }
+    #endif
+
+    private func makeManager(mountSnapshots: MountTableSnapshotService?) -> MountManager {
+        let diagnostics = DiagnosticsService()
+        let parser = MountStateParser()
+        let runner = SilentRunner()
+        return MountManager(
+            runner: runner,
+            dependencyChecker: ReadyDependencyChecker(),
+            askpassHelper: AskpassHelper(),
+            unmountService: UnmountService(
+                runner: runner,
+                diagnostics: diagnostics,
+                mountStateParser: parser
+            ),
+            mountStateParser: parser,
+            mountSnapshots: mountSnapshots,
+            diagnostics: diagnostics,
+            commandBuilder: MountCommandBuilder(redactionService: RedactionService())
+        )
+    }
+
+    private func makeRemote(name: String, mountPoint: String) -> RemoteConfig {
+        RemoteConfig(
+            displayName: name,
+            host: "10.0.0.2",
+            port: 22,
+            username: "dev",
+            authMode: .privateKey,
+            privateKeyPath: "/tmp/mock-id",
+            remoteDirectory: "/srv",
+            localMountPoint: mountPoint
+        )
+    }
+}
+
+private struct ReadyDependencyChecker: DependencyChecking {
+    func check(sshfsOverride: String?) -> DependencyStatus {
+        DependencyStatus(isReady: true, sshfsPath: sshfsOverride ?? "/usr/bin/sshfs", issues: [])
+    }
+}
+
+/// Beginner note: Runner for code paths that must not depend on process output.
+private struct SilentRunner: ProcessRunning {
+    func run(
+        executable: String,
+        arguments: [String],
+        environment: [String : String],
+        timeout: TimeInterval,
+        standardInput: String?
+    ) async throws -> ProcessResult {
+        ProcessResult(
+            executable: executable,
+            arguments: arguments,
+            stdout: "",
+            stderr: "",
+            exitCode: 0,
+            timedOut: false,
+            duration: 0.01
+        )
+    }
+}
+
+/// Beginner note: Thread-safe reader whose table tests can swap between reads.
+private final class SwitchableMountTableReader: MountTableReading, @unchecked Sendable {
+    private let lock = NSLock()
+    private var storedRecords: [MountRecord]
+    private var storedReadCount = 0
+
+    init(records: [MountRecord]) {
+        storedRecords = records
+    }
+
+    var backendName: String { "scripted" }
+
+    var records: [MountRecord] {
+        get { lock.lock(); defer { lock.unlock() }; return storedRecords }
+        set { lock.lock(); storedRecords = newValue; lock.unlock() }
+    }
+
+    var readCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return storedReadCount
+    }
+
+    func readMountTable() throws -> [MountRecord] {
+        lock.lock()
+        defer { lock.unlock() }
+        storedReadCount += 1
+        return storedRecords
+    }
+}
+
+/// Beginner note: Collects events handed over from the watcher's queue.
+private final class EventRecorder: @unchecked Sendable {
+    private let lock = NSLock()
+    private var stored: [MountChangeEvent] = []
+
+    var events: [MountChangeEvent] {
+        lock.lock()
+        defer { lock.unlock() }
+        return stored
+    }
+
+    func append(_ event: MountChangeEvent) {
+        lock.lock()
+        stored.append(event)
+        lock.unlock()
+    }
+}
@@ -0,0 +1,240 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Compares the byte-level MountStateParser with the String-based parser it replaced, and benchmarks lookups.
+// Concurrency: Runs with standard synchronous execution unless specific methods use async/await.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class MountStateParserEquivalenceTests: XCTestCase {
+    // Fuzz alphabet: delimiters, escapes, path segments and multi-byte text. Carriage returns and
+    // combining marks are left out because they merge with neighbours into one Character, which
+    // only the String parser (not mount(8) output) ever had to care about.
+    private static let tokens = [
+        "a", "Z", "0", "7", "8", "/", "//", "/./", "/../", ".", "..", " ", "  ", "\t", " on ", "on", "o",
+        " (", "(", ")", ",", ", ", "\\", "\\\\", "\\040", "\\303\\251", "\\777", "\\08", "\\x", "é", "日本",
+        "🙂", "\u{00A0}", "\u{2003}", "@", ":", "-", "\n"
+    ]
+
+    /// Beginner note: Random lines must produce identical records and identical lookups.
+    func testFuzzedOutputMatchesStringParser() {
+        var generator = SplitMix64(seed: 0x6d6f_756e_7470_6172)
+        let parser = MountStateParser()
+
+        for iteration in 0..<3_000 {
+            let output = Self.fuzzedOutput(using: &generator)
+            let expected = LegacyMountOutputParser.parse(output)
+            let actual = parser.parseMountOutput(output)
+            XCTAssertEqual(actual, expected, "iteration \(iteration) output: \(output.debugDescription)")
+
+            var targets = expected.map(\.mountPoint)
+            targets += expected.map { $0.mountPoint + "/" }
+            targets += expected.map { "/./" + $0.mountPoint }
+            targets.append(Self.soup(using: &generator, length: 3))
+            for target in targets {
+                XCTAssertEqual(
+                    parser.record(forMountPoint: target, inMountOutput: output),
+                    parser.record(forMountPoint: target, from: expected),
+                    "iteration \(iteration) target \(target.debugDescription) output: \(output.debugDescription)"
+                )
+            }
+            if testRun?.failureCount ?? 0 > 0 {
+                return
+            }
+        }
+    }
+
+    /// Beginner note: Hand-picked edge cases that random soup rarely hits.
+    func testEdgeCasesMatchStringParser() {
+        let outputs = [
+            "",
+            "\n\n",
+            "src on / (apfs)",
+            "src on /Volumes/a (apfs",
+            " src on /Volumes/a/ ( apfs ,x)",
+            "src on token on /Volumes/real (macfuse_sshfs, nodev) (extra)",
+            "\u{00A0}src\u{00A0} on \u{2003}/Volumes/é\u{2003} (\u{00A0}macfuse, x)",
+            "src on /Volumes/a\\ (macfuse, x)",
+            "src on /Volumes/a\\\\040b (macfuse, x)",
+            "src on /Volumes/../Volumes/./a (macfuse, x)",
+            "src on \\040 (macfuse, x)",
+            "src on \u{00A0} (macfuse, x)"
+        ]
+        let parser = MountStateParser()
+
+        for output in outputs {
+            let expected = LegacyMountOutputParser.parse(output)
+            XCTAssertEqual(parser.parseMountOutput(output), expected, output.debugDescription)
+            for target in ["/", "/Volumes/a", "/Volumes/é", "/Volumes/real", "/Volumes/a\\040b", " "] {
+                XCTAssertEqual(
+                    parser.record(forMountPoint: target, inMountOutput: output),
+                    parser.record(forMountPoint: target, from: expected),
+                    "target \(target.debugDescription) output: \(output.debugDescription)"
+                )
+            }
+        }
+    }
+
+    /// Beginner note: Synthetic tables at 10 / 1k / 50k lines parse and look up exactly like the
+    /// String parser. The lookup for the last line is the scanner's worst case.
+    func testLargeTablesMatchStringParser() {
+        let parser = MountStateParser()
+        for lineCount in [10, 1_000, 50_000] {
+            let output = Self.syntheticMountOutput(lines: lineCount)
+            let expected = LegacyMountOutputParser.parse(output)
+            let actual = parser.parseMountOutput(output)
+            XCTAssertEqual(actual.count, lineCount)
+            XCTAssertEqual(actual, expected, "\(lineCount) lines")
+
+            for index in [0, lineCount / 2, lineCount - 1] {
+                let target = "/System/Volumes/Data/mnt/remote \(index)"
+                let match = parser.record(forMountPoint: target, inMountOutput: output)
+                XCTAssertNotNil(match, "\(lineCount) lines target \(target)")
+                XCTAssertEqual(match, parser.record(forMountPoint: target, from: expected), "\(lineCount) lines target \(target)")
+            }
+            XCTAssertNil(parser.record(forMountPoint: "/System/Volumes/Data/mnt/remote \(lineCount)", inMountOutput: output))
+        }
+    }
+
+    /// Beginner note: Benchmark for the lookup alone on a container-host-sized table.
+    func testBenchmarkLookupOnFiftyThousandLines() {
+        let parser = MountStateParser()
+        let output = Self.syntheticMountOutput(lines: 50_000)
+        measure {
+            XCTAssertNotNil(parser.record(forMountPoint: "/System/Volumes/Data/mnt/remote 49999", inMountOutput: output))
+        }
+    }
+
+    /// Beginner note: Full-table parse benchmarks, byte-level parser against the String parser at
+    /// each size. Timing only; compare the baselines pairwise in the test report.
+    func testBenchmarkByteParserTenLines() {
+        measureParse(lines: 10) { MountStateParser().parseMountOutput($0) }
+    }
+
+    func testBenchmarkStringParserTenLines() {
+        measureParse(lines: 10) { LegacyMountOutputParser.parse($0) }
+    }
+
+    func testBenchmarkByteParserOneThousandLines() {
+        measureParse(lines: 1_000) { MountStateParser().parseMountOutput($0) }
+    }
+
+    func testBenchmarkStringParserOneThousandLines() {
+        measureParse(lines: 1_000) { LegacyMountOutputParser.parse($0) }
+    }
+
+    func testBenchmarkByteParserFiftyThousandLines() {
+        measureParse(lines: 50_000) { MountStateParser().parseMountOutput($0) }
+    }
+
+    func testBenchmarkStringParserFiftyThousandLines() {
+        measureParse(lines: 50_000) { LegacyMountOutputParser.parse($0) }
+    }
+
+    /// Beginner note: Small tables repeat the parse so one measurement is not just timer noise.
+    private func measureParse(lines: Int, _ parse: (String) -> [MountRecord]) {
+        let output = Self.syntheticMountOutput(lines: lines)
+        let repetitions = max(1, 10_000 / lines)
+        measure {
+            for _ in 0..<repetitions {
+                _ = parse(output)
+            }
+        }
+    }
+
+    private static func fuzzedOutput(using generator: inout SplitMix64) -> String {
+        (0..<Int(generator.next() % 4 + 1)).map { _ -> String in
+            if generator.next() % 3 == 0 {
+                return soup(using: &generator, length: Int(generator.next() % 12))
+            }
+            let source = soup(using: &generator, length: Int(generator.next() % 4 + 1))
+            let mountPoint = "/" + soup(using: &generator, length: Int(generator.next() % 5))
+            let type = soup(using: &generator, length: Int(generator.next() % 3))
+            let options = soup(using: &generator, length: Int(generator.next() % 3))
+            return "\(source) on \(mountPoint) (\(type), \(options))"
+        }
+        .joined(separator: "\n")
+    }
+
+    private static func soup(using generator: inout SplitMix64, length: Int) -> String {
+        (0..<length).map { _ in tokens[Int(generator.next() % UInt64(tokens.count))] }.joined()
+    }
+
+    private static func syntheticMountOutput(lines: Int) -> String {
+        (0..<lines).map { index -> String in
+            if index % 10 == 0 {
+                return "dev@host:/srv/share\\040\(index) on /System/Volumes/Data/mnt/remote\\040\(index) (macfuse, nodev, nosuid, synchronous, mounted by dev)"
+            }
+            return "/dev/disk\(index)s1 on /System/Volumes/Data/mnt/remote \(index) (apfs, local, nodev, nosuid, journaled, noatime)"
+        }
+        .joined(separator: "\n")
+    }
+}
+
+/// Beginner note: Small deterministic generator so fuzz failures reproduce from the seed.
+private struct SplitMix64 {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var value = state
+        value = (value ^ (value >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        value = (value ^ (value >> 27)) &* 0x94D0_49BB_1331_11EB
+        return value ^ (value >> 31)
+    }
+}
+
+/// Beginner note: The String-based parser MountStateParser used before the byte-level scanner,
+/// kept verbatim as the reference the fuzz tests compare against.
+private enum LegacyMountOutputParser {
+    static func parse(_ output: String) -> [MountRecord] {
+        let decoder = MountStateParser()
+        return output
+            .split(separator: "\n", omittingEmptySubsequences: true)
+            .compactMap { line in
+                let lineString = String(line)
+                guard let typeStart = lineString.range(of: " (", options: .backwards) else {
+                    return nil
+                }
+                guard let onRange = lineString.range(
+                    of: " on ",
+                    options: .backwards,
+                    range: lineString.startIndex..<typeStart.lowerBound
+                ) else {
+                    return nil
+                }
+                guard let typeEnd = lineString[typeStart.upperBound...].firstIndex(of: ")") else {
+                    return nil
+                }
+
+                let source = decoder.decodeEscapedMountField(
+                    lineString[..<onRange.lowerBound]
+                        .trimmingCharacters(in: .whitespacesAndNewlines)
+                )
+                let mountPoint = decoder.decodeEscapedMountField(
+                    lineString[onRange.upperBound..<typeStart.lowerBound]
+                        .trimmingCharacters(in: .whitespacesAndNewlines)
+                )
+                let fsType = lineString[typeStart.upperBound..<typeEnd]
+                    .split(separator: ",", maxSplits: 1, omittingEmptySubsequences: false)
+                    .first
+                    .map(String.init)?
+                    .trimmingCharacters(in: .whitespacesAndNewlines) ?? ""
+
+                guard !source.isEmpty, !mountPoint.isEmpty, !fsType.isEmpty else {
+                    return nil
+                }
+
+                return MountRecord(source: source, mountPoint: mountPoint, filesystemType: fsType)
+            }
+    }
+}
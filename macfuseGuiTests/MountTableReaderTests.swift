@@ -0,0 +1,101 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives the mountinfo decoder with fixtures and compares the native reader with /sbin/mount output.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class MountTableReaderTests: XCTestCase {
+    /// Beginner note: Optional fields, octal escapes and multi-byte names decode like the kernel wrote them.
+    func testMountInfoDecodesEscapedFieldsAndOptionalTags() {
+        let fixture = """
+        22 1 8:1 / / rw,relatime shared:1 - ext4 /dev/sda1 rw
+        97 22 0:52 / /home/dev/MACFUSE\\040REMOTES/Test\\040Space rw,nosuid,nodev shared:60 master:2 - fuse.sshfs dev@host:/srv/remote\\040path rw,user_id=1000
+        98 22 0:53 / /mnt/caf\\303\\251 rw - fuse.sshfs dev@host:/caf\\303\\251 rw
+        99 22 0:54 / /mnt/literal\\\\back rw - tmpfs tmpfs rw
+        broken line without separator
+        """
+
+        let records = MountInfoTableReader.records(fromMountInfo: Data(fixture.utf8))
+
+        XCTAssertEqual(records.count, 4)
+        XCTAssertEqual(records[0], MountRecord(source: "/dev/sda1", mountPoint: "/", filesystemType: "ext4"))
+        XCTAssertEqual(records[1].mountPoint, "/home/dev/MACFUSE REMOTES/Test Space")
+        XCTAssertEqual(records[1].source, "dev@host:/srv/remote path")
+        XCTAssertEqual(records[1].filesystemType, "fuse.sshfs")
+        XCTAssertEqual(records[2].mountPoint, "/mnt/café")
+        XCTAssertEqual(records[2].source, "dev@host:/café")
+        XCTAssertEqual(records[3].mountPoint, "/mnt/literal\\\\back")
+        XCTAssertNotNil(MountStateParser().record(forMountPoint: "/home/dev/MACFUSE REMOTES/Test Space", from: records))
+    }
+
+    /// Beginner note: A missing table surfaces as an error so services fall back to process probes.
+    func testMountInfoReaderThrowsWhenTableIsMissing() {
+        let reader = MountInfoTableReader(path: "/nonexistent/macfusegui-tests/mountinfo")
+        XCTAssertThrowsError(try reader.readMountTable())
+    }
+
+    /// Beginner note: The native table holds the same mounts /sbin/mount reports, field for field.
+    /// Reads are retried when the table changed between the native read and the spawn.
+    func testNativeReaderMatchesParsedMountOutput() async throws {
+        let reader = try XCTUnwrap(MountTableReaders.platformDefault())
+        let parser = MountStateParser()
+        let runner = ProcessRunner()
+
+        var nativeRecords: [MountRecord] = []
+        var spawnRecords: [MountRecord] = []
+        for _ in 0..<3 {
+            let before = try reader.readMountTable()
+            let result = try await runner.run(executable: "/sbin/mount", arguments: [], timeout: 5)
+            XCTAssertEqual(result.exitCode, 0)
+            spawnRecords = parser.parseMountOutput(result.stdout)
+            nativeRecords = try reader.readMountTable()
+            if Set(before) == Set(nativeRecords) {
+                break
+            }
+        }
+
+        XCTAssertNotNil(parser.record(forMountPoint: "/", from: nativeRecords))
+        XCTAssertFalse(spawnRecords.isEmpty)
+        let nativeByMountPoint = Dictionary(nativeRecords.map { ($0.mountPoint, $0) }, uniquingKeysWith: { _, last in last })
+        let spawnByMountPoint = Dictionary(spawnRecords.map { ($0.mountPoint, $0) }, uniquingKeysWith: { _, last in last })
+        XCTAssertEqual(Set(nativeByMountPoint.keys), Set(spawnByMountPoint.keys))
+        for (mountPoint, spawned) in spawnByMountPoint {
+            guard let native = nativeByMountPoint[mountPoint] else {
+                continue
+            }
+            XCTAssertEqual(native.source, spawned.source, "source differs for \(mountPoint)")
+            XCTAssertEqual(native.filesystemType, spawned.filesystemType, "filesystem type differs for \(mountPoint)")
+        }
+    }
+
+    /// Beginner note: Benchmark for the native read. Compare its baseline with the spawn benchmark below.
+    func testBenchmarkNativeMountTableRead() throws {
+        let reader = try XCTUnwrap(MountTableReaders.platformDefault())
+        measure {
+            _ = try? reader.readMountTable()
+        }
+    }
+
+    /// Beginner note: Benchmark for the path the native read replaced: spawn /sbin/mount and parse its output.
+    func testBenchmarkMountSpawnAndParse() {
+        let parser = MountStateParser()
+        let runner = ProcessRunner()
+        measure {
+            let finished = expectation(description: "mount spawned and parsed")
+            Task {
+                if let result = try? await runner.run(executable: "/sbin/mount", arguments: [], timeout: 5) {
+                    _ = parser.parseMountOutput(result.stdout)
+                }
+                finished.fulfill()
+            }
+            wait(for: [finished], timeout: 10)
+        }
+    }
+}
@@ -0,0 +1,118 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Drives MountTableSnapshotService with a scripted mount-table reader.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class MountTableSnapshotServiceTests: XCTestCase {
+    private static let root = MountRecord(source: "/dev/disk3s1", mountPoint: "/", filesystemType: "apfs")
+    private static let remote = MountRecord(source: "dev@host:/srv", mountPoint: "/Volumes/remote a", filesystemType: "macfuse")
+
+    /// Beginner note: A whole refresh pass worth of concurrent lookups costs one table read.
+    func testConcurrentLookupsWithinWindowShareOneRead() async throws {
+        let reader = ScriptedMountTableReader(records: [Self.root, Self.remote])
+        let service = MountTableSnapshotService(reader: reader, maxAge: 60)
+
+        let generations = await withTaskGroup(of: UInt64?.self) { group -> [UInt64?] in
+            for _ in 0..<40 {
+                group.addTask {
+                    try? service.snapshot().generation
+                }
+            }
+            return await group.reduce(into: []) { $0.append($1) }
+        }
+
+        XCTAssertEqual(reader.readCount, 1)
+        XCTAssertEqual(Set(generations), [1])
+        let metrics = service.metrics()
+        XCTAssertEqual(metrics.reads, 1)
+        XCTAssertEqual(metrics.reuses, 39)
+        let snapshot = try service.snapshot()
+        XCTAssertEqual(snapshot.record(forMountPoint: "/Volumes/remote a/"), Self.remote)
+        XCTAssertEqual(snapshot.record(forMountPoint: "/Volumes/./remote a"), Self.remote)
+        XCTAssertNil(snapshot.record(forMountPoint: "/Volumes/remote b"))
+    }
+
+    /// Beginner note: Invalidation and fresh reads re-read; generation moves only when contents change.
+    func testGenerationAdvancesOnlyWhenTableChanges() throws {
+        let reader = ScriptedMountTableReader(records: [Self.root])
+        let service = MountTableSnapshotService(reader: reader, maxAge: 60)
+
+        XCTAssertEqual(try service.snapshot().generation, 1)
+        service.invalidate()
+        XCTAssertEqual(try service.snapshot().generation, 1)
+        XCTAssertEqual(reader.readCount, 2)
+
+        reader.records = [Self.root, Self.remote]
+        XCTAssertNil(try service.snapshot().record(forMountPoint: Self.remote.mountPoint), "window still serves the cached table")
+        let fresh = try service.snapshot(maxAge: 0)
+        XCTAssertEqual(fresh.generation, 2)
+        XCTAssertEqual(fresh.record(forMountPoint: Self.remote.mountPoint), Self.remote)
+        XCTAssertEqual(reader.readCount, 3)
+        XCTAssertTrue(service.summaryLine().contains("generation=2 records=2 reads=3"), service.summaryLine())
+    }
+
+    /// Beginner note: A failed read propagates (so callers fall back to mount/df) and is not cached.
+    func testReadFailurePropagatesAndIsRetried() throws {
+        let reader = ScriptedMountTableReader(records: [Self.root])
+        reader.failing = true
+        let service = MountTableSnapshotService(reader: reader, maxAge: 60)
+
+        XCTAssertThrowsError(try service.snapshot())
+        reader.failing = false
+        XCTAssertEqual(try service.snapshot().records, [Self.root])
+        XCTAssertEqual(service.metrics().failures, 1)
+        XCTAssertEqual(reader.readCount, 2)
+    }
+}
+
+/// Beginner note: Thread-safe reader whose table and failure mode tests can change between reads.
+private final class ScriptedMountTableReader: MountTableReading, @unchecked Sendable {
+    private let lock = NSLock()
+    private var storedRecords: [MountRecord]
+    private var storedFailing = false
+    private var storedReadCount = 0
+
+    init(records: [MountRecord]) {
+        storedRecords = records
+    }
+
+    var backendName: String { "scripted" }
+
+    var records: [MountRecord] {
+        get { locked { storedRecords } }
+        set { locked { storedRecords = newValue } }
+    }
+
+    var failing: Bool {
+        get { locked { storedFailing } }
+        set { locked { storedFailing = newValue } }
+    }
+
+    var readCount: Int {
+        locked { storedReadCount }
+    }
+
+    func readMountTable() throws -> [MountRecord] {
+        try locked {
+            storedReadCount += 1
+            if storedFailing {
+                throw AppError.processFailure("scripted mount-table failure")
+            }
+            return storedRecords
+        }
+    }
+
+    private func locked<T>(_ body: () throws -> T) rethrows -> T {
+        lock.lock()
+        defer { lock.unlock() }
+        return try body()
+    }
+}
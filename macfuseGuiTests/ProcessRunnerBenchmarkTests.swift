@@ -0,0 +1,159 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Spawns many short real processes through ProcessRunner and through the Process-based runner it replaced.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class ProcessRunnerBenchmarkTests: XCTestCase {
+    private static let commandCount = 500
+
+    /// Beginner note: 500 concurrent short commands through the shipping configuration. The
+    /// event-loop runner suspends callers beyond its spawn slots and watches every child from one
+    /// queue. Timing only; correctness lives in ProcessRunnerConcurrencyTests.
+    func testBenchmarkFiveHundredConcurrentCommandsPosixSpawn() {
+        measureBatch(ProcessRunner())
+    }
+
+    /// Beginner note: The same batch through the Process-based runner it replaced, which parks one
+    /// GCD worker per child on a semaphore. Compare the two baselines in the test report.
+    func testBenchmarkFiveHundredConcurrentCommandsProcess() {
+        measureBatch(LegacyProcessRunner())
+    }
+
+    private func measureBatch(_ runner: ProcessRunning) {
+        measure {
+            let finished = expectation(description: "batch finished")
+            Task {
+                await Self.runBatch(runner)
+                finished.fulfill()
+            }
+            wait(for: [finished], timeout: 120)
+        }
+    }
+
+    private static func runBatch(_ runner: ProcessRunning) async {
+        await withTaskGroup(of: Void.self) { group in
+            for index in 0..<commandCount {
+                group.addTask {
+                    _ = try? await runner.run(
+                        executable: "/bin/echo",
+                        arguments: ["bench-\(index)"],
+                        timeout: 60
+                    )
+                }
+            }
+        }
+    }
+}
+
+/// Beginner note: The Process-based runner ProcessRunner used before the event loop, reduced to its
+/// thread model (one worker blocked on a semaphore per child, NSLock-guarded readability handlers)
+/// so the benchmark compares against what shipped. Cancellation bookkeeping is left out.
+private struct LegacyProcessRunner: ProcessRunning {
+    func run(
+        executable: String,
+        arguments: [String],
+        environment: [String: String],
+        timeout: TimeInterval,
+        standardInput: String?
+    ) async throws -> ProcessResult {
+        try await withCheckedThrowingContinuation { continuation in
+            DispatchQueue.global(qos: .userInitiated).async {
+                let start = Date()
+                let process = Process()
+                let stdoutPipe = Pipe()
+                let stderrPipe = Pipe()
+                process.executableURL = URL(fileURLWithPath: executable)
+                process.arguments = arguments
+                var mergedEnvironment = ProcessInfo.processInfo.environment
+                environment.forEach { mergedEnvironment[$0.key] = $0.value }
+                process.environment = mergedEnvironment
+                process.standardOutput = stdoutPipe
+                process.standardError = stderrPipe
+
+                let terminationSemaphore = DispatchSemaphore(value: 0)
+                let captureLock = NSLock()
+                var stdoutData = Data()
+                var stderrData = Data()
+
+                func drain(_ handle: FileHandle, toStdout: Bool) -> Bool {
+                    captureLock.lock()
+                    defer { captureLock.unlock() }
+                    var buffer = [UInt8](repeating: 0, count: 16_384)
+                    while true {
+                        let bytesRead = read(handle.fileDescriptor, &buffer, buffer.count)
+                        if bytesRead > 0 {
+                            if toStdout {
+                                stdoutData.append(contentsOf: buffer[0..<bytesRead])
+                            } else {
+                                stderrData.append(contentsOf: buffer[0..<bytesRead])
+                            }
+                            continue
+                        }
+                        if bytesRead < 0 && errno == EINTR {
+                            continue
+                        }
+                        return bytesRead == 0 || !(errno == EAGAIN || errno == EWOULDBLOCK)
+                    }
+                }
+
+                for handle in [stdoutPipe.fileHandleForReading, stderrPipe.fileHandleForReading] {
+                    let fd = handle.fileDescriptor
+                    _ = fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK)
+                }
+                stdoutPipe.fileHandleForReading.readabilityHandler = { handle in
+                    if drain(handle, toStdout: true) {
+                        handle.readabilityHandler = nil
+                    }
+                }
+                stderrPipe.fileHandleForReading.readabilityHandler = { handle in
+                    if drain(handle, toStdout: false) {
+                        handle.readabilityHandler = nil
+                    }
+                }
+                process.terminationHandler = { _ in
+                    terminationSemaphore.signal()
+                }
+
+                do {
+                    try process.run()
+                } catch {
+                    continuation.resume(throwing: error)
+                    return
+                }
+
+                let didTimeout = terminationSemaphore.wait(timeout: .now() + timeout) == .timedOut
+                if didTimeout {
+                    process.terminate()
+                    _ = terminationSemaphore.wait(timeout: .now() + 0.6)
+                }
+                stdoutPipe.fileHandleForReading.readabilityHandler = nil
+                stderrPipe.fileHandleForReading.readabilityHandler = nil
+                _ = drain(stdoutPipe.fileHandleForReading, toStdout: true)
+                _ = drain(stderrPipe.fileHandleForReading, toStdout: false)
+
+                captureLock.lock()
+                let finalStdout = stdoutData
+                let finalStderr = stderrData
+                captureLock.unlock()
+                let stillRunning = process.isRunning
+                continuation.resume(returning: ProcessResult(
+                    executable: executable,
+                    arguments: arguments,
+                    stdout: String(data: finalStdout, encoding: .utf8) ?? "",
+                    stderr: String(data: finalStderr, encoding: .utf8) ?? "",
+                    exitCode: stillRunning ? -1 : process.terminationStatus,
+                    timedOut: didTimeout || stillRunning,
+                    duration: Date().timeIntervalSince(start)
+                ))
+            }
+        }
+    }
+}
@@ -0,0 +1,158 @@
+// BEGINNER FILE GUIDE
+// Layer: Automated test layer
+// Purpose: This file verifies production behavior and protects against regressions when code changes.
+// Called by: Executed by XCTest during xcodebuild test or IDE test runs.
+// Calls into: Spawns many short real processes through ProcessRunner with a small spawn-slot limit.
+// Concurrency: Contains async functions; these can suspend and resume without blocking the calling thread.
+// Maintenance tip: Start reading top-to-bottom once, then follow one user action end-to-end through call sites.
+
+import XCTest
+@testable import macfuseGui
+
+/// Beginner note: This type groups related state and behavior for one part of the app.
+/// Read stored properties first, then follow methods top-to-bottom to understand flow.
+final class ProcessRunnerConcurrencyTests: XCTestCase {
+    private static let commandCount = 200
+    private static let linesPerCommand = 50
+
+    /// Beginner note: Many more commands than spawn slots, with every tenth one timing out. Each
+    /// result must hold exactly its own lines in order, timeouts must only hit the sleepers, and
+    /// no descriptor or child process may outlive the batch.
+    func testQueuedCommandsKeepOrderedOutputTimeOutAndLeakNothing() async throws {
+        let runner = ProcessRunner(maxConcurrentChildren: 8)
+        let descriptorsBefore = Self.openDescriptorCount()
+
+        let results = try await withThrowingTaskGroup(of: (Int, ProcessResult).self) { group in
+            for index in 0..<Self.commandCount {
+                let sleeps = index % 10 == 0
+                group.addTask {
+                    // Print this shell's pid first so the test can check it was reaped.
+                    let script = sleeps
+                        ? "echo pid:$$; sleep 30 & echo pid:$!; wait"
+                        : "echo pid:$$; i=0; while [ $i -lt \(Self.linesPerCommand) ]; do echo out-\(index)-$i; echo err-\(index)-$i 1>&2; i=$((i+1)); done"
+                    let result = try await runner.run(
+                        executable: "/bin/sh",
+                        arguments: ["-c", script],
+                        timeout: sleeps ? 1 : 30
+                    )
+                    return (index, result)
+                }
+            }
+            var collected: [Int: ProcessResult] = [:]
+            for try await (index, result) in group {
+                collected[index] = result
+            }
+            return collected
+        }
+
+        XCTAssertEqual(results.count, Self.commandCount)
+        var pids: [pid_t] = []
+        for (index, result) in results {
+            let lines = result.stdout.split(separator: "\n").map(String.init)
+            pids.append(contentsOf: lines.compactMap(Self.pid(fromLine:)))
+            if index % 10 == 0 {
+                XCTAssertTrue(result.timedOut, "command \(index) should have timed out")
+                XCTAssertLessThan(result.duration, 10, "a timed-out command must not wait for its sleeper")
+                continue
+            }
+            XCTAssertFalse(result.timedOut, "command \(index) timed out")
+            XCTAssertEqual(result.exitCode, 0)
+            let expectedStdout = (0..<Self.linesPerCommand).map { "out-\(index)-\($0)" }
+            let expectedStderr = (0..<Self.linesPerCommand).map { "err-\(index)-\($0)" }
+            XCTAssertEqual(Array(lines.dropFirst()), expectedStdout, "stdout of command \(index) is mixed or reordered")
+            XCTAssertEqual(result.stderr.split(separator: "\n").map(String.init), expectedStderr)
+        }
+        XCTAssertGreaterThanOrEqual(pids.count, Self.commandCount - Self.commandCount / 10)
+
+        try await assertEventually("children are still alive or unreaped") {
+            pids.allSatisfy(Self.processIsGone)
+        }
+        try await assertEventually("descriptors leaked: before=\(descriptorsBefore) after=\(Self.openDescriptorCount())") {
+            Self.openDescriptorCount() <= descriptorsBefore
+        }
+    }
+
+    /// Beginner note: A caller cancelled while it waits for a spawn slot leaves the queue at once,
+    /// while the slot is still busy, never starts its child, and does not take the slot later.
+    func testCancelledWhileWaitingForSlotLeavesQueueImmediately() async throws {
+        let runner = ProcessRunner(maxConcurrentChildren: 1)
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("macfusegui-runner-\(UUID().uuidString)", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let marker = directory.appendingPathComponent("spawned").path
+
+        let blockerDone = CompletionFlag()
+        let blocker = Task {
+            defer { blockerDone.set() }
+            return try await runner.run(executable: "/bin/sleep", arguments: ["30"], timeout: 60)
+        }
+        try await Task.sleep(nanoseconds: 100_000_000)
+        let queued = Task {
+            try await runner.run(executable: "/usr/bin/touch", arguments: [marker], timeout: 10)
+        }
+        try await Task.sleep(nanoseconds: 100_000_000)
+        queued.cancel()
+
+        do {
+            _ = try await queued.value
+            XCTFail("a command cancelled before its slot opened must not run")
+        } catch is CancellationError {
+        }
+        XCTAssertFalse(blockerDone.isSet, "the cancelled wait must end while the only slot is still busy")
+        XCTAssertFalse(FileManager.default.fileExists(atPath: marker), "the cancelled command was spawned")
+
+        blocker.cancel()
+        _ = try await blocker.value
+        let next = try await runner.run(executable: "/bin/echo", arguments: ["after"], timeout: 10)
+        XCTAssertEqual(next.stdout, "after\n")
+        XCTAssertFalse(FileManager.default.fileExists(atPath: marker))
+    }
+
+    private func assertEventually(
+        _ message: @autoclosure () -> String,
+        file: StaticString = #filePath,
+        line: UInt = #line,
+        _ condition: () -> Bool
+    ) async throws {
+        let deadline = Date().addingTimeInterval(5)
+        while !condition(), Date() < deadline {
+            try await Task.sleep(nanoseconds: 20_000_000)
+        }
+        XCTAssertTrue(condition(), message(), file: file, line: line)
+    }
+
+    private static func pid(fromLine line: String) -> pid_t? {
+        guard line.hasPrefix("pid:") else {
+            return nil
+        }
+        return pid_t(line.dropFirst(4))
+    }
+
+    /// Beginner note: kill(pid, 0) still succeeds for a zombie, so ESRCH also proves the child was reaped.
+    private static func processIsGone(_ pid: pid_t) -> Bool {
+        kill(pid, 0) != 0 && errno == ESRCH
+    }
+
+    private static func openDescriptorCount() -> Int {
+        (try? FileManager.default.contentsOfDirectory(atPath: "/dev/fd").count) ?? 0
+    }
+}
+
+/// Beginner note: Set once from any thread; read by the test to check ordering without timing.
+private final class CompletionFlag: @unchecked Sendable {
+    private let lock = NSLock()
+    private var value = false
+
+    var isSet: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return value
+    }
+
+    func set() {
+        lock.lock()
+        value = true
+        lock.unlock()
+    }
+}
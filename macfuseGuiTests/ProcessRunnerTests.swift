@@ -127,6 +127,47 @@ final class ProcessRunnerTests: XCTestCase {
         }
     }
 
+    /// Beginner note: The optional cap keeps the first bytes, drains the rest so the child
+    /// still exits normally, and flags the result as truncated.
+    func testOutputCapKeepsPrefixAndFlagsTruncation() async throws {
+        let runner = ProcessRunner(maxOutputBytes: 4_096)
+        let result = try await runner.run(
+            executable: "/bin/sh",
+            arguments: ["-c", "i=0; while [ $i -lt 20000 ]; do echo line-$i; i=$((i+1)); done; echo done 1>&2"],
+            timeout: 10
+        )
+
+        XCTAssertFalse(result.timedOut)
+        XCTAssertEqual(result.exitCode, 0)
+        XCTAssertTrue(result.outputTruncated)
+        XCTAssertEqual(result.stdout.utf8.count, 4_096)
+        XCTAssertTrue(result.stdout.hasPrefix("line-0\nline-1\n"))
+        XCTAssertEqual(result.stderr, "done\n")
+    }
+
+    /// Beginner note: stdin is fed from the event loop, environment overrides are applied,
+    /// and a missing executable throws instead of returning a result.
+    func testStandardInputEnvironmentAndSpawnFailure() async throws {
+        let runner = ProcessRunner()
+        let echoed = try await runner.run(
+            executable: "/bin/sh",
+            arguments: ["-c", "cat; printf ':%s' \"$MACFUSEGUI_TEST_VALUE\""],
+            environment: ["MACFUSEGUI_TEST_VALUE": "override"],
+            timeout: 5,
+            standardInput: "from-stdin"
+        )
+        XCTAssertEqual(echoed.exitCode, 0)
+        XCTAssertEqual(echoed.stdout, "from-stdin:override")
+        XCTAssertFalse(echoed.outputTruncated)
+
+        do {
+            _ = try await runner.run(executable: "/nonexistent/macfusegui-tests/tool", arguments: [], timeout: 5)
+            XCTFail("Expected spawn failure")
+        } catch let AppError.processFailure(detail) {
+            XCTAssertTrue(detail.contains("Failed to start process"), detail)
+        }
+    }
+
     private func childPIDFromOutput(_ output: String) -> Int32? {
         for line in output.split(whereSeparator: \.isNewline) {
             let text = line.trimmingCharacters(in: .whitespacesAndNewlines)
@@ -109,10 +109,82 @@ final class RemotesViewModelRecoveryTests: XCTestCase {
         )
     }
 
+    func testMountChangeEventRefreshesOnlyFlaggedRemote() async throws {
+        let runner = RecordingCleanupRunner()
+        let diagnostics = DiagnosticsService()
+        let parser = MountStateParser()
+        let watched = makeRemote(name: "Watched", mountPoint: "/tmp/macfusegui-tests/watched")
+        let untouched = makeRemote(name: "Untouched", mountPoint: "/tmp/macfusegui-tests/untouched")
+        let root = MountRecord(source: "/dev/disk3s1", mountPoint: "/", filesystemType: "apfs")
+        let reader = ScriptedMountTableReader(records: [root])
+
+        let mountManager = MountManager(
+            runner: runner,
+            dependencyChecker: ReadyDependencyChecker(),
+            askpassHelper: AskpassHelper(),
+            unmountService: UnmountService(
+                runner: runner,
+                diagnostics: diagnostics,
+                mountStateParser: parser
+            ),
+            mountStateParser: parser,
+            mountSnapshots: MountTableSnapshotService(reader: reader, maxAge: 60),
+            diagnostics: diagnostics,
+            commandBuilder: MountCommandBuilder(redactionService: RedactionService())
+        )
+        let watcher = ManualMountChangeWatcher()
+        var configuration = RuntimeConfiguration()
+        configuration.remotes.mountChangeDebounceInterval = 0
+        // Keep the periodic pass out of the way so only the event can cause a refresh.
+        configuration.remotes.periodicRecoveryPassInterval = 3_600
+
+        let viewModel = makeViewModel(
+            diagnostics: diagnostics,
+            mountManager: mountManager,
+            runner: runner,
+            remoteStore: InMemoryRemoteStore(remotes: [watched, untouched]),
+            mountChangeWatcher: watcher,
+            runtimeConfiguration: configuration
+        )
+        viewModel.load()
+        XCTAssertTrue(watcher.isStarted, "loading remotes must start the mount-change watcher")
+        XCTAssertEqual(viewModel.status(for: watched.id).state, .disconnected)
+
+        reader.records = [
+            root,
+            MountRecord(source: "dev@10.0.0.2:/srv", mountPoint: watched.localMountPoint, filesystemType: "macfuse")
+        ]
+        watcher.fire(MountChangeEvent(flags: .mounted))
+
+        let deadline = Date().addingTimeInterval(5)
+        while viewModel.status(for: watched.id).state != .connected, Date() < deadline {
+            try await Task.sleep(nanoseconds: 10_000_000)
+        }
+
+        XCTAssertEqual(viewModel.status(for: watched.id).state, .connected)
+        XCTAssertEqual(viewModel.status(for: watched.id).mountedPath, watched.localMountPoint)
+        XCTAssertEqual(viewModel.status(for: untouched.id).state, .disconnected)
+        let commands = await runner.recordedCommands()
+        XCTAssertTrue(
+            commands.contains { $0.executable == "/usr/bin/stat" && $0.arguments.last == watched.localMountPoint },
+            "the flagged remote must be probed"
+        )
+        XCTAssertFalse(
+            commands.contains { $0.arguments.contains(untouched.localMountPoint) },
+            "a remote whose table presence did not change must not be probed"
+        )
+
+        await viewModel.prepareForTermination()
+        XCTAssertFalse(watcher.isStarted)
+    }
+
     private func makeViewModel(
         diagnostics: DiagnosticsService,
         mountManager: MountManager,
-        runner: ProcessRunning
+        runner: ProcessRunning,
+        remoteStore: RemoteStore = InMemoryRemoteStore(),
+        mountChangeWatcher: MountChangeWatching? = nil,
+        runtimeConfiguration: RuntimeConfiguration = RuntimeConfiguration()
     ) -> RemotesViewModel {
         let browserService = RemoteDirectoryBrowserService(
             manager: RemoteBrowserSessionManager(
@@ -128,14 +200,16 @@ final class RemotesViewModelRecoveryTests: XCTestCase {
         )
 
         return RemotesViewModel(
-            remoteStore: InMemoryRemoteStore(),
+            remoteStore: remoteStore,
             keychainService: StubKeychainService(),
             validationService: ValidationService(),
             dependencyChecker: DependencyChecker(),
             mountManager: mountManager,
             remoteDirectoryBrowserService: browserService,
             diagnostics: diagnostics,
-            launchAtLoginService: launchService
+            launchAtLoginService: launchService,
+            mountChangeWatcher: mountChangeWatcher,
+            runtimeConfiguration: runtimeConfiguration
         )
     }
 
@@ -166,8 +240,13 @@ private struct ReadyDependencyChecker: DependencyChecking {
 @MainActor
 private final class InMemoryRemoteStore: RemoteStore {
     let storageURL = URL(fileURLWithPath: "/tmp/macfusegui-tests/remotes.json")
+    private let remotes: [RemoteConfig]
+
+    init(remotes: [RemoteConfig] = []) {
+        self.remotes = remotes
+    }
 
-    func load() throws -> [RemoteConfig] { [] }
+    func load() throws -> [RemoteConfig] { remotes }
     func save(_ remotes: [RemoteConfig]) throws {}
     func upsert(_ remote: RemoteConfig) throws {}
     func delete(id: UUID) throws {}
@@ -231,3 +310,57 @@ private actor RecordingCleanupRunner: ProcessRunning {
         commands
     }
 }
+
+/// Beginner note: Watcher whose events the test fires by hand instead of waiting on the kernel.
+private final class ManualMountChangeWatcher: MountChangeWatching, @unchecked Sendable {
+    private let lock = NSLock()
+    private var handler: MountChangeHandler?
+
+    var backendName: String { "manual" }
+
+    var isStarted: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return handler != nil
+    }
+
+    func start(onChange: @escaping MountChangeHandler) throws {
+        lock.lock()
+        handler = onChange
+        lock.unlock()
+    }
+
+    func stop() {
+        lock.lock()
+        handler = nil
+        lock.unlock()
+    }
+
+    func fire(_ event: MountChangeEvent) {
+        lock.lock()
+        let current = handler
+        lock.unlock()
+        current?(event)
+    }
+}
+
+/// Beginner note: Thread-safe mount table the test swaps between reads.
+private final class ScriptedMountTableReader: MountTableReading, @unchecked Sendable {
+    private let lock = NSLock()
+    private var storedRecords: [MountRecord]
+
+    init(records: [MountRecord]) {
+        storedRecords = records
+    }
+
+    var backendName: String { "scripted" }
+
+    var records: [MountRecord] {
+        get { lock.lock(); defer { lock.unlock() }; return storedRecords }
+        set { lock.lock(); storedRecords = newValue; lock.unlock() }
+    }
+
+    func readMountTable() throws -> [MountRecord] {
+        records
+    }
+}